@@ -75,6 +75,12 @@ void CalibrationHandlerBindings::bind(pybind11::module& m, void* pCallstack) {
              py::arg("dstCamera"),
              py::arg("useSpecTranslation") = false,
              DOC(dai, CalibrationHandler, getCameraExtrinsics))
+        .def("getCameraExtrinsicsMatrix",
+             &CalibrationHandler::getCameraExtrinsicsMatrix,
+             py::arg("srcCamera"),
+             py::arg("dstCamera"),
+             py::arg("useSpecTranslation") = false,
+             DOC(dai, CalibrationHandler, getCameraExtrinsicsMatrix))
 
         .def("getCameraTranslationVector",
              &CalibrationHandler::getCameraTranslationVector,
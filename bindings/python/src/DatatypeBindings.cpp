@@ -17,6 +17,7 @@ void bind_imgdetections(pybind11::module& m, void* pCallstack);
 void bind_imgframe(pybind11::module& m, void* pCallstack);
 void bind_encodedframe(pybind11::module& m, void* pCallstack);
 void bind_imudata(pybind11::module& m, void* pCallstack);
+void bind_imubatch(pybind11::module& m, void* pCallstack);
 void bind_message_group(pybind11::module& m, void* pCallstack);
 void bind_nndata(pybind11::module& m, void* pCallstack);
 void bind_spatialimgdetections(pybind11::module& m, void* pCallstack);
@@ -58,6 +59,7 @@ void DatatypeBindings::addToCallstack(std::deque<StackFunction>& callstack) {
     callstack.push_front(bind_imgframe);
     callstack.push_front(bind_encodedframe);
     callstack.push_front(bind_imudata);
+    callstack.push_front(bind_imubatch);
     callstack.push_front(bind_message_group);
     callstack.push_front(bind_nndata);
     callstack.push_front(bind_spatialimgdetections);
@@ -119,6 +121,7 @@ void DatatypeBindings::bind(pybind11::module& m, void* pCallstack) {
         .value("AprilTags", DatatypeEnum::AprilTags)
         .value("Tracklets", DatatypeEnum::Tracklets)
         .value("IMUData", DatatypeEnum::IMUData)
+        .value("IMUBatch", DatatypeEnum::IMUBatch)
         .value("StereoDepthConfig", DatatypeEnum::StereoDepthConfig)
         .value("FeatureTrackerConfig", DatatypeEnum::FeatureTrackerConfig)
         .value("ThermalConfig", DatatypeEnum::ThermalConfig)
@@ -61,6 +61,7 @@ void MessageQueueBindings::bind(pybind11::module& m, void* pCallstack) {
 
     // To prevent blocking whole python interpreter, blocking functions like 'get' and 'send'
     // are pooled with a reasonable delay and check for python interrupt signal in between.
+    // Non-blocking functions still lock the queue, so they release the GIL as well.
 
     // Bind DataOutputQueue
     auto addCallbackLambda = [](MessageQueue& q, py::function cb) -> int {
@@ -109,6 +110,10 @@ void MessageQueueBindings::bind(pybind11::module& m, void* pCallstack) {
         .def("setMaxSize", &MessageQueue::setMaxSize, py::arg("maxSize"), DOC(dai, MessageQueue, setMaxSize))
         .def("getMaxSize", &MessageQueue::getMaxSize, DOC(dai, MessageQueue, getMaxSize))
         .def("getSize", &MessageQueue::getSize, DOC(dai, MessageQueue, getSize))
+        .def("setMaxBytes", &MessageQueue::setMaxBytes, py::arg("maxBytes"), DOC(dai, MessageQueue, setMaxBytes))
+        .def("getMaxBytes", &MessageQueue::getMaxBytes, DOC(dai, MessageQueue, getMaxBytes))
+        .def("getBytes", &MessageQueue::getBytes, DOC(dai, MessageQueue, getBytes))
+        .def_static("getTotalBytes", &MessageQueue::getTotalBytes, DOC(dai, MessageQueue, getTotalBytes))
         .def("isFull", &MessageQueue::isFull, DOC(dai, MessageQueue, isFull))
         .def("addCallback", addCallbackLambda, py::arg("callback"), DOC(dai, MessageQueue, addCallback))
         .def(
@@ -128,8 +133,11 @@ void MessageQueueBindings::bind(pybind11::module& m, void* pCallstack) {
             },
             py::arg("callbackId"),
             DOC(dai, MessageQueue, removeCallback))
-        .def("has", static_cast<bool (MessageQueue::*)()>(&MessageQueue::has), DOC(dai, MessageQueue, has))
-        .def("tryGet", static_cast<std::shared_ptr<ADatatype> (MessageQueue::*)()>(&MessageQueue::tryGet), DOC(dai, MessageQueue, tryGet))
+        .def("has", static_cast<bool (MessageQueue::*)()>(&MessageQueue::has), DOC(dai, MessageQueue, has), py::call_guard<py::gil_scoped_release>())
+        .def("tryGet",
+             static_cast<std::shared_ptr<ADatatype> (MessageQueue::*)()>(&MessageQueue::tryGet),
+             DOC(dai, MessageQueue, tryGet),
+             py::call_guard<py::gil_scoped_release>())
         .def(
             "get",
             [](MessageQueue& obj) {
@@ -149,7 +157,10 @@ void MessageQueueBindings::bind(pybind11::module& m, void* pCallstack) {
                 return d;
             },
             DOC(dai, MessageQueue, get))
-        .def("front", static_cast<std::shared_ptr<ADatatype> (MessageQueue::*)()>(&MessageQueue::front), DOC(dai, MessageQueue, front))
+        .def("front",
+             static_cast<std::shared_ptr<ADatatype> (MessageQueue::*)()>(&MessageQueue::front),
+             DOC(dai, MessageQueue, front),
+             py::call_guard<py::gil_scoped_release>())
         .def(
             "get",
             [](MessageQueue& obj, milliseconds timeout) {
@@ -170,7 +181,10 @@ void MessageQueueBindings::bind(pybind11::module& m, void* pCallstack) {
             },
             py::arg("timeout"),
             DOC(dai, MessageQueue, get))
-        .def("tryGetAll", static_cast<std::vector<std::shared_ptr<ADatatype>> (MessageQueue::*)()>(&MessageQueue::tryGetAll), DOC(dai, MessageQueue, tryGetAll))
+        .def("tryGetAll",
+             static_cast<std::vector<std::shared_ptr<ADatatype>> (MessageQueue::*)()>(&MessageQueue::tryGetAll),
+             DOC(dai, MessageQueue, tryGetAll),
+             py::call_guard<py::gil_scoped_release>())
         .def(
             "getAll",
             [](MessageQueue& obj) {
@@ -219,5 +233,51 @@ void MessageQueueBindings::bind(pybind11::module& m, void* pCallstack) {
             py::arg("msg"),
             py::arg("timeout"),
             DOC(dai, MessageQueue, send))
-        .def("trySend", &MessageQueue::trySend, py::arg("msg"), DOC(dai, MessageQueue, trySend));
+        .def(
+            "getAsync",
+            [](std::shared_ptr<MessageQueue> obj) {
+                // Bridges the queue to the running asyncio event loop. The future is resolved from the sending thread through
+                // call_soon_threadsafe, so no thread is needed per waiting queue
+                auto loop = py::module::import("asyncio").attr("get_running_loop")();
+                auto future = loop.attr("create_future")();
+                // Python objects captured by the callback may be released on a non-Python thread, so release them under the GIL
+                std::shared_ptr<py::object> loopFuture(new py::object(py::make_tuple(loop, future)), [](py::object* o) {
+                    py::gil_scoped_acquire gil;
+                    delete o;
+                });
+                auto resolve = [loopFuture](std::shared_ptr<ADatatype> msg) {
+                    py::gil_scoped_acquire gil;
+                    py::object loop = (*loopFuture)[py::int_(0)];
+                    py::object future = (*loopFuture)[py::int_(1)];
+                    py::object result = msg ? py::cast(msg) : messageQueueException(MessageQueue::QueueException("MessageQueue was closed").what());
+                    auto setResult = py::cpp_function([isException = msg == nullptr](py::object future, py::object result) {
+                        if(future.attr("done")().cast<bool>()) return;
+                        future.attr(isException ? "set_exception" : "set_result")(result);
+                    });
+                    try {
+                        loop.attr("call_soon_threadsafe")(setResult, future, result);
+                    } catch(py::error_already_set& e) {
+                        // Event loop was already closed, nobody awaits the result anymore
+                        e.discard_as_unraisable(__func__);
+                    }
+                };
+                MessageQueue::CallbackId id;
+                {
+                    py::gil_scoped_release release;
+                    id = obj->getAsync(resolve);
+                }
+                // Don't consume a message on behalf of a cancelled future
+                std::weak_ptr<MessageQueue> weakQueue = obj;
+                future.attr("add_done_callback")(py::cpp_function([weakQueue, id](py::object future) {
+                    if(!future.attr("cancelled")().cast<bool>()) return;
+                    auto queue = weakQueue.lock();
+                    if(queue) {
+                        py::gil_scoped_release release;
+                        queue->cancelGetAsync(id);
+                    }
+                }));
+                return future;
+            },
+            "Returns an asyncio future, resolved with the next message received by the queue. Must be called from within a running event loop.")
+        .def("trySend", &MessageQueue::trySend, py::arg("msg"), DOC(dai, MessageQueue, trySend), py::call_guard<py::gil_scoped_release>());
 }
\ No newline at end of file
@@ -24,6 +24,9 @@ void bind_adatatype(pybind11::module& m, void* pCallstack) {
     using namespace dai;
 
     py::class_<ADatatype, PyADataType, std::shared_ptr<ADatatype>> adatatype(m, "ADatatype", DOC(dai, ADatatype));
+    py::class_<LineageHop> lineageHop(m, "LineageHop", DOC(dai, LineageHop));
+    py::class_<LineageHopLatency> lineageHopLatency(m, "LineageHopLatency", DOC(dai, LineageHopLatency));
+    py::class_<MessageLineage, std::shared_ptr<MessageLineage>> messageLineage(m, "MessageLineage", DOC(dai, MessageLineage));
 
     ///////////////////////////////////////////////////////////////////////
     ///////////////////////////////////////////////////////////////////////
@@ -38,7 +41,28 @@ void bind_adatatype(pybind11::module& m, void* pCallstack) {
     ///////////////////////////////////////////////////////////////////////
     ///////////////////////////////////////////////////////////////////////
 
-    adatatype.def(py::init<>(), DOC(dai, ADatatype, ADatatype));
+    adatatype.def(py::init<>(), DOC(dai, ADatatype, ADatatype)).def("getLineage", &ADatatype::getLineage, DOC(dai, ADatatype, getLineage));
+
+    lineageHop.def(py::init<>())
+        .def_readwrite("nodeId", &LineageHop::nodeId, DOC(dai, LineageHop, nodeId))
+        .def_readwrite("name", &LineageHop::name, DOC(dai, LineageHop, name))
+        .def_readwrite("enqueued", &LineageHop::enqueued, DOC(dai, LineageHop, enqueued))
+        .def_readwrite("dequeued", &LineageHop::dequeued, DOC(dai, LineageHop, dequeued))
+        .def_readwrite("emitted", &LineageHop::emitted, DOC(dai, LineageHop, emitted));
+
+    lineageHopLatency.def(py::init<>())
+        .def_readwrite("nodeId", &LineageHopLatency::nodeId)
+        .def_readwrite("name", &LineageHopLatency::name)
+        .def_readwrite("transport", &LineageHopLatency::transport, DOC(dai, LineageHopLatency, transport))
+        .def_readwrite("queueing", &LineageHopLatency::queueing, DOC(dai, LineageHopLatency, queueing))
+        .def_readwrite("processing", &LineageHopLatency::processing, DOC(dai, LineageHopLatency, processing));
+
+    messageLineage.def_static("setEnabled", &MessageLineage::setEnabled, py::arg("enabled"), DOC(dai, MessageLineage, setEnabled))
+        .def_static("isEnabled", &MessageLineage::isEnabled, DOC(dai, MessageLineage, isEnabled))
+        .def("getHops", &MessageLineage::getHops, DOC(dai, MessageLineage, getHops))
+        .def("getLatencyBreakdown", &MessageLineage::getLatencyBreakdown, DOC(dai, MessageLineage, getLatencyBreakdown))
+        .def("toString", &MessageLineage::toString, DOC(dai, MessageLineage, toString))
+        .def("__str__", &MessageLineage::toString);
     // Message
     // adatatype
     // .def("getRaw", &ADatatype::getRaw);
@@ -6,11 +6,16 @@
 // depthai
 #include "depthai/pipeline/datatype/BenchmarkReport.hpp"
 
+// pybind
+#include <pybind11/chrono.h>
+#include <pybind11/stl.h>
+
 void bind_benchmarkreport(pybind11::module& m, void* pCallstack) {
     using namespace dai;
 
     // py::class_<RawBenchmarkReport, RawBuffer, std::shared_ptr<RawBenchmarkReport>> rawBenchmarkReport(m, "RawBenchmarkReport", DOC(dai, RawBenchmarkReport));
     py::class_<BenchmarkReport, Py<BenchmarkReport>, Buffer, std::shared_ptr<BenchmarkReport>> benchmarkReport(m, "BenchmarkReport", DOC(dai, BenchmarkReport));
+    py::class_<LatencyHistogram> latencyHistogram(m, "LatencyHistogram", DOC(dai, LatencyHistogram));
 
     ///////////////////////////////////////////////////////////////////////
     ///////////////////////////////////////////////////////////////////////
@@ -25,6 +30,21 @@ void bind_benchmarkreport(pybind11::module& m, void* pCallstack) {
     ///////////////////////////////////////////////////////////////////////
     ///////////////////////////////////////////////////////////////////////
 
+    latencyHistogram.def(py::init<>())
+        .def_readwrite("count", &LatencyHistogram::count, DOC(dai, LatencyHistogram, count))
+        .def_readwrite("min", &LatencyHistogram::min, DOC(dai, LatencyHistogram, min))
+        .def_readwrite("max", &LatencyHistogram::max, DOC(dai, LatencyHistogram, max))
+        .def_readwrite("sum", &LatencyHistogram::sum, DOC(dai, LatencyHistogram, sum))
+        .def_readwrite("sumSquares", &LatencyHistogram::sumSquares, DOC(dai, LatencyHistogram, sumSquares))
+        .def_readwrite("bucketIndices", &LatencyHistogram::bucketIndices, DOC(dai, LatencyHistogram, bucketIndices))
+        .def_readwrite("bucketCounts", &LatencyHistogram::bucketCounts, DOC(dai, LatencyHistogram, bucketCounts))
+        .def("record", &LatencyHistogram::record, py::arg("value"), DOC(dai, LatencyHistogram, record))
+        .def("merge", &LatencyHistogram::merge, py::arg("other"), DOC(dai, LatencyHistogram, merge))
+        .def("reset", &LatencyHistogram::reset, DOC(dai, LatencyHistogram, reset))
+        .def("getPercentile", &LatencyHistogram::getPercentile, py::arg("percentile"), DOC(dai, LatencyHistogram, getPercentile))
+        .def("getMean", &LatencyHistogram::getMean, DOC(dai, LatencyHistogram, getMean))
+        .def("getStdDev", &LatencyHistogram::getStdDev, DOC(dai, LatencyHistogram, getStdDev));
+
     // Message
     benchmarkReport.def(py::init<>())
         .def("__repr__", &BenchmarkReport::str)
@@ -32,5 +52,8 @@ void bind_benchmarkreport(pybind11::module& m, void* pCallstack) {
         .def_property_readonly("timeTotal", [](BenchmarkReport& i) { return &i.timeTotal; })
         .def_property_readonly("numMessagesReceived", [](BenchmarkReport& i) { return &i.numMessagesReceived; })
         .def_property_readonly("latencies", [](BenchmarkReport& i) { return &i.latencies; })
-        .def_property_readonly("averageLatency", [](BenchmarkReport& i) { return &i.averageLatency; });
+        .def_property_readonly("averageLatency", [](BenchmarkReport& i) { return &i.averageLatency; })
+        .def_readwrite("latencyHistogram", &BenchmarkReport::latencyHistogram)
+        .def_readwrite("interArrivalHistogram", &BenchmarkReport::interArrivalHistogram)
+        .def_readwrite("jitter", &BenchmarkReport::jitter);
 }
@@ -17,7 +17,7 @@ void bind_buffer(pybind11::module& m, void* pCallstack) {
     using namespace dai;
 
     // py::class_<RawBuffer, std::shared_ptr<RawBuffer>> rawBuffer(m, "RawBuffer", DOC(dai, RawBuffer));
-    py::class_<Buffer, Py<Buffer>, ADatatype, std::shared_ptr<Buffer>> buffer(m, "Buffer", DOC(dai, Buffer));
+    py::class_<Buffer, Py<Buffer>, ADatatype, std::shared_ptr<Buffer>> buffer(m, "Buffer", DOC(dai, Buffer), py::buffer_protocol());
 
     ///////////////////////////////////////////////////////////////////////
     ///////////////////////////////////////////////////////////////////////
@@ -78,6 +78,11 @@ void bind_buffer(pybind11::module& m, void* pCallstack) {
                 return py::array_t<uint8_t>(a.getData().size(), a.getData().data(), obj);
             },
             DOC(dai, Buffer, getData))
+        // Exposes the message payload through the buffer protocol (eg. memoryview(msg)) without copying
+        .def_buffer([](Buffer& buffer) -> py::buffer_info {
+            auto data = buffer.getData();
+            return py::buffer_info(data.data(), static_cast<ssize_t>(data.size()));
+        })
         .def("setData", py::overload_cast<const std::vector<std::uint8_t>&>(&Buffer::setData), DOC(dai, Buffer, setData))
         .def(
             "setData",
@@ -0,0 +1,98 @@
+#include <memory>
+
+#include "DatatypeBindings.hpp"
+#include "pipeline/CommonBindings.hpp"
+
+// depthai
+#include "depthai/pipeline/datatype/IMUBatch.hpp"
+
+// pybind
+#include <pybind11/chrono.h>
+#include <pybind11/numpy.h>
+
+void bind_imubatch(pybind11::module& m, void* pCallstack) {
+    using namespace dai;
+
+    py::class_<IMUBatch, Py<IMUBatch>, Buffer, std::shared_ptr<IMUBatch>> imuBatch(m, "IMUBatch", DOC(dai, IMUBatch));
+    py::enum_<IMUBatch::Report> imuBatchReport(imuBatch, "Report", DOC(dai, IMUBatch, Report));
+
+    ///////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////
+    // Call the rest of the type defines, then perform the actual bindings
+    Callstack* callstack = (Callstack*)pCallstack;
+    auto cb = callstack->top();
+    callstack->pop();
+    cb(m, pCallstack);
+    // Actual bindings
+    ///////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////
+
+    imuBatchReport.value("ACCELEROMETER", IMUBatch::Report::ACCELEROMETER)
+        .value("GYROSCOPE", IMUBatch::Report::GYROSCOPE)
+        .value("MAGNETIC_FIELD", IMUBatch::Report::MAGNETIC_FIELD)
+        .value("ROTATION_VECTOR", IMUBatch::Report::ROTATION_VECTOR);
+
+    // Message
+    imuBatch.def(py::init<>())
+        .def(py::init<const IMUData&>(), py::arg("imuData"), DOC(dai, IMUBatch, IMUBatch))
+        .def("__repr__", &IMUBatch::str)
+        .def_readonly_static("NO_TIMESTAMP", &IMUBatch::NO_TIMESTAMP, DOC(dai, IMUBatch, NO_TIMESTAMP))
+        .def("setPackets",
+             [](IMUBatch& batch, const std::vector<IMUPacket>& packets) { batch.setPackets(packets); },
+             py::arg("packets"),
+             DOC(dai, IMUBatch, setPackets))
+        .def("getPackets", &IMUBatch::getPackets, DOC(dai, IMUBatch, getPackets))
+        .def("toIMUData", &IMUBatch::toIMUData, DOC(dai, IMUBatch, toIMUData))
+        .def("getNumPackets", &IMUBatch::getNumPackets, DOC(dai, IMUBatch, getNumPackets))
+        .def("hasReport", &IMUBatch::hasReport, py::arg("report"), DOC(dai, IMUBatch, hasReport))
+        .def_static("getNumComponents", &IMUBatch::getNumComponents, py::arg("report"), DOC(dai, IMUBatch, getNumComponents))
+        .def("getBaseTimestamp", &IMUBatch::getBaseTimestamp, DOC(dai, IMUBatch, getBaseTimestamp))
+        .def("getBaseTimestampDevice", &IMUBatch::getBaseTimestampDevice, DOC(dai, IMUBatch, getBaseTimestampDevice))
+        // obj is "Python" object, which we used then to bind the numpy arrays lifespan to
+        .def(
+            "getTimestampOffsets",
+            [](py::object& obj, IMUBatch::Report report) {
+                // creates numpy array (zero-copy) over the column
+                const auto column = obj.cast<const IMUBatch&>().getTimestampOffsets(report);
+                return py::array_t<std::uint32_t>(column.size(), column.data(), obj);
+            },
+            py::arg("report"),
+            DOC(dai, IMUBatch, getTimestampOffsets))
+        .def(
+            "getTimestampDeviceOffsets",
+            [](py::object& obj, IMUBatch::Report report) {
+                const auto column = obj.cast<const IMUBatch&>().getTimestampDeviceOffsets(report);
+                return py::array_t<std::uint32_t>(column.size(), column.data(), obj);
+            },
+            py::arg("report"),
+            DOC(dai, IMUBatch, getTimestampDeviceOffsets))
+        .def(
+            "getSequenceNums",
+            [](py::object& obj, IMUBatch::Report report) {
+                const auto column = obj.cast<const IMUBatch&>().getSequenceNums(report);
+                return py::array_t<std::int32_t>(column.size(), column.data(), obj);
+            },
+            py::arg("report"),
+            DOC(dai, IMUBatch, getSequenceNums))
+        .def(
+            "getValues",
+            [](py::object& obj, IMUBatch::Report report) {
+                // one row of components per packet
+                const auto column = obj.cast<const IMUBatch&>().getValues(report);
+                const auto numComponents = static_cast<ssize_t>(IMUBatch::getNumComponents(report));
+                const auto numPackets = static_cast<ssize_t>(column.size()) / numComponents;
+                return py::array_t<float>({numPackets, numComponents}, {numComponents * ssize_t(sizeof(float)), ssize_t(sizeof(float))}, column.data(), obj);
+            },
+            py::arg("report"),
+            DOC(dai, IMUBatch, getValues))
+        .def(
+            "getAccuracies",
+            [](py::object& obj, IMUBatch::Report report) {
+                const auto column = obj.cast<const IMUBatch&>().getAccuracies(report);
+                return py::array_t<std::uint8_t>(column.size(), reinterpret_cast<const std::uint8_t*>(column.data()), obj);
+            },
+            py::arg("report"),
+            DOC(dai, IMUBatch, getAccuracies));
+}
@@ -3,6 +3,7 @@
 
 #include "DatatypeBindings.hpp"
 #include "pipeline/CommonBindings.hpp"
+#include "utility/ArrayViewBindings.hpp"
 
 // depthai
 #include "depthai/pipeline/datatype/ImgDetections.hpp"
@@ -19,6 +20,7 @@ void bind_imgdetections(pybind11::module& m, void* pCallstack) {
     // py::class_<RawImgDetections, RawBuffer, std::shared_ptr<RawImgDetections>> rawImgDetections(m, "RawImgDetections", DOC(dai, RawImgDetections));
     py::class_<ImgDetections, Py<ImgDetections>, Buffer, std::shared_ptr<ImgDetections>> imgDetections(m, "ImgDetections", DOC(dai, ImgDetections));
     py::class_<ImgDetection> imgDetection(m, "ImgDetection", DOC(dai, ImgDetection));
+    py::class_<ImgDetectionArrays> imgDetectionArrays(m, "ImgDetectionArrays", DOC(dai, ImgDetectionArrays));
 
     ///////////////////////////////////////////////////////////////////////
     ///////////////////////////////////////////////////////////////////////
@@ -43,6 +45,35 @@ void bind_imgdetections(pybind11::module& m, void* pCallstack) {
         .def_readwrite("xmax", &ImgDetection::xmax)
         .def_readwrite("ymax", &ImgDetection::ymax);
 
+    // Arrays are exposed as numpy arrays over the stored values, kept alive by the ImgDetectionArrays object
+    imgDetectionArrays.def(py::init<>())
+        .def(py::init([](const std::vector<ImgDetection>& detections) { return ImgDetectionArrays(detections); }), py::arg("detections"))
+        .def_property(
+            "boxes",
+            [](py::object& obj) { return python::arrayView<float>(obj, obj.cast<ImgDetectionArrays&>().boxes, 4); },
+            [](ImgDetectionArrays& arrays, py::array_t<float, py::array::c_style | py::array::forcecast> boxes) {
+                python::assignArray(arrays.boxes, boxes, "boxes", 4);
+            },
+            DOC(dai, ImgDetectionArrays, boxes))
+        .def_property(
+            "confidences",
+            [](py::object& obj) { return python::arrayView<float>(obj, obj.cast<ImgDetectionArrays&>().confidences); },
+            [](ImgDetectionArrays& arrays, py::array_t<float, py::array::c_style | py::array::forcecast> confidences) {
+                python::assignArray(arrays.confidences, confidences, "confidences");
+            })
+        .def_property(
+            "labels",
+            [](py::object& obj) { return python::arrayView<std::uint32_t>(obj, obj.cast<ImgDetectionArrays&>().labels); },
+            [](ImgDetectionArrays& arrays, py::array_t<std::uint32_t, py::array::c_style | py::array::forcecast> labels) {
+                python::assignArray(arrays.labels, labels, "labels");
+            })
+        .def_readwrite("labelNames", &ImgDetectionArrays::labelNames, DOC(dai, ImgDetectionArrays, labelNames))
+        .def("__len__", &ImgDetectionArrays::size)
+        .def("size", &ImgDetectionArrays::size, DOC(dai, ImgDetectionArrays, size))
+        .def("add", &ImgDetectionArrays::add, py::arg("detection"), DOC(dai, ImgDetectionArrays, add))
+        .def("get", &ImgDetectionArrays::get, py::arg("index"), DOC(dai, ImgDetectionArrays, get))
+        .def("toDetections", &ImgDetectionArrays::toDetections, DOC(dai, ImgDetectionArrays, toDetections));
+
     // rawImgDetections
     //     .def(py::init<>())
     //     .def_readwrite("detections", &RawImgDetections::detections)
@@ -82,6 +113,8 @@ void bind_imgdetections(pybind11::module& m, void* pCallstack) {
         .def("getSequenceNum", &ImgDetections::Buffer::getSequenceNum, DOC(dai, Buffer, getSequenceNum))
         .def("getTransformation", [](ImgDetections& msg) { return msg.transformation; })
         .def("setTransformation", [](ImgDetections& msg, const std::optional<ImgTransformation>& transformation) { msg.transformation = transformation; })
+        .def("getArrays", &ImgDetections::getArrays, DOC(dai, ImgDetections, getArrays))
+        .def("setArrays", &ImgDetections::setArrays, py::arg("arrays"), DOC(dai, ImgDetections, setArrays))
         // .def("setTimestamp", &ImgDetections::setTimestamp, DOC(dai, Buffer, setTimestamp))
         // .def("setTimestampDevice", &ImgDetections::setTimestampDevice, DOC(dai, Buffer, setTimestampDevice))
         // .def("setSequenceNum", &ImgDetections::setSequenceNum, DOC(dai, ImgDetections, setSequenceNum))
@@ -175,6 +175,25 @@ void bind_imgframe(pybind11::module& m, void* pCallstack) {
         .def("remapPointFrom", &ImgTransformation::remapPointFrom, py::arg("to"), py::arg("point"), DOC(dai, ImgTransformation, remapPointFrom))
         .def("remapRectTo", &ImgTransformation::remapRectTo, py::arg("to"), py::arg("rect"), DOC(dai, ImgTransformation, remapRectTo))
         .def("remapRectFrom", &ImgTransformation::remapRectFrom, py::arg("to"), py::arg("rect"), DOC(dai, ImgTransformation, remapRectFrom))
+        .def("getRemapMatrixTo", &ImgTransformation::getRemapMatrixTo, py::arg("to"), DOC(dai, ImgTransformation, getRemapMatrixTo))
+        .def(
+            "remapPointsTo",
+            [](const ImgTransformation& self, const ImgTransformation& to, std::vector<Point2f> points) {
+                self.remapPointsTo(to, points);
+                return points;
+            },
+            py::arg("to"),
+            py::arg("points"),
+            DOC(dai, ImgTransformation, remapPointsTo))
+        .def(
+            "remapRectsTo",
+            [](const ImgTransformation& self, const ImgTransformation& to, std::vector<RotatedRect> rects) {
+                self.remapRectsTo(to, rects);
+                return rects;
+            },
+            py::arg("to"),
+            py::arg("rects"),
+            DOC(dai, ImgTransformation, remapRectsTo))
         .def("isValid", &ImgTransformation::isValid, DOC(dai, ImgTransformation, isValid));
 
     // TODO add RawImgFrame::CameraSettings
@@ -213,6 +232,48 @@ void bind_imgframe(pybind11::module& m, void* pCallstack) {
         .def("getSourceHeight", &ImgFrame::getSourceHeight, DOC(dai, ImgFrame, getSourceHeight))
         .def("getTransformation", [](ImgFrame& msg) { return msg.transformation; })
         .def("validateTransformations", &ImgFrame::validateTransformations, DOC(dai, ImgFrame, validateTransformations))
+        // obj is "Python" object, which we used then to bind the numpy arrays lifespan to
+        .def(
+            "getFrameView",
+            [](py::object& obj) {
+                // creates numpy array (zero-copy) over the frame data, shaped according to the frame type
+                dai::ImgFrame& frame = obj.cast<dai::ImgFrame&>();
+                auto data = frame.getData();
+                const ssize_t width = frame.getWidth();
+                const ssize_t height = frame.getHeight();
+                const ssize_t stride = frame.getStride();
+                const size_t minSize = frame.fb.p1Offset + static_cast<size_t>(stride * height);
+                uint8_t* base = data.data() + frame.fb.p1Offset;
+                if(data.size() >= minSize) {
+                    switch(frame.getType()) {
+                        case ImgFrame::Type::GRAY8:
+                        case ImgFrame::Type::RAW8:
+                            return py::array(py::dtype::of<uint8_t>(), {height, width}, {stride, ssize_t(1)}, base, obj);
+                        case ImgFrame::Type::RAW16:
+                            return py::array(py::dtype::of<uint16_t>(), {height, width}, {stride, ssize_t(sizeof(uint16_t))}, base, obj);
+                        case ImgFrame::Type::GRAYF16:
+                            return py::array(py::dtype("float16"), {height, width}, {stride, ssize_t(sizeof(uint16_t))}, base, obj);
+                        case ImgFrame::Type::BGR888i:
+                        case ImgFrame::Type::RGB888i:
+                            return py::array(py::dtype::of<uint8_t>(), {height, width, ssize_t(3)}, {stride, ssize_t(3), ssize_t(1)}, base, obj);
+                        case ImgFrame::Type::BGR888p:
+                        case ImgFrame::Type::RGB888p: {
+                            const ssize_t planeStride = frame.getPlaneStride();
+                            if(data.size() >= minSize + static_cast<size_t>(2 * planeStride)) {
+                                return py::array(py::dtype::of<uint8_t>(), {ssize_t(3), height, width}, {planeStride, stride, ssize_t(1)}, base, obj);
+                            }
+                            break;
+                        }
+                        default:
+                            break;
+                    }
+                }
+                // Other (e.g. multi-planar YUV) types are exposed as raw bytes
+                return py::array(py::dtype::of<uint8_t>(), {ssize_t(data.size())}, {ssize_t(1)}, data.data(), obj);
+            },
+            "Returns a numpy view (zero-copy) over the frame data, valid for the lifetime of the message. "
+            "GRAY8, RAW8, RAW16 and GRAYF16 frames are shaped (height, width), interleaved frames (height, width, 3) and planar frames (3, height, width). "
+            "Other types are returned as a flat array of bytes.")
 
 #ifdef DEPTHAI_HAVE_OPENCV_SUPPORT
         // The cast function itself does a copy, so we can avoid two copies by always not copying
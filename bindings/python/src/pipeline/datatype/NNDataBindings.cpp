@@ -326,6 +326,67 @@ void bind_nndata(pybind11::module& m, void* pCallstack) {
         // DOC(dai, NNData, getTensor, 3))
         .def("getTensorDatatype", &NNData::getTensorDatatype, py::arg("name"), DOC(dai, NNData, getTensorDatatype))
         .def("getTensorInfo", &NNData::getTensorInfo, py::arg("name"), DOC(dai, NNData, getTensorInfo))
+        // obj is "Python" object, which we used then to bind the numpy arrays lifespan to
+        .def(
+            "getTensorView",
+            [](py::object& obj, const std::string& name) {
+                // creates numpy array (zero-copy) over the raw tensor data, without dequantization
+                dai::NNData& nnData = obj.cast<dai::NNData&>();
+                auto info = nnData.getTensorInfo(name);
+                if(!info) throw std::runtime_error("Tensor does not exist");
+                py::dtype dtype;
+                switch(info->dataType) {
+                    case TensorInfo::DataType::FP16:
+                        dtype = py::dtype("float16");
+                        break;
+                    case TensorInfo::DataType::U8F:
+                        dtype = py::dtype::of<uint8_t>();
+                        break;
+                    case TensorInfo::DataType::INT:
+                        dtype = py::dtype::of<int32_t>();
+                        break;
+                    case TensorInfo::DataType::FP32:
+                        dtype = py::dtype::of<float>();
+                        break;
+                    case TensorInfo::DataType::I8:
+                        dtype = py::dtype::of<int8_t>();
+                        break;
+                    case TensorInfo::DataType::FP64:
+                        dtype = py::dtype::of<double>();
+                        break;
+                    default:
+                        throw std::runtime_error("Unsupported tensor data type");
+                }
+                std::vector<ssize_t> shape(info->dims.begin(), info->dims.end());
+                // Use strides from TensorInfo if they describe the layout, otherwise assume a contiguous row major tensor (as getTensor does)
+                bool validStrides = info->strides.size() == info->dims.size();
+                for(size_t i = 0; validStrides && i < info->dims.size(); i++) {
+                    validStrides = info->dims[i] == 1 || info->strides[i] != 0;
+                }
+                std::vector<ssize_t> strides(shape.size());
+                ssize_t extent = dtype.itemsize();
+                if(validStrides) {
+                    for(size_t i = 0; i < shape.size(); i++) {
+                        strides[i] = info->strides[i];
+                        if(shape[i] > 0) extent += (shape[i] - 1) * strides[i];
+                    }
+                } else {
+                    ssize_t stride = dtype.itemsize();
+                    for(size_t i = shape.size(); i-- > 0;) {
+                        strides[i] = stride;
+                        stride *= shape[i];
+                    }
+                    extent = stride;
+                }
+                auto data = nnData.getData();
+                if(info->offset + static_cast<size_t>(extent) > data.size()) {
+                    throw std::runtime_error("Tensor '" + name + "' exceeds NNData buffer");
+                }
+                return py::array(dtype, shape, strides, data.data() + info->offset, obj);
+            },
+            py::arg("name"),
+            "Returns a numpy view (zero-copy) over the raw data of the tensor with the given name, valid for the lifetime of the message. "
+            "Unlike getTensor, the data is neither converted nor dequantized.")
         .def("getTransformation", [](NNData& msg) { return msg.transformation; })
         .def("setTransformation", [](NNData& msg, const std::optional<ImgTransformation>& transformation) { msg.transformation = transformation; });
 }
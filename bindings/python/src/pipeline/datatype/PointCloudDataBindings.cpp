@@ -52,31 +52,14 @@ void bind_pointclouddata(pybind11::module& m, void* pCallstack) {
         .def("__repr__", &PointCloudData::str)
         // .def_property("points", [](PointCloudData& data) { return &data.getPoints(); }, [](PointCloudData& data, std::vector<Point3f> points)
         // {data.getPoints() = points;})
+        // obj is "Python" object, which we used then to bind the numpy arrays lifespan to
         .def("getPoints",
              [](py::object& obj) {
+                 // creates numpy array (zero-copy) over the xyz coordinates of the points
                  dai::PointCloudData& data = obj.cast<dai::PointCloudData&>();
-                 if(data.isColor()) {
-                     Point3fRGBA* points = (Point3fRGBA*)data.getData().data();
-                     unsigned long size = data.getData().size() / sizeof(Point3fRGBA);
-                     py::array_t<float> arr({size, 3UL});
-                     auto ra = arr.mutable_unchecked();
-                     for(int i = 0; i < size; i++) {
-                         ra(i, 0) = points[i].x;
-                         ra(i, 1) = points[i].y;
-                         ra(i, 2) = points[i].z;
-                     }
-                     return arr;
-                 }
-                 Point3f* points = (Point3f*)data.getData().data();
-                 unsigned long size = data.getData().size() / sizeof(Point3f);
-                 py::array_t<float> arr({size, 3UL});
-                 auto ra = arr.mutable_unchecked();
-                 for(int i = 0; i < size; i++) {
-                     ra(i, 0) = points[i].x;
-                     ra(i, 1) = points[i].y;
-                     ra(i, 2) = points[i].z;
-                 }
-                 return arr;
+                 const ssize_t pointSize = data.isColor() ? sizeof(Point3fRGBA) : sizeof(Point3f);
+                 const ssize_t size = data.getData().size() / pointSize;
+                 return py::array_t<float>({size, ssize_t(3)}, {pointSize, ssize_t(sizeof(float))}, reinterpret_cast<float*>(data.getData().data()), obj);
              })
         .def("getPointsRGB",
              [](py::object& obj) {
@@ -85,22 +68,10 @@ void bind_pointclouddata(pybind11::module& m, void* pCallstack) {
                      throw std::runtime_error("PointCloudData does not contain color data");
                  }
                  Point3fRGBA* points = (Point3fRGBA*)data.getData().data();
-                 unsigned long size = data.getData().size() / sizeof(Point3fRGBA);
-                 py::array_t<float> arr({size, 3UL});
-                 auto ra = arr.mutable_unchecked();
-                 for(int i = 0; i < size; i++) {
-                     ra(i, 0) = points[i].x;
-                     ra(i, 1) = points[i].y;
-                     ra(i, 2) = points[i].z;
-                 }
-                 py::array_t<uint8_t> arr2({size, 4UL});
-                 auto ra2 = arr2.mutable_unchecked();
-                 for(int i = 0; i < size; i++) {
-                     ra2(i, 0) = points[i].r;
-                     ra2(i, 1) = points[i].g;
-                     ra2(i, 2) = points[i].b;
-                     ra2(i, 3) = points[i].a;
-                 }
+                 const ssize_t pointSize = sizeof(Point3fRGBA);
+                 const ssize_t size = data.getData().size() / pointSize;
+                 py::array_t<float> arr({size, ssize_t(3)}, {pointSize, ssize_t(sizeof(float))}, &points->x, obj);
+                 py::array_t<uint8_t> arr2({size, ssize_t(4)}, {pointSize, ssize_t(1)}, &points->r, obj);
                  return py::make_tuple(arr, arr2);
              })
         .def("getWidth", &PointCloudData::getWidth, DOC(dai, PointCloudData, getWidth))
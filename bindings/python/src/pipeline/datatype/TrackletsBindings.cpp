@@ -3,6 +3,7 @@
 
 #include "DatatypeBindings.hpp"
 #include "pipeline/CommonBindings.hpp"
+#include "utility/ArrayViewBindings.hpp"
 
 // depthai
 #include "depthai/pipeline/datatype/Tracklets.hpp"
@@ -19,6 +20,7 @@ void bind_tracklets(pybind11::module& m, void* pCallstack) {
     // py::class_<RawTracklets, RawBuffer, std::shared_ptr<RawTracklets>> rawTacklets(m, "RawTracklets", DOC(dai, RawTracklets));
     py::class_<Tracklet> tracklet(m, "Tracklet", DOC(dai, Tracklet));
     py::enum_<Tracklet::TrackingStatus> trackletTrackingStatus(tracklet, "TrackingStatus", DOC(dai, Tracklet, TrackingStatus));
+    py::class_<TrackletArrays> trackletArrays(m, "TrackletArrays", DOC(dai, TrackletArrays));
     py::class_<Tracklets, Py<Tracklets>, Buffer, std::shared_ptr<Tracklets>> tracklets(m, "Tracklets", DOC(dai, Tracklets));
 
     ///////////////////////////////////////////////////////////////////////
@@ -49,6 +51,63 @@ void bind_tracklets(pybind11::module& m, void* pCallstack) {
         .value("LOST", Tracklet::TrackingStatus::LOST)
         .value("REMOVED", Tracklet::TrackingStatus::REMOVED);
 
+    // Statuses are exposed as their int32 values
+    trackletArrays.def(py::init<>())
+        .def(py::init([](const std::vector<Tracklet>& tracklets) { return TrackletArrays(tracklets); }), py::arg("tracklets"))
+        .def_readonly_static("ROI_NORMALIZED", &TrackletArrays::ROI_NORMALIZED)
+        .def_readonly_static("ROI_HAS_NORMALIZED", &TrackletArrays::ROI_HAS_NORMALIZED)
+        .def_property(
+            "rois",
+            [](py::object& obj) { return python::arrayView<float>(obj, obj.cast<TrackletArrays&>().rois, 4); },
+            [](TrackletArrays& arrays, py::array_t<float, py::array::c_style | py::array::forcecast> rois) {
+                python::assignArray(arrays.rois, rois, "rois", 4);
+            },
+            DOC(dai, TrackletArrays, rois))
+        .def_property(
+            "roiFlags",
+            [](py::object& obj) { return python::arrayView<std::uint8_t>(obj, obj.cast<TrackletArrays&>().roiFlags); },
+            [](TrackletArrays& arrays, py::array_t<std::uint8_t, py::array::c_style | py::array::forcecast> roiFlags) {
+                python::assignArray(arrays.roiFlags, roiFlags, "roiFlags");
+            },
+            DOC(dai, TrackletArrays, roiFlags))
+        .def_property(
+            "ids",
+            [](py::object& obj) { return python::arrayView<std::int32_t>(obj, obj.cast<TrackletArrays&>().ids); },
+            [](TrackletArrays& arrays, py::array_t<std::int32_t, py::array::c_style | py::array::forcecast> ids) {
+                python::assignArray(arrays.ids, ids, "ids");
+            })
+        .def_property(
+            "labels",
+            [](py::object& obj) { return python::arrayView<std::int32_t>(obj, obj.cast<TrackletArrays&>().labels); },
+            [](TrackletArrays& arrays, py::array_t<std::int32_t, py::array::c_style | py::array::forcecast> labels) {
+                python::assignArray(arrays.labels, labels, "labels");
+            })
+        .def_property(
+            "ages",
+            [](py::object& obj) { return python::arrayView<std::int32_t>(obj, obj.cast<TrackletArrays&>().ages); },
+            [](TrackletArrays& arrays, py::array_t<std::int32_t, py::array::c_style | py::array::forcecast> ages) {
+                python::assignArray(arrays.ages, ages, "ages");
+            })
+        .def_property(
+            "statuses",
+            [](py::object& obj) { return python::arrayView<std::int32_t>(obj, obj.cast<TrackletArrays&>().statuses); },
+            [](TrackletArrays& arrays, py::array_t<std::int32_t, py::array::c_style | py::array::forcecast> statuses) {
+                python::assignArray(arrays.statuses, statuses, "statuses");
+            })
+        .def_property(
+            "spatialCoordinates",
+            [](py::object& obj) { return python::arrayView<float>(obj, obj.cast<TrackletArrays&>().spatialCoordinates, 3); },
+            [](TrackletArrays& arrays, py::array_t<float, py::array::c_style | py::array::forcecast> spatialCoordinates) {
+                python::assignArray(arrays.spatialCoordinates, spatialCoordinates, "spatialCoordinates", 3);
+            },
+            DOC(dai, TrackletArrays, spatialCoordinates))
+        .def_readwrite("srcImgDetections", &TrackletArrays::srcImgDetections)
+        .def("__len__", &TrackletArrays::size)
+        .def("size", &TrackletArrays::size, DOC(dai, TrackletArrays, size))
+        .def("add", &TrackletArrays::add, py::arg("tracklet"), DOC(dai, TrackletArrays, add))
+        .def("get", &TrackletArrays::get, py::arg("index"), DOC(dai, TrackletArrays, get))
+        .def("toTracklets", &TrackletArrays::toTracklets, DOC(dai, TrackletArrays, toTracklets));
+
     // rawTacklets
     //     .def(py::init<>())
     //     .def_readwrite("tracklets", &RawTracklets::tracklets)
@@ -67,6 +126,8 @@ void bind_tracklets(pybind11::module& m, void* pCallstack) {
         .def("getSequenceNum", &Tracklets::Buffer::getSequenceNum, DOC(dai, Buffer, getSequenceNum))
         .def("getTransformation", [](Tracklets& msg) { return msg.transformation; })
         .def("setTransformation", [](Tracklets& msg, const ImgTransformation& transformation) { msg.transformation = transformation; })
+        .def("getArrays", &Tracklets::getArrays, DOC(dai, Tracklets, getArrays))
+        .def("setArrays", &Tracklets::setArrays, py::arg("arrays"), DOC(dai, Tracklets, setArrays))
         // .def("setTimestamp", &Tracklets::setTimestamp, DOC(dai, Tracklets, setTimestamp))
         // .def("setTimestampDevice", &Tracklets::setTimestampDevice, DOC(dai, Tracklets, setTimestampDevice))
         // .def("setSequenceNum", &Tracklets::setSequenceNum, DOC(dai, Tracklets, setSequenceNum))
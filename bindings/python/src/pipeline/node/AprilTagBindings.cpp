@@ -40,6 +40,8 @@ void bind_apriltag(pybind11::module& m, void* pCallstack) {
         .def("runOnHost", &AprilTag::runOnHost, DOC(dai, node, AprilTag, runOnHost))
         .def("setRunOnHost", &AprilTag::setRunOnHost, DOC(dai, node, AprilTag, setRunOnHost))
         .def("setNumThreads", &AprilTag::setNumThreads, py::arg("numThreads"), DOC(dai, node, AprilTag, setNumThreads))
-        .def("getNumThreads", &AprilTag::getNumThreads, DOC(dai, node, AprilTag, getNumThreads));
+        .def("getNumThreads", &AprilTag::getNumThreads, DOC(dai, node, AprilTag, getNumThreads))
+        .def("setRoi", &AprilTag::setRoi, py::arg("roi"), DOC(dai, node, AprilTag, setRoi))
+        .def("getRoi", &AprilTag::getRoi, DOC(dai, node, AprilTag, getRoi));
     daiNodeModule.attr("AprilTag").attr("Properties") = aprilTagProperties;
 }
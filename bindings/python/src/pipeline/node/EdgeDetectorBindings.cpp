@@ -36,6 +36,7 @@ void bind_edgedetector(pybind11::module& m, void* pCallstack) {
         .def_readonly("inputImage", &EdgeDetector::inputImage, DOC(dai, node, EdgeDetector, inputImage))
         .def_readonly("outputImage", &EdgeDetector::outputImage, DOC(dai, node, EdgeDetector, outputImage))
         .def("setNumFramesPool", &EdgeDetector::setNumFramesPool, DOC(dai, node, EdgeDetector, setNumFramesPool))
-        .def("setMaxOutputFrameSize", &EdgeDetector::setMaxOutputFrameSize, DOC(dai, node, EdgeDetector, setMaxOutputFrameSize));
+        .def("setMaxOutputFrameSize", &EdgeDetector::setMaxOutputFrameSize, DOC(dai, node, EdgeDetector, setMaxOutputFrameSize))
+        .def("setRunOnHost", &EdgeDetector::setRunOnHost, py::arg("runOnHost"), DOC(dai, node, EdgeDetector, setRunOnHost));
     daiNodeModule.attr("EdgeDetector").attr("Properties") = edgeDetectorProperties;
 }
@@ -40,6 +40,7 @@ void bind_featuretracker(pybind11::module& m, void* pCallstack) {
              &FeatureTracker::setHardwareResources,
              py::arg("numShaves"),
              py::arg("numMemorySlices"),
-             DOC(dai, node, FeatureTracker, setHardwareResources));
+             DOC(dai, node, FeatureTracker, setHardwareResources))
+        .def("setRunOnHost", &FeatureTracker::setRunOnHost, py::arg("runOnHost"), DOC(dai, node, FeatureTracker, setRunOnHost));
     daiNodeModule.attr("FeatureTracker").attr("Properties") = featureTrackerProperties;
 }
@@ -0,0 +1,62 @@
+#include "Common.hpp"
+#include "NodeBindings.hpp"
+#include "depthai/pipeline/ThreadedHostNode.hpp"
+#include "depthai/pipeline/node/host/HostSpatialDetections.hpp"
+
+void bind_hostspatialdetections(pybind11::module& m, void* pCallstack) {
+    using namespace dai;
+    using namespace dai::node;
+
+    // declare upfront
+    auto hostSpatialDetections = ADD_NODE_DERIVED(HostSpatialDetections, ThreadedHostNode);
+
+    ///////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////
+    // Call the rest of the type defines, then perform the actual bindings
+    Callstack* callstack = (Callstack*)pCallstack;
+    auto cb = callstack->top();
+    callstack->pop();
+    cb(m, pCallstack);
+    // Actual bindings
+    ///////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////
+
+    // HostSpatialDetections Node
+    hostSpatialDetections
+        .def_property_readonly(
+            "inputDetections", [](HostSpatialDetections& node) { return &node.inputDetections; }, py::return_value_policy::reference_internal)
+        .def_property_readonly(
+            "inputDepth", [](HostSpatialDetections& node) { return &node.inputDepth; }, py::return_value_policy::reference_internal)
+        .def_readonly("out", &HostSpatialDetections::out, DOC(dai, node, HostSpatialDetections, out))
+        .def("setBoundingBoxScaleFactor",
+             &HostSpatialDetections::setBoundingBoxScaleFactor,
+             py::arg("scaleFactor"),
+             DOC(dai, node, HostSpatialDetections, setBoundingBoxScaleFactor))
+        .def("setDepthLowerThreshold",
+             &HostSpatialDetections::setDepthLowerThreshold,
+             py::arg("lowerThreshold"),
+             DOC(dai, node, HostSpatialDetections, setDepthLowerThreshold))
+        .def("setDepthUpperThreshold",
+             &HostSpatialDetections::setDepthUpperThreshold,
+             py::arg("upperThreshold"),
+             DOC(dai, node, HostSpatialDetections, setDepthUpperThreshold))
+        .def("setSpatialCalculationAlgorithm",
+             &HostSpatialDetections::setSpatialCalculationAlgorithm,
+             py::arg("calculationAlgorithm"),
+             DOC(dai, node, HostSpatialDetections, setSpatialCalculationAlgorithm))
+        .def("setSpatialCalculationStepSize",
+             &HostSpatialDetections::setSpatialCalculationStepSize,
+             py::arg("stepSize"),
+             DOC(dai, node, HostSpatialDetections, setSpatialCalculationStepSize))
+        .def("getBoundingBoxScaleFactor", &HostSpatialDetections::getBoundingBoxScaleFactor, DOC(dai, node, HostSpatialDetections, getBoundingBoxScaleFactor))
+        .def("getDepthLowerThreshold", &HostSpatialDetections::getDepthLowerThreshold, DOC(dai, node, HostSpatialDetections, getDepthLowerThreshold))
+        .def("getDepthUpperThreshold", &HostSpatialDetections::getDepthUpperThreshold, DOC(dai, node, HostSpatialDetections, getDepthUpperThreshold))
+        .def("getSpatialCalculationAlgorithm",
+             &HostSpatialDetections::getSpatialCalculationAlgorithm,
+             DOC(dai, node, HostSpatialDetections, getSpatialCalculationAlgorithm))
+        .def("getSpatialCalculationStepSize",
+             &HostSpatialDetections::getSpatialCalculationStepSize,
+             DOC(dai, node, HostSpatialDetections, getSpatialCalculationStepSize));
+}
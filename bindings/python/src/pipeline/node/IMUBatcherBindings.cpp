@@ -0,0 +1,33 @@
+#include "Common.hpp"
+#include "NodeBindings.hpp"
+#include "depthai/pipeline/ThreadedHostNode.hpp"
+#include "depthai/pipeline/node/host/IMUBatcher.hpp"
+
+void bind_imubatcher(pybind11::module& m, void* pCallstack) {
+    using namespace dai;
+    using namespace dai::node;
+
+    // declare upfront
+    auto imuBatcher = ADD_NODE_DERIVED(IMUBatcher, ThreadedHostNode);
+
+    ///////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////
+    // Call the rest of the type defines, then perform the actual bindings
+    Callstack* callstack = (Callstack*)pCallstack;
+    auto cb = callstack->top();
+    callstack->pop();
+    cb(m, pCallstack);
+    // Actual bindings
+    ///////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////
+
+    // IMUBatcher Node
+    imuBatcher.def_readonly("input", &IMUBatcher::input, DOC(dai, node, IMUBatcher, input))
+        .def_readonly("out", &IMUBatcher::out, DOC(dai, node, IMUBatcher, out))
+        .def("setBatchSize", &IMUBatcher::setBatchSize, py::arg("batchSize"), DOC(dai, node, IMUBatcher, setBatchSize))
+        .def("setMaxLatency", &IMUBatcher::setMaxLatency, py::arg("maxLatency"), DOC(dai, node, IMUBatcher, setMaxLatency))
+        .def("getBatchSize", &IMUBatcher::getBatchSize, DOC(dai, node, IMUBatcher, getBatchSize))
+        .def("getMaxLatency", &IMUBatcher::getMaxLatency, DOC(dai, node, IMUBatcher, getMaxLatency));
+}
@@ -0,0 +1,36 @@
+#include "Common.hpp"
+#include "NodeBindings.hpp"
+#include "depthai/pipeline/ThreadedHostNode.hpp"
+#include "depthai/pipeline/node/host/Overlay.hpp"
+
+void bind_overlay(pybind11::module& m, void* pCallstack) {
+    using namespace dai;
+    using namespace dai::node;
+
+    // declare upfront
+    auto overlay = ADD_NODE_DERIVED(Overlay, ThreadedHostNode);
+
+    ///////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////
+    // Call the rest of the type defines, then perform the actual bindings
+    Callstack* callstack = (Callstack*)pCallstack;
+    auto cb = callstack->top();
+    callstack->pop();
+    cb(m, pCallstack);
+    // Actual bindings
+    ///////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////
+
+    // Overlay Node
+    overlay.def_readonly("input", &Overlay::input, DOC(dai, node, Overlay, input))
+        .def_readonly("annotations", &Overlay::annotations, DOC(dai, node, Overlay, annotations))
+        .def_readonly("out", &Overlay::out, DOC(dai, node, Overlay, out))
+        .def("setThickness", &Overlay::setThickness, py::arg("thickness"), DOC(dai, node, Overlay, setThickness))
+        .def("setFontSize", &Overlay::setFontSize, py::arg("fontSize"), DOC(dai, node, Overlay, setFontSize))
+        .def("setNumFramesPool", &Overlay::setNumFramesPool, py::arg("numFramesPool"), DOC(dai, node, Overlay, setNumFramesPool))
+        .def("getThickness", &Overlay::getThickness, DOC(dai, node, Overlay, getThickness))
+        .def("getFontSize", &Overlay::getFontSize, DOC(dai, node, Overlay, getFontSize))
+        .def("getNumFramesPool", &Overlay::getNumFramesPool, DOC(dai, node, Overlay, getNumFramesPool));
+}
@@ -39,6 +39,9 @@ void bind_rtabmapslamnode(pybind11::module& m, void* pCallstack) {
         .def_readonly("obstaclePCL", &RTABMapSLAM::obstaclePCL, DOC(dai, node, RTABMapSLAM, obstaclePCL))
         .def_readonly("groundPCL", &RTABMapSLAM::groundPCL, DOC(dai, node, RTABMapSLAM, groundPCL))
         .def_readonly("occupancyGridMap", &RTABMapSLAM::occupancyGridMap, DOC(dai, node, RTABMapSLAM, occupancyGridMap))
+        .def_readonly("obstaclePCLUpdate", &RTABMapSLAM::obstaclePCLUpdate, DOC(dai, node, RTABMapSLAM, obstaclePCLUpdate))
+        .def_readonly("groundPCLUpdate", &RTABMapSLAM::groundPCLUpdate, DOC(dai, node, RTABMapSLAM, groundPCLUpdate))
+        .def_readonly("occupancyGridMapUpdate", &RTABMapSLAM::occupancyGridMapUpdate, DOC(dai, node, RTABMapSLAM, occupancyGridMapUpdate))
         .def_readonly("passthroughRect", &RTABMapSLAM::passthroughRect, DOC(dai, node, RTABMapSLAM, passthroughRect))
         .def_readonly("passthroughDepth", &RTABMapSLAM::passthroughDepth, DOC(dai, node, RTABMapSLAM, passthroughDepth))
         .def_readonly("passthroughFeatures", &RTABMapSLAM::passthroughFeatures, DOC(dai, node, RTABMapSLAM, passthroughFeatures))
@@ -54,6 +57,10 @@ void bind_rtabmapslamnode(pybind11::module& m, void* pCallstack) {
         .def("setPublishObstacleCloud", &RTABMapSLAM::setPublishObstacleCloud, py::arg("publish"), DOC(dai, node, RTABMapSLAM, setPublishObstacleCloud))
         .def("setPublishGroundCloud", &RTABMapSLAM::setPublishGroundCloud, py::arg("publish"), DOC(dai, node, RTABMapSLAM, setPublishGroundCloud))
         .def("setPublishGrid", &RTABMapSLAM::setPublishGrid, py::arg("publish"), DOC(dai, node, RTABMapSLAM, setPublishGrid))
+        .def("setPublishIncremental", &RTABMapSLAM::setPublishIncremental, py::arg("incremental"), DOC(dai, node, RTABMapSLAM, setPublishIncremental))
+        .def("setKeyframeInterval", &RTABMapSLAM::setKeyframeInterval, py::arg("interval"), DOC(dai, node, RTABMapSLAM, setKeyframeInterval))
+        .def("setGridTileSize", &RTABMapSLAM::setGridTileSize, py::arg("size"), DOC(dai, node, RTABMapSLAM, setGridTileSize))
+        .def("setMaxMapPublishRate", &RTABMapSLAM::setMaxMapPublishRate, py::arg("pointsPerSecond"), DOC(dai, node, RTABMapSLAM, setMaxMapPublishRate))
         .def("setFreq", &RTABMapSLAM::setFreq, py::arg("f"), DOC(dai, node, RTABMapSLAM, setFreq))
         .def("setAlphaScaling", &RTABMapSLAM::setAlphaScaling, py::arg("alpha"), DOC(dai, node, RTABMapSLAM, setAlphaScaling))
         .def("setUseFeatures", &RTABMapSLAM::setUseFeatures, py::arg("useFeatures"), DOC(dai, node, RTABMapSLAM, setUseFeatures))
@@ -0,0 +1,33 @@
+#include "Common.hpp"
+#include "NodeBindings.hpp"
+#include "depthai/pipeline/ThreadedHostNode.hpp"
+#include "depthai/pipeline/node/host/VideoDecoder.hpp"
+
+void bind_videodecoder(pybind11::module& m, void* pCallstack) {
+    using namespace dai;
+    using namespace dai::node;
+
+    // declare upfront
+    auto videoDecoder = ADD_NODE_DERIVED(VideoDecoder, ThreadedHostNode);
+
+    ///////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////
+    // Call the rest of the type defines, then perform the actual bindings
+    Callstack* callstack = (Callstack*)pCallstack;
+    auto cb = callstack->top();
+    callstack->pop();
+    cb(m, pCallstack);
+    // Actual bindings
+    ///////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////
+
+    // VideoDecoder Node
+    videoDecoder.def_readonly("input", &VideoDecoder::input, DOC(dai, node, VideoDecoder, input))
+        .def_readonly("out", &VideoDecoder::out, DOC(dai, node, VideoDecoder, out))
+        .def("setOutputType", &VideoDecoder::setOutputType, py::arg("type"), DOC(dai, node, VideoDecoder, setOutputType))
+        .def("setNumFramesPool", &VideoDecoder::setNumFramesPool, py::arg("numFramesPool"), DOC(dai, node, VideoDecoder, setNumFramesPool))
+        .def("getOutputType", &VideoDecoder::getOutputType, DOC(dai, node, VideoDecoder, getOutputType))
+        .def("getNumFramesPool", &VideoDecoder::getNumFramesPool, DOC(dai, node, VideoDecoder, getNumFramesPool));
+}
@@ -49,7 +49,8 @@ void bind_warp(pybind11::module& m, void* pCallstack) {
         .def("setHwIds", &Warp::setHwIds, DOC(dai, node, Warp, setHwIds))
         .def("getHwIds", &Warp::getHwIds, DOC(dai, node, Warp, getHwIds))
         .def("setInterpolation", &Warp::setInterpolation, DOC(dai, node, Warp, setInterpolation))
-        .def("getInterpolation", &Warp::getInterpolation, DOC(dai, node, Warp, getInterpolation));
+        .def("getInterpolation", &Warp::getInterpolation, DOC(dai, node, Warp, getInterpolation))
+        .def("setRunOnHost", &Warp::setRunOnHost, py::arg("runOnHost"), DOC(dai, node, Warp, setRunOnHost));
 
     daiNodeModule.attr("Warp").attr("Properties") = warpProperties;
 }
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+
+#include <string>
+#include <vector>
+
+namespace dai {
+namespace python {
+
+/**
+ * Numpy array over the elements of a vector, without copying them. The array keeps owner alive,
+ * it is invalidated when the vector is resized.
+ * @param columns Number of consecutive elements in each row, 1 for a one dimensional array
+ */
+template <typename T, typename V>
+pybind11::array_t<T> arrayView(pybind11::handle owner, std::vector<V>& values, pybind11::ssize_t columns = 1) {
+    static_assert(sizeof(T) == sizeof(V), "Array elements have to match the vector elements");
+    const auto rows = static_cast<pybind11::ssize_t>(values.size()) / columns;
+    const auto itemSize = static_cast<pybind11::ssize_t>(sizeof(T));
+    auto* data = reinterpret_cast<T*>(values.data());
+    if(columns == 1) return pybind11::array_t<T>({rows}, {itemSize}, data, owner);
+    return pybind11::array_t<T>({rows, columns}, {columns * itemSize, itemSize}, data, owner);
+}
+
+/**
+ * Copy the elements of a numpy array, in row major order, into a vector
+ * @param name Name of the array in errors
+ * @param columns Number of elements in each row, the array has to be of shape (N, columns), or (N,) for 1
+ * @throws ValueError if the array has another shape
+ */
+template <typename V, typename T>
+void assignArray(std::vector<V>& values,
+                 const pybind11::array_t<T, pybind11::array::c_style | pybind11::array::forcecast>& array,
+                 const char* name,
+                 pybind11::ssize_t columns = 1) {
+    static_assert(sizeof(T) == sizeof(V), "Array elements have to match the vector elements");
+    const bool valid = columns == 1 ? array.ndim() == 1 : array.ndim() == 2 && array.shape(1) == columns;
+    if(!valid) {
+        throw pybind11::value_error(std::string(name) + (columns == 1 ? " must have shape (N,)" : " must have shape (N, " + std::to_string(columns) + ")"));
+    }
+    const auto* data = reinterpret_cast<const V*>(array.data());
+    values.assign(data, data + array.size());
+}
+
+}  // namespace python
+}  // namespace dai
@@ -0,0 +1,38 @@
+#include "MetricsRegistryBindings.hpp"
+
+// depthai
+#include "depthai/utility/MetricsRegistry.hpp"
+
+void MetricsRegistryBindings::bind(pybind11::module& m, void* pCallstack) {
+    using namespace dai;
+
+    py::class_<MetricsRegistry, std::unique_ptr<MetricsRegistry, py::nodelete>> metricsRegistry(m, "MetricsRegistry", DOC(dai, MetricsRegistry));
+
+    ///////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////
+    // Call the rest of the type defines, then perform the actual bindings
+    Callstack* callstack = (Callstack*)pCallstack;
+    auto cb = callstack->top();
+    callstack->pop();
+    cb(m, pCallstack);
+    ///////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////
+
+    metricsRegistry
+        .def_static(
+            "getInstance",
+            []() { return std::unique_ptr<MetricsRegistry, py::nodelete>(&MetricsRegistry::getInstance()); },
+            DOC(dai, MetricsRegistry, getInstance))
+        .def_static("setEnabled", &MetricsRegistry::setEnabled, py::arg("enabled"), DOC(dai, MetricsRegistry, setEnabled))
+        .def_static("isEnabled", &MetricsRegistry::isEnabled, DOC(dai, MetricsRegistry, isEnabled))
+        .def("scrape", &MetricsRegistry::scrape, py::call_guard<py::gil_scoped_release>(), DOC(dai, MetricsRegistry, scrape))
+        .def("startServer",
+             &MetricsRegistry::startServer,
+             py::arg("host") = "127.0.0.1",
+             py::arg("port") = MetricsRegistry::DEFAULT_PORT,
+             DOC(dai, MetricsRegistry, startServer))
+        .def("stopServer", &MetricsRegistry::stopServer, py::call_guard<py::gil_scoped_release>(), DOC(dai, MetricsRegistry, stopServer))
+        .def("isServerRunning", &MetricsRegistry::isServerRunning, DOC(dai, MetricsRegistry, isServerRunning));
+}
@@ -45,5 +45,25 @@ def test_dai_image_conversion(size, type):
     mse = np.mean((largeImage.astype("float") - recoveredImage.astype("float")) ** 2)
     assert mse <= tolerance, f"Images differ significantly with MSE: {mse}"
 
+@pytest.mark.parametrize("type", [dai.ImgFrame.Type.BGR888p, dai.ImgFrame.Type.BGR888i, dai.ImgFrame.Type.GRAY8])
+def test_dai_image_view(type):
+    image = generate_test_image()
+    imgDai = dai.ImgFrame()
+    imgDai.setCvFrame(image, type)
+
+    view = imgDai.getFrameView()
+    if type == dai.ImgFrame.Type.BGR888i:
+        assert view.shape == (100, 100, 3)
+        assert (view == image).all()
+    elif type == dai.ImgFrame.Type.BGR888p:
+        assert view.shape == (3, 100, 100)
+        assert (view == image.transpose(2, 0, 1)).all()
+    else:
+        assert view.shape == (100, 100)
+
+    # The view aliases the message data
+    assert np.shares_memory(view, imgDai.getData())
+    assert bytes(memoryview(imgDai)) == imgDai.getData().tobytes()
+
 if __name__ == "__main__":
     test_dai_image_conversion((1000, 1000), dai.ImgFrame.Type.BGR888p)
\ No newline at end of file
@@ -431,3 +431,37 @@ def test_regression_gil_locks():
             time.sleep(0.01)
             queue.removeCallback(id2)
             print(f"[{i}] after removing all callbacks")
+
+
+def test_get_async():
+    import asyncio
+
+    queue = MessageQueue("test", maxSize=10, blocking=True)
+    msg1 = Buffer()
+    msg2 = Buffer()
+
+    async def consume():
+        # Message already in the queue
+        queue.send(msg1)
+        assert await queue.getAsync() == msg1
+
+        # Message sent from another thread while awaiting
+        future = queue.getAsync()
+        threading.Timer(0.1, lambda: queue.send(msg2)).start()
+        assert await asyncio.wait_for(future, timeout=2) == msg2
+
+        # Cancelled waits don't consume messages
+        future = queue.getAsync()
+        future.cancel()
+        await asyncio.sleep(0)
+        queue.send(Buffer())
+        assert queue.getSize() == 1
+
+        # Closing the queue fails pending waits
+        queue.tryGetAll()
+        future = queue.getAsync()
+        queue.close()
+        with pytest.raises(MessageQueue.QueueException):
+            await future
+
+    asyncio.run(consume())
@@ -35,5 +35,26 @@ def test_nndata_tensor():
 
   assert(np.allclose(nndata.getFirstTensor(), tensorA, atol=0.002)) 
 
+def test_nndata_tensor_view():
+  nndata = dai.NNData()
+  tensorA = np.random.rand(3,3,3,3).astype(np.float16)
+  tensorB = np.random.rand(2,5).astype(np.float32)
+  nndata.addTensor("a", tensorA)
+  nndata.addTensor("b", tensorB)
+
+  viewA = nndata.getTensorView("a")
+  viewB = nndata.getTensorView("b")
+  assert(viewA.dtype == np.float16 and viewA.shape == tensorA.shape)
+  assert(viewB.dtype == np.float32 and viewB.shape == tensorB.shape)
+  assert((viewA == tensorA).all())
+  assert((viewB == tensorB).all())
+
+  # Views share memory with the message and keep it alive
+  viewB[0, 0] = 42
+  assert(nndata.getTensor("b")[0, 0] == 42)
+  del nndata
+  assert(viewB[0, 0] == 42)
+
 if __name__ == '__main__':
-  test_nndata_tensor()
\ No newline at end of file
+  test_nndata_tensor()
+  test_nndata_tensor_view()
\ No newline at end of file
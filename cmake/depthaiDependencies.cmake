@@ -52,6 +52,8 @@ if(NOT CONFIG_MODE OR (CONFIG_MODE AND NOT DEPTHAI_SHARED_LIBS))
     find_package(httplib ${_QUIET} CONFIG REQUIRED)
     # ZLIB for compressing Apps
     find_package(ZLIB REQUIRED)
+    # Zstandard for streaming compression
+    find_package(zstd ${_QUIET} CONFIG REQUIRED)
     find_package(Eigen3 ${_QUIET} CONFIG REQUIRED)
 
     # spdlog for library and device logging
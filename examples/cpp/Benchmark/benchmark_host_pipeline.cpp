@@ -0,0 +1,432 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <new>
+#include <nlohmann/json.hpp>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+    #include <malloc.h>
+#endif
+
+#include "depthai/depthai.hpp"
+
+// Device-free benchmark of host side pipeline overhead.
+// A source (BenchmarkOut running on host, or ReplayVideo) feeds `fanout` parallel chains of host nodes, with a BenchmarkIn
+// after each stage. BenchmarkIn measures the latency since the source. The processing and queueing time of each node is taken from
+// the message lineage of the messages leaving each chain.
+//
+// Usage: ./benchmark_host_pipeline [--width 1920] [--height 1080] [--type nv12|bgr|raw16] [--fps 30] [--fanout 1]
+//                                  [--stages manip,sync] [--duration 10] [--output results.json] [--replay video.mp4]
+// Supported stages: manip (resize to half and convert to BGR), filters (ImageFilters, use with raw16), sync (single input Sync),
+// tracker (ObjectTracker with synthetic detections), rgbd (RGBD with synthetic depth, has to be the last stage)
+// With --replay, frames of the video are replayed at the set size and type instead of a synthetic frame.
+
+// Count heap allocations of the whole process, to report allocations per source message
+static std::atomic<std::uint64_t> allocationCount{0};
+
+static void* allocateAligned(std::size_t size, std::size_t alignment) {
+#ifdef _WIN32
+    return _aligned_malloc(size == 0 ? 1 : size, alignment);
+#else
+    // aligned_alloc requires a size which is a multiple of the alignment
+    return std::aligned_alloc(alignment, (std::max<std::size_t>(size, 1) + alignment - 1) / alignment * alignment);
+#endif
+}
+
+static void freeAligned(void* ptr) {
+#ifdef _WIN32
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+void* operator new(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if(void* ptr = std::malloc(size == 0 ? 1 : size)) return ptr;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+void operator delete[](void* ptr) noexcept {
+    std::free(ptr);
+}
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+void operator delete[](void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if(void* ptr = allocateAligned(size, static_cast<std::size_t>(alignment))) return ptr;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return operator new(size, alignment);
+}
+void operator delete(void* ptr, std::align_val_t) noexcept {
+    freeAligned(ptr);
+}
+void operator delete[](void* ptr, std::align_val_t) noexcept {
+    freeAligned(ptr);
+}
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept {
+    freeAligned(ptr);
+}
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept {
+    freeAligned(ptr);
+}
+
+// Sends a message derived from each input frame, such as synthetic depth or detections with the timestamp of the frame
+class MapFrames : public dai::NodeCRTP<dai::node::ThreadedHostNode, MapFrames> {
+   public:
+    constexpr static const char* NAME = "MapFrames";
+
+    Input input{*this, {"in", DEFAULT_GROUP, true, 4, {{{dai::DatatypeEnum::ImgFrame, false}}}}};
+    Output out{*this, {"out", DEFAULT_GROUP, {{{dai::DatatypeEnum::Buffer, true}}}}};
+
+    std::function<std::shared_ptr<dai::Buffer>(std::shared_ptr<dai::ImgFrame>)> function;
+
+    void run() override {
+        while(isRunning()) {
+            auto frame = input.get<dai::ImgFrame>();
+            if(frame == nullptr) continue;
+            out.send(function(frame));
+        }
+    }
+};
+
+struct Stage {
+    std::string name;
+    std::shared_ptr<dai::MessageQueue> reports;
+};
+
+struct Chain {
+    std::vector<Stage> stages;
+    // Messages leaving the chain, for their lineage
+    std::shared_ptr<dai::MessageQueue> tap;
+    // Nodes of the chain, as the messages of the source and of nodes which forward their input share one lineage between chains
+    std::set<std::int64_t> nodeIds;
+};
+
+// Time each node spent on a message and the time the message waited in its input queue
+struct NodeLatency {
+    dai::LatencyHistogram processing;
+    dai::LatencyHistogram queueing;
+};
+
+static std::vector<std::string> split(const std::string& str, char delimiter) {
+    std::vector<std::string> parts;
+    std::stringstream ss(str);
+    std::string part;
+    while(std::getline(ss, part, delimiter)) {
+        if(!part.empty()) parts.push_back(part);
+    }
+    return parts;
+}
+
+int main(int argc, char** argv) {
+    using namespace std::chrono;
+
+    std::map<std::string, std::string> args = {{"width", "1920"},
+                                               {"height", "1080"},
+                                               {"type", "nv12"},
+                                               {"fps", "30"},
+                                               {"fanout", "1"},
+                                               {"stages", "manip"},
+                                               {"duration", "10"},
+                                               {"output", ""},
+                                               {"replay", ""}};
+    for(int i = 1; i + 1 < argc; i += 2) {
+        std::string key = argv[i];
+        if(key.rfind("--", 0) != 0 || args.count(key.substr(2)) == 0) {
+            std::cout << "Unknown argument " << key << std::endl;
+            return -1;
+        }
+        args[key.substr(2)] = argv[i + 1];
+    }
+
+    const unsigned width = std::stoul(args["width"]);
+    const unsigned height = std::stoul(args["height"]);
+    const float fps = std::stof(args["fps"]);
+    const int fanout = std::stoi(args["fanout"]);
+    const auto stageNames = split(args["stages"], ',');
+    const seconds runDuration(std::stoi(args["duration"]));
+
+    dai::ImgFrame::Type frameType = dai::ImgFrame::Type::NV12;
+    if(args["type"] == "bgr") frameType = dai::ImgFrame::Type::BGR888i;
+    if(args["type"] == "raw16") frameType = dai::ImgFrame::Type::RAW16;
+
+    // Synthetic frame, sent repeatedly by the source
+    auto frame = std::make_shared<dai::ImgFrame>();
+    frame->setWidth(width);
+    frame->setHeight(height);
+    frame->setSourceSize(width, height);
+    frame->setType(frameType);
+    frame->transformation = dai::ImgTransformation(width, height);
+    std::vector<std::uint8_t> data(static_cast<size_t>(width * height * frame->getBytesPerPixel()));
+    for(size_t i = 0; i < data.size(); i++) data[i] = static_cast<std::uint8_t>(i * 31);
+    frame->setData(data);
+
+    // Lineage adds a few timestamps per hop, which is included in the measured latencies
+    dai::MessageLineage::setEnabled(true);
+
+    dai::Pipeline pipeline(false);
+    std::vector<Chain> chains(fanout);
+    // Nodes are named by their stage in the lineage
+    auto addNode = [&](dai::Node& node, const std::string& name, Chain& chain) {
+        node.setAlias(name);
+        chain.nodeIds.insert(node.id);
+    };
+    std::shared_ptr<dai::InputQueue> inputQueue;
+    dai::Node::Output* sourceOutput = nullptr;
+    if(args["replay"].empty()) {
+        auto source = pipeline.create<dai::node::BenchmarkOut>();
+        addNode(*source, "source", chains[0]);
+        source->setRunOnHost(true);
+        source->setFps(fps);
+        inputQueue = source->input.createInputQueue();
+        sourceOutput = &source->out;
+    } else {
+        auto replay = pipeline.create<dai::node::ReplayVideo>();
+        addNode(*replay, "source", chains[0]);
+        replay->setReplayVideoFile(args["replay"]);
+        replay->setSize(width, height);
+        replay->setOutFrameType(frameType);
+        replay->setFps(fps);
+        // Replayed frames carry the recorded device timestamps, latency is measured from the time they are replayed
+        auto stamp = pipeline.create<MapFrames>();
+        addNode(*stamp, "source.stamp", chains[0]);
+        stamp->function = [](std::shared_ptr<dai::ImgFrame> frame) {
+            frame->setTimestamp(steady_clock::now());
+            return frame;
+        };
+        replay->out.link(stamp->input);
+        sourceOutput = &stamp->out;
+    }
+
+    // Reports are sent every second worth of messages
+    const auto reportEvery = static_cast<uint32_t>(std::max(1.0f, fps));
+    auto addBenchmark = [&](dai::Node::Output& output, const std::string& name, Chain& chain) {
+        auto benchmarkIn = pipeline.create<dai::node::BenchmarkIn>();
+        addNode(*benchmarkIn, "benchmark." + name, chain);
+        benchmarkIn->setRunOnHost(true);
+        benchmarkIn->sendReportEveryNMessages(reportEvery);
+        benchmarkIn->logReportsAsWarnings(false);
+        output.link(benchmarkIn->input);
+        chain.stages.push_back({name, benchmarkIn->report.createOutputQueue(100, false)});
+        return &benchmarkIn->passthrough;
+    };
+
+    for(auto& chain : chains) {
+        dai::Node::Output* output = addBenchmark(*sourceOutput, "source", chain);
+        for(size_t i = 0; i < stageNames.size(); i++) {
+            const auto& stageName = stageNames[i];
+            if(stageName == "manip") {
+                auto manip = pipeline.create<dai::node::ImageManip>();
+                addNode(*manip, stageName, chain);
+                manip->setRunOnHost();
+                manip->setMaxOutputFrameSize(width * height * 3);
+                manip->initialConfig->setOutputSize(width / 2, height / 2);
+                manip->initialConfig->setFrameType(dai::ImgFrame::Type::BGR888i);
+                output->link(manip->inputImage);
+                output = &manip->out;
+            } else if(stageName == "filters") {
+                auto filters = pipeline.create<dai::node::ImageFilters>();
+                addNode(*filters, stageName, chain);
+                filters->setRunOnHost(true);
+                output->link(filters->input);
+                output = &filters->output;
+            } else if(stageName == "sync") {
+                auto sync = pipeline.create<dai::node::Sync>();
+                addNode(*sync, stageName, chain);
+                sync->setRunOnHost(true);
+                output->link(sync->inputs["frame"]);
+                output = &sync->out;
+            } else if(stageName == "tracker") {
+                auto tracker = pipeline.create<dai::node::ObjectTracker>();
+                addNode(*tracker, stageName, chain);
+                tracker->setRunOnHost(true);
+                tracker->setTrackerType(dai::TrackerType::SHORT_TERM_IMAGELESS);
+                auto detections = pipeline.create<MapFrames>();
+                addNode(*detections, stageName + ".detections", chain);
+                detections->function = [](std::shared_ptr<dai::ImgFrame> frame) {
+                    auto message = std::make_shared<dai::ImgDetections>();
+                    for(int j = 0; j < 4; j++) {
+                        dai::ImgDetection detection;
+                        detection.label = j;
+                        detection.confidence = 0.9f;
+                        detection.xmin = 0.2f * j + 0.05f;
+                        detection.ymin = 0.3f;
+                        detection.xmax = 0.2f * j + 0.2f;
+                        detection.ymax = 0.6f;
+                        message->detections.push_back(detection);
+                    }
+                    message->transformation = frame->transformation;
+                    message->setTimestamp(frame->getTimestamp());
+                    message->setSequenceNum(frame->getSequenceNum());
+                    return message;
+                };
+                output->link(detections->input);
+                detections->out.link(tracker->inputDetections);
+                output->link(tracker->inputTrackerFrame);
+                output = &tracker->passthroughTrackerFrame;
+            } else if(stageName == "rgbd") {
+                if(i + 1 != stageNames.size()) {
+                    std::cout << "Stage rgbd has to be the last one" << std::endl;
+                    return -1;
+                }
+                auto rgbd = pipeline.create<dai::node::RGBD>();
+                addNode(*rgbd, stageName, chain);
+                addNode(*rgbd->sync, stageName + ".sync", chain);
+                rgbd->sync->setRunOnHost(true);
+                // Depth of a plane 1m away, aligned to the color frame
+                auto depth = pipeline.create<MapFrames>();
+                addNode(*depth, stageName + ".depth", chain);
+                depth->function = [depthData = std::shared_ptr<dai::Memory>()](std::shared_ptr<dai::ImgFrame> frame) mutable {
+                    auto depthFrame = std::make_shared<dai::ImgFrame>();
+                    depthFrame->setMetadata(frame);
+                    depthFrame->setType(dai::ImgFrame::Type::RAW16);
+                    depthFrame->setStride(frame->getWidth() * 2);
+                    const size_t size = static_cast<size_t>(frame->getWidth()) * frame->getHeight() * 2;
+                    if(depthData == nullptr || depthData->getSize() != size) {
+                        std::vector<std::uint8_t> pixels(size);
+                        for(size_t j = 0; j < size; j += 2) {
+                            pixels[j] = 1000 & 0xFF;
+                            pixels[j + 1] = 1000 >> 8;
+                        }
+                        depthFrame->setData(pixels);
+                        depthData = depthFrame->data;
+                    }
+                    depthFrame->data = depthData;
+                    return depthFrame;
+                };
+                output->link(rgbd->inColor);
+                output->link(depth->input);
+                depth->out.link(rgbd->inDepth);
+                output = &rgbd->pcl;
+            } else {
+                std::cout << "Unknown stage " << stageName << std::endl;
+                return -1;
+            }
+            output = addBenchmark(*output, stageName, chain);
+        }
+        chain.tap = output->createOutputQueue(16, false);
+    }
+
+    pipeline.start();
+    if(inputQueue != nullptr) inputQueue->send(frame);
+
+    // Warm up, then measure
+    std::this_thread::sleep_for(seconds(1));
+    for(auto& chain : chains) {
+        for(auto& stage : chain.stages) stage.reports->tryGetAll();
+        chain.tap->tryGetAll();
+    }
+    std::map<std::string, NodeLatency> nodes;
+    auto collectLineage = [&]() {
+        for(auto& chain : chains) {
+            for(auto& msg : chain.tap->tryGetAll()) {
+                auto lineage = msg->getLineage();
+                if(lineage == nullptr) continue;
+                for(const auto& hop : lineage->getLatencyBreakdown()) {
+                    if(chain.nodeIds.count(hop.nodeId) == 0) continue;
+                    auto& node = nodes[hop.name];
+                    if(hop.processing) node.processing.record(*hop.processing);
+                    if(hop.queueing) node.queueing.record(*hop.queueing);
+                }
+            }
+        }
+    };
+    const auto allocationsStart = allocationCount.load();
+    const auto cpuStart = std::clock();
+    const auto wallStart = steady_clock::now();
+    while(steady_clock::now() - wallStart < runDuration) {
+        std::this_thread::sleep_for(milliseconds(10));
+        collectLineage();
+    }
+    const auto cpuTime = static_cast<double>(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+    const auto wallTime = duration_cast<duration<double>>(steady_clock::now() - wallStart).count();
+    const auto allocations = allocationCount.load() - allocationsStart;
+
+    // Aggregate reports of all chains per stage
+    nlohmann::json results;
+    results["config"] = args;
+    results["wallTime"] = wallTime;
+    results["cpuTime"] = cpuTime;
+    results["cpuUsage"] = cpuTime / wallTime;
+    auto toMs = [](microseconds us) { return duration<double, std::milli>(us).count(); };
+    std::uint64_t sourceMessages = 0;
+    for(size_t i = 0; i < chains[0].stages.size(); i++) {
+        dai::LatencyHistogram latency;
+        dai::LatencyHistogram interArrival;
+        for(auto& chain : chains) {
+            for(auto& msg : chain.stages[i].reports->tryGetAll()) {
+                auto report = std::dynamic_pointer_cast<dai::BenchmarkReport>(msg);
+                if(report == nullptr) continue;
+                latency.merge(report->latencyHistogram);
+                interArrival.merge(report->interArrivalHistogram);
+            }
+        }
+        // Every chain receives all messages of the source
+        if(i == 0) sourceMessages = latency.count / chains.size();
+        results["stages"].push_back({{"name", chains[0].stages[i].name},
+                                     {"messages", latency.count},
+                                     {"throughput", latency.count / wallTime},
+                                     {"latencyMs",
+                                      {{"mean", latency.getMean().count() / 1000.0},
+                                       {"p50", toMs(latency.getPercentile(50))},
+                                       {"p90", toMs(latency.getPercentile(90))},
+                                       {"p99", toMs(latency.getPercentile(99))},
+                                       {"p99.9", toMs(latency.getPercentile(99.9))},
+                                       {"max", toMs(microseconds(latency.max))}}},
+                                     {"interArrivalMs",
+                                      {{"mean", interArrival.getMean().count() / 1000.0},
+                                       {"stdDev", interArrival.getStdDev().count() / 1000.0},
+                                       {"p99", toMs(interArrival.getPercentile(99))}}}});
+    }
+    pipeline.stop();
+
+    // Own latency of each node, aggregated over the chains
+    auto summary = [&](const dai::LatencyHistogram& histogram) {
+        return nlohmann::json{{"mean", histogram.getMean().count() / 1000.0},
+                              {"p50", toMs(histogram.getPercentile(50))},
+                              {"p90", toMs(histogram.getPercentile(90))},
+                              {"p99", toMs(histogram.getPercentile(99))},
+                              {"max", toMs(microseconds(histogram.max))}};
+    };
+    for(const auto& node : nodes) {
+        results["nodes"].push_back({{"name", node.first},
+                                    {"messages", node.second.processing.count},
+                                    {"processingMs", summary(node.second.processing)},
+                                    {"queueingMs", summary(node.second.queueing)}});
+    }
+    results["allocations"] = allocations;
+    // All allocations of the process, for each frame produced by the source regardless of fanout
+    results["allocationsPerMessage"] = sourceMessages > 0 ? static_cast<double>(allocations) / sourceMessages : 0.0;
+
+    if(args["output"].empty()) {
+        std::cout << results.dump(4) << std::endl;
+    } else {
+        std::ofstream(args["output"]) << results.dump(4) << std::endl;
+        std::cout << "Results written to " << args["output"] << std::endl;
+    }
+
+    return 0;
+}
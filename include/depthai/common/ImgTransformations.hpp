@@ -4,9 +4,12 @@
 #include "depthai/common/Point2f.hpp"
 #include "depthai/common/RotatedRect.hpp"
 #include "depthai/utility/Serialization.hpp"
+#include "depthai/utility/span.hpp"
 
 namespace dai {
 
+struct ImgDetection;
+
 std::array<std::array<float, 3>, 3> getMatrixInverse(const std::array<std::array<float, 3>, 3>& matrix);
 
 /**
@@ -240,6 +243,46 @@ struct ImgTransformation {
      */
     dai::RotatedRect remapRectFrom(const ImgTransformation& from, dai::RotatedRect rect) const;
 
+    /**
+     * Retrieve the matrix which remaps pixel coordinates from this transformation to another. Composed of the inverse transformation of this frame,
+     * the transformation between source intrinsics (if they differ) and the transformation of the other frame.
+     * Can be computed once and reused while remapping many points between the same pair of frames.
+     * @param to Transformation to remap to
+     * @return Remap matrix
+     */
+    std::array<std::array<float, 3>, 3> getRemapMatrixTo(const ImgTransformation& to) const;
+    /**
+     * Transform points in place from the source frame to the current frame.
+     * @param points Points to transform
+     */
+    void transformPoints(span<dai::Point2f> points) const;
+    /**
+     * Transform points in place from the current frame to the source frame.
+     * @param points Points to transform
+     */
+    void invTransformPoints(span<dai::Point2f> points) const;
+    /**
+     * Remap points in place from this transformation to another. Equivalent to calling remapPointTo on each point,
+     * but the remap matrix is composed only once for the whole batch.
+     * @param to Transformation to remap to
+     * @param points Points to remap
+     */
+    void remapPointsTo(const ImgTransformation& to, span<dai::Point2f> points) const;
+    /**
+     * Remap rotated rects in place from this transformation to another. Same as calling remapRectTo on each rect,
+     * but the matrices of both transformations are looked up only once for the whole batch.
+     * @param to Transformation to remap to
+     * @param rects RotatedRects to remap
+     */
+    void remapRectsTo(const ImgTransformation& to, span<dai::RotatedRect> rects) const;
+    /**
+     * Remap detections in place from this transformation to another. Bounding boxes are normalized before and after remapping;
+     * each box is replaced with the axis aligned bounding box of its remapped corners, clipped to the destination frame.
+     * @param to Transformation to remap to
+     * @param detections Detections to remap
+     */
+    void remapDetectionsTo(const ImgTransformation& to, span<dai::ImgDetection> detections) const;
+
     /**
      * Check if the transformations are valid. The transformations are valid if the source frame size and the current frame size are set.
      */
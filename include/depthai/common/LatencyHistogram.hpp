@@ -0,0 +1,84 @@
+#pragma once
+
+// std
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "depthai/utility/Serialization.hpp"
+
+namespace dai {
+
+/**
+ * Fixed precision, log-linear (HDR style) histogram of durations in microseconds.
+ * Values below 128us are recorded exactly, larger values with a relative error below 1/64.
+ * Only non-empty buckets are stored, which keeps the histogram compact regardless of the number of recorded values.
+ * Histograms can be merged, eg. to aggregate reports of multiple BenchmarkIn nodes.
+ */
+struct LatencyHistogram {
+    /// Number of recorded values
+    std::uint64_t count = 0;
+    /// Minimum recorded value in microseconds
+    std::uint64_t min = 0;
+    /// Maximum recorded value in microseconds
+    std::uint64_t max = 0;
+    /// Sum of recorded values in microseconds
+    std::uint64_t sum = 0;
+    /// Sum of squared recorded values in microseconds squared
+    double sumSquares = 0.0;
+    /// Indices of non-empty buckets, in ascending order
+    std::vector<std::uint16_t> bucketIndices;
+    /// Number of values recorded in each non-empty bucket
+    std::vector<std::uint64_t> bucketCounts;
+
+    /**
+     * Record a duration. Negative durations (eg. due to clock skew) are recorded as zero.
+     */
+    void record(std::chrono::microseconds value);
+
+    /**
+     * Add all values recorded in another histogram
+     */
+    void merge(const LatencyHistogram& other);
+
+    /**
+     * Clear all recorded values
+     */
+    void reset();
+
+    /**
+     * Get value at a given percentile
+     * @param percentile Percentile in range [0, 100]
+     * @returns Highest value equivalent (within histogram precision) to the value at the percentile, or zero if histogram is empty
+     */
+    std::chrono::microseconds getPercentile(double percentile) const;
+
+    /**
+     * Get mean of recorded values
+     */
+    std::chrono::duration<double, std::micro> getMean() const;
+
+    /**
+     * Get standard deviation of recorded values
+     */
+    std::chrono::duration<double, std::micro> getStdDev() const;
+
+    /**
+     * Get bucket index into which a value is recorded
+     */
+    static std::uint16_t getBucketIndex(std::uint64_t value);
+
+    /**
+     * Get lowest value recorded into a bucket
+     */
+    static std::uint64_t getBucketLowestValue(std::uint16_t index);
+
+    /**
+     * Get highest value recorded into a bucket
+     */
+    static std::uint64_t getBucketHighestValue(std::uint16_t index);
+};
+
+DEPTHAI_SERIALIZE_EXT(LatencyHistogram, count, min, max, sum, sumSquares, bucketIndices, bucketCounts);
+
+}  // namespace dai
@@ -1,6 +1,8 @@
 // IWYU pragma: private, include "depthai/depthai.hpp"
 #pragma once
+#include <array>
 #include <filesystem>
+#include <memory>
 #include <string>
 #include <tuple>
 
@@ -31,6 +33,9 @@ namespace dai {
  */
 class CalibrationHandler {
    public:
+    /// 4x4 homogeneous transformation matrix, row major
+    using Matrix4x4 = std::array<std::array<float, 4>, 4>;
+
     CalibrationHandler() = default;
 
     /**
@@ -226,6 +231,18 @@ class CalibrationHandler {
      */
     std::vector<std::vector<float>> getCameraExtrinsics(CameraBoardSocket srcCamera, CameraBoardSocket dstCamera, bool useSpecTranslation = false) const;
 
+    /**
+     * Get the Camera Extrinsics between two cameras as a fixed size matrix.
+     * Transformations between all linked cameras are computed once per calibration and cached (until calibration is modified),
+     * so this is cheap to call repeatedly. Same semantics as getCameraExtrinsics.
+     *
+     * @param srcCamera Camera Id of the camera which will be considered as origin.
+     * @param dstCamera  Camera Id of the destination camera to which we are fetching the rotation and translation from the SrcCamera
+     * @param useSpecTranslation Enabling this bool uses the translation information from the board design data
+     * @return a transformationMatrix which is 4x4 in homogeneous coordinate system
+     */
+    Matrix4x4 getCameraExtrinsicsMatrix(CameraBoardSocket srcCamera, CameraBoardSocket dstCamera, bool useSpecTranslation = false) const;
+
     /**
      * Get the Camera translation vector between two cameras from the calibration data.
      *
@@ -608,9 +625,24 @@ class CalibrationHandler {
      * and linked to CameraBoardSocket.AUTO)
      * @param cameraId Camera Id of the camera for which the origin matrix is being calculated
      * @param useSpecTranslation Enabling this bool uses the translation information from the board design data
+     * @param logErrors Log broken links before throwing, disabled where the error is reported later if at all
      * @return a transformationMatrix which is 4x4 in homogeneous coordinate system
      */
-    std::vector<std::vector<float>> getExtrinsicsToOrigin(CameraBoardSocket cameraId, bool useSpecTranslation, CameraBoardSocket& originSocket) const;
+    std::vector<std::vector<float>> getExtrinsicsToOrigin(CameraBoardSocket cameraId,
+                                                          bool useSpecTranslation,
+                                                          CameraBoardSocket& originSocket,
+                                                          bool logErrors = true) const;
+
+    /**
+     * Computes extrinsics between two cameras by walking the camera link graph, without using the cached table
+     */
+    std::vector<std::vector<float>> computeCameraExtrinsics(CameraBoardSocket srcCamera, CameraBoardSocket dstCamera, bool useSpecTranslation) const;
+
+    // Transformations between all pairs of linked cameras, built lazily and dropped whenever calibration data changes
+    struct ExtrinsicsTable;
+    mutable std::array<std::shared_ptr<const ExtrinsicsTable>, 2> extrinsicsTables;
+    std::shared_ptr<const ExtrinsicsTable> getExtrinsicsTable(bool useSpecTranslation) const;
+    void invalidateExtrinsicsTables();
 
     DEPTHAI_SERIALIZE(CalibrationHandler, eepromData);
 };
@@ -23,6 +23,7 @@
 #include "depthai/device/Version.hpp"
 #include "depthai/openvino/OpenVINO.hpp"
 #include "depthai/pipeline/PipelineSchema.hpp"
+#include "depthai/utility/MetricsRegistry.hpp"
 #include "depthai/utility/Pimpl.hpp"
 #include "depthai/utility/ProfilingData.hpp"
 #include "depthai/xlink/XLinkConnection.hpp"
@@ -847,6 +848,7 @@ class DeviceBase {
         bool hasPipeline;
     };
     void monitorCallback(std::chrono::milliseconds watchdogTimeout, PrevInfo prev);
+    void collectMetrics(MetricsRegistry::Writer& writer);
     DeviceInfo deviceInfo = {};
     std::optional<Version> bootloaderVersion;
 
@@ -2,6 +2,8 @@
 #pragma once
 
 // std
+#include <cstdint>
+#include <functional>
 #include <string>
 #include <thread>
 #include <type_traits>
@@ -144,6 +146,30 @@ class DeviceBootloader {
                                                                 std::string applicationName = "",
                                                                 bool checkChecksum = false);
 
+    /**
+     * Receives contents of an application package while it is being created.
+     * Called with offset into the package and data to place there.
+     * All contents apart from the package header are written once, in increasing offset order, including zero padding between sections.
+     * The package header (first SBR_RAW_SIZE bytes) is written last, once all section checksums are known.
+     */
+    using PackageSink = std::function<void(std::size_t offset, const std::uint8_t* data, std::size_t size)>;
+
+    /**
+     * Creates application package and streams it to the given sink, without holding the whole package in memory.
+     * Section checksums are computed while streaming and firmware is compressed in parallel; output is identical to createDepthaiApplicationPackage.
+     * @param sink Sink receiving package contents
+     * @param pipeline Pipeline from which to create the application package
+     * @param pathToCmd Optional path to custom device firmware
+     * @param compress Optional boolean which specifies if contents should be compressed
+     * @param applicationName Optional name the application that is flashed
+     */
+    static void writeDepthaiApplicationPackage(const PackageSink& sink,
+                                               const Pipeline& pipeline,
+                                               const fs::path& pathToCmd = {},
+                                               bool compress = false,
+                                               std::string applicationName = "",
+                                               bool checkChecksum = false);
+
     /**
      * Saves application package to a file which can be flashed to depthai device.
      * @param path Path where to save the application package
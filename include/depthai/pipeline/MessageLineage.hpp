@@ -0,0 +1,136 @@
+#pragma once
+
+// std
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace dai {
+
+class ADatatype;
+
+/**
+ * Timestamps of a single hop of a message through a host node or queue
+ */
+struct LineageHop {
+    using Timepoint = std::chrono::steady_clock::time_point;
+
+    /// Id of the node, or -1 for queues which don't belong to a node (eg. output queues)
+    std::int64_t nodeId = -1;
+    /// Alias or name of the node, or name of the queue
+    std::string name;
+    /// When the message was pushed into the input queue, default constructed if not recorded
+    Timepoint enqueued{};
+    /// When the message was popped from the input queue, default constructed if not recorded
+    Timepoint dequeued{};
+    /// When the message (or a message derived from it) was sent out by the node, default constructed if not recorded
+    Timepoint emitted{};
+};
+
+/**
+ * Latency breakdown of a single hop
+ */
+struct LineageHopLatency {
+    std::int64_t nodeId = -1;
+    std::string name;
+    /// Time between being emitted by the previous node and being enqueued
+    std::optional<std::chrono::microseconds> transport;
+    /// Time spent waiting in the input queue
+    std::optional<std::chrono::microseconds> queueing;
+    /// Time between being dequeued and emitted, the processing time of the node
+    std::optional<std::chrono::microseconds> processing;
+};
+
+/**
+ * Opt-in record of the path a message took through host nodes and queues.
+ * When enabled, queues stamp when a message was enqueued and dequeued, and node outputs when it was emitted.
+ * Messages created by a node (instead of forwarded) inherit the lineage of the last message that node's thread dequeued.
+ * When disabled (default), no lineage is allocated and recording is skipped.
+ */
+class MessageLineage {
+   public:
+    /// Maximum number of recorded hops, oldest hops are dropped first
+    static constexpr size_t MAX_HOPS = 32;
+
+    MessageLineage() = default;
+    MessageLineage(const MessageLineage& other);
+    MessageLineage& operator=(const MessageLineage& other);
+
+    /**
+     * Enable or disable recording of lineage for all pipelines in the process
+     */
+    static void setEnabled(bool enabled);
+
+    /**
+     * Check whether recording of lineage is enabled
+     */
+    static bool isEnabled();
+
+    /**
+     * Get recorded hops, from the oldest to the newest
+     */
+    std::vector<LineageHop> getHops() const;
+
+    /**
+     * Get per hop breakdown of latency into transport, queueing and processing time.
+     * Durations which can't be computed (eg. message was dropped from a queue) are left empty.
+     */
+    std::vector<LineageHopLatency> getLatencyBreakdown() const;
+
+    /**
+     * Human readable per hop latency breakdown, one hop per line
+     */
+    std::string toString() const;
+
+    /// Record that a message was pushed into a queue
+    static void recordEnqueue(ADatatype& msg, std::int64_t nodeId, const std::string& name);
+    /// Record that a message was popped from a queue
+    static void recordDequeue(ADatatype& msg, std::int64_t nodeId, const std::string& name);
+    /// Record that a message was sent out by a node
+    static void recordEmit(ADatatype& msg, std::int64_t nodeId, const std::string& name);
+
+   private:
+    mutable std::mutex mtx;
+    std::vector<LineageHop> hops;
+
+    void addHop(LineageHop hop);
+};
+
+/**
+ * Pointer to a message lineage, which copies the lineage when copied.
+ * Messages copied from one another thereby continue their lineage independently.
+ */
+class MessageLineagePtr {
+   public:
+    MessageLineagePtr() = default;
+    MessageLineagePtr(const MessageLineagePtr& other) : ptr(other.ptr ? std::make_shared<MessageLineage>(*other.ptr) : nullptr) {}
+    MessageLineagePtr(MessageLineagePtr&& other) noexcept = default;
+    MessageLineagePtr& operator=(const MessageLineagePtr& other) {
+        if(this != &other) ptr = other.ptr ? std::make_shared<MessageLineage>(*other.ptr) : nullptr;
+        return *this;
+    }
+    MessageLineagePtr& operator=(MessageLineagePtr&& other) noexcept = default;
+    MessageLineagePtr& operator=(std::shared_ptr<MessageLineage> lineage) {
+        ptr = std::move(lineage);
+        return *this;
+    }
+
+    const std::shared_ptr<MessageLineage>& get() const {
+        return ptr;
+    }
+    MessageLineage* operator->() const {
+        return ptr.get();
+    }
+    explicit operator bool() const {
+        return ptr != nullptr;
+    }
+
+   private:
+    std::shared_ptr<MessageLineage> ptr;
+};
+
+}  // namespace dai
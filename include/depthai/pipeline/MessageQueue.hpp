@@ -1,12 +1,16 @@
 #pragma once
 
 // std
+#include <deque>
+#include <future>
 #include <memory>
 #include <vector>
 
 // project
+#include "depthai/pipeline/MessageLineage.hpp"
 #include "depthai/pipeline/datatype/ADatatype.hpp"
 #include "depthai/utility/LockingQueue.hpp"
+#include "depthai/utility/MetricsRegistry.hpp"
 
 // shared
 namespace dai {
@@ -19,6 +23,20 @@ class MessageQueue : public std::enable_shared_from_this<MessageQueue> {
     /// Alias for callback id
     using CallbackId = int;
 
+    /// Queue statistics
+    struct Stats {
+        /// Number of messages pushed into the queue
+        std::uint64_t pushed = 0;
+        /// Number of messages dropped because the queue was full (non blocking) or had zero size
+        std::uint64_t dropped = 0;
+        /// Total time senders spent blocked on a full (blocking) queue
+        std::chrono::nanoseconds blockedTime{0};
+        /// Number of messages currently in the queue
+        unsigned size = 0;
+        /// Bytes held by payloads of messages currently in the queue
+        std::size_t heldBytes = 0;
+    };
+
     class QueueException : public std::runtime_error {
        public:
         explicit QueueException(const std::string& message) : std::runtime_error(message) {}
@@ -36,7 +54,31 @@ class MessageQueue : public std::enable_shared_from_this<MessageQueue> {
     CallbackId uniqueCallbackId{0};
 
    private:
+    std::mutex asyncGetsMtx;
+    std::deque<std::pair<CallbackId, std::function<void(std::shared_ptr<ADatatype>)>>> asyncGets;
+    CallbackId uniqueAsyncGetId{0};
+
     void callCallbacks(std::shared_ptr<ADatatype> msg);
+    void serveAsyncGets();
+    void cancelAsyncGets();
+
+    void recordEnqueue(const std::shared_ptr<ADatatype>& msg) {
+        if(MessageLineage::isEnabled()) MessageLineage::recordEnqueue(*msg, getParentNodeId(), getParentNodeName());
+    }
+    void recordDequeue(const std::shared_ptr<ADatatype>& msg) {
+        if(msg && MessageLineage::isEnabled()) MessageLineage::recordDequeue(*msg, getParentNodeId(), getParentNodeName());
+        if(MetricsRegistry::isEnabled()) MetricsRegistry::recordDequeue(getParentNodeId());
+    }
+
+   protected:
+    /// Id of the node this queue belongs to, -1 if it doesn't belong to a node
+    virtual std::int64_t getParentNodeId() const {
+        return -1;
+    }
+    /// Alias or name of the node this queue belongs to, or name of the queue if it doesn't belong to a node
+    virtual std::string getParentNodeName() const {
+        return name;
+    }
 
    public:
     // DataOutputQueue constructor
@@ -126,6 +168,36 @@ class MessageQueue : public std::enable_shared_from_this<MessageQueue> {
      */
     unsigned int getSize() const;
 
+    /**
+     * Sets maximum number of bytes held by payloads of messages in the queue, in addition to maxSize.
+     * When exceeded, the queue blocks or drops the oldest messages, same as when maxSize is reached.
+     * A single message larger than the limit is still accepted by an empty queue.
+     *
+     * @param maxBytes Maximum number of bytes, 0 for no limit (default)
+     */
+    void setMaxBytes(std::size_t maxBytes);
+
+    /**
+     * Gets maximum number of bytes held by the queue
+     *
+     * @returns Maximum number of bytes, 0 if not limited
+     */
+    std::size_t getMaxBytes() const;
+
+    /**
+     * Gets number of bytes held by payloads of messages currently in the queue
+     *
+     * @returns Current number of bytes
+     */
+    std::size_t getBytes() const;
+
+    /**
+     * Gets number of bytes held by payloads of messages in all queues
+     *
+     * @returns Total number of bytes in flight
+     */
+    static std::size_t getTotalBytes();
+
     /**
      * Gets whether queue is full
      *
@@ -133,6 +205,11 @@ class MessageQueue : public std::enable_shared_from_this<MessageQueue> {
      */
     unsigned int isFull() const;
 
+    /**
+     * Get queue statistics
+     */
+    Stats getStats() const;
+
     /**
      * Adds a callback on message received
      *
@@ -165,6 +242,55 @@ class MessageQueue : public std::enable_shared_from_this<MessageQueue> {
      */
     bool removeCallback(CallbackId callbackId);
 
+    /**
+     * Retrieves the next message without blocking, by calling the callback once a message is available.
+     * If a message is already in the queue, callback is called immediately from the calling thread,
+     * otherwise it is called from the thread which sends the message. Pending asynchronous gets are
+     * served in the order they were issued.
+     * If the queue is closed before a message arrives, callback is called with nullptr.
+     *
+     * @param callback Callback function called once with the retrieved message
+     * @returns Id which can be used to cancel the pending get
+     */
+    CallbackId getAsync(std::function<void(std::shared_ptr<ADatatype>)> callback);
+
+    /**
+     * Cancels a pending asynchronous get
+     *
+     * @param getId Id returned by getAsync
+     * @returns True if get was still pending and was cancelled, false otherwise
+     */
+    bool cancelGetAsync(CallbackId getId);
+
+    /**
+     * Retrieves the next message without blocking the calling thread.
+     *
+     * @returns Future which resolves to message of type T (or nullptr if message isn't of type T),
+     * or throws QueueException if the queue is closed before a message arrives
+     */
+    template <class T>
+    std::future<std::shared_ptr<T>> getAsync() {
+        auto promise = std::make_shared<std::promise<std::shared_ptr<T>>>();
+        auto future = promise->get_future();
+        getAsync([promise](std::shared_ptr<ADatatype> msg) {
+            if(msg == nullptr) {
+                promise->set_exception(std::make_exception_ptr(QueueException(CLOSED_QUEUE_MESSAGE)));
+            } else {
+                promise->set_value(std::dynamic_pointer_cast<T>(std::move(msg)));
+            }
+        });
+        return future;
+    }
+
+    /**
+     * Retrieves the next message without blocking the calling thread.
+     *
+     * @returns Future which resolves to message, or throws QueueException if the queue is closed before a message arrives
+     */
+    std::future<std::shared_ptr<ADatatype>> getAsync() {
+        return getAsync<ADatatype>();
+    }
+
     /**
      * Check whether front of the queue has message of type T
      * @returns True if queue isn't empty and the first element is of type T, false otherwise
@@ -201,6 +327,7 @@ class MessageQueue : public std::enable_shared_from_this<MessageQueue> {
         }
         std::shared_ptr<ADatatype> val = nullptr;
         if(!queue.tryPop(val)) return nullptr;
+        recordDequeue(val);
         return std::dynamic_pointer_cast<T>(val);
     }
 
@@ -224,6 +351,7 @@ class MessageQueue : public std::enable_shared_from_this<MessageQueue> {
         if(!queue.waitAndPop(val)) {
             throw QueueException(CLOSED_QUEUE_MESSAGE);
         }
+        recordDequeue(val);
         return std::dynamic_pointer_cast<T>(val);
     }
 
@@ -282,6 +410,7 @@ class MessageQueue : public std::enable_shared_from_this<MessageQueue> {
             return nullptr;
         }
         hasTimedout = false;
+        recordDequeue(val);
         return std::dynamic_pointer_cast<T>(val);
     }
 
@@ -308,7 +437,8 @@ class MessageQueue : public std::enable_shared_from_this<MessageQueue> {
             throw QueueException(CLOSED_QUEUE_MESSAGE);
         }
         std::vector<std::shared_ptr<T>> messages;
-        queue.consumeAll([&messages](std::shared_ptr<ADatatype>& msg) {
+        queue.consumeAll([this, &messages](std::shared_ptr<ADatatype>& msg) {
+            recordDequeue(msg);
             // dynamic pointer cast may return nullptr
             // in which case that message in vector will be nullptr
             messages.push_back(std::dynamic_pointer_cast<T>(std::move(msg)));
@@ -334,7 +464,8 @@ class MessageQueue : public std::enable_shared_from_this<MessageQueue> {
     template <class T>
     std::vector<std::shared_ptr<T>> getAll() {
         std::vector<std::shared_ptr<T>> messages;
-        bool notDestructed = queue.waitAndConsumeAll([&messages](std::shared_ptr<ADatatype>& msg) {
+        bool notDestructed = queue.waitAndConsumeAll([this, &messages](std::shared_ptr<ADatatype>& msg) {
+            recordDequeue(msg);
             // dynamic pointer cast may return nullptr
             // in which case that message in vector will be nullptr
             messages.push_back(std::dynamic_pointer_cast<T>(std::move(msg)));
@@ -369,7 +500,8 @@ class MessageQueue : public std::enable_shared_from_this<MessageQueue> {
         }
         std::vector<std::shared_ptr<T>> messages;
         hasTimedout = !queue.waitAndConsumeAll(
-            [&messages](std::shared_ptr<ADatatype>& msg) {
+            [this, &messages](std::shared_ptr<ADatatype>& msg) {
+                recordDequeue(msg);
                 // dynamic pointer cast may return nullptr
                 // in which case that message in vector will be nullptr
                 messages.push_back(std::dynamic_pointer_cast<T>(std::move(msg)));
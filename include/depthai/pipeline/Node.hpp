@@ -1,6 +1,8 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <set>
@@ -130,7 +132,32 @@ class Node : public std::enable_shared_from_this<Node> {
         Type type = Type::MSender;  // Slave sender not supported yet
         OutputDescription desc;
 
+        // Statistics counters, copies of an output start from zero
+        struct Counters {
+            std::atomic<std::uint64_t> messages{0};
+            std::atomic<std::uint64_t> processedMessages{0};
+            std::atomic<std::int64_t> processingTimeNs{0};
+            Counters() = default;
+            Counters(const Counters&) {}
+            Counters& operator=(const Counters&) {
+                return *this;
+            }
+        } counters;
+
+        void recordSend(const std::shared_ptr<ADatatype>& msg);
+
        public:
+        /// Output statistics
+        struct Stats {
+            /// Number of messages sent
+            std::uint64_t messages = 0;
+            /// Number of sent messages with a measured processing time
+            std::uint64_t processedMessages = 0;
+            /// Total time between the node dequeuing an input and sending a message, on the same thread.
+            /// Only measured while MetricsRegistry is enabled.
+            std::chrono::nanoseconds processingTime{0};
+        };
+
         // std::vector<Capability> possibleCapabilities;
 
         Output(Node& par, OutputDescription desc, bool ref = true) : parent(par), desc(std::move(desc)) {
@@ -153,6 +180,11 @@ class Node : public std::enable_shared_from_this<Node> {
         /// Output to string representation
         std::string toString() const;
 
+        /**
+         * Get output statistics
+         */
+        Stats getStats() const;
+
         /**
          * Get name of the output
          */
@@ -341,6 +373,10 @@ class Node : public std::enable_shared_from_this<Node> {
         std::string group;
         Type type = Type::SReceiver;
 
+       protected:
+        std::int64_t getParentNodeId() const override;
+        std::string getParentNodeName() const override;
+
        public:
         std::vector<DatatypeHierarchy> possibleDatatypes;
         explicit Input(Node& par, InputDescription desc, bool ref = true)
@@ -118,6 +118,10 @@ class PipelineImpl : public std::enable_shared_from_this<PipelineImpl> {
     // Output queues
     std::vector<std::shared_ptr<MessageQueue>> outputQueues;
 
+    // Metrics collector, registered while the pipeline is running
+    MetricsRegistry::CollectorId metricsCollectorId = -1;
+    void collectMetrics(MetricsRegistry::Writer& writer) const;
+
     // parent
     Pipeline& parent;
 
@@ -2,6 +2,7 @@
 #include <memory>
 #include <vector>
 
+#include "depthai/pipeline/MessageLineage.hpp"
 #include "depthai/pipeline/datatype/DatatypeEnum.hpp"
 #include "depthai/utility/Memory.hpp"
 #include "depthai/utility/Serialization.hpp"
@@ -29,6 +30,17 @@ class ADatatype {
     };
 
     std::shared_ptr<Memory> data;
+
+    /// Host side lineage of the message, only recorded when enabled with MessageLineage::setEnabled
+    MessageLineagePtr lineage;
+
+    /**
+     * Get recorded lineage of the message
+     * @returns Lineage or nullptr if lineage recording is disabled
+     */
+    std::shared_ptr<MessageLineage> getLineage() const {
+        return lineage.get();
+    }
 };
 
 }  // namespace dai
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "depthai/common/LatencyHistogram.hpp"
 #include "depthai/pipeline/datatype/Buffer.hpp"
 namespace dai {
 
@@ -18,12 +19,29 @@ class BenchmarkReport : public Buffer {
     // Only filled if measureIndividualLatencies is set to true
     std::vector<float> latencies;
 
+    // Distribution of latencies of all messages in the report
+    LatencyHistogram latencyHistogram;
+    // Distribution of times between consecutive messages
+    LatencyHistogram interArrivalHistogram;
+    float jitter = 0.0f;  // seconds, mean absolute difference between latencies of consecutive messages
+
     void serialize(std::vector<std::uint8_t>& metadata, DatatypeEnum& datatype) const override {
         metadata = utility::serialize(*this);
         datatype = DatatypeEnum::BenchmarkReport;
     };
 
-    DEPTHAI_SERIALIZE(BenchmarkReport, Buffer::sequenceNum, Buffer::ts, Buffer::tsDevice, fps, timeTotal, numMessagesReceived, averageLatency, latencies);
+    DEPTHAI_SERIALIZE(BenchmarkReport,
+                      Buffer::sequenceNum,
+                      Buffer::ts,
+                      Buffer::tsDevice,
+                      fps,
+                      timeTotal,
+                      numMessagesReceived,
+                      averageLatency,
+                      latencies,
+                      latencyHistogram,
+                      interArrivalHistogram,
+                      jitter);
 };
 
 }  // namespace dai
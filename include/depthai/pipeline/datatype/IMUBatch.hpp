@@ -0,0 +1,136 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "depthai/pipeline/datatype/Buffer.hpp"
+#include "depthai/pipeline/datatype/IMUData.hpp"
+#include "depthai/utility/span.hpp"
+
+namespace dai {
+
+/**
+ * IMUBatch message. Carries the packets of IMUData messages in a compact columnar layout.
+ *
+ * Only the reports of enabled sensors are stored, each one as columns in the data buffer: timestamp offsets, device timestamp offsets,
+ * sequence numbers, values and accuracies. Timestamp offsets are in nanoseconds from the base timestamps of the batch.
+ * All columns are accessible as spans over the data, without copies.
+ */
+class IMUBatch : public Buffer {
+   public:
+    /**
+     * Reports of an IMUPacket, in the order their columns are stored
+     */
+    enum class Report : std::uint8_t { ACCELEROMETER, GYROSCOPE, MAGNETIC_FIELD, ROTATION_VECTOR };
+
+    /**
+     * Timestamp offset of reports without timestamps, of sensors that were enabled for only part of the batch
+     */
+    static constexpr std::uint32_t NO_TIMESTAMP = 0xFFFFFFFF;
+
+    /**
+     * Maximum time between the reports of a batch, on each of the clocks
+     */
+    static constexpr std::chrono::nanoseconds MAX_TIME_SPAN{NO_TIMESTAMP - 1};
+
+    IMUBatch() = default;
+
+    /**
+     * Construct IMUBatch message from the packets and metadata of an IMUData message
+     * @throws std::invalid_argument if its reports lie further apart than MAX_TIME_SPAN
+     */
+    explicit IMUBatch(const IMUData& imuData);
+    virtual ~IMUBatch() = default;
+
+    /**
+     * Store packets, a report is stored if it has timestamps in any of them
+     * @throws std::invalid_argument if the reports lie further apart than MAX_TIME_SPAN
+     */
+    void setPackets(span<const IMUPacket> packets);
+
+    /**
+     * Retrieves the stored packets, reports that aren't stored are left default
+     */
+    std::vector<IMUPacket> getPackets() const;
+
+    /**
+     * Converts to an IMUData message with the same packets and metadata
+     */
+    std::shared_ptr<IMUData> toIMUData() const;
+
+    /**
+     * Retrieves the number of packets
+     */
+    std::size_t getNumPackets() const;
+
+    /**
+     * Whether the columns of a report are stored
+     */
+    bool hasReport(Report report) const;
+
+    /**
+     * Number of values of each report, 3 for vectors and 5 for the rotation vector (i, j, k, real, rotationVectorAccuracy)
+     */
+    static std::size_t getNumComponents(Report report);
+
+    /**
+     * Retrieves the base of report timestamps, related to dai::Clock::now()
+     */
+    std::chrono::time_point<std::chrono::steady_clock, std::chrono::steady_clock::duration> getBaseTimestamp() const;
+
+    /**
+     * Retrieves the base of report device timestamps, captured from device's monotonic clock
+     */
+    std::chrono::time_point<std::chrono::steady_clock, std::chrono::steady_clock::duration> getBaseTimestampDevice() const;
+
+    /**
+     * Retrieves the timestamps of a report, as nanoseconds from the base timestamp, or NO_TIMESTAMP
+     * @returns One offset per packet, empty if the report isn't stored
+     */
+    span<const std::uint32_t> getTimestampOffsets(Report report) const;
+
+    /**
+     * Retrieves the device timestamps of a report, as nanoseconds from the base device timestamp, or NO_TIMESTAMP
+     * @returns One offset per packet, empty if the report isn't stored
+     */
+    span<const std::uint32_t> getTimestampDeviceOffsets(Report report) const;
+
+    /**
+     * Retrieves the sequence numbers of a report
+     * @returns One sequence number per packet, empty if the report isn't stored
+     */
+    span<const std::int32_t> getSequenceNums(Report report) const;
+
+    /**
+     * Retrieves the values of a report, getNumComponents(report) consecutive values per packet
+     * @returns Values of all packets, empty if the report isn't stored
+     */
+    span<const float> getValues(Report report) const;
+
+    /**
+     * Retrieves the accuracies of a report
+     * @returns One accuracy per packet, empty if the report isn't stored
+     */
+    span<const IMUReport::Accuracy> getAccuracies(Report report) const;
+
+    void serialize(std::vector<std::uint8_t>& metadata, DatatypeEnum& datatype) const override {
+        metadata = utility::serialize(*this);
+        datatype = DatatypeEnum::IMUBatch;
+    };
+
+    DEPTHAI_SERIALIZE(IMUBatch, Buffer::ts, Buffer::tsDevice, Buffer::sequenceNum, numPackets, reports, baseTimestamp, baseTimestampDevice);
+
+   private:
+    enum class Column { TIMESTAMP, TIMESTAMP_DEVICE, SEQUENCE, VALUES, ACCURACY };
+    const std::uint8_t* getColumn(Report report, Column column) const;
+
+    std::uint32_t numPackets = 0;
+    // Bit mask of stored reports
+    std::uint8_t reports = 0;
+    Timestamp baseTimestamp = {};
+    Timestamp baseTimestampDevice = {};
+};
+
+}  // namespace dai
@@ -1,11 +1,15 @@
 #pragma once
 
+#include <cstddef>
+#include <string>
 #include <vector>
 
 #include "depthai/common/ImgTransformations.hpp"
 #include "depthai/common/optional.hpp"
 #include "depthai/pipeline/datatype/Buffer.hpp"
+#include "depthai/utility/DerivedCache.hpp"
 #include "depthai/utility/ProtoSerializable.hpp"
+#include "depthai/utility/span.hpp"
 
 namespace dai {
 
@@ -21,6 +25,59 @@ struct ImgDetection {
 
 DEPTHAI_SERIALIZE_EXT(ImgDetection, label, labelName, confidence, xmin, ymin, xmax, ymax);
 
+/**
+ * Detections stored as arrays, with the values of all detections contiguous, for bulk processing and serialization.
+ * Arrays of numbers are serialized without the per element structure of vectors of structs.
+ */
+struct ImgDetectionArrays {
+    /// xmin, ymin, xmax and ymax of each detection
+    std::vector<float> boxes;
+    std::vector<float> confidences;
+    std::vector<std::uint32_t> labels;
+    /// Label name of each detection, empty if none of the detections has one
+    std::vector<std::string> labelNames;
+
+    ImgDetectionArrays() = default;
+    explicit ImgDetectionArrays(span<const ImgDetection> detections);
+
+    /**
+     * Retrieves the number of detections
+     */
+    std::size_t size() const;
+    bool empty() const;
+    void reserve(std::size_t size);
+    void clear();
+
+    /**
+     * Append a detection
+     */
+    void add(const ImgDetection& detection);
+
+    /**
+     * Retrieves a detection
+     * @throws std::out_of_range if index is out of range
+     */
+    ImgDetection get(std::size_t index) const;
+
+    /**
+     * Converts to a vector of detections
+     * @throws std::invalid_argument if the lengths of the arrays don't match
+     */
+    std::vector<ImgDetection> toDetections() const;
+
+    /**
+     * Checks whether the detection at index equals the given one
+     */
+    bool matches(std::size_t index, const ImgDetection& detection) const;
+
+    /**
+     * Checks whether the arrays hold exactly the given detections
+     */
+    bool matches(span<const ImgDetection> detections) const;
+};
+
+DEPTHAI_SERIALIZE_EXT(ImgDetectionArrays, boxes, confidences, labels, labelNames);
+
 /**
  * ImgDetections message. Carries normalized detection results
  */
@@ -36,6 +93,18 @@ class ImgDetections : public Buffer, public ProtoSerializable {
     std::vector<ImgDetection> detections;
     std::optional<ImgTransformation> transformation;
 
+    /**
+     * Retrieves the detections stored as arrays.
+     * The arrays are built on first use and kept while the detections don't change, so later calls only compare them.
+     */
+    const ImgDetectionArrays& getArrays() const;
+
+    /**
+     * Replaces the detections with the ones stored in arrays
+     * @throws std::invalid_argument if the lengths of the arrays don't match
+     */
+    void setArrays(const ImgDetectionArrays& arrays);
+
     void serialize(std::vector<std::uint8_t>& metadata, DatatypeEnum& datatype) const override {
         metadata = utility::serialize(*this);
         datatype = DatatypeEnum::ImgDetections;
@@ -58,6 +127,9 @@ class ImgDetections : public Buffer, public ProtoSerializable {
 #endif
 
     DEPTHAI_SERIALIZE(ImgDetections, Buffer::sequenceNum, Buffer::ts, Buffer::tsDevice, detections, transformation);
+
+   private:
+    DerivedCache<ImgDetectionArrays> arraysCache;
 };
 
 }  // namespace dai
@@ -1,26 +1,70 @@
 #pragma once
 
 // standard
+#include <cstdint>
+#include <deque>
 #include <memory>
+#include <utility>
 
 // libraries
 #include <XLink/XLinkPublicDefines.h>
 
 // project
+#include "depthai/common/ImgTransformations.hpp"
 #include "depthai/pipeline/datatype/ADatatype.hpp"
 #include "depthai/xlink/XLinkStream.hpp"
 
 // StreamPacket structure ->  || imgframepixels... , serialized_object, object_type, serialized_object_size ||
 // object_type -> DataType(int), serialized_object_size -> int
+// object_type of an ImgFrame with an interned transformation has 0x40000000 set, serialized_object being an InternedImgFrame (see TransformationCache)
 
 namespace dai {
 class StreamMessageParser {
    public:
+    /**
+     * Interned ImgTransformations of a stream. An ImgFrame sends its transformation once, along with an id,
+     * and later frames with the same transformation reference only the id.
+     * The sender and the receiver of a stream each keep one, reset whenever the stream is reopened.
+     * Interned packets are flagged with 0x40000000 in their object type, a format only parsers with a cache understand.
+     * XLinkInHost resolves interned streams. Host to device streams stay plain until device firmware parses the flag,
+     * so XLinkOutHost doesn't intern.
+     */
+    class TransformationCache {
+       public:
+        /// Number of transformations kept, so that streams alternating between a few sources don't resend them
+        static constexpr std::uint32_t CAPACITY = 8;
+
+        void reset();
+
+       private:
+        friend class StreamMessageParser;
+
+        // Returns the id of the transformation and whether it was newly added
+        std::pair<std::uint32_t, bool> intern(const ImgTransformation& transformation);
+        const ImgTransformation* find(std::uint32_t id) const;
+        void insert(std::uint32_t id, const ImgTransformation& transformation);
+
+        std::uint32_t lastId = 0;
+        // Oldest first
+        std::deque<std::pair<std::uint32_t, ImgTransformation>> entries;
+    };
+
     static std::shared_ptr<ADatatype> parseMessage(StreamPacketDesc packet);
     static std::shared_ptr<ADatatype> parseMessage(streamPacketDesc_t* const packet);
+    /**
+     * Parses a message of a stream, resolving interned transformations through the cache of the stream
+     */
+    static std::shared_ptr<ADatatype> parseMessage(StreamPacketDesc packet, TransformationCache& cache);
+    static std::shared_ptr<ADatatype> parseMessage(streamPacketDesc_t* const packet, TransformationCache& cache);
     // static std::vector<std::uint8_t> serializeMessage(const std::shared_ptr<const ADatatype>& data);
     // static std::vector<std::uint8_t> serializeMessage(const ADatatype& data);
     static std::vector<std::uint8_t> serializeMetadata(const std::shared_ptr<const ADatatype>& data);
     static std::vector<std::uint8_t> serializeMetadata(const ADatatype& data);
+    /**
+     * Serializes a message of a stream, ImgFrame transformations are interned in the cache of the stream.
+     * The receiving end has to parse the stream with its own cache.
+     */
+    static std::vector<std::uint8_t> serializeMetadata(const std::shared_ptr<const ADatatype>& data, TransformationCache& cache);
+    static std::vector<std::uint8_t> serializeMetadata(const ADatatype& data, TransformationCache& cache);
 };
 }  // namespace dai
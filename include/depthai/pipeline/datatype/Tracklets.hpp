@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <ostream>
 #include <vector>
 
@@ -8,6 +10,7 @@
 #include "depthai/common/optional.hpp"
 #include "depthai/pipeline/datatype/Buffer.hpp"
 #include "depthai/pipeline/datatype/ImgDetections.hpp"
+#include "depthai/utility/DerivedCache.hpp"
 
 namespace dai {
 
@@ -56,6 +59,62 @@ struct Tracklet {
     DEPTHAI_SERIALIZE(Tracklet, roi, id, label, age, status, srcImgDetection, spatialCoordinates);
 };
 
+/**
+ * Tracklets stored as arrays in the manner of ImgDetectionArrays, the detections they track included.
+ */
+struct TrackletArrays {
+    /// Flags of roiFlags
+    static constexpr std::uint8_t ROI_NORMALIZED = 1;
+    static constexpr std::uint8_t ROI_HAS_NORMALIZED = 2;
+
+    /// x, y, width and height of the region of interest of each tracklet
+    std::vector<float> rois;
+    /// Whether the region of interest of each tracklet is normalized, as ROI_NORMALIZED and ROI_HAS_NORMALIZED flags
+    std::vector<std::uint8_t> roiFlags;
+    std::vector<std::int32_t> ids;
+    std::vector<std::int32_t> labels;
+    std::vector<std::int32_t> ages;
+    std::vector<Tracklet::TrackingStatus> statuses;
+    /// x, y and z of each tracklet
+    std::vector<float> spatialCoordinates;
+    ImgDetectionArrays srcImgDetections;
+
+    TrackletArrays() = default;
+    explicit TrackletArrays(span<const Tracklet> tracklets);
+
+    /**
+     * Retrieves the number of tracklets
+     */
+    std::size_t size() const;
+    bool empty() const;
+    void reserve(std::size_t size);
+    void clear();
+
+    /**
+     * Append a tracklet
+     */
+    void add(const Tracklet& tracklet);
+
+    /**
+     * Retrieves a tracklet
+     * @throws std::out_of_range if index is out of range
+     */
+    Tracklet get(std::size_t index) const;
+
+    /**
+     * Converts to a vector of tracklets
+     * @throws std::invalid_argument if the lengths of the arrays don't match
+     */
+    std::vector<Tracklet> toTracklets() const;
+
+    /**
+     * Checks whether the arrays hold exactly the given tracklets
+     */
+    bool matches(span<const Tracklet> tracklets) const;
+};
+
+DEPTHAI_SERIALIZE_EXT(TrackletArrays, rois, roiFlags, ids, labels, ages, statuses, spatialCoordinates, srcImgDetections);
+
 /**
  * Tracklets message. Carries object tracking information.
  */
@@ -74,12 +133,27 @@ class Tracklets : public Buffer {
     std::vector<Tracklet> tracklets;
     ImgTransformation transformation;
 
+    /**
+     * Retrieves the tracklets stored as arrays.
+     * The arrays are built on first use and kept while the tracklets don't change, so later calls only compare them.
+     */
+    const TrackletArrays& getArrays() const;
+
+    /**
+     * Replaces the tracklets with the ones stored in arrays
+     * @throws std::invalid_argument if the lengths of the arrays don't match
+     */
+    void setArrays(const TrackletArrays& arrays);
+
     void serialize(std::vector<std::uint8_t>& metadata, DatatypeEnum& datatype) const override {
         metadata = utility::serialize(*this);
         datatype = DatatypeEnum::Tracklets;
     };
 
     DEPTHAI_SERIALIZE(Tracklets, tracklets, transformation, Buffer::ts, Buffer::tsDevice, Buffer::sequenceNum);
+
+   private:
+    DerivedCache<TrackletArrays> arraysCache;
 };
 
 }  // namespace dai
@@ -5,6 +5,7 @@
 // shared
 #include <depthai/properties/AprilTagProperties.hpp>
 
+#include "depthai/common/Rect.hpp"
 #include "depthai/pipeline/datatype/AprilTagConfig.hpp"
 
 namespace dai {
@@ -16,6 +17,7 @@ namespace node {
 class AprilTag : public DeviceNodeCRTP<DeviceNode, AprilTag, AprilTagProperties>, public HostRunnable {
    private:
     bool runOnHostVar = false;
+    Rect roi;
 
    public:
     constexpr static const char* NAME = "AprilTag";
@@ -84,6 +86,19 @@ class AprilTag : public DeviceNodeCRTP<DeviceNode, AprilTag, AprilTagProperties>
      */
     int getNumThreads() const;
 
+    /**
+     * Restrict detection to a region of the input frames. Only applies when running on host.
+     * Corners of detected tags stay relative to the whole frame.
+     * @param roi Region in pixels or normalized coordinates, an empty one (default) for the whole frame
+     */
+    void setRoi(const Rect& roi);
+
+    /**
+     * Get the region of the input frames detection is restricted to.
+     * @return Region, empty for the whole frame
+     */
+    Rect getRoi() const;
+
     /**
      * Specify whether to run on host or device
      * By default, the node will run on device.
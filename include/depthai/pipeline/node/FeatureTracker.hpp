@@ -17,7 +17,10 @@ namespace node {
  * @brief FeatureTracker node.
  * Performs feature tracking and reidentification using motion estimation between 2 consecutive frames.
  */
-class FeatureTracker : public DeviceNodeCRTP<DeviceNode, FeatureTracker, FeatureTrackerProperties> {
+class FeatureTracker : public DeviceNodeCRTP<DeviceNode, FeatureTracker, FeatureTrackerProperties>, public HostRunnable {
+   private:
+    bool runOnHostVar = false;
+
    public:
     constexpr static const char* NAME = "FeatureTracker";
     using DeviceNodeCRTP::DeviceNodeCRTP;
@@ -64,6 +67,21 @@ class FeatureTracker : public DeviceNodeCRTP<DeviceNode, FeatureTracker, Feature
      * @param numMemorySlices Number of memory slices. Maximum 2.
      */
     void setHardwareResources(int numShaves, int numMemorySlices);
+
+    /**
+     * Specify whether to run on host or device
+     * By default, the node will run on device.
+     * On host, only frames with an 8 bit luma plane (GRAY8, RAW8, YUV400p, NV12, YUV420p) are supported
+     * and optical flow is used for either motion estimator type.
+     */
+    void setRunOnHost(bool runOnHost);
+
+    /**
+     * Check if the node is set to run on host
+     */
+    bool runOnHost() const override;
+
+    void run() override;
 };
 
 }  // namespace node
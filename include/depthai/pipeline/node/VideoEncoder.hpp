@@ -11,7 +11,10 @@ namespace node {
 /**
  * @brief VideoEncoder node. Encodes frames into MJPEG, H264 or H265.
  */
-class VideoEncoder : public DeviceNodeCRTP<DeviceNode, VideoEncoder, VideoEncoderProperties> {
+class VideoEncoder : public DeviceNodeCRTP<DeviceNode, VideoEncoder, VideoEncoderProperties>, public HostRunnable {
+   private:
+    bool runOnHostVar = false;
+
    public:
     constexpr static const char* NAME = "VideoEncoder";
     using DeviceNodeCRTP::DeviceNodeCRTP;
@@ -126,6 +129,21 @@ class VideoEncoder : public DeviceNodeCRTP<DeviceNode, VideoEncoder, VideoEncode
     /// Get lossless mode. Applies only when using [M]JPEG profile.
     bool getLossless() const;
     int getMaxOutputFrameSize() const;
+
+    /**
+     * Specify whether to run on host or device
+     * By default, the node will run on device.
+     * On host, only the MJPEG profile is supported, for NV12 and 8 bit grayscale frames.
+     * Lossless mode isn't supported on host.
+     */
+    void setRunOnHost(bool runOnHost);
+
+    /**
+     * Check if the node is set to run on host
+     */
+    bool runOnHost() const override;
+
+    void run() override;
 };
 
 }  // namespace node
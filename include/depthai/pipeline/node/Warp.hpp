@@ -13,13 +13,17 @@ namespace node {
 /**
  * @brief Warp node. Capability to crop, resize, warp, ... incoming image frames
  */
-class Warp : public DeviceNodeCRTP<DeviceNode, Warp, WarpProperties> {
+class Warp : public DeviceNodeCRTP<DeviceNode, Warp, WarpProperties>, public HostRunnable {
+   private:
+    bool runOnHostVar = false;
+
    public:
     constexpr static const char* NAME = "Warp";
     using DeviceNodeCRTP::DeviceNodeCRTP;
 
    private:
     void setWarpMesh(const float* meshData, int numMeshPoints, int width, int height);
+    std::vector<Point2f> getWarpMesh() const;
 
    public:
     /**
@@ -77,6 +81,21 @@ class Warp : public DeviceNodeCRTP<DeviceNode, Warp, WarpProperties> {
     void setInterpolation(dai::Interpolation interpolation);
     /// Retrieve which interpolation method to use
     dai::Interpolation getInterpolation() const;
+
+    /**
+     * Specify whether to run on host or device
+     * By default, the node will run on device.
+     * On host, GRAY8, RAW8, YUV400p, NV12, RGB888p, BGR888p, RGB888i and BGR888i frames are supported
+     * and BICUBIC interpolation falls back to bilinear.
+     */
+    void setRunOnHost(bool runOnHost);
+
+    /**
+     * Check if the node is set to run on host
+     */
+    bool runOnHost() const override;
+
+    void run() override;
 };
 
 }  // namespace node
@@ -1,18 +1,52 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <depthai/pipeline/ThreadedHostNode.hpp>
 #include <depthai/pipeline/datatype/ImgFrame.hpp>
 
 namespace dai {
 namespace node {
+
+/**
+ * @brief Display node. Shows frames in a window, overlaid with the FPS and latency, or composites them into output frames in headless mode.
+ *
+ * Frames are rendered on a separate thread. A frame arriving while the previous one is still being rendered replaces
+ * the frame waiting to be rendered, which is counted as dropped, so a slow window system doesn't hold up the pipeline.
+ */
 class Display : public dai::NodeCRTP<ThreadedHostNode, Display> {
    private:
     std::string name;
+    bool headless = false;
+    std::atomic<uint64_t> renderedFrames{0};
+    std::atomic<uint64_t> droppedFrames{0};
 
    public:
     explicit Display(std::string name = "Display");
     Input input{*this, {}};
+
+    /**
+     * Outputs composited frames in headless mode
+     */
+    Output out{*this, {"out", DEFAULT_GROUP, {{{DatatypeEnum::ImgFrame, false}}}}};
+
+    /**
+     * Composite frames into the output instead of showing them in a window, so no display is needed. False by default.
+     */
+    Display& setHeadless(bool headless);
+    bool isHeadless() const;
+
+    /**
+     * Number of frames rendered so far
+     */
+    uint64_t getRenderedFrames() const;
+
+    /**
+     * Number of frames replaced by newer ones before they were rendered
+     */
+    uint64_t getDroppedFrames() const;
+
     void run() override;
 };
 }  // namespace node
-}  // namespace dai
\ No newline at end of file
+}  // namespace dai
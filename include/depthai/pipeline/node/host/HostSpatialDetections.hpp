@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "depthai/pipeline/Subnode.hpp"
+#include "depthai/pipeline/ThreadedHostNode.hpp"
+#include "depthai/pipeline/datatype/ImgDetections.hpp"
+#include "depthai/pipeline/datatype/ImgFrame.hpp"
+#include "depthai/pipeline/datatype/SpatialImgDetections.hpp"
+#include "depthai/pipeline/datatype/SpatialLocationCalculatorConfig.hpp"
+#include "depthai/pipeline/node/Sync.hpp"
+
+namespace dai {
+namespace node {
+
+/**
+ * @brief HostSpatialDetections node. Computes the spatial coordinates of ImgDetections from a depth frame on host,
+ * the way SpatialDetectionNetwork does on device.
+ *
+ * Boxes are remapped into the depth frame through the ImgTransformations of both messages, scaled around their center
+ * and reduced to a depth with the calculation algorithm. X and Y follow from the intrinsics of the depth frame.
+ * Depth frames are RAW16 in depth units (millimeter by default), as StereoDepth outputs them.
+ */
+class HostSpatialDetections : public NodeCRTP<ThreadedHostNode, HostSpatialDetections> {
+   public:
+    constexpr static const char* NAME = "HostSpatialDetections";
+
+    Subnode<node::Sync> sync{*this, "sync"};
+    InputMap& inputs = sync->inputs;
+
+    std::string detectionsInputName = "detections";
+    std::string depthInputName = "depth";
+    /**
+     * Input for ImgDetections messages
+     */
+    Input& inputDetections = inputs[detectionsInputName];
+    /**
+     * Input for depth frames, synced with the detections by timestamp
+     */
+    Input& inputDepth = inputs[depthInputName];
+
+    /**
+     * Outputs SpatialImgDetections messages, with the metadata and transformation of the detections
+     */
+    Output out{*this, {"out", DEFAULT_GROUP, {{{DatatypeEnum::SpatialImgDetections, false}}}}};
+
+    /**
+     * Specifies scale factor for bounding boxes of the detections.
+     * @param scaleFactor Scale factor must be in the interval (0,1].
+     * @throws std::invalid_argument if out of the interval
+     */
+    HostSpatialDetections& setBoundingBoxScaleFactor(float scaleFactor);
+
+    /**
+     * Specifies lower threshold in depth units for depth values which will used to calculate spatial data
+     */
+    HostSpatialDetections& setDepthLowerThreshold(uint32_t lowerThreshold);
+
+    /**
+     * Specifies upper threshold in depth units for depth values which will used to calculate spatial data
+     */
+    HostSpatialDetections& setDepthUpperThreshold(uint32_t upperThreshold);
+
+    /**
+     * Specifies spatial location calculator algorithm: Average/Min/Max/Mode/Median
+     */
+    HostSpatialDetections& setSpatialCalculationAlgorithm(SpatialLocationCalculatorAlgorithm calculationAlgorithm);
+
+    /**
+     * Specifies step size for depth calculation, 1 takes every pixel into calculation, 2 every second etc.
+     * @param stepSize Step size, or SpatialLocationCalculatorConfigData::AUTO for 1 with AVERAGE, MIN, MAX and 2 with MODE, MEDIAN
+     * @throws std::invalid_argument if smaller than 1 and not AUTO
+     */
+    HostSpatialDetections& setSpatialCalculationStepSize(int stepSize);
+
+    float getBoundingBoxScaleFactor() const;
+    uint32_t getDepthLowerThreshold() const;
+    uint32_t getDepthUpperThreshold() const;
+    SpatialLocationCalculatorAlgorithm getSpatialCalculationAlgorithm() const;
+    int getSpatialCalculationStepSize() const;
+
+    void buildInternal() override;
+    void run() override;
+
+   private:
+    Input inSync{*this, {"inSync", DEFAULT_GROUP, DEFAULT_BLOCKING, DEFAULT_QUEUE_SIZE, {{{DatatypeEnum::MessageGroup, true}}}, DEFAULT_WAIT_FOR_MESSAGE}};
+
+    float scaleFactor = 1.0f;
+    SpatialLocationCalculatorConfigThresholds depthThresholds;
+    SpatialLocationCalculatorAlgorithm calculationAlgorithm = SpatialLocationCalculatorAlgorithm::MEDIAN;
+    int stepSize = SpatialLocationCalculatorConfigData::AUTO;
+};
+
+}  // namespace node
+}  // namespace dai
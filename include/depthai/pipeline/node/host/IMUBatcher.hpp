@@ -0,0 +1,55 @@
+#pragma once
+
+#include <chrono>
+
+#include "depthai/pipeline/ThreadedHostNode.hpp"
+#include "depthai/pipeline/datatype/IMUBatch.hpp"
+#include "depthai/pipeline/datatype/IMUData.hpp"
+
+namespace dai {
+namespace node {
+
+/**
+ * @brief IMUBatcher node. Collects the packets of IMUData messages into compact IMUBatch messages on host.
+ *
+ * A batch is sent once it holds the batch size of packets, or once its first packet has waited for the maximum latency.
+ * Batches carry the metadata of the last IMUData message they hold packets of.
+ */
+class IMUBatcher : public NodeCRTP<ThreadedHostNode, IMUBatcher> {
+   public:
+    constexpr static const char* NAME = "IMUBatcher";
+
+    /**
+     * Input for IMUData messages to be batched
+     */
+    Input input{*this, {"input", DEFAULT_GROUP, DEFAULT_BLOCKING, DEFAULT_QUEUE_SIZE, {{{DatatypeEnum::IMUData, false}}}, DEFAULT_WAIT_FOR_MESSAGE}};
+
+    /**
+     * Outputs IMUBatch messages
+     */
+    Output out{*this, {"out", DEFAULT_GROUP, {{{DatatypeEnum::IMUBatch, false}}}}};
+
+    /**
+     * Set the number of packets in a batch
+     * @throws std::invalid_argument if smaller than 1
+     */
+    IMUBatcher& setBatchSize(int batchSize);
+
+    /**
+     * Set how long the first packet of a batch waits for the batch to fill up, zero to wait until it is full
+     * @throws std::invalid_argument if negative
+     */
+    IMUBatcher& setMaxLatency(std::chrono::milliseconds maxLatency);
+
+    int getBatchSize() const;
+    std::chrono::milliseconds getMaxLatency() const;
+
+    void run() override;
+
+   private:
+    int batchSize = 20;
+    std::chrono::milliseconds maxLatency{50};
+};
+
+}  // namespace node
+}  // namespace dai
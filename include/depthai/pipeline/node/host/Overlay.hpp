@@ -0,0 +1,73 @@
+#pragma once
+
+#include <memory>
+
+#include "depthai/pipeline/ThreadedHostNode.hpp"
+#include "depthai/pipeline/datatype/ImgFrame.hpp"
+
+namespace dai {
+namespace node {
+
+/**
+ * @brief Overlay node. Draws annotations into frames on host, so they can be recorded or encoded along with the image.
+ *
+ * ImgAnnotations, ImgDetections and Tracklets messages linked to the annotations inputs are drawn into each frame from input,
+ * anti-aliased and directly in its NV12, GRAY8 or BGR888i planes. The latest message received on every annotations input is drawn
+ * until it is replaced. ImgAnnotations coordinates are normalized to the frame, while detections and tracklets are remapped from
+ * their transformation to the one of the frame.
+ */
+class Overlay : public NodeCRTP<ThreadedHostNode, Overlay> {
+   public:
+    constexpr static const char* NAME = "Overlay";
+
+    /**
+     * Input for ImgFrame messages to be drawn into
+     */
+    Input input{*this, {"input", DEFAULT_GROUP, DEFAULT_BLOCKING, DEFAULT_QUEUE_SIZE, {{{DatatypeEnum::ImgFrame, false}}}, DEFAULT_WAIT_FOR_MESSAGE}};
+
+    /**
+     * Inputs for ImgAnnotations, ImgDetections or Tracklets messages, each one drawn independently of the others
+     */
+    InputMap annotations{*this,
+                         "annotations",
+                         {"",
+                          DEFAULT_GROUP,
+                          NON_BLOCKING_QUEUE,
+                          1,
+                          {{{DatatypeEnum::ImgAnnotations, false}, {DatatypeEnum::ImgDetections, false}, {DatatypeEnum::Tracklets, false}}},
+                          DEFAULT_WAIT_FOR_MESSAGE}};
+
+    /**
+     * Outputs copies of the input frames with the annotations drawn
+     */
+    Output out{*this, {"out", DEFAULT_GROUP, {{{DatatypeEnum::ImgFrame, false}}}}};
+
+    /**
+     * Set the thickness of detection and tracklet boxes in pixels
+     */
+    Overlay& setThickness(float thickness);
+
+    /**
+     * Set the size of detection and tracklet labels in pixels
+     */
+    Overlay& setFontSize(float fontSize);
+
+    /**
+     * Set the number of output buffers kept for reuse once the frames holding them are released
+     */
+    Overlay& setNumFramesPool(int numFramesPool);
+
+    float getThickness() const;
+    float getFontSize() const;
+    int getNumFramesPool() const;
+
+    void run() override;
+
+   private:
+    float thickness = 2.0f;
+    float fontSize = 16.0f;
+    int numFramesPool = 4;
+};
+
+}  // namespace node
+}  // namespace dai
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "depthai/pipeline/ThreadedHostNode.hpp"
+#include "depthai/pipeline/datatype/EncodedFrame.hpp"
+#include "depthai/pipeline/datatype/ImgFrame.hpp"
+
+namespace dai {
+namespace node {
+
+/**
+ * @brief VideoDecoder node. Decodes EncodedFrame messages into ImgFrame messages on host.
+ *
+ * Each stream, identified by the instance number of its frames, gets its own decoder.
+ * Only the MJPEG profile is decoded, H.264 and H.265 frames are dropped with a warning.
+ */
+class VideoDecoder : public NodeCRTP<ThreadedHostNode, VideoDecoder> {
+   public:
+    constexpr static const char* NAME = "VideoDecoder";
+
+    /**
+     * Input for EncodedFrame messages to be decoded
+     */
+    Input input{*this, {"input", DEFAULT_GROUP, DEFAULT_BLOCKING, DEFAULT_QUEUE_SIZE, {{{DatatypeEnum::EncodedFrame, false}}}, DEFAULT_WAIT_FOR_MESSAGE}};
+
+    /**
+     * Outputs decoded ImgFrame messages, carrying the metadata of the encoded frames
+     */
+    Output out{*this, {"out", DEFAULT_GROUP, {{{DatatypeEnum::ImgFrame, false}}}}};
+
+    /**
+     * Set the type of decoded frames, NV12 (default) or GRAY8. Chroma of grayscale streams is neutral in NV12 frames.
+     * @throws std::invalid_argument for other types
+     */
+    VideoDecoder& setOutputType(ImgFrame::Type type);
+
+    /**
+     * Set the number of output buffers kept for reuse once the decoded frames holding them are released
+     */
+    VideoDecoder& setNumFramesPool(int numFramesPool);
+
+    ImgFrame::Type getOutputType() const;
+    int getNumFramesPool() const;
+
+    void run() override;
+
+   private:
+    ImgFrame::Type outputType = ImgFrame::Type::NV12;
+    int numFramesPool = 4;
+};
+
+}  // namespace node
+}  // namespace dai
@@ -33,11 +33,15 @@
 #include "node/UVC.hpp"
 #include "node/VideoEncoder.hpp"
 #include "node/Warp.hpp"
+#include "node/host/HostSpatialDetections.hpp"
+#include "node/host/IMUBatcher.hpp"
 #include "node/host/RGBD.hpp"
+#include "node/host/VideoDecoder.hpp"
 #ifdef DEPTHAI_HAVE_OPENCV_SUPPORT
     #include "node/host/Display.hpp"
     #include "node/host/HostCamera.hpp"
     #include "node/host/HostNode.hpp"
+    #include "node/host/Overlay.hpp"
     #include "node/host/Record.hpp"
     #include "node/host/Replay.hpp"
 #endif
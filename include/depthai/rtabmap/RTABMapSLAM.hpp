@@ -1,6 +1,8 @@
 #pragma once
 
+#include <atomic>
 #include <depthai/pipeline/Subnode.hpp>
+#include <memory>
 
 #include "depthai/pipeline/DeviceNode.hpp"
 #include "depthai/pipeline/ThreadedHostNode.hpp"
@@ -75,6 +77,21 @@ class RTABMapSLAM : public dai::NodeCRTP<dai::node::ThreadedHostNode, RTABMapSLA
      * Output occupancy grid map.
      */
     Output occupancyGridMap{*this, {"occupancyGridMap", DEFAULT_GROUP, {{{dai::DatatypeEnum::ImgFrame, true}}}}};
+    /**
+     * Output obstacle voxels changed since the previous obstacle cloud, when publishing incrementally.
+     * Each added voxel is one of its points, each removed voxel is the point it was added with, with an alpha of 0.
+     */
+    Output obstaclePCLUpdate{*this, {"obstaclePCLUpdate", DEFAULT_GROUP, {{{dai::DatatypeEnum::PointCloudData, true}}}}};
+    /**
+     * Output ground voxels changed since the previous ground cloud, when publishing incrementally, as for obstaclePCLUpdate.
+     */
+    Output groundPCLUpdate{*this, {"groundPCLUpdate", DEFAULT_GROUP, {{{dai::DatatypeEnum::PointCloudData, true}}}}};
+    /**
+     * Output tiles of the occupancy grid map changed since the previous map, when publishing incrementally.
+     * Tiles are aligned to a fixed grid in the world. The transformation of a tile maps it into the latest full map,
+     * tiles outside of it extend the map as it grew.
+     */
+    Output occupancyGridMapUpdate{*this, {"occupancyGridMapUpdate", DEFAULT_GROUP, {{{dai::DatatypeEnum::ImgFrame, true}}}}};
 
     /**
      * Output passthrough rectified image.
@@ -150,6 +167,33 @@ class RTABMapSLAM : public dai::NodeCRTP<dai::node::ThreadedHostNode, RTABMapSLA
     void setPublishGrid(bool publish) {
         publishGrid = publish;
     }
+    /**
+     * Whether to publish only changes of the maps, on the update outputs. False by default.
+     * Full maps are still published on the map outputs periodically and whenever the map is reset or corrected by a loop closure.
+     * Full maps and their updates share sequence numbers, updates apply on top of the latest full map with a lower sequence number.
+     */
+    void setPublishIncremental(bool incremental) {
+        publishIncremental = incremental;
+    }
+    /**
+     * Set the number of map updates published between full maps, when publishing incrementally. 10 by default.
+     */
+    void setKeyframeInterval(int interval) {
+        keyframeInterval = interval;
+    }
+    /**
+     * Set the size of occupancy grid map update tiles, in cells. 64 by default.
+     */
+    void setGridTileSize(int size) {
+        gridTileSize = size;
+    }
+    /**
+     * Limit the number of points or grid cells per second published as full maps, 0 for no limit (default).
+     * Full maps are published less often as they grow, in between only updates are published when publishing incrementally.
+     */
+    void setMaxMapPublishRate(size_t pointsPerSecond) {
+        maxMapPublishRate = pointsPerSecond;
+    }
     /**
      * Set the frequency at which the node processes data. 1Hz by default.
      */
@@ -189,6 +233,11 @@ class RTABMapSLAM : public dai::NodeCRTP<dai::node::ThreadedHostNode, RTABMapSLA
     void publishGridMap(const std::map<int, rtabmap::Transform>& optimizedPoses);
     void publishPointClouds(const std::map<int, rtabmap::Transform>& optimizedPoses);
 
+    // Keeps what was published for incremental publishing
+    class MapPublisher;
+    std::shared_ptr<MapPublisher> mapPublisher;
+    std::atomic<bool> newMapTriggered{false};
+
     rtabmap::StereoCameraModel model;
     rtabmap::Rtabmap rtabmap;
     rtabmap::Transform currPose, odomCorr;
@@ -212,6 +261,10 @@ class RTABMapSLAM : public dai::NodeCRTP<dai::node::ThreadedHostNode, RTABMapSLA
     bool publishObstacleCloud = true;
     bool publishGroundCloud = true;
     bool publishGrid = true;
+    bool publishIncremental = false;
+    int keyframeInterval = 10;
+    int gridTileSize = 64;
+    size_t maxMapPublishRate = 0;
     float freq = 1.0f;
 };
 }  // namespace node
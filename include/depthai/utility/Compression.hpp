@@ -1,14 +1,140 @@
+#pragma once
+
 #include <cstdint>
 #include <filesystem>
+#include <functional>
+#include <memory>
 #include <string>
 #include <vector>
 
 namespace dai {
 namespace utility {
 
+enum class CompressionFormat : std::uint8_t {
+    /// zlib stream, as produced by zlib's compress()
+    ZLIB,
+    /// Zstandard frames
+    ZSTD
+};
+
+/**
+ * Streaming compressor. Input is pushed in chunks of any size and the compressed stream produced so far is pulled as it becomes available,
+ * so the whole input doesn't have to be held in memory.
+ *
+ * With a single thread ZLIB output is identical to the one of zlib's compress2() at the same level, whatever the chunk sizes,
+ * except for level 0 where the sizes of stored blocks follow the chunks.
+ * With more threads ZLIB input is split into blocks deflated in parallel and the output is identical to the one of deflateParallel()
+ * with the same level and block size. ZSTD uses the worker threads of the library, if it was built with them.
+ */
+class StreamCompressor {
+   public:
+    /**
+     * @param format Format of the compressed stream
+     * @param compressionLevel 0-9 for ZLIB, ZSTD_minCLevel() to ZSTD_maxCLevel() (22) for ZSTD
+     * @param numThreads Number of worker threads, 0 to use hardware concurrency
+     * @param blockSize Size of input blocks deflated in parallel, ignored for ZSTD
+     * @throws std::invalid_argument if the compression level or the block size is out of range
+     */
+    explicit StreamCompressor(CompressionFormat format = CompressionFormat::ZLIB,
+                              int compressionLevel = 6,
+                              unsigned numThreads = 1,
+                              size_t blockSize = 1024 * 1024);
+    ~StreamCompressor();
+    StreamCompressor(StreamCompressor&&) noexcept;
+    StreamCompressor& operator=(StreamCompressor&&) noexcept;
+
+    /**
+     * Compress a chunk of input. Blocks while all worker threads are busy.
+     * @throws std::logic_error if the stream was already finished
+     */
+    void push(const uint8_t* data, size_t size);
+
+    /**
+     * Compress the remaining input and end the stream
+     */
+    void finish();
+
+    /**
+     * Take the compressed data produced so far, without waiting for blocks still being compressed
+     */
+    std::vector<uint8_t> pull();
+
+    bool isFinished() const;
+
+   private:
+    class Impl;
+    std::unique_ptr<Impl> pimpl;
+};
+
+/**
+ * Streaming decompressor, the counterpart of StreamCompressor. Concatenated ZSTD frames are decompressed one after another.
+ */
+class StreamDecompressor {
+   public:
+    explicit StreamDecompressor(CompressionFormat format = CompressionFormat::ZLIB);
+    ~StreamDecompressor();
+    StreamDecompressor(StreamDecompressor&&) noexcept;
+    StreamDecompressor& operator=(StreamDecompressor&&) noexcept;
+
+    /**
+     * Decompress a chunk of the compressed stream
+     * @throws std::runtime_error if the data is corrupted or follows the end of a ZLIB stream
+     */
+    void push(const uint8_t* data, size_t size);
+
+    /**
+     * Check that the whole stream was decompressed
+     * @throws std::runtime_error if the stream is truncated
+     */
+    void finish();
+
+    /**
+     * Take the data decompressed so far
+     */
+    std::vector<uint8_t> pull();
+
+    /**
+     * Whether the pushed data ends with the end of a ZLIB stream or of a ZSTD frame
+     */
+    bool isFinished() const;
+
+   private:
+    class Impl;
+    std::unique_ptr<Impl> pimpl;
+};
+
+/**
+ * Compresses a buffer in one call, see StreamCompressor
+ */
+std::vector<uint8_t> compress(const uint8_t* data, size_t size, CompressionFormat format, int compressionLevel, unsigned numThreads = 1);
+
+/**
+ * Decompresses a whole compressed stream, see StreamDecompressor
+ * @throws std::runtime_error if the data is corrupted or truncated
+ */
+std::vector<uint8_t> decompress(const uint8_t* data, size_t size, CompressionFormat format);
+
 std::vector<uint8_t> deflate(uint8_t* data, size_t size, int compressionLevel = 6);
 std::vector<uint8_t> inflate(uint8_t* data, size_t size);
 
+/**
+ * Compresses data into a single zlib stream using multiple threads.
+ * Input is split into fixed size blocks which are deflated independently (each primed with the preceding 32KiB as dictionary)
+ * and concatenated. Output depends only on the input, compression level and block size - not on the number of threads.
+ * @param data Pointer to data to compress
+ * @param size Size of data in bytes
+ * @param callback Called in order with consecutive pieces of the compressed stream
+ * @param compressionLevel zlib compression level (0-9)
+ * @param blockSize Size of independently compressed input blocks in bytes
+ * @param numThreads Number of worker threads, 0 to use hardware concurrency
+ */
+void deflateParallel(const uint8_t* data,
+                     size_t size,
+                     const std::function<void(const uint8_t*, size_t)>& callback,
+                     int compressionLevel = 6,
+                     size_t blockSize = 1024 * 1024,
+                     unsigned numThreads = 0);
+
 /**
  * Gets a list of filenames contained within a tar archive.
  * @param tarPath Path to the tar file to read
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <mutex>
+#include <optional>
+#include <utility>
+
+namespace dai {
+
+/**
+ * Value derived from other members of a message, built on demand and kept while it still matches them.
+ * Public members can change at any time, so the kept value is checked against them before it's reused.
+ */
+template <typename T>
+class DerivedCache {
+   public:
+    DerivedCache() = default;
+    DerivedCache(const DerivedCache& other) {
+        std::lock_guard<std::mutex> lock(other.mtx);
+        value = other.value;
+    }
+    DerivedCache& operator=(const DerivedCache& other) {
+        if(this != &other) {
+            std::scoped_lock lock(mtx, other.mtx);
+            value = other.value;
+        }
+        return *this;
+    }
+
+    /**
+     * Retrieves the value, rebuilt with build() unless the kept one passes isCurrent()
+     */
+    template <typename IsCurrent, typename Build>
+    const T& get(IsCurrent&& isCurrent, Build&& build) const {
+        std::lock_guard<std::mutex> lock(mtx);
+        if(!value || !isCurrent(*value)) value = build();
+        return *value;
+    }
+
+    /**
+     * Keep a value known to match
+     */
+    void set(T newValue) {
+        std::lock_guard<std::mutex> lock(mtx);
+        value = std::move(newValue);
+    }
+
+   private:
+    mutable std::mutex mtx;
+    mutable std::optional<T> value;
+};
+
+}  // namespace dai
@@ -2596,6 +2596,9 @@ std::array<std::array<float, 2>, 4> getOuterRotatedRect(const std::vector<std::a
 
 dai::RotatedRect getRotatedRectFromPoints(const std::vector<std::array<float, 2>>& points);
 
+// Same as getRotatedRectFromPoints for the four corners of a transformed rect, without allocating
+dai::RotatedRect getRotatedRectFromCorners(const std::array<std::array<float, 2>, 4>& corners);
+
 std::array<std::array<float, 3>, 3> getResizeMat(Resize o, float width, float height, uint32_t outputWidth, uint32_t outputHeight);
 
 void getTransformImpl(const ManipOp& op,
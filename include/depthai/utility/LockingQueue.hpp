@@ -1,9 +1,11 @@
 #pragma once
+#include <chrono>
 #include <condition_variable>
+#include <cstdint>
+#include <deque>
 #include <functional>
 #include <limits>
 #include <mutex>
-#include <queue>
 
 namespace dai {
 
@@ -21,25 +23,72 @@ namespace dai {
 template <typename T>
 class LockingQueue {
    public:
+    /// Returns number of bytes an element holds
+    using SizeFunction = std::function<std::size_t(const T&)>;
+    /// Called with the change of bytes held by the queue
+    using BytesChangedFunction = std::function<void(std::int64_t)>;
+
     LockingQueue() = default;
     explicit LockingQueue(unsigned maxSize, bool blocking = true) {
         this->maxSize = maxSize;
         this->blocking = blocking;
     }
-    LockingQueue(const LockingQueue& obj) : maxSize(obj.maxSize), blocking(obj.blocking), queue(obj.queue), destructed(obj.destructed){};
-    LockingQueue(LockingQueue&& obj) noexcept : maxSize(obj.maxSize), blocking(obj.blocking), queue(std::move(obj.queue)), destructed(obj.destructed){};
+    LockingQueue(const LockingQueue& obj)
+        : maxSize(obj.maxSize),
+          maxBytes(obj.maxBytes),
+          blocking(obj.blocking),
+          queue(obj.queue),
+          elementBytes(obj.elementBytes),
+          bytes(obj.bytes),
+          sizeOf(obj.sizeOf),
+          onBytesChanged(obj.onBytesChanged),
+          destructed(obj.destructed) {
+        notifyBytesChanged(static_cast<std::int64_t>(bytes));
+    };
+    LockingQueue(LockingQueue&& obj) noexcept
+        : maxSize(obj.maxSize),
+          maxBytes(obj.maxBytes),
+          blocking(obj.blocking),
+          queue(std::move(obj.queue)),
+          elementBytes(std::move(obj.elementBytes)),
+          bytes(obj.bytes),
+          sizeOf(std::move(obj.sizeOf)),
+          onBytesChanged(std::move(obj.onBytesChanged)),
+          destructed(obj.destructed) {
+        obj.queue.clear();
+        obj.elementBytes.clear();
+        obj.bytes = 0;
+    };
     LockingQueue& operator=(const LockingQueue& obj) {
+        if(this == &obj) return *this;
+        notifyBytesChanged(-static_cast<std::int64_t>(bytes));
         maxSize = obj.maxSize;
+        maxBytes = obj.maxBytes;
         blocking = obj.blocking;
         queue = obj.queue;
+        elementBytes = obj.elementBytes;
+        bytes = obj.bytes;
+        sizeOf = obj.sizeOf;
+        onBytesChanged = obj.onBytesChanged;
         destructed = obj.destructed;
+        notifyBytesChanged(static_cast<std::int64_t>(bytes));
         return *this;
     }
     LockingQueue& operator=(LockingQueue&& obj) noexcept {
+        if(this == &obj) return *this;
+        notifyBytesChanged(-static_cast<std::int64_t>(bytes));
         maxSize = obj.maxSize;
+        maxBytes = obj.maxBytes;
         blocking = obj.blocking;
         queue = std::move(obj.queue);
+        elementBytes = std::move(obj.elementBytes);
+        bytes = obj.bytes;
+        sizeOf = std::move(obj.sizeOf);
+        onBytesChanged = std::move(obj.onBytesChanged);
         destructed = obj.destructed;
+        obj.queue.clear();
+        obj.elementBytes.clear();
+        obj.bytes = 0;
         return *this;
     }
 
@@ -49,6 +98,30 @@ class LockingQueue {
         maxSize = sz;
     }
 
+    /**
+     * Set maximum number of bytes held by elements in the queue, 0 for no limit.
+     * A single element larger than the limit is still accepted by an empty queue.
+     * Requires a size function to be set.
+     */
+    void setMaxBytes(std::size_t sz) {
+        {
+            std::unique_lock<std::mutex> lock(guard);
+            maxBytes = sz;
+        }
+        // Raising the limit can unblock waiting pushes
+        signalPop.notify_all();
+    }
+
+    /**
+     * Set function which returns number of bytes held by an element, and optionally a function
+     * notified of every change of bytes held by the queue (eg. to keep a global total)
+     */
+    void setSizeFunction(SizeFunction sizeFunction, BytesChangedFunction bytesChangedFunction = nullptr) {
+        std::unique_lock<std::mutex> lock(guard);
+        sizeOf = std::move(sizeFunction);
+        onBytesChanged = std::move(bytesChangedFunction);
+    }
+
     void setBlocking(bool bl) {
         // Lock first
         std::unique_lock<std::mutex> lock(guard);
@@ -61,16 +134,31 @@ class LockingQueue {
         return maxSize;
     }
 
+    std::size_t getMaxBytes() const {
+        // Lock first
+        std::unique_lock<std::mutex> lock(guard);
+        return maxBytes;
+    }
+
     unsigned getSize() const {
         // Lock first
         std::unique_lock<std::mutex> lock(guard);
         return queue.size();
     }
 
+    /**
+     * Number of bytes held by elements in the queue, as reported by the size function when they were pushed
+     */
+    std::size_t getBytes() const {
+        // Lock first
+        std::unique_lock<std::mutex> lock(guard);
+        return bytes;
+    }
+
     unsigned isFull() const {
         // Lock first
         std::unique_lock<std::mutex> lock(guard);
-        return queue.size() >= maxSize;
+        return queue.size() >= maxSize || (maxBytes > 0 && bytes >= maxBytes);
     }
 
     bool getBlocking() const {
@@ -92,7 +180,9 @@ class LockingQueue {
         return destructed;
     }
 
-    ~LockingQueue() = default;
+    ~LockingQueue() {
+        notifyBytesChanged(-static_cast<std::int64_t>(bytes));
+    }
 
     template <typename Rep, typename Period>
     bool waitAndConsumeAll(std::function<void(T&)> callback, std::chrono::duration<Rep, Period> timeout) {
@@ -107,7 +197,7 @@ class LockingQueue {
             // Continue here if and only if queue has any elements
             while(!queue.empty()) {
                 callback(queue.front());
-                queue.pop();
+                popFront();
             }
         }
 
@@ -125,7 +215,7 @@ class LockingQueue {
 
             while(!queue.empty()) {
                 callback(queue.front());
-                queue.pop();
+                popFront();
             }
         }
 
@@ -141,7 +231,7 @@ class LockingQueue {
 
             while(!queue.empty()) {
                 callback(queue.front());
-                queue.pop();
+                popFront();
             }
         }
 
@@ -152,25 +242,26 @@ class LockingQueue {
     bool push(T const& data) {
         {
             std::unique_lock<std::mutex> lock(guard);
+            const std::size_t dataBytes = sizeOf ? sizeOf(data) : 0;
             if(maxSize == 0) {
                 // necessary if maxSize was changed
-                while(!queue.empty()) {
-                    queue.pop();
-                }
+                droppedCount += queue.size() + 1;
+                clear();
                 return true;
             }
             if(!blocking) {
                 // if non blocking, remove as many oldest elements as necessary, so next one will fit
                 // necessary if maxSize was changed
-                while(queue.size() >= maxSize) {
-                    queue.pop();
+                while(!fits(dataBytes)) {
+                    popFront();
+                    droppedCount++;
                 }
             } else {
-                signalPop.wait(lock, [this]() { return queue.size() < maxSize || destructed; });
+                waitForSpace(lock, dataBytes);
                 if(destructed) return false;
             }
 
-            queue.push(data);
+            pushBack(data, dataBytes);
         }
         signalPush.notify_all();
         return true;
@@ -179,25 +270,26 @@ class LockingQueue {
     bool push(T&& data) {
         {
             std::unique_lock<std::mutex> lock(guard);
+            const std::size_t dataBytes = sizeOf ? sizeOf(data) : 0;
             if(maxSize == 0) {
                 // necessary if maxSize was changed
-                while(!queue.empty()) {
-                    queue.pop();
-                }
+                droppedCount += queue.size() + 1;
+                clear();
                 return true;
             }
             if(!blocking) {
                 // if non blocking, remove as many oldest elements as necessary, so next one will fit
                 // necessary if maxSize was changed
-                while(queue.size() >= maxSize) {
-                    queue.pop();
+                while(!fits(dataBytes)) {
+                    popFront();
+                    droppedCount++;
                 }
             } else {
-                signalPop.wait(lock, [this]() { return queue.size() < maxSize || destructed; });
+                waitForSpace(lock, dataBytes);
                 if(destructed) return false;
             }
 
-            queue.push(std::move(data));
+            pushBack(std::move(data), dataBytes);
         }
         signalPush.notify_all();
         return true;
@@ -207,27 +299,28 @@ class LockingQueue {
     bool tryWaitAndPush(T const& data, std::chrono::duration<Rep, Period> timeout) {
         {
             std::unique_lock<std::mutex> lock(guard);
+            const std::size_t dataBytes = sizeOf ? sizeOf(data) : 0;
             if(maxSize == 0) {
                 // necessary if maxSize was changed
-                while(!queue.empty()) {
-                    queue.pop();
-                }
+                droppedCount += queue.size() + 1;
+                clear();
                 return true;
             }
             if(!blocking) {
                 // if non blocking, remove as many oldest elements as necessary, so next one will fit
                 // necessary if maxSize was changed
-                while(queue.size() >= maxSize) {
-                    queue.pop();
+                while(!fits(dataBytes)) {
+                    popFront();
+                    droppedCount++;
                 }
             } else {
                 // First checks predicate, then waits
-                bool pred = signalPop.wait_for(lock, timeout, [this]() { return queue.size() < maxSize || destructed; });
+                bool pred = waitForSpace(lock, dataBytes, timeout);
                 if(!pred) return false;
                 if(destructed) return false;
             }
 
-            queue.push(data);
+            pushBack(data, dataBytes);
         }
         signalPush.notify_all();
         return true;
@@ -237,27 +330,28 @@ class LockingQueue {
     bool tryWaitAndPush(T&& data, std::chrono::duration<Rep, Period> timeout) {
         {
             std::unique_lock<std::mutex> lock(guard);
+            const std::size_t dataBytes = sizeOf ? sizeOf(data) : 0;
             if(maxSize == 0) {
                 // necessary if maxSize was changed
-                while(!queue.empty()) {
-                    queue.pop();
-                }
+                droppedCount += queue.size() + 1;
+                clear();
                 return true;
             }
             if(!blocking) {
                 // if non blocking, remove as many oldest elements as necessary, so next one will fit
                 // necessary if maxSize was changed
-                while(queue.size() >= maxSize) {
-                    queue.pop();
+                while(!fits(dataBytes)) {
+                    popFront();
+                    droppedCount++;
                 }
             } else {
                 // First checks predicate, then waits
-                bool pred = signalPop.wait_for(lock, timeout, [this]() { return queue.size() < maxSize || destructed; });
+                bool pred = waitForSpace(lock, dataBytes, timeout);
                 if(!pred) return false;
                 if(destructed) return false;
             }
 
-            queue.push(std::move(data));
+            pushBack(std::move(data), dataBytes);
         }
         signalPush.notify_all();
         return true;
@@ -286,7 +380,7 @@ class LockingQueue {
             }
 
             value = std::move(queue.front());
-            queue.pop();
+            popFront();
         }
         signalPop.notify_all();
         return true;
@@ -301,7 +395,7 @@ class LockingQueue {
             if(destructed) return false;
 
             value = std::move(queue.front());
-            queue.pop();
+            popFront();
         }
         signalPop.notify_all();
         return true;
@@ -318,7 +412,7 @@ class LockingQueue {
             if(destructed) return false;
 
             value = std::move(queue.front());
-            queue.pop();
+            popFront();
         }
         signalPop.notify_all();
         return true;
@@ -329,12 +423,96 @@ class LockingQueue {
         signalPop.wait(lock, [this]() { return queue.empty() || destructed; });
     }
 
+    /**
+     * Number of elements pushed into the queue
+     */
+    std::uint64_t getPushedCount() const {
+        std::lock_guard<std::mutex> lock(guard);
+        return pushedCount;
+    }
+
+    /**
+     * Number of elements dropped, because the queue was full (non blocking) or had zero size
+     */
+    std::uint64_t getDroppedCount() const {
+        std::lock_guard<std::mutex> lock(guard);
+        return droppedCount;
+    }
+
+    /**
+     * Total time pushes spent waiting for space in a full (blocking) queue
+     */
+    std::chrono::nanoseconds getBlockedTime() const {
+        std::lock_guard<std::mutex> lock(guard);
+        return blockedTime;
+    }
+
    private:
+    // Whether an element of given size can be pushed without exceeding the limits
+    bool fits(std::size_t dataBytes) const {
+        if(queue.empty()) return maxSize > 0;
+        return queue.size() < maxSize && (maxBytes == 0 || bytes + dataBytes <= maxBytes);
+    }
+
+    // Waits until there is space in the queue or it is destructed, accumulating the time spent blocked
+    void waitForSpace(std::unique_lock<std::mutex>& lock, std::size_t dataBytes) {
+        if(fits(dataBytes) || destructed) return;
+        auto start = std::chrono::steady_clock::now();
+        signalPop.wait(lock, [this, dataBytes]() { return fits(dataBytes) || destructed; });
+        blockedTime += std::chrono::steady_clock::now() - start;
+    }
+
+    template <typename Rep, typename Period>
+    bool waitForSpace(std::unique_lock<std::mutex>& lock, std::size_t dataBytes, std::chrono::duration<Rep, Period> timeout) {
+        if(fits(dataBytes) || destructed) return true;
+        auto start = std::chrono::steady_clock::now();
+        bool pred = signalPop.wait_for(lock, timeout, [this, dataBytes]() { return fits(dataBytes) || destructed; });
+        blockedTime += std::chrono::steady_clock::now() - start;
+        return pred;
+    }
+
+    template <typename U>
+    void pushBack(U&& data, std::size_t dataBytes) {
+        queue.push_back(std::forward<U>(data));
+        elementBytes.push_back(dataBytes);
+        bytes += dataBytes;
+        pushedCount++;
+        notifyBytesChanged(static_cast<std::int64_t>(dataBytes));
+    }
+
+    void popFront() {
+        const auto dataBytes = elementBytes.front();
+        queue.pop_front();
+        elementBytes.pop_front();
+        bytes -= dataBytes;
+        notifyBytesChanged(-static_cast<std::int64_t>(dataBytes));
+    }
+
+    void clear() {
+        queue.clear();
+        elementBytes.clear();
+        notifyBytesChanged(-static_cast<std::int64_t>(bytes));
+        bytes = 0;
+    }
+
+    void notifyBytesChanged(std::int64_t delta) {
+        if(delta != 0 && onBytesChanged) onBytesChanged(delta);
+    }
+
     unsigned maxSize = std::numeric_limits<unsigned>::max();
+    std::size_t maxBytes = 0;
     bool blocking = true;
-    std::queue<T> queue;
+    std::deque<T> queue;
+    // Bytes held by each element, recorded when pushed
+    std::deque<std::size_t> elementBytes;
+    std::size_t bytes = 0;
+    SizeFunction sizeOf;
+    BytesChangedFunction onBytesChanged;
     mutable std::mutex guard;
     bool destructed{false};
+    std::uint64_t pushedCount{0};
+    std::uint64_t droppedCount{0};
+    std::chrono::nanoseconds blockedTime{0};
     std::condition_variable signalPop;
     std::condition_variable signalPush;
 };
@@ -0,0 +1,143 @@
+#pragma once
+
+// std
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace dai {
+
+/**
+ * Process wide registry of pipeline and device metrics, exposed in OpenMetrics (Prometheus) text format.
+ * Metrics are gathered by collectors when scraped, so while messages flow only cheap counters are kept.
+ * Started pipelines and connected devices register their collectors automatically.
+ * The registry can be scraped directly or through a local HTTP endpoint, also started by setting DEPTHAI_METRICS_PORT.
+ */
+class MetricsRegistry {
+   public:
+    /// Alias for collector id
+    using CollectorId = int;
+    /// Label names and values of a sample
+    using Labels = std::vector<std::pair<std::string, std::string>>;
+
+    /**
+     * Gathers samples of metric families during a scrape
+     */
+    class Writer {
+       public:
+        /**
+         * Add a sample of a gauge, a value which can go up and down
+         */
+        void gauge(const std::string& name, const std::string& help, const Labels& labels, double value);
+
+        /**
+         * Add a sample of a monotonically increasing counter. Name is given without the "_total" suffix
+         */
+        void counter(const std::string& name, const std::string& help, const Labels& labels, double value);
+
+        /**
+         * Serialize gathered samples into OpenMetrics text format
+         */
+        std::string toString() const;
+
+       private:
+        struct Family {
+            std::string type;
+            std::string help;
+            std::vector<std::string> samples;
+        };
+        std::vector<std::pair<std::string, Family>> families;
+        std::map<std::string, size_t> familyIndex;
+
+        void add(const std::string& name, const char* type, const std::string& help, const Labels& labels, double value);
+    };
+
+    using Collector = std::function<void(Writer&)>;
+
+    /// Content type of the scraped text
+    static constexpr auto CONTENT_TYPE = "application/openmetrics-text; version=1.0.0; charset=utf-8";
+    /// Default port of the HTTP endpoint
+    static constexpr int DEFAULT_PORT = 9464;
+
+    static MetricsRegistry& getInstance();
+    MetricsRegistry(MetricsRegistry const&) = delete;
+    void operator=(MetricsRegistry const&) = delete;
+
+    /**
+     * Enable or disable per message timing metrics (node processing time).
+     * Queue and output counters are always kept. Enabled automatically when the HTTP endpoint is started.
+     */
+    static void setEnabled(bool enabled);
+
+    /**
+     * Check whether per message timing metrics are enabled
+     */
+    static bool isEnabled();
+
+    /**
+     * Register a collector, called on each scrape
+     * @returns Id which can be used to remove the collector
+     */
+    CollectorId addCollector(Collector collector);
+
+    /**
+     * Remove a previously added collector. Waits for the collector to return if a scrape is running it, so it mustn't be called from
+     * within the collector itself.
+     * @returns True if collector was removed, false otherwise
+     */
+    bool removeCollector(CollectorId id);
+
+    /**
+     * Gather all metrics
+     * @returns Metrics in OpenMetrics text format
+     */
+    std::string scrape();
+
+    /**
+     * Start serving metrics over HTTP at "/metrics"
+     * @param host Address to bind to, local only by default
+     * @param port Port to bind to, or 0 to pick a free port
+     * @returns Port the endpoint is bound to
+     */
+    int startServer(const std::string& host = "127.0.0.1", int port = DEFAULT_PORT);
+
+    /**
+     * Stop serving metrics over HTTP
+     */
+    void stopServer();
+
+    /**
+     * Check whether the HTTP endpoint is running
+     */
+    bool isServerRunning() const;
+
+    /// Record that a node dequeued a message on the calling thread
+    static void recordDequeue(std::int64_t nodeId);
+    /// Time since the node last dequeued a message on the calling thread, if it did
+    static std::optional<std::chrono::nanoseconds> getTimeSinceDequeue(std::int64_t nodeId);
+
+   private:
+    MetricsRegistry();
+    ~MetricsRegistry();
+
+    // Collectors are run outside collectorsMtx, each entry guards its own runs so removal can wait for them
+    struct CollectorEntry;
+    std::mutex collectorsMtx;
+    std::map<CollectorId, std::shared_ptr<CollectorEntry>> collectors;
+    CollectorId uniqueCollectorId{0};
+
+    struct Server;
+    mutable std::mutex serverMtx;
+    std::unique_ptr<Server> server;
+};
+
+}  // namespace dai
@@ -1,5 +1,14 @@
 #include "depthai/basalt/BasaltVIO.hpp"
 
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "../pipeline/ThreadedNodeImpl.hpp"
+#include "../utility/ImagePool.hpp"
+#include "../utility/ImageWidening.hpp"
+#include "../utility/ParallelFor.hpp"
 #include "../utility/PimplImpl.hpp"
 #include "basalt/vi_estimator/vio_estimator.h"
 #include "depthai/pipeline/Pipeline.hpp"
@@ -11,9 +20,21 @@ namespace dai {
 
 namespace node {
 
+namespace {
+
+bool isLuma8(ImgFrame::Type type) {
+    using Type = ImgFrame::Type;
+    return type == Type::GRAY8 || type == Type::RAW8 || type == Type::YUV400p || type == Type::NV12 || type == Type::NV21 || type == Type::YUV420p
+           || type == Type::YV12;
+}
+
+}  // namespace
+
 class BasaltVIO::Impl {
    public:
     Impl() = default;
+    // One per camera
+    std::vector<utility::ImagePool<basalt::ManagedImage<uint16_t>>> imagePools;
     std::shared_ptr<tbb::concurrent_bounded_queue<basalt::OpticalFlowInput::Ptr>> imageDataQueue;
     std::shared_ptr<tbb::concurrent_bounded_queue<basalt::ImuData<double>::Ptr>> imuDataQueue;
     std::shared_ptr<tbb::concurrent_bounded_queue<basalt::PoseVelBiasState<double>::Ptr>> outStateQueue;
@@ -73,39 +94,47 @@ void BasaltVIO::run() {
 void BasaltVIO::stereoCB(std::shared_ptr<ADatatype> in) {
     auto group = std::dynamic_pointer_cast<MessageGroup>(in);
     if(group == nullptr) return;
-    if(!initialized) {
-        std::vector<std::shared_ptr<ImgFrame>> imgFrames;
-        for(auto& msg : *group) {
-            imgFrames.emplace_back(std::dynamic_pointer_cast<ImgFrame>(msg.second));
+    std::vector<std::shared_ptr<ImgFrame>> imgFrames;
+    for(auto& msg : *group) {
+        imgFrames.emplace_back(std::dynamic_pointer_cast<ImgFrame>(msg.second));
+    }
+    for(const auto& imgFrame : imgFrames) {
+        if(imgFrame->getType() != ImgFrame::Type::RAW16 && !isLuma8(imgFrame->getType())) {
+            auto type = static_cast<int>(imgFrame->getType());
+            ThreadedNode::pimpl->logger->error("BasaltVIO needs grayscale, YUV or RAW16 frames, skipping frames of type {}", type);
+            return;
         }
-
+    }
+    if(!initialized) {
         initialize(imgFrames);
     }
-    int i = 0;
-    basalt::OpticalFlowInput::Ptr data(new basalt::OpticalFlowInput(2));
-    for(auto& msg : *group) {
-        std::shared_ptr<ImgFrame> imgFrame = std::dynamic_pointer_cast<ImgFrame>(msg.second);
-        if(i == 0) {
-            leftImg = imgFrame;
-        };
-        auto t = imgFrame->getTimestamp();
-        int64_t tNS = std::chrono::time_point_cast<std::chrono::nanoseconds>(t).time_since_epoch().count();
-        auto exposure = imgFrame->getExposureTime();
 
-        int exposureMS = std::chrono::duration_cast<std::chrono::milliseconds>(exposure).count();
-        data->img_data[i].img = std::make_shared<basalt::ManagedImage<uint16_t>>(imgFrame->getWidth(), imgFrame->getHeight());
-        data->t_ns = tNS;
-        data->img_data[i].exposure = exposureMS;
-        size_t fullSize = imgFrame->getWidth() * imgFrame->getHeight();
-        const uint8_t* dataIN = imgFrame->getData().data();
-        uint16_t* data_out = data->img_data[i].img->ptr;
-        for(size_t j = 0; j < fullSize; j++) {
-            int val = dataIN[j];
-            val = val << 8;
-            data_out[j] = val;
+    const int numImages = static_cast<int>(imgFrames.size());
+    if(pimpl->imagePools.size() < imgFrames.size()) pimpl->imagePools.resize(imgFrames.size());
+    basalt::OpticalFlowInput::Ptr data(new basalt::OpticalFlowInput(numImages));
+    leftImg = imgFrames.front();
+    auto t = imgFrames.back()->getTimestamp();
+    data->t_ns = std::chrono::time_point_cast<std::chrono::nanoseconds>(t).time_since_epoch().count();
+
+    // Each camera is converted on its own thread
+    const unsigned numThreads = std::max(1u, std::min(static_cast<unsigned>(numImages), std::thread::hardware_concurrency()));
+    utility::parallelFor(0, numImages, numThreads, 1, [&](int begin, int end) {
+        for(int i = begin; i < end; i++) {
+            const auto& imgFrame = imgFrames[i];
+            const size_t width = imgFrame->getWidth();
+            const size_t height = imgFrame->getHeight();
+            auto image = pimpl->imagePools[i].acquire(width, height);
+            const uint8_t* pixels = imgFrame->getData().data() + imgFrame->fb.p1Offset;
+            if(imgFrame->getType() == ImgFrame::Type::RAW16) {
+                // Already 16 bit, taken as is
+                utility::copy16(reinterpret_cast<const uint16_t*>(pixels), imgFrame->getStride(), image->ptr, image->pitch, width, height);
+            } else {
+                utility::widen8To16(pixels, imgFrame->getStride(), image->ptr, image->pitch, width, height);
+            }
+            data->img_data[i].img = std::move(image);
+            data->img_data[i].exposure = std::chrono::duration_cast<std::chrono::milliseconds>(imgFrame->getExposureTime()).count();
         }
-        i++;
-    }
+    });
     lastImgData = data;
     if(pimpl->imageDataQueue) {
         pimpl->imageDataQueue->push(data);
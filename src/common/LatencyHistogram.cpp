@@ -0,0 +1,118 @@
+#include "depthai/common/LatencyHistogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace dai {
+
+namespace {
+
+// Values below 2^EXACT_BITS are recorded exactly, each following power of two range is split into SUB_BUCKETS linear buckets
+constexpr std::uint32_t EXACT_BITS = 7;
+constexpr std::uint64_t EXACT_BUCKETS = 1ULL << EXACT_BITS;
+constexpr std::uint64_t SUB_BUCKETS = EXACT_BUCKETS / 2;
+
+}  // namespace
+
+std::uint16_t LatencyHistogram::getBucketIndex(std::uint64_t value) {
+    if(value < EXACT_BUCKETS) return static_cast<std::uint16_t>(value);
+    std::uint32_t msb = EXACT_BITS;
+    while(msb < 63 && (value >> (msb + 1)) != 0) msb++;
+    const std::uint32_t shift = msb - EXACT_BITS + 1;
+    return static_cast<std::uint16_t>(EXACT_BUCKETS + (msb - EXACT_BITS) * SUB_BUCKETS + ((value >> shift) - SUB_BUCKETS));
+}
+
+std::uint64_t LatencyHistogram::getBucketLowestValue(std::uint16_t index) {
+    if(index < EXACT_BUCKETS) return index;
+    const std::uint64_t octave = (index - EXACT_BUCKETS) / SUB_BUCKETS;
+    const std::uint64_t subBucket = (index - EXACT_BUCKETS) % SUB_BUCKETS;
+    return (SUB_BUCKETS + subBucket) << (octave + 1);
+}
+
+std::uint64_t LatencyHistogram::getBucketHighestValue(std::uint16_t index) {
+    if(index < EXACT_BUCKETS) return index;
+    const std::uint64_t octave = (index - EXACT_BUCKETS) / SUB_BUCKETS;
+    return getBucketLowestValue(index) + (1ULL << (octave + 1)) - 1;
+}
+
+void LatencyHistogram::record(std::chrono::microseconds value) {
+    const std::uint64_t us = value.count() > 0 ? static_cast<std::uint64_t>(value.count()) : 0;
+    min = count == 0 ? us : std::min(min, us);
+    max = count == 0 ? us : std::max(max, us);
+    count++;
+    sum += us;
+    sumSquares += static_cast<double>(us) * static_cast<double>(us);
+
+    const auto index = getBucketIndex(us);
+    auto it = std::lower_bound(bucketIndices.begin(), bucketIndices.end(), index);
+    auto pos = std::distance(bucketIndices.begin(), it);
+    if(it != bucketIndices.end() && *it == index) {
+        bucketCounts[pos]++;
+    } else {
+        bucketIndices.insert(it, index);
+        bucketCounts.insert(bucketCounts.begin() + pos, 1);
+    }
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    if(other.count == 0) return;
+    min = count == 0 ? other.min : std::min(min, other.min);
+    max = count == 0 ? other.max : std::max(max, other.max);
+    count += other.count;
+    sum += other.sum;
+    sumSquares += other.sumSquares;
+
+    // Merge sorted sparse buckets
+    std::vector<std::uint16_t> indices;
+    std::vector<std::uint64_t> counts;
+    indices.reserve(bucketIndices.size() + other.bucketIndices.size());
+    counts.reserve(bucketIndices.size() + other.bucketIndices.size());
+    size_t i = 0, j = 0;
+    while(i < bucketIndices.size() || j < other.bucketIndices.size()) {
+        if(j == other.bucketIndices.size() || (i < bucketIndices.size() && bucketIndices[i] < other.bucketIndices[j])) {
+            indices.push_back(bucketIndices[i]);
+            counts.push_back(bucketCounts[i++]);
+        } else if(i == bucketIndices.size() || other.bucketIndices[j] < bucketIndices[i]) {
+            indices.push_back(other.bucketIndices[j]);
+            counts.push_back(other.bucketCounts[j++]);
+        } else {
+            indices.push_back(bucketIndices[i]);
+            counts.push_back(bucketCounts[i++] + other.bucketCounts[j++]);
+        }
+    }
+    bucketIndices = std::move(indices);
+    bucketCounts = std::move(counts);
+}
+
+void LatencyHistogram::reset() {
+    *this = LatencyHistogram();
+}
+
+std::chrono::microseconds LatencyHistogram::getPercentile(double percentile) const {
+    if(count == 0) return std::chrono::microseconds(0);
+    percentile = std::min(std::max(percentile, 0.0), 100.0);
+    const auto rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(percentile / 100.0 * static_cast<double>(count))));
+    std::uint64_t cumulative = 0;
+    for(size_t i = 0; i < bucketIndices.size(); i++) {
+        cumulative += bucketCounts[i];
+        if(cumulative >= rank) {
+            const auto value = std::min(std::max(getBucketHighestValue(bucketIndices[i]), min), max);
+            return std::chrono::microseconds(value);
+        }
+    }
+    return std::chrono::microseconds(max);
+}
+
+std::chrono::duration<double, std::micro> LatencyHistogram::getMean() const {
+    if(count == 0) return std::chrono::duration<double, std::micro>(0.0);
+    return std::chrono::duration<double, std::micro>(static_cast<double>(sum) / static_cast<double>(count));
+}
+
+std::chrono::duration<double, std::micro> LatencyHistogram::getStdDev() const {
+    if(count == 0) return std::chrono::duration<double, std::micro>(0.0);
+    const double mean = getMean().count();
+    const double variance = sumSquares / static_cast<double>(count) - mean * mean;
+    return std::chrono::duration<double, std::micro>(std::sqrt(std::max(variance, 0.0)));
+}
+
+}  // namespace dai
@@ -6,9 +6,11 @@
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <map>
 #include <string>
 #include <tuple>
 #include <unordered_set>
+#include <utility>
 
 #include "depthai/common/CameraInfo.hpp"
 #include "depthai/common/Extrinsics.hpp"
@@ -47,8 +49,58 @@ void invertSe3Matrix4x4InPlace(std::vector<std::vector<float>>& mat) {
     }
     for(int i = 0; i < 3; ++i) mat[i][3] = newTrans[i];
 }
+
+void invertSe3Matrix4x4InPlace(CalibrationHandler::Matrix4x4& mat) {
+    std::swap(mat[0][1], mat[1][0]);
+    std::swap(mat[0][2], mat[2][0]);
+    std::swap(mat[1][2], mat[2][1]);
+
+    // The inverse of an SE(3) transformation (R, t) is (R^T, -R^T t)
+    float newTrans[3];
+    for(int i = 0; i < 3; ++i) {
+        newTrans[i] = 0;
+        for(int j = 0; j < 3; ++j) {
+            newTrans[i] -= mat[i][j] * mat[j][3];
+        }
+    }
+    for(int i = 0; i < 3; ++i) mat[i][3] = newTrans[i];
+}
+
+CalibrationHandler::Matrix4x4 matMul4x4(const CalibrationHandler::Matrix4x4& first, const CalibrationHandler::Matrix4x4& second) {
+    CalibrationHandler::Matrix4x4 res = {};
+    for(int i = 0; i < 4; ++i) {
+        for(int j = 0; j < 4; ++j) {
+            for(int k = 0; k < 4; ++k) {
+                res[i][j] += first[i][k] * second[k][j];
+            }
+        }
+    }
+    return res;
+}
+
+CalibrationHandler::Matrix4x4 toMatrix4x4(const std::vector<std::vector<float>>& mat) {
+    CalibrationHandler::Matrix4x4 res = {};
+    for(int i = 0; i < 4; ++i) {
+        for(int j = 0; j < 4; ++j) {
+            res[i][j] = mat.at(i).at(j);
+        }
+    }
+    return res;
+}
+
+std::vector<std::vector<float>> toVector(const CalibrationHandler::Matrix4x4& mat) {
+    std::vector<std::vector<float>> res;
+    for(const auto& row : mat) {
+        res.emplace_back(row.begin(), row.end());
+    }
+    return res;
+}
 }  // namespace
 
+struct CalibrationHandler::ExtrinsicsTable {
+    std::map<std::pair<CameraBoardSocket, CameraBoardSocket>, Matrix4x4> extrinsics;
+};
+
 CalibrationHandler::CalibrationHandler(std::filesystem::path eepromDataPath) {
     std::ifstream jsonStream(eepromDataPath);
     // TODO(sachin): Check if the file exists first.
@@ -357,6 +409,65 @@ CameraModel CalibrationHandler::getDistortionModel(CameraBoardSocket cameraId) c
 std::vector<std::vector<float>> CalibrationHandler::getCameraExtrinsics(CameraBoardSocket srcCamera,
                                                                         CameraBoardSocket dstCamera,
                                                                         bool useSpecTranslation) const {
+    return toVector(getCameraExtrinsicsMatrix(srcCamera, dstCamera, useSpecTranslation));
+}
+
+CalibrationHandler::Matrix4x4 CalibrationHandler::getCameraExtrinsicsMatrix(CameraBoardSocket srcCamera,
+                                                                            CameraBoardSocket dstCamera,
+                                                                            bool useSpecTranslation) const {
+    auto table = getExtrinsicsTable(useSpecTranslation);
+    auto it = table->extrinsics.find({srcCamera, dstCamera});
+    if(it != table->extrinsics.end()) {
+        return it->second;
+    }
+    // Cameras aren't linked or calibration is invalid - walk the graph to report the appropriate error
+    return toMatrix4x4(computeCameraExtrinsics(srcCamera, dstCamera, useSpecTranslation));
+}
+
+std::shared_ptr<const CalibrationHandler::ExtrinsicsTable> CalibrationHandler::getExtrinsicsTable(bool useSpecTranslation) const {
+    auto& cached = extrinsicsTables[useSpecTranslation ? 1 : 0];
+    auto table = std::atomic_load(&cached);
+    if(table) {
+        return table;
+    }
+
+    // Compute transformation of each camera to its origin camera once
+    std::map<CameraBoardSocket, std::pair<CameraBoardSocket, Matrix4x4>> toOrigin;
+    for(const auto& camera : eepromData.cameraData) {
+        try {
+            CameraBoardSocket origin;
+            auto extrinsics = getExtrinsicsToOrigin(camera.first, useSpecTranslation, origin, false);
+            toOrigin[camera.first] = {origin, toMatrix4x4(extrinsics)};
+        } catch(const std::exception&) {
+            // Broken link, left out of the table. Errors are reported and logged only when such camera is requested
+        }
+    }
+
+    // Then combine all pairs sharing the same origin
+    auto newTable = std::make_shared<ExtrinsicsTable>();
+    for(const auto& src : toOrigin) {
+        for(const auto& dst : toOrigin) {
+            if(src.second.first != dst.second.first) continue;
+            auto dstOriginMatrix = dst.second.second;
+            invertSe3Matrix4x4InPlace(dstOriginMatrix);
+            newTable->extrinsics[{src.first, dst.first}] = matMul4x4(dstOriginMatrix, src.second.second);
+        }
+    }
+
+    table = newTable;
+    std::atomic_store(&cached, table);
+    return table;
+}
+
+void CalibrationHandler::invalidateExtrinsicsTables() {
+    for(auto& table : extrinsicsTables) {
+        std::atomic_store(&table, std::shared_ptr<const ExtrinsicsTable>());
+    }
+}
+
+std::vector<std::vector<float>> CalibrationHandler::computeCameraExtrinsics(CameraBoardSocket srcCamera,
+                                                                            CameraBoardSocket dstCamera,
+                                                                            bool useSpecTranslation) const {
     /**
      * 1. Check if both camera ID exists.
      * 2. Check if the forward link exists from source and destination camera to origin camera.
@@ -394,13 +505,14 @@ std::vector<std::vector<float>> CalibrationHandler::getCameraExtrinsics(CameraBo
 
 std::vector<std::vector<float>> CalibrationHandler::getExtrinsicsToOrigin(CameraBoardSocket cameraId,
                                                                           bool useSpecTranslation,
-                                                                          CameraBoardSocket& originSocket) const {
+                                                                          CameraBoardSocket& originSocket,
+                                                                          bool logErrors) const {
     std::vector<std::vector<float>> extrinsics;
 
     // Check if the cameraId exists in the data
     auto cameraIt = eepromData.cameraData.find(cameraId);
     if(cameraIt == eepromData.cameraData.end()) {
-        logger::error("Camera ID {} does not exist in the calibration data.", static_cast<int>(cameraId));
+        if(logErrors) logger::error("Camera ID {} does not exist in the calibration data.", static_cast<int>(cameraId));
         throw std::runtime_error("Camera ID does not exist in the calibration data.");
     }
 
@@ -412,7 +524,7 @@ std::vector<std::vector<float>> CalibrationHandler::getExtrinsicsToOrigin(Camera
     while(true) {
         auto currentIt = eepromData.cameraData.find(currentCameraId);
         if(currentIt == eepromData.cameraData.end()) {
-            logger::error("Invalid camera link detected at camera ID {}.", static_cast<int>(currentCameraId));
+            if(logErrors) logger::error("Invalid camera link detected at camera ID {}.", static_cast<int>(currentCameraId));
             throw std::runtime_error("Invalid camera link detected.");
         }
 
@@ -688,6 +800,7 @@ void CalibrationHandler::setProductName(std::string productName) {
 }
 
 void CalibrationHandler::setCameraIntrinsics(CameraBoardSocket cameraId, std::vector<std::vector<float>> intrinsics, int width, int height) {
+    invalidateExtrinsicsTables();
     if(intrinsics.size() != 3 || intrinsics[0].size() != 3) {
         throw std::runtime_error("Intrinsic Matrix size should always be 3x3 ");
     }
@@ -721,6 +834,7 @@ void CalibrationHandler::setCameraIntrinsics(CameraBoardSocket cameraId, std::ve
 }
 
 void CalibrationHandler::setDistortionCoefficients(CameraBoardSocket cameraId, std::vector<float> distortionCoefficients) {
+    invalidateExtrinsicsTables();
     const size_t num = 14;
 
     if(distortionCoefficients.size() > num) {
@@ -747,6 +861,7 @@ void CalibrationHandler::setDistortionCoefficients(CameraBoardSocket cameraId, s
 }
 
 void CalibrationHandler::setFov(CameraBoardSocket cameraId, float hfov) {
+    invalidateExtrinsicsTables();
     if(eepromData.cameraData.find(cameraId) == eepromData.cameraData.end()) {
         dai::CameraInfo camera_info;
         camera_info.specHfovDeg = hfov;
@@ -758,6 +873,7 @@ void CalibrationHandler::setFov(CameraBoardSocket cameraId, float hfov) {
 }
 
 void CalibrationHandler::setLensPosition(CameraBoardSocket cameraId, uint8_t lensPosition) {
+    invalidateExtrinsicsTables();
     if(eepromData.cameraData.find(cameraId) == eepromData.cameraData.end()) {
         dai::CameraInfo camera_info;
         camera_info.lensPosition = lensPosition;
@@ -769,6 +885,7 @@ void CalibrationHandler::setLensPosition(CameraBoardSocket cameraId, uint8_t len
 }
 
 void CalibrationHandler::setCameraType(CameraBoardSocket cameraId, CameraModel cameraModel) {
+    invalidateExtrinsicsTables();
     if(eepromData.cameraData.find(cameraId) == eepromData.cameraData.end()) {
         dai::CameraInfo camera_info;
         camera_info.cameraType = cameraModel;
@@ -800,6 +917,7 @@ void CalibrationHandler::setCameraExtrinsics(CameraBoardSocket srcCameraId,
     extrinsics.specTranslation = dai::Point3f(specTranslation[0], specTranslation[1], specTranslation[2]);
     extrinsics.toCameraSocket = destCameraId;
 
+    invalidateExtrinsicsTables();
     if(eepromData.cameraData.find(srcCameraId) == eepromData.cameraData.end()) {
         dai::CameraInfo camera_info;
         camera_info.extrinsics = extrinsics;
@@ -263,6 +263,9 @@ class DeviceBase::Impl {
     std::shared_ptr<XLinkStream> rpcStream;
     std::unique_ptr<nanorpc::core::client<nanorpc::packer::nlohmann_msgpack>> rpcClient;
 
+    // Metrics collector, registered while connected
+    MetricsRegistry::CollectorId metricsCollectorId = -1;
+
     void setLogLevel(LogLevel level);
     LogLevel getLogLevel();
     void setPattern(const std::string& pattern);
@@ -410,6 +413,8 @@ unsigned int getCrashdumpTimeout(XLinkProtocol_t protocol) {
 void DeviceBase::closeImpl() {
     using namespace std::chrono;
     isClosing = true;
+    MetricsRegistry::getInstance().removeCollector(pimpl->metricsCollectorId);
+    pimpl->metricsCollectorId = -1;
     auto t1 = steady_clock::now();
     bool shouldGetCrashDump = false;
     // Check if the device is RVC3 - in case it is, crash dump retrieval is done differently
@@ -949,6 +954,10 @@ void DeviceBase::init2(Config cfg, const std::filesystem::path& pathToMvcmd, boo
             // Rethrow original exception
             throw;
         }
+
+        // Expose device metrics while connected
+        MetricsRegistry::getInstance().removeCollector(pimpl->metricsCollectorId);
+        pimpl->metricsCollectorId = MetricsRegistry::getInstance().addCollector([this](MetricsRegistry::Writer& writer) { collectMetrics(writer); });
     }
 }
 
@@ -1321,6 +1330,51 @@ bool DeviceBase::hasCrashDump() {
     return pimpl->rpcClient->call("hasCrashDump").as<bool>();
 }
 
+void DeviceBase::collectMetrics(MetricsRegistry::Writer& writer) {
+    const MetricsRegistry::Labels labels{{"device_id", deviceInfo.getDeviceId()}};
+    auto profiling = getProfilingData();
+    writer.counter("depthai_device_xlink_written_bytes", "Bytes written over XLink to the device", labels, static_cast<double>(profiling.numBytesWritten));
+    writer.counter("depthai_device_xlink_read_bytes", "Bytes read over XLink from the device", labels, static_cast<double>(profiling.numBytesRead));
+
+    // System information, not every platform provides all of it
+    auto withLabel = [&labels](const std::string& name, const std::string& value) {
+        auto extended = labels;
+        extended.emplace_back(name, value);
+        return extended;
+    };
+    auto addMemory = [&](const std::string& memory, const std::function<MemoryInfo()>& getUsage) {
+        try {
+            auto usage = getUsage();
+            writer.gauge("depthai_device_memory_used_bytes", "Used device memory", withLabel("memory", memory), static_cast<double>(usage.used));
+            writer.gauge("depthai_device_memory_total_bytes", "Total device memory", withLabel("memory", memory), static_cast<double>(usage.total));
+        } catch(const std::exception& ex) {
+            pimpl->logger.trace("Couldn't collect {} memory usage: {}", memory, ex.what());
+        }
+    };
+    addMemory("ddr", [this]() { return getDdrMemoryUsage(); });
+    if(deviceInfo.platform == X_LINK_MYRIAD_X) {
+        addMemory("cmx", [this]() { return getCmxMemoryUsage(); });
+        addMemory("leon_css_heap", [this]() { return getLeonCssHeapUsage(); });
+        addMemory("leon_mss_heap", [this]() { return getLeonMssHeapUsage(); });
+        try {
+            writer.gauge("depthai_device_cpu_usage_ratio", "Average device CPU usage", withLabel("cpu", "leon_css"), getLeonCssCpuUsage().average);
+            writer.gauge("depthai_device_cpu_usage_ratio", "Average device CPU usage", withLabel("cpu", "leon_mss"), getLeonMssCpuUsage().average);
+        } catch(const std::exception& ex) {
+            pimpl->logger.trace("Couldn't collect CPU usage: {}", ex.what());
+        }
+    }
+    try {
+        auto temperature = getChipTemperature();
+        const std::vector<std::pair<std::string, float>> sensors = {
+            {"css", temperature.css}, {"mss", temperature.mss}, {"upa", temperature.upa}, {"dss", temperature.dss}, {"average", temperature.average}};
+        for(const auto& [sensor, value] : sensors) {
+            writer.gauge("depthai_device_temperature_celsius", "Device chip temperature", withLabel("sensor", sensor), value);
+        }
+    } catch(const std::exception& ex) {
+        pimpl->logger.trace("Couldn't collect chip temperature: {}", ex.what());
+    }
+}
+
 ProfilingData DeviceBase::getProfilingData() {
     return connection->getProfilingData();
 }
@@ -1,6 +1,7 @@
 #include "device/DeviceBootloader.hpp"
 
 // std
+#include <algorithm>
 #include <fstream>
 
 // shared
@@ -9,6 +10,8 @@
 #include "depthai-bootloader-shared/Structure.hpp"
 #include "depthai-bootloader-shared/XLinkConstants.hpp"
 #include "depthai/pipeline/Assets.hpp"
+#include "depthai/utility/Checksum.hpp"
+#include "depthai/utility/Compression.hpp"
 #include "depthai/utility/Serialization.hpp"
 #include "depthai/xlink/XLinkConstants.hpp"
 
@@ -62,8 +65,51 @@ std::vector<DeviceInfo> DeviceBootloader::getAllAvailableDevices() {
     return availableDevices;
 }
 
-std::vector<uint8_t> DeviceBootloader::createDepthaiApplicationPackage(
-    const Pipeline& pipeline, const fs::path& pathToCmd, bool compress, std::string applicationName, bool checkChecksum) {
+namespace {
+
+// Writes sections of an application package to a sink, computing section checksums on the fly
+class ApplicationPackageWriter {
+   public:
+    explicit ApplicationPackageWriter(const DeviceBootloader::PackageSink& sink) : sink(sink) {}
+
+    // Starts a new section at given offset, zero padding the gap from the end of previous section
+    void beginSection(SBR_SECTION* section, const char* name, std::size_t offset) {
+        static const std::vector<std::uint8_t> zeros(64 * 1024, 0);
+        while(position < offset) {
+            const auto size = std::min(zeros.size(), offset - position);
+            sink(position, zeros.data(), size);
+            position += size;
+        }
+        current = section;
+        sectionStart = position;
+        checksum = utility::checksum(nullptr, 0);
+        sbr_section_set_name(current, name);
+        sbr_section_set_offset(current, static_cast<uint32_t>(offset));
+    }
+
+    void write(const void* data, std::size_t size) {
+        checksum = utility::checksum(data, size, checksum);
+        sink(position, reinterpret_cast<const std::uint8_t*>(data), size);
+        position += size;
+    }
+
+    void endSection() {
+        sbr_section_set_size(current, static_cast<uint32_t>(position - sectionStart));
+        sbr_section_set_checksum(current, checksum);
+    }
+
+   private:
+    const DeviceBootloader::PackageSink& sink;
+    SBR_SECTION* current = nullptr;
+    std::size_t position = SBR_RAW_SIZE;
+    std::size_t sectionStart = SBR_RAW_SIZE;
+    std::uint32_t checksum = 0;
+};
+
+}  // namespace
+
+void DeviceBootloader::writeDepthaiApplicationPackage(
+    const PackageSink& sink, const Pipeline& pipeline, const fs::path& pathToCmd, bool compress, std::string applicationName, bool checkChecksum) {
     // Serialize the pipeline
     PipelineSchema schema;
     Assets assets;
@@ -113,44 +159,11 @@ std::vector<uint8_t> DeviceBootloader::createDepthaiApplicationPackage(
         return ((((S) + (SECTION_ALIGNMENT_SIZE)-1)) & ~((SECTION_ALIGNMENT_SIZE)-1));
     };
 
-    // Should compress firmware?
-    if(compress) {
-        using namespace std::chrono;
-
-        auto t1 = steady_clock::now();
-        auto compressBufferSize = compressBound(static_cast<decltype(compressBound(1))>(deviceFirmware.size()));
-        std::vector<uint8_t> compressBuffer(compressBufferSize);
-        // Chosen impirically
-        constexpr int COMPRESSION_LEVEL = 9;
-        if(compress2(compressBuffer.data(),
-                     &compressBufferSize,
-                     deviceFirmware.data(),
-                     static_cast<decltype(compressBufferSize)>(deviceFirmware.size()),
-                     COMPRESSION_LEVEL)
-           != Z_OK) {
-            throw std::runtime_error("Error while compressing device firmware\n");
-        }
-
-        // Resize output buffer
-        compressBuffer.resize(compressBufferSize);
-
-        // Set the compressed firmware
-        auto prevSize = deviceFirmware.size();
-        deviceFirmware = std::move(compressBuffer);
-
-        auto diff = duration_cast<milliseconds>(steady_clock::now() - t1);
-        logger::debug("Compressed firmware for Dephai Application Package. Took {}, size reduced from {:.2f}MiB to {:.2f}MiB",
-                      diff,
-                      prevSize / (1024.0f * 1024.0f),
-                      deviceFirmware.size() / (1024.0f * 1024.0f));
-    }
+    ApplicationPackageWriter writer(sink);
 
     // Section, MVCMD, name '__firmware'
-    sbr_section_set_name(fwSection, "__firmware");
+    writer.beginSection(fwSection, "__firmware", SBR_RAW_SIZE);
     sbr_section_set_bootable(fwSection, true);
-    sbr_section_set_size(fwSection, static_cast<uint32_t>(deviceFirmware.size()));
-    sbr_section_set_checksum(fwSection, sbr_compute_checksum(deviceFirmware.data(), static_cast<uint32_t>(deviceFirmware.size())));
-    sbr_section_set_offset(fwSection, SBR_RAW_SIZE);
     if(checkChecksum) {
         // Don't ignore checksum, use it when booting
         sbr_section_set_ignore_checksum(fwSection, false);
@@ -158,59 +171,68 @@ std::vector<uint8_t> DeviceBootloader::createDepthaiApplicationPackage(
         // Ignore checksum to allow faster booting (images are verified after flashing, low risk)
         sbr_section_set_ignore_checksum(fwSection, true);
     }
-    // Set compression flags
+    // Should compress firmware?
     if(compress) {
+        using namespace std::chrono;
+
+        auto t1 = steady_clock::now();
+        // Chosen impirically
+        constexpr int COMPRESSION_LEVEL = 9;
+        // Compressed in parallel, block size fixed so the resulting package doesn't depend on number of cores
+        constexpr std::size_t COMPRESSION_BLOCK_SIZE = 1024 * 1024;
+        utility::deflateParallel(
+            deviceFirmware.data(),
+            deviceFirmware.size(),
+            [&writer](const uint8_t* data, size_t size) { writer.write(data, size); },
+            COMPRESSION_LEVEL,
+            COMPRESSION_BLOCK_SIZE);
+        writer.endSection();
         sbr_section_set_compression(fwSection, SBR_COMPRESSION_ZLIB);
+
+        auto diff = duration_cast<milliseconds>(steady_clock::now() - t1);
+        logger::debug("Compressed firmware for Dephai Application Package. Took {}, size reduced from {:.2f}MiB to {:.2f}MiB",
+                      diff,
+                      deviceFirmware.size() / (1024.0f * 1024.0f),
+                      fwSection->size / (1024.0f * 1024.0f));
     } else {
+        writer.write(deviceFirmware.data(), deviceFirmware.size());
+        writer.endSection();
         sbr_section_set_compression(fwSection, SBR_NO_COMPRESSION);
     }
+    // Firmware isn't needed anymore
+    deviceFirmware = {};
 
     // Section, pipeline schema, name 'pipeline'
-    sbr_section_set_name(pipelineSection, "pipeline");
-    sbr_section_set_size(pipelineSection, static_cast<uint32_t>(pipelineBinary.size()));
-    sbr_section_set_checksum(pipelineSection, sbr_compute_checksum(pipelineBinary.data(), static_cast<uint32_t>(pipelineBinary.size())));
-    sbr_section_set_offset(pipelineSection, getSectionAlignedOffset(fwSection->offset + fwSection->size));
+    writer.beginSection(pipelineSection, "pipeline", getSectionAlignedOffset(fwSection->offset + fwSection->size));
+    writer.write(pipelineBinary.data(), pipelineBinary.size());
+    writer.endSection();
 
     // Section, assets map, name 'assets'
-    sbr_section_set_name(assetsSection, "assets");
-    sbr_section_set_size(assetsSection, static_cast<uint32_t>(assetsBinary.size()));
-    sbr_section_set_checksum(assetsSection, sbr_compute_checksum(assetsBinary.data(), static_cast<uint32_t>(assetsBinary.size())));
-    sbr_section_set_offset(assetsSection, getSectionAlignedOffsetSmall(pipelineSection->offset + pipelineSection->size));
+    writer.beginSection(assetsSection, "assets", getSectionAlignedOffsetSmall(pipelineSection->offset + pipelineSection->size));
+    writer.write(assetsBinary.data(), assetsBinary.size());
+    writer.endSection();
 
     // Section, asset storage, name 'asset_storage'
-    sbr_section_set_name(assetStorageSection, "asset_storage");
-    sbr_section_set_size(assetStorageSection, static_cast<uint32_t>(assetStorage.size()));
-    sbr_section_set_checksum(assetStorageSection, sbr_compute_checksum(assetStorage.data(), static_cast<uint32_t>(assetStorage.size())));
-    sbr_section_set_offset(assetStorageSection, getSectionAlignedOffsetSmall(assetsSection->offset + assetsSection->size));
+    writer.beginSection(assetStorageSection, "asset_storage", getSectionAlignedOffsetSmall(assetsSection->offset + assetsSection->size));
+    writer.write(assetStorage.data(), assetStorage.size());
+    writer.endSection();
 
     // Section, firmware version
-    sbr_section_set_name(fwVersionSection, "__fw_version");
-    sbr_section_set_size(fwVersionSection, static_cast<uint32_t>(fwVersionBuffer.size()));
-    sbr_section_set_checksum(fwVersionSection, sbr_compute_checksum(fwVersionBuffer.data(), static_cast<uint32_t>(fwVersionBuffer.size())));
-    sbr_section_set_offset(fwVersionSection, getSectionAlignedOffsetSmall(assetStorageSection->offset + assetStorageSection->size));
+    writer.beginSection(fwVersionSection, "__fw_version", getSectionAlignedOffsetSmall(assetStorageSection->offset + assetStorageSection->size));
+    writer.write(fwVersionBuffer.data(), fwVersionBuffer.size());
+    writer.endSection();
 
     // Section, application name
-    sbr_section_set_name(appNameSection, "app_name");
-    sbr_section_set_size(appNameSection, static_cast<uint32_t>(applicationName.size()));
-    sbr_section_set_checksum(appNameSection, sbr_compute_checksum(applicationName.data(), static_cast<uint32_t>(applicationName.size())));
-    sbr_section_set_offset(appNameSection, getSectionAlignedOffsetSmall(fwVersionSection->offset + fwVersionSection->size));
+    writer.beginSection(appNameSection, "app_name", getSectionAlignedOffsetSmall(fwVersionSection->offset + fwVersionSection->size));
+    writer.write(applicationName.data(), applicationName.size());
+    writer.endSection();
 
     // TODO(themarpe) - Add additional sections (Pipeline nodes will be able to use sections)
 
-    // Create a vector to hold whole dap package
-    std::vector<uint8_t> fwPackage;
-    fwPackage.resize(lastSection->offset + lastSection->size);
-
-    // Serialize SBR
-    sbr_serialize(&sbr, fwPackage.data(), static_cast<uint32_t>(fwPackage.size()));
-
-    // Write to fwPackage
-    for(std::size_t i = 0; i < deviceFirmware.size(); i++) fwPackage[fwSection->offset + i] = deviceFirmware[i];
-    for(std::size_t i = 0; i < fwVersionBuffer.size(); i++) fwPackage[fwVersionSection->offset + i] = fwVersionBuffer[i];
-    for(std::size_t i = 0; i < applicationName.size(); i++) fwPackage[appNameSection->offset + i] = applicationName[i];
-    for(std::size_t i = 0; i < pipelineBinary.size(); i++) fwPackage[pipelineSection->offset + i] = pipelineBinary[i];
-    for(std::size_t i = 0; i < assetsBinary.size(); i++) fwPackage[assetsSection->offset + i] = assetsBinary[i];
-    for(std::size_t i = 0; i < assetStorage.size(); i++) fwPackage[assetStorageSection->offset + i] = assetStorage[i];
+    // Serialize SBR, now that all sections are known
+    std::vector<uint8_t> header(SBR_RAW_SIZE);
+    sbr_serialize(&sbr, header.data(), static_cast<uint32_t>(header.size()));
+    sink(0, header.data(), header.size());
 
     // Debug
     if(logger::get_level() == spdlog::level::debug) {
@@ -220,7 +242,22 @@ std::vector<uint8_t> DeviceBootloader::createDepthaiApplicationPackage(
             logger::debug("{}, {}B, {}, {}, {}, {}", cur->name, cur->size, cur->offset, cur->checksum, cur->type, cur->flags);
         }
     }
+}
 
+std::vector<uint8_t> DeviceBootloader::createDepthaiApplicationPackage(
+    const Pipeline& pipeline, const fs::path& pathToCmd, bool compress, std::string applicationName, bool checkChecksum) {
+    // Create a vector to hold whole dap package
+    std::vector<uint8_t> fwPackage;
+    writeDepthaiApplicationPackage(
+        [&fwPackage](std::size_t offset, const std::uint8_t* data, std::size_t size) {
+            if(fwPackage.size() < offset + size) fwPackage.resize(offset + size);
+            std::copy(data, data + size, fwPackage.begin() + offset);
+        },
+        pipeline,
+        pathToCmd,
+        compress,
+        applicationName,
+        checkChecksum);
     return fwPackage;
 }
 
@@ -233,16 +270,28 @@ std::vector<uint8_t> DeviceBootloader::createDepthaiApplicationPackage(const Pip
 
 void DeviceBootloader::saveDepthaiApplicationPackage(
     const fs::path& path, const Pipeline& pipeline, const fs::path& pathToCmd, bool compress, std::string applicationName, bool checkChecksum) {
-    auto dap = createDepthaiApplicationPackage(pipeline, pathToCmd, compress, applicationName, checkChecksum);
     std::ofstream outfile(path, std::ios::binary);
-    outfile.write(reinterpret_cast<const char*>(dap.data()), dap.size());
+    if(!outfile) {
+        throw std::runtime_error(fmt::format("Could not open file {} for writing", path));
+    }
+    writeDepthaiApplicationPackage(
+        [&outfile](std::size_t offset, const std::uint8_t* data, std::size_t size) {
+            outfile.seekp(static_cast<std::streamoff>(offset));
+            outfile.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size));
+            if(!outfile) {
+                throw std::runtime_error("Error while writing Depthai Application Package");
+            }
+        },
+        pipeline,
+        pathToCmd,
+        compress,
+        applicationName,
+        checkChecksum);
 }
 
 void DeviceBootloader::saveDepthaiApplicationPackage(
     const fs::path& path, const Pipeline& pipeline, bool compress, std::string applicationName, bool checkChecksum) {
-    auto dap = createDepthaiApplicationPackage(pipeline, compress, applicationName, checkChecksum);
-    std::ofstream outfile(path, std::ios::binary);
-    outfile.write(reinterpret_cast<const char*>(dap.data()), dap.size());
+    saveDepthaiApplicationPackage(path, pipeline, "", compress, applicationName, checkChecksum);
 }
 
 DeviceBootloader::DeviceBootloader(const DeviceInfo& devInfo) : deviceInfo(devInfo) {
@@ -0,0 +1,155 @@
+#include "depthai/pipeline/MessageLineage.hpp"
+
+// std
+#include <algorithm>
+#include <atomic>
+#include <sstream>
+
+// project
+#include "depthai/pipeline/datatype/ADatatype.hpp"
+
+namespace dai {
+
+namespace {
+
+std::atomic<bool> lineageEnabled{false};
+
+// Lineage of the last message dequeued by a node on this thread, inherited by messages the node creates
+thread_local std::shared_ptr<MessageLineage> lastDequeuedLineage;
+thread_local std::int64_t lastDequeuedNodeId = -1;
+
+bool isSet(const LineageHop::Timepoint& timepoint) {
+    return timepoint != LineageHop::Timepoint{};
+}
+
+std::optional<std::chrono::microseconds> between(const LineageHop::Timepoint& from, const LineageHop::Timepoint& to) {
+    if(!isSet(from) || !isSet(to)) return std::nullopt;
+    return std::chrono::duration_cast<std::chrono::microseconds>(to - from);
+}
+
+}  // namespace
+
+MessageLineage::MessageLineage(const MessageLineage& other) {
+    std::lock_guard<std::mutex> lock(other.mtx);
+    hops = other.hops;
+}
+
+MessageLineage& MessageLineage::operator=(const MessageLineage& other) {
+    if(this == &other) return *this;
+    auto otherHops = other.getHops();
+    std::lock_guard<std::mutex> lock(mtx);
+    hops = std::move(otherHops);
+    return *this;
+}
+
+void MessageLineage::setEnabled(bool enabled) {
+    lineageEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool MessageLineage::isEnabled() {
+    return lineageEnabled.load(std::memory_order_relaxed);
+}
+
+std::vector<LineageHop> MessageLineage::getHops() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return hops;
+}
+
+std::vector<LineageHopLatency> MessageLineage::getLatencyBreakdown() const {
+    auto hops = getHops();
+    std::vector<LineageHopLatency> breakdown;
+    breakdown.reserve(hops.size());
+    const LineageHop* lastEmitted = nullptr;
+    for(const auto& hop : hops) {
+        LineageHopLatency latency;
+        latency.nodeId = hop.nodeId;
+        latency.name = hop.name;
+        if(lastEmitted != nullptr) latency.transport = between(lastEmitted->emitted, hop.enqueued);
+        latency.queueing = between(hop.enqueued, hop.dequeued);
+        latency.processing = between(hop.dequeued, hop.emitted);
+        breakdown.push_back(std::move(latency));
+        if(isSet(hop.emitted)) lastEmitted = &hop;
+    }
+    return breakdown;
+}
+
+std::string MessageLineage::toString() const {
+    auto format = [](const std::optional<std::chrono::microseconds>& duration) { return duration ? std::to_string(duration->count()) + "us" : std::string("-"); };
+    std::stringstream ss;
+    for(const auto& hop : getLatencyBreakdown()) {
+        ss << "[" << hop.nodeId << "] " << hop.name << ": transport " << format(hop.transport) << ", queueing " << format(hop.queueing) << ", processing "
+           << format(hop.processing) << "\n";
+    }
+    return ss.str();
+}
+
+void MessageLineage::addHop(LineageHop hop) {
+    if(hops.size() >= MAX_HOPS) hops.erase(hops.begin());
+    hops.push_back(std::move(hop));
+}
+
+void MessageLineage::recordEnqueue(ADatatype& msg, std::int64_t nodeId, const std::string& name) {
+    if(!msg.lineage) msg.lineage = std::make_shared<MessageLineage>();
+    LineageHop hop;
+    hop.nodeId = nodeId;
+    hop.name = name;
+    hop.enqueued = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(msg.lineage->mtx);
+    msg.lineage->addHop(std::move(hop));
+}
+
+void MessageLineage::recordDequeue(ADatatype& msg, std::int64_t nodeId, const std::string& name) {
+    const auto now = std::chrono::steady_clock::now();
+    const auto& lineage = msg.lineage.get();
+    if(lineage == nullptr) return;
+    {
+        std::lock_guard<std::mutex> lock(lineage->mtx);
+        auto it = std::find_if(lineage->hops.rbegin(), lineage->hops.rend(), [&](const LineageHop& hop) {
+            return hop.nodeId == nodeId && hop.name == name && isSet(hop.enqueued) && !isSet(hop.dequeued);
+        });
+        if(it != lineage->hops.rend()) it->dequeued = now;
+    }
+    if(nodeId >= 0) {
+        lastDequeuedLineage = lineage;
+        lastDequeuedNodeId = nodeId;
+    }
+}
+
+void MessageLineage::recordEmit(ADatatype& msg, std::int64_t nodeId, const std::string& name) {
+    const auto now = std::chrono::steady_clock::now();
+    if(!msg.lineage) {
+        // A newly created message, derive lineage from the last input the node received on this thread
+        auto lineage = std::make_shared<MessageLineage>();
+        if(lastDequeuedLineage != nullptr && lastDequeuedNodeId == nodeId) {
+            std::lock_guard<std::mutex> lock(lastDequeuedLineage->mtx);
+            // Keep upstream hops and the hop of this node, but not hops of sibling consumers of the input
+            std::copy_if(lastDequeuedLineage->hops.begin(), lastDequeuedLineage->hops.end(), std::back_inserter(lineage->hops), [&](const LineageHop& hop) {
+                return isSet(hop.emitted) || hop.nodeId == nodeId;
+            });
+        }
+        msg.lineage = std::move(lineage);
+        auto& hops = msg.lineage->hops;
+        auto it = std::find_if(hops.rbegin(), hops.rend(), [&](const LineageHop& hop) { return hop.nodeId == nodeId; });
+        if(it != hops.rend()) {
+            it->emitted = now;
+            return;
+        }
+    } else {
+        std::lock_guard<std::mutex> lock(msg.lineage->mtx);
+        auto& hops = msg.lineage->hops;
+        auto it = std::find_if(hops.rbegin(), hops.rend(), [&](const LineageHop& hop) { return hop.nodeId == nodeId && !isSet(hop.emitted); });
+        if(it != hops.rend()) {
+            it->emitted = now;
+            return;
+        }
+    }
+    // Node is the origin of the message (or resends it), start a new hop
+    LineageHop hop;
+    hop.nodeId = nodeId;
+    hop.name = name;
+    hop.emitted = now;
+    std::lock_guard<std::mutex> lock(msg.lineage->mtx);
+    msg.lineage->addHop(std::move(hop));
+}
+
+}  // namespace dai
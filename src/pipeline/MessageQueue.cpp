@@ -1,6 +1,8 @@
 #include "depthai/pipeline/MessageQueue.hpp"
 
 // std
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <iostream>
 
@@ -17,9 +19,28 @@
 
 namespace dai {
 
-MessageQueue::MessageQueue(std::string name, unsigned int maxSize, bool blocking) : queue(maxSize, blocking), name(std::move(name)) {}
+namespace {
 
-MessageQueue::MessageQueue(unsigned int maxSize, bool blocking) : queue(maxSize, blocking) {}
+// Bytes held by messages in all queues of the process
+std::atomic<std::int64_t> totalBytes{0};
+
+std::size_t messageBytes(const std::shared_ptr<ADatatype>& msg) {
+    return msg && msg->data ? msg->data->getSize() : 0;
+}
+
+void addTotalBytes(std::int64_t delta) {
+    totalBytes.fetch_add(delta, std::memory_order_relaxed);
+}
+
+}  // namespace
+
+MessageQueue::MessageQueue(std::string name, unsigned int maxSize, bool blocking) : queue(maxSize, blocking), name(std::move(name)) {
+    queue.setSizeFunction(messageBytes, addTotalBytes);
+}
+
+MessageQueue::MessageQueue(unsigned int maxSize, bool blocking) : queue(maxSize, blocking) {
+    queue.setSizeFunction(messageBytes, addTotalBytes);
+}
 
 bool MessageQueue::isClosed() const {
     return queue.isDestroyed();
@@ -29,6 +50,9 @@ void MessageQueue::close() {
     // Destroy queue
     queue.destruct();
 
+    // Unblock pending asynchronous gets
+    cancelAsyncGets();
+
     // Log if name not empty
     if(!name.empty()) spdlog::debug("MessageQueue ({}) closed", name);
 }
@@ -66,10 +90,36 @@ unsigned int MessageQueue::getSize() const {
     return queue.getSize();
 }
 
+void MessageQueue::setMaxBytes(std::size_t maxBytes) {
+    queue.setMaxBytes(maxBytes);
+}
+
+std::size_t MessageQueue::getMaxBytes() const {
+    return queue.getMaxBytes();
+}
+
+std::size_t MessageQueue::getBytes() const {
+    return queue.getBytes();
+}
+
+std::size_t MessageQueue::getTotalBytes() {
+    return static_cast<std::size_t>(std::max<std::int64_t>(totalBytes.load(std::memory_order_relaxed), 0));
+}
+
 unsigned int MessageQueue::isFull() const {
     return queue.isFull();
 }
 
+MessageQueue::Stats MessageQueue::getStats() const {
+    Stats stats;
+    stats.pushed = queue.getPushedCount();
+    stats.dropped = queue.getDroppedCount();
+    stats.blockedTime = queue.getBlockedTime();
+    stats.size = queue.getSize();
+    stats.heldBytes = queue.getBytes();
+    return stats;
+}
+
 int MessageQueue::addCallback(std::function<void(std::string, std::shared_ptr<ADatatype>)> callback) {
     // Lock first
     std::unique_lock<std::mutex> lock(callbacksMtx);
@@ -112,8 +162,10 @@ void MessageQueue::send(const std::shared_ptr<ADatatype>& msg) {
         throw QueueException(CLOSED_QUEUE_MESSAGE);
     }
     callCallbacks(msg);
+    recordEnqueue(msg);
     auto queueNotClosed = queue.push(msg);
     if(!queueNotClosed) throw QueueException(CLOSED_QUEUE_MESSAGE);
+    serveAsyncGets();
 }
 
 bool MessageQueue::send(const std::shared_ptr<ADatatype>& msg, std::chrono::milliseconds timeout) {
@@ -122,7 +174,10 @@ bool MessageQueue::send(const std::shared_ptr<ADatatype>& msg, std::chrono::mill
     if(queue.isDestroyed()) {
         throw QueueException(CLOSED_QUEUE_MESSAGE);
     }
-    return queue.tryWaitAndPush(msg, timeout);
+    recordEnqueue(msg);
+    bool sent = queue.tryWaitAndPush(msg, timeout);
+    if(sent) serveAsyncGets();
+    return sent;
 }
 
 bool MessageQueue::trySend(const std::shared_ptr<ADatatype>& msg) {
@@ -133,6 +188,63 @@ bool MessageQueue::trySend(const std::shared_ptr<ADatatype>& msg) {
     return send(msg, std::chrono::milliseconds(0));
 }
 
+MessageQueue::CallbackId MessageQueue::getAsync(std::function<void(std::shared_ptr<ADatatype>)> callback) {
+    std::shared_ptr<ADatatype> msg = nullptr;
+    CallbackId id;
+    {
+        std::unique_lock<std::mutex> lock(asyncGetsMtx);
+        id = uniqueAsyncGetId++;
+        // Earlier gets take precedence over the messages already in the queue
+        if(!asyncGets.empty() || !queue.tryPop(msg)) {
+            if(queue.isDestroyed()) {
+                lock.unlock();
+                callback(nullptr);
+                return id;
+            }
+            asyncGets.emplace_back(id, std::move(callback));
+            return id;
+        }
+    }
+    recordDequeue(msg);
+    callback(std::move(msg));
+    return id;
+}
+
+bool MessageQueue::cancelGetAsync(CallbackId getId) {
+    std::unique_lock<std::mutex> lock(asyncGetsMtx);
+    auto it = std::find_if(asyncGets.begin(), asyncGets.end(), [getId](const auto& get) { return get.first == getId; });
+    if(it == asyncGets.end()) return false;
+    asyncGets.erase(it);
+    return true;
+}
+
+void MessageQueue::serveAsyncGets() {
+    // Callbacks are called without holding the lock, so they can issue further gets
+    while(true) {
+        std::function<void(std::shared_ptr<ADatatype>)> callback;
+        std::shared_ptr<ADatatype> msg = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(asyncGetsMtx);
+            if(asyncGets.empty() || !queue.tryPop(msg)) return;
+            callback = std::move(asyncGets.front().second);
+            asyncGets.pop_front();
+        }
+        recordDequeue(msg);
+        callback(std::move(msg));
+    }
+}
+
+void MessageQueue::cancelAsyncGets() {
+    decltype(asyncGets) pending;
+    {
+        std::unique_lock<std::mutex> lock(asyncGetsMtx);
+        std::swap(pending, asyncGets);
+    }
+    for(auto& get : pending) {
+        get.second(nullptr);
+    }
+}
+
 void MessageQueue::callCallbacks(std::shared_ptr<ADatatype> message) {
     // Lock first
     std::lock_guard<std::mutex> lock(callbacksMtx);
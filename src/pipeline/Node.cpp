@@ -8,6 +8,14 @@
 
 namespace dai {
 
+namespace {
+// Nodes are identified in message lineage by alias if set, otherwise by name
+std::string lineageNameOf(const Node& node) {
+    auto alias = node.getAlias();
+    return alias.empty() ? std::string(node.getName()) : alias;
+}
+}  // namespace
+
 const Pipeline Node::getParentPipeline() const {
     auto impl = parent.lock();
     if(impl == nullptr) {
@@ -224,6 +232,27 @@ void Node::Output::unlink(Input& in) {
     in.connectedOutputs.erase(std::remove(in.connectedOutputs.begin(), in.connectedOutputs.end(), this), in.connectedOutputs.end());
 }
 
+Node::Output::Stats Node::Output::getStats() const {
+    Stats stats;
+    stats.messages = counters.messages.load(std::memory_order_relaxed);
+    stats.processedMessages = counters.processedMessages.load(std::memory_order_relaxed);
+    stats.processingTime = std::chrono::nanoseconds(counters.processingTimeNs.load(std::memory_order_relaxed));
+    return stats;
+}
+
+void Node::Output::recordSend(const std::shared_ptr<ADatatype>& msg) {
+    counters.messages.fetch_add(1, std::memory_order_relaxed);
+    if(MetricsRegistry::isEnabled()) {
+        if(auto processingTime = MetricsRegistry::getTimeSinceDequeue(getParent().id)) {
+            counters.processedMessages.fetch_add(1, std::memory_order_relaxed);
+            counters.processingTimeNs.fetch_add(processingTime->count(), std::memory_order_relaxed);
+        }
+    }
+    if(msg && MessageLineage::isEnabled()) {
+        MessageLineage::recordEmit(*msg, getParent().id, lineageNameOf(getParent()));
+    }
+}
+
 void Node::Output::send(const std::shared_ptr<ADatatype>& msg) {
     // for(auto& conn : getConnections()) {
     //     // Get node AND hold a reference to it.
@@ -239,6 +268,7 @@ void Node::Output::send(const std::shared_ptr<ADatatype>& msg) {
     //         }
     //     }
     // }
+    recordSend(msg);
     for(auto& messageQueue : connectedInputs) {
         messageQueue->send(msg);
     }
@@ -261,6 +291,7 @@ bool Node::Output::trySend(const std::shared_ptr<ADatatype>& msg) {
     //         }
     //     }
     // }
+    recordSend(msg);
     for(auto& messageQueue : connectedInputs) {
         success &= messageQueue->trySend(msg);
     }
@@ -268,6 +299,14 @@ bool Node::Output::trySend(const std::shared_ptr<ADatatype>& msg) {
     return success;
 }
 
+std::int64_t Node::Input::getParentNodeId() const {
+    return getParent().id;
+}
+
+std::string Node::Input::getParentNodeName() const {
+    return lineageNameOf(getParent());
+}
+
 void Node::Input::setWaitForMessage(bool newWaitForMessage) {
     waitForMessage = newWaitForMessage;
 }
@@ -811,6 +811,50 @@ void PipelineImpl::start() {
         const auto weak = std::weak_ptr<PipelineImpl>(shared);
         defaultDevice->pipelinePtr = weak;
     }
+
+    // Expose queue and node metrics while running
+    MetricsRegistry::getInstance().removeCollector(metricsCollectorId);
+    metricsCollectorId = MetricsRegistry::getInstance().addCollector([this](MetricsRegistry::Writer& writer) { collectMetrics(writer); });
+}
+
+void PipelineImpl::collectMetrics(MetricsRegistry::Writer& writer) const {
+    auto addQueue = [&writer](const MessageQueue& queue, const MetricsRegistry::Labels& labels) {
+        auto stats = queue.getStats();
+        writer.gauge("depthai_queue_messages", "Number of messages in the queue", labels, stats.size);
+        writer.gauge("depthai_queue_capacity", "Maximum number of messages in the queue", labels, queue.getMaxSize());
+        writer.gauge("depthai_queue_held_bytes", "Bytes held by payloads of messages in the queue", labels, static_cast<double>(stats.heldBytes));
+        writer.gauge("depthai_queue_capacity_bytes", "Maximum bytes held by the queue, 0 if not limited", labels, static_cast<double>(queue.getMaxBytes()));
+        writer.counter("depthai_queue_pushed_messages", "Messages pushed into the queue", labels, static_cast<double>(stats.pushed));
+        writer.counter("depthai_queue_dropped_messages", "Messages dropped because the queue was full", labels, static_cast<double>(stats.dropped));
+        writer.counter("depthai_queue_blocked_seconds",
+                       "Time senders spent blocked on the full queue",
+                       labels,
+                       std::chrono::duration<double>(stats.blockedTime).count());
+    };
+
+    for(const auto& node : getAllNodes()) {
+        const std::string nodeName = node->getAlias().empty() ? node->getName() : node->getAlias();
+        const std::string nodeId = std::to_string(node->id);
+        for(const auto* input : node->getInputRefs()) {
+            addQueue(*input, {{"node", nodeName}, {"node_id", nodeId}, {"queue", input->getName()}});
+        }
+        for(const auto* output : node->getOutputRefs()) {
+            auto stats = output->getStats();
+            MetricsRegistry::Labels labels{{"node", nodeName}, {"node_id", nodeId}, {"output", output->getName()}};
+            writer.counter("depthai_node_sent_messages", "Messages sent by the node output", labels, static_cast<double>(stats.messages));
+            writer.counter("depthai_node_processed_messages",
+                           "Messages sent with a measured node processing time",
+                           labels,
+                           static_cast<double>(stats.processedMessages));
+            writer.counter("depthai_node_processing_seconds",
+                           "Time between the node receiving an input and sending a message",
+                           labels,
+                           std::chrono::duration<double>(stats.processingTime).count());
+        }
+    }
+    for(const auto& queue : outputQueues) {
+        addQueue(*queue, {{"node", ""}, {"node_id", "-1"}, {"queue", queue->getName()}});
+    }
 }
 
 void PipelineImpl::resetConnections() {
@@ -854,6 +898,10 @@ void PipelineImpl::stop() {
     if(!running) {
         return;
     }
+    // Stop exposing metrics
+    MetricsRegistry::getInstance().removeCollector(metricsCollectorId);
+    metricsCollectorId = -1;
+
     // Stops the pipeline execution
     for(const auto& node : getAllNodes()) {
         if(node->runOnHost()) {
@@ -27,6 +27,7 @@ const std::unordered_map<DatatypeEnum, std::vector<DatatypeEnum>> hierarchy = {
          DatatypeEnum::EdgeDetectorConfig,
          DatatypeEnum::Tracklets,
          DatatypeEnum::IMUData,
+         DatatypeEnum::IMUBatch,
          DatatypeEnum::StereoDepthConfig,
          DatatypeEnum::FeatureTrackerConfig,
          DatatypeEnum::ThermalConfig,
@@ -64,6 +65,7 @@ const std::unordered_map<DatatypeEnum, std::vector<DatatypeEnum>> hierarchy = {
          DatatypeEnum::EdgeDetectorConfig,
          DatatypeEnum::Tracklets,
          DatatypeEnum::IMUData,
+         DatatypeEnum::IMUBatch,
          DatatypeEnum::StereoDepthConfig,
          DatatypeEnum::FeatureTrackerConfig,
          DatatypeEnum::ThermalConfig,
@@ -99,6 +101,7 @@ const std::unordered_map<DatatypeEnum, std::vector<DatatypeEnum>> hierarchy = {
     {DatatypeEnum::EdgeDetectorConfig, {}},
     {DatatypeEnum::Tracklets, {}},
     {DatatypeEnum::IMUData, {}},
+    {DatatypeEnum::IMUBatch, {}},
     {DatatypeEnum::StereoDepthConfig, {}},
     {DatatypeEnum::FeatureTrackerConfig, {}},
     {DatatypeEnum::ThermalConfig, {}},
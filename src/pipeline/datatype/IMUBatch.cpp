@@ -0,0 +1,329 @@
+#include "depthai/pipeline/datatype/IMUBatch.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace dai {
+
+namespace {
+
+constexpr std::array<IMUBatch::Report, 4> REPORTS = {
+    IMUBatch::Report::ACCELEROMETER, IMUBatch::Report::GYROSCOPE, IMUBatch::Report::MAGNETIC_FIELD, IMUBatch::Report::ROTATION_VECTOR};
+constexpr std::size_t MAX_COMPONENTS = 5;
+
+std::uint8_t reportBit(IMUBatch::Report report) {
+    return static_cast<std::uint8_t>(1u << static_cast<unsigned>(report));
+}
+
+size_t alignColumn(size_t size) {
+    return (size + 3) & ~size_t(3);
+}
+
+// Size of all columns of a report, each of them starts 4 byte aligned
+size_t reportSize(IMUBatch::Report report, size_t numPackets) {
+    return numPackets * (3 * sizeof(std::uint32_t) + IMUBatch::getNumComponents(report) * sizeof(float)) + alignColumn(numPackets);
+}
+
+const IMUReport& getReport(const IMUPacket& packet, IMUBatch::Report report) {
+    switch(report) {
+        case IMUBatch::Report::ACCELEROMETER:
+            return packet.acceleroMeter;
+        case IMUBatch::Report::GYROSCOPE:
+            return packet.gyroscope;
+        case IMUBatch::Report::MAGNETIC_FIELD:
+            return packet.magneticField;
+        case IMUBatch::Report::ROTATION_VECTOR:
+            return packet.rotationVector;
+    }
+    throw std::invalid_argument("Unknown IMU report");
+}
+
+IMUReport& getReport(IMUPacket& packet, IMUBatch::Report report) {
+    return const_cast<IMUReport&>(getReport(static_cast<const IMUPacket&>(packet), report));
+}
+
+void readValues(const IMUPacket& packet, IMUBatch::Report report, float* values) {
+    switch(report) {
+        case IMUBatch::Report::ACCELEROMETER:
+            values[0] = packet.acceleroMeter.x;
+            values[1] = packet.acceleroMeter.y;
+            values[2] = packet.acceleroMeter.z;
+            break;
+        case IMUBatch::Report::GYROSCOPE:
+            values[0] = packet.gyroscope.x;
+            values[1] = packet.gyroscope.y;
+            values[2] = packet.gyroscope.z;
+            break;
+        case IMUBatch::Report::MAGNETIC_FIELD:
+            values[0] = packet.magneticField.x;
+            values[1] = packet.magneticField.y;
+            values[2] = packet.magneticField.z;
+            break;
+        case IMUBatch::Report::ROTATION_VECTOR:
+            values[0] = packet.rotationVector.i;
+            values[1] = packet.rotationVector.j;
+            values[2] = packet.rotationVector.k;
+            values[3] = packet.rotationVector.real;
+            values[4] = packet.rotationVector.rotationVectorAccuracy;
+            break;
+    }
+}
+
+void writeValues(IMUPacket& packet, IMUBatch::Report report, const float* values) {
+    switch(report) {
+        case IMUBatch::Report::ACCELEROMETER:
+            packet.acceleroMeter.x = values[0];
+            packet.acceleroMeter.y = values[1];
+            packet.acceleroMeter.z = values[2];
+            break;
+        case IMUBatch::Report::GYROSCOPE:
+            packet.gyroscope.x = values[0];
+            packet.gyroscope.y = values[1];
+            packet.gyroscope.z = values[2];
+            break;
+        case IMUBatch::Report::MAGNETIC_FIELD:
+            packet.magneticField.x = values[0];
+            packet.magneticField.y = values[1];
+            packet.magneticField.z = values[2];
+            break;
+        case IMUBatch::Report::ROTATION_VECTOR:
+            packet.rotationVector.i = values[0];
+            packet.rotationVector.j = values[1];
+            packet.rotationVector.k = values[2];
+            packet.rotationVector.real = values[3];
+            packet.rotationVector.rotationVectorAccuracy = values[4];
+            break;
+    }
+}
+
+bool isSet(const Timestamp& timestamp) {
+    return timestamp.sec != 0 || timestamp.nsec != 0;
+}
+
+int64_t toNanoseconds(const Timestamp& timestamp) {
+    return timestamp.sec * 1000000000 + timestamp.nsec;
+}
+
+Timestamp fromNanoseconds(int64_t nanoseconds) {
+    Timestamp timestamp;
+    timestamp.sec = nanoseconds / 1000000000;
+    timestamp.nsec = nanoseconds % 1000000000;
+    return timestamp;
+}
+
+// Earliest and latest set timestamps of the stored reports
+struct TimeRange {
+    int64_t first = std::numeric_limits<int64_t>::max();
+    int64_t last = std::numeric_limits<int64_t>::min();
+    void add(const Timestamp& timestamp) {
+        if(!isSet(timestamp)) return;
+        first = std::min(first, toNanoseconds(timestamp));
+        last = std::max(last, toNanoseconds(timestamp));
+    }
+    bool empty() const {
+        return first > last;
+    }
+};
+
+std::uint32_t toOffset(const Timestamp& timestamp, const TimeRange& range) {
+    return isSet(timestamp) ? static_cast<std::uint32_t>(toNanoseconds(timestamp) - range.first) : IMUBatch::NO_TIMESTAMP;
+}
+
+Timestamp fromOffset(std::uint32_t offset, const Timestamp& base) {
+    return offset == IMUBatch::NO_TIMESTAMP ? Timestamp{} : fromNanoseconds(toNanoseconds(base) + offset);
+}
+
+template <typename T>
+void writeColumn(std::uint8_t*& column, const std::vector<T>& values) {
+    std::memcpy(column, values.data(), values.size() * sizeof(T));
+    column += alignColumn(values.size() * sizeof(T));
+}
+
+}  // namespace
+
+IMUBatch::IMUBatch(const IMUData& imuData) {
+    ts = imuData.ts;
+    tsDevice = imuData.tsDevice;
+    sequenceNum = imuData.sequenceNum;
+    setPackets(imuData.packets);
+}
+
+void IMUBatch::setPackets(span<const IMUPacket> packets) {
+    if(packets.size() > std::numeric_limits<std::uint32_t>::max()) {
+        throw std::invalid_argument("Too many packets for an IMUBatch");
+    }
+    std::uint8_t stored = 0;
+    TimeRange hostRange;
+    TimeRange deviceRange;
+    for(const auto& packet : packets) {
+        for(auto report : REPORTS) {
+            const auto& entry = getReport(packet, report);
+            if(!isSet(entry.timestamp) && !isSet(entry.tsDevice)) continue;
+            stored |= reportBit(report);
+            hostRange.add(entry.timestamp);
+            deviceRange.add(entry.tsDevice);
+        }
+    }
+    for(const auto* range : {&hostRange, &deviceRange}) {
+        if(!range->empty() && range->last - range->first > MAX_TIME_SPAN.count()) {
+            throw std::invalid_argument("IMU reports of a batch have to lie within IMUBatch::MAX_TIME_SPAN of each other");
+        }
+    }
+
+    const size_t count = packets.size();
+    size_t size = 0;
+    for(auto report : REPORTS) {
+        if(stored & reportBit(report)) size += reportSize(report, count);
+    }
+    std::vector<std::uint8_t> buffer(size);
+    std::uint8_t* column = buffer.data();
+    std::vector<std::uint32_t> offsets(count);
+    std::vector<std::int32_t> sequenceNums(count);
+    std::vector<float> values;
+    std::vector<std::uint8_t> accuracies(count);
+    for(auto report : REPORTS) {
+        if(!(stored & reportBit(report))) continue;
+        for(size_t i = 0; i < count; i++) offsets[i] = toOffset(getReport(packets[i], report).timestamp, hostRange);
+        writeColumn(column, offsets);
+        for(size_t i = 0; i < count; i++) offsets[i] = toOffset(getReport(packets[i], report).tsDevice, deviceRange);
+        writeColumn(column, offsets);
+        const size_t numComponents = getNumComponents(report);
+        values.resize(count * numComponents);
+        for(size_t i = 0; i < count; i++) {
+            const auto& entry = getReport(packets[i], report);
+            sequenceNums[i] = entry.sequence;
+            accuracies[i] = static_cast<std::uint8_t>(entry.accuracy);
+        }
+        writeColumn(column, sequenceNums);
+        for(size_t i = 0; i < count; i++) readValues(packets[i], report, &values[i * numComponents]);
+        writeColumn(column, values);
+        writeColumn(column, accuracies);
+    }
+
+    setData(std::move(buffer));
+    numPackets = static_cast<std::uint32_t>(count);
+    reports = stored;
+    baseTimestamp = hostRange.empty() ? Timestamp{} : fromNanoseconds(hostRange.first);
+    baseTimestampDevice = deviceRange.empty() ? Timestamp{} : fromNanoseconds(deviceRange.first);
+}
+
+std::vector<IMUPacket> IMUBatch::getPackets() const {
+    std::vector<IMUPacket> packets(numPackets);
+    std::array<float, MAX_COMPONENTS> buffer{};
+    for(auto report : REPORTS) {
+        if(!hasReport(report)) continue;
+        const auto timestampOffsets = getTimestampOffsets(report);
+        const auto timestampDeviceOffsets = getTimestampDeviceOffsets(report);
+        const auto sequenceNums = getSequenceNums(report);
+        const auto values = getValues(report);
+        const auto accuracies = getAccuracies(report);
+        const size_t numComponents = getNumComponents(report);
+        for(size_t i = 0; i < packets.size(); i++) {
+            auto& output = getReport(packets[i], report);
+            output.timestamp = fromOffset(timestampOffsets[i], baseTimestamp);
+            output.tsDevice = fromOffset(timestampDeviceOffsets[i], baseTimestampDevice);
+            output.sequence = sequenceNums[i];
+            output.accuracy = accuracies[i];
+            std::copy_n(values.begin() + i * numComponents, numComponents, buffer.begin());
+            writeValues(packets[i], report, buffer.data());
+        }
+    }
+    return packets;
+}
+
+std::shared_ptr<IMUData> IMUBatch::toIMUData() const {
+    auto imuData = std::make_shared<IMUData>();
+    imuData->ts = ts;
+    imuData->tsDevice = tsDevice;
+    imuData->sequenceNum = sequenceNum;
+    imuData->packets = getPackets();
+    return imuData;
+}
+
+std::size_t IMUBatch::getNumPackets() const {
+    return numPackets;
+}
+
+bool IMUBatch::hasReport(Report report) const {
+    return (reports & reportBit(report)) != 0;
+}
+
+std::size_t IMUBatch::getNumComponents(Report report) {
+    return report == Report::ROTATION_VECTOR ? 5 : 3;
+}
+
+std::chrono::time_point<std::chrono::steady_clock, std::chrono::steady_clock::duration> IMUBatch::getBaseTimestamp() const {
+    return baseTimestamp.get();
+}
+
+std::chrono::time_point<std::chrono::steady_clock, std::chrono::steady_clock::duration> IMUBatch::getBaseTimestampDevice() const {
+    return baseTimestampDevice.get();
+}
+
+span<const std::uint32_t> IMUBatch::getTimestampOffsets(Report report) const {
+    const auto* column = getColumn(report, Column::TIMESTAMP);
+    if(column == nullptr) return {};
+    return {reinterpret_cast<const std::uint32_t*>(column), numPackets};
+}
+
+span<const std::uint32_t> IMUBatch::getTimestampDeviceOffsets(Report report) const {
+    const auto* column = getColumn(report, Column::TIMESTAMP_DEVICE);
+    if(column == nullptr) return {};
+    return {reinterpret_cast<const std::uint32_t*>(column), numPackets};
+}
+
+span<const std::int32_t> IMUBatch::getSequenceNums(Report report) const {
+    const auto* column = getColumn(report, Column::SEQUENCE);
+    if(column == nullptr) return {};
+    return {reinterpret_cast<const std::int32_t*>(column), numPackets};
+}
+
+span<const float> IMUBatch::getValues(Report report) const {
+    const auto* column = getColumn(report, Column::VALUES);
+    if(column == nullptr) return {};
+    return {reinterpret_cast<const float*>(column), numPackets * getNumComponents(report)};
+}
+
+span<const IMUReport::Accuracy> IMUBatch::getAccuracies(Report report) const {
+    const auto* column = getColumn(report, Column::ACCURACY);
+    if(column == nullptr) return {};
+    return {reinterpret_cast<const IMUReport::Accuracy*>(column), numPackets};
+}
+
+const std::uint8_t* IMUBatch::getColumn(Report report, Column column) const {
+    if(!hasReport(report)) return nullptr;
+    size_t offset = 0;
+    size_t size = 0;
+    for(auto stored : REPORTS) {
+        if(!hasReport(stored)) continue;
+        if(stored < report) offset += reportSize(stored, numPackets);
+        size += reportSize(stored, numPackets);
+    }
+    const auto buffer = getData();
+    if(buffer.size() < size) {
+        throw std::runtime_error("IMUBatch data is smaller than the columns of its packets");
+    }
+    const size_t column32 = numPackets * sizeof(std::uint32_t);
+    switch(column) {
+        case Column::ACCURACY:
+            offset += numPackets * getNumComponents(report) * sizeof(float);
+            [[fallthrough]];
+        case Column::VALUES:
+            offset += column32;
+            [[fallthrough]];
+        case Column::SEQUENCE:
+            offset += column32;
+            [[fallthrough]];
+        case Column::TIMESTAMP_DEVICE:
+            offset += column32;
+            [[fallthrough]];
+        case Column::TIMESTAMP:
+            break;
+    }
+    return buffer.data() + offset;
+}
+
+}  // namespace dai
@@ -1,4 +1,6 @@
 #include "depthai/pipeline/datatype/ImgDetections.hpp"
+
+#include <stdexcept>
 #ifdef DEPTHAI_ENABLE_PROTOBUF
     #include "depthai/schemas/ImgDetections.pb.h"
     #include "utility/ProtoSerialize.hpp"
@@ -6,6 +8,91 @@
 
 namespace dai {
 
+ImgDetectionArrays::ImgDetectionArrays(span<const ImgDetection> detections) {
+    reserve(detections.size());
+    for(const auto& detection : detections) add(detection);
+}
+
+std::size_t ImgDetectionArrays::size() const {
+    return confidences.size();
+}
+
+bool ImgDetectionArrays::empty() const {
+    return confidences.empty();
+}
+
+void ImgDetectionArrays::reserve(std::size_t size) {
+    boxes.reserve(size * 4);
+    confidences.reserve(size);
+    labels.reserve(size);
+}
+
+void ImgDetectionArrays::clear() {
+    boxes.clear();
+    confidences.clear();
+    labels.clear();
+    labelNames.clear();
+}
+
+void ImgDetectionArrays::add(const ImgDetection& detection) {
+    // Label names are only stored once a detection has one
+    if(!detection.labelName.empty() && labelNames.empty()) labelNames.resize(size());
+    if(!labelNames.empty()) labelNames.push_back(detection.labelName);
+    boxes.insert(boxes.end(), {detection.xmin, detection.ymin, detection.xmax, detection.ymax});
+    confidences.push_back(detection.confidence);
+    labels.push_back(detection.label);
+}
+
+ImgDetection ImgDetectionArrays::get(std::size_t index) const {
+    if(index >= size()) throw std::out_of_range("ImgDetectionArrays index out of range");
+    if(boxes.size() < (index + 1) * 4 || labels.size() <= index || (!labelNames.empty() && labelNames.size() <= index)) {
+        throw std::invalid_argument("ImgDetectionArrays arrays have to hold the same number of detections");
+    }
+    ImgDetection detection;
+    detection.label = labels[index];
+    if(!labelNames.empty()) detection.labelName = labelNames[index];
+    detection.confidence = confidences[index];
+    detection.xmin = boxes[index * 4];
+    detection.ymin = boxes[index * 4 + 1];
+    detection.xmax = boxes[index * 4 + 2];
+    detection.ymax = boxes[index * 4 + 3];
+    return detection;
+}
+
+std::vector<ImgDetection> ImgDetectionArrays::toDetections() const {
+    if(boxes.size() != size() * 4 || labels.size() != size() || (!labelNames.empty() && labelNames.size() != size())) {
+        throw std::invalid_argument("ImgDetectionArrays arrays have to hold the same number of detections");
+    }
+    std::vector<ImgDetection> detections;
+    detections.reserve(size());
+    for(std::size_t i = 0; i < size(); i++) detections.push_back(get(i));
+    return detections;
+}
+
+bool ImgDetectionArrays::matches(std::size_t index, const ImgDetection& detection) const {
+    if(index >= size() || boxes.size() < (index + 1) * 4 || labels.size() <= index) return false;
+    if(labelNames.empty() ? !detection.labelName.empty() : labelNames.size() <= index || labelNames[index] != detection.labelName) return false;
+    return labels[index] == detection.label && confidences[index] == detection.confidence && boxes[index * 4] == detection.xmin
+           && boxes[index * 4 + 1] == detection.ymin && boxes[index * 4 + 2] == detection.xmax && boxes[index * 4 + 3] == detection.ymax;
+}
+
+bool ImgDetectionArrays::matches(span<const ImgDetection> detections) const {
+    if(detections.size() != size() || boxes.size() != size() * 4 || labels.size() != size()) return false;
+    for(std::size_t i = 0; i < detections.size(); i++) {
+        if(!matches(i, detections[i])) return false;
+    }
+    return true;
+}
+
+const ImgDetectionArrays& ImgDetections::getArrays() const {
+    return arraysCache.get([this](const ImgDetectionArrays& kept) { return kept.matches(detections); }, [this]() { return ImgDetectionArrays(detections); });
+}
+
+void ImgDetections::setArrays(const ImgDetectionArrays& arrays) {
+    detections = arrays.toDetections();
+    arraysCache.set(arrays);
+}
+
 #ifdef DEPTHAI_ENABLE_PROTOBUF
 ProtoSerializable::SchemaPair ImgDetections::serializeSchema() const {
     return utility::serializeSchema(utility::getProtoMessage(this));
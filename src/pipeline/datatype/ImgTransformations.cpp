@@ -2,9 +2,12 @@
 
 #include <assert.h>
 
+#include <algorithm>
 #include <cstring>
 
+#include "depthai/pipeline/datatype/ImgDetections.hpp"
 #include "depthai/utility/ImageManipImpl.hpp"
+#include "utility/Simd.hpp"
 
 namespace dai {
 
@@ -101,6 +104,124 @@ std::array<std::array<float, 3>, 3> getMatrixInverse(const std::array<std::array
     return inv;
 }
 
+#if defined(DEPTHAI_SIMD_SSE2)
+using Float4 = __m128;
+inline Float4 load4(const float* p) {
+    return _mm_loadu_ps(p);
+}
+inline void store4(float* p, Float4 v) {
+    _mm_storeu_ps(p, v);
+}
+inline Float4 set4(float v) {
+    return _mm_set1_ps(v);
+}
+inline Float4 add4(Float4 a, Float4 b) {
+    return _mm_add_ps(a, b);
+}
+inline Float4 mul4(Float4 a, Float4 b) {
+    return _mm_mul_ps(a, b);
+}
+inline Float4 div4(Float4 a, Float4 b) {
+    return _mm_div_ps(a, b);
+}
+#elif defined(DEPTHAI_SIMD_NEON)
+using Float4 = float32x4_t;
+inline Float4 load4(const float* p) {
+    return vld1q_f32(p);
+}
+inline void store4(float* p, Float4 v) {
+    vst1q_f32(p, v);
+}
+inline Float4 set4(float v) {
+    return vdupq_n_f32(v);
+}
+inline Float4 add4(Float4 a, Float4 b) {
+    return vaddq_f32(a, b);
+}
+inline Float4 mul4(Float4 a, Float4 b) {
+    return vmulq_f32(a, b);
+}
+inline Float4 div4(Float4 a, Float4 b) {
+    #if defined(__aarch64__)
+    return vdivq_f32(a, b);
+    #else
+    // 32 bit NEON has no exact division
+    float lanesA[4], lanesB[4];
+    vst1q_f32(lanesA, a);
+    vst1q_f32(lanesB, b);
+    for(int i = 0; i < 4; ++i) lanesA[i] /= lanesB[i];
+    return vld1q_f32(lanesA);
+    #endif
+}
+#endif
+
+// Applies homography to points in place, given as separate x and y coordinates. The vector path does the same operations as the scalar one,
+// so results don't depend on where a point falls in the batch
+inline void applyHomography(const std::array<std::array<float, 3>, 3>& M, float* x, float* y, size_t count) {
+    const float m00 = M[0][0], m01 = M[0][1], m02 = M[0][2];
+    const float m10 = M[1][0], m11 = M[1][1], m12 = M[1][2];
+    const float m20 = M[2][0], m21 = M[2][1], m22 = M[2][2];
+    size_t i = 0;
+#if defined(DEPTHAI_SIMD_SSE2) || defined(DEPTHAI_SIMD_NEON)
+    const Float4 v00 = set4(m00), v01 = set4(m01), v02 = set4(m02);
+    const Float4 v10 = set4(m10), v11 = set4(m11), v12 = set4(m12);
+    const Float4 v20 = set4(m20), v21 = set4(m21), v22 = set4(m22);
+    const Float4 one = set4(1.0f);
+    for(; i + 4 <= count; i += 4) {
+        const Float4 px = load4(x + i);
+        const Float4 py = load4(y + i);
+        const Float4 invZ = div4(one, add4(add4(mul4(v20, px), mul4(v21, py)), v22));
+        store4(x + i, mul4(add4(add4(mul4(v00, px), mul4(v01, py)), v02), invZ));
+        store4(y + i, mul4(add4(add4(mul4(v10, px), mul4(v11, py)), v12), invZ));
+    }
+#endif
+    for(; i < count; ++i) {
+        const float px = x[i];
+        const float py = y[i];
+        const float invZ = 1.0f / (m20 * px + m21 * py + m22);
+        x[i] = (m00 * px + m01 * py + m02) * invZ;
+        y[i] = (m10 * px + m11 * py + m12) * invZ;
+    }
+}
+
+// Applies homography to points in place, split into chunks of separate coordinates on the stack
+inline void applyHomography(const std::array<std::array<float, 3>, 3>& M, span<dai::Point2f> points) {
+    constexpr size_t CHUNK = 64;
+    float x[CHUNK], y[CHUNK];
+    for(size_t start = 0; start < points.size(); start += CHUNK) {
+        const size_t count = std::min(CHUNK, points.size() - start);
+        for(size_t i = 0; i < count; ++i) {
+            x[i] = points[start + i].x;
+            y[i] = points[start + i].y;
+        }
+        applyHomography(M, x, y, count);
+        for(size_t i = 0; i < count; ++i) {
+            points[start + i].x = x[i];
+            points[start + i].y = y[i];
+        }
+    }
+}
+
+// Maps the corners of a rect with a homography and fits the smallest rotated rect around them
+inline dai::RotatedRect fitTransformedRect(const std::array<std::array<float, 3>, 3>& M, const dai::RotatedRect& rect) {
+    const auto points = rect.getPoints();
+    float x[4], y[4];
+    for(auto i = 0U; i < 4; ++i) {
+        x[i] = points[i].x;
+        y[i] = points[i].y;
+    }
+    applyHomography(M, x, y, 4);
+    return impl::getRotatedRectFromCorners({{{x[0], y[0]}, {x[1], y[1]}, {x[2], y[2]}, {x[3], y[3]}}});
+}
+
+// Converts remap matrix operating on pixel coordinates to one operating on normalized coordinates
+inline std::array<std::array<float, 3>, 3> normalizedRemapMatrix(
+    const std::array<std::array<float, 3>, 3>& M, size_t fromWidth, size_t fromHeight, size_t toWidth, size_t toHeight) {
+    std::array<std::array<float, 3>, 3> denormalize = {{{(float)fromWidth, 0, 0}, {0, (float)fromHeight, 0}, {0, 0, 1}}};
+    std::array<std::array<float, 3>, 3> normalize = {{{1.0f / toWidth, 0, 0}, {0, 1.0f / toHeight, 0}, {0, 0, 1}}};
+    return matmul(normalize, matmul(M, denormalize));
+}
+
 dai::Point2f interSourceFrameTransform(dai::Point2f sourcePt, const ImgTransformation& from, const ImgTransformation& to) {
     auto fromSource = from.getSourceIntrinsicMatrix();
     auto fromSourceInv = from.getSourceIntrinsicMatrixInv();
@@ -110,19 +231,42 @@ dai::Point2f interSourceFrameTransform(dai::Point2f sourcePt, const ImgTransform
     auto transformed = matvecmul(transformMat, {sourcePt.x, sourcePt.y});
     return {transformed[0], transformed[1]};
 }
-dai::RotatedRect interSourceFrameTransform(dai::RotatedRect sourceRect, const ImgTransformation& from, const ImgTransformation& to) {
-    auto fromSource = from.getSourceIntrinsicMatrix();
-    auto toSource = to.getSourceIntrinsicMatrix();
-    if(mateq(fromSource, toSource)) return sourceRect;
-
-    const auto points = sourceRect.getPoints();
-    std::vector<std::array<float, 2>> vPoints(points.size());
-    for(auto i = 0U; i < points.size(); ++i) {
-        auto point = interSourceFrameTransform(points[i], from, to);
-        vPoints[i] = {point.x, point.y};
+// Remaps rects between transformations the way remapRectTo does: to the source frame, between source frames and to the destination frame,
+// fitting a rotated rect after each step. Matrices are looked up once, so batches share them
+class RectRemap {
+   public:
+    RectRemap(const ImgTransformation& from, const ImgTransformation& to)
+        : fromMatrixInv(from.getMatrixInv()),
+          sourceMatrix(matmul(to.getSourceIntrinsicMatrix(), from.getSourceIntrinsicMatrixInv())),
+          sameSource(mateq(from.getSourceIntrinsicMatrix(), to.getSourceIntrinsicMatrix())),
+          toMatrix(to.getMatrix()),
+          fromSize(from.getSize()),
+          toSize(to.getSize()) {}
+
+    dai::RotatedRect operator()(dai::RotatedRect rect) const {
+        const bool normalized = rect.isNormalized();
+        if(normalized) {
+            rect = rect.denormalize(fromSize.first, fromSize.second);
+        }
+        rect = fitTransformedRect(fromMatrixInv, rect);
+        if(!sameSource) {
+            rect = fitTransformedRect(sourceMatrix, rect);
+        }
+        rect = fitTransformedRect(toMatrix, rect);
+        if(normalized) {
+            rect = rect.normalize(toSize.first, toSize.second);
+        }
+        return rect;
     }
-    return impl::getRotatedRectFromPoints(vPoints);
-}
+
+   private:
+    std::array<std::array<float, 3>, 3> fromMatrixInv;
+    std::array<std::array<float, 3>, 3> sourceMatrix;
+    bool sameSource;
+    std::array<std::array<float, 3>, 3> toMatrix;
+    std::pair<size_t, size_t> fromSize;
+    std::pair<size_t, size_t> toSize;
+};
 
 void ImgTransformation::calcCrops() {
     if(cropsValid) return;
@@ -159,26 +303,14 @@ dai::Point2f ImgTransformation::transformPoint(dai::Point2f point) const {
     return {transformed[0], transformed[1]};
 }
 dai::RotatedRect ImgTransformation::transformRect(dai::RotatedRect rect) const {
-    const auto points = rect.getPoints();
-    std::vector<std::array<float, 2>> vPoints(points.size());
-    for(auto i = 0U; i < points.size(); ++i) {
-        auto point = transformPoint(points[i]);
-        vPoints[i] = {point.x, point.y};
-    }
-    return impl::getRotatedRectFromPoints(vPoints);
+    return fitTransformedRect(transformationMatrix, rect);
 }
 dai::Point2f ImgTransformation::invTransformPoint(dai::Point2f point) const {
     auto transformed = matvecmul(transformationMatrixInv, {point.x, point.y});
     return {transformed[0], transformed[1]};
 }
 dai::RotatedRect ImgTransformation::invTransformRect(dai::RotatedRect rect) const {
-    const auto points = rect.getPoints();
-    std::vector<std::array<float, 2>> vPoints(points.size());
-    for(auto i = 0U; i < points.size(); ++i) {
-        auto point = invTransformPoint(points[i]);
-        vPoints[i] = {point.x, point.y};
-    }
-    return impl::getRotatedRectFromPoints(vPoints);
+    return fitTransformedRect(transformationMatrixInv, rect);
 }
 
 std::pair<size_t, size_t> ImgTransformation::getSize() const {
@@ -420,30 +552,54 @@ dai::Point2f ImgTransformation::remapPointFrom(const ImgTransformation& from, da
     return transformed;
 }
 dai::RotatedRect ImgTransformation::remapRectTo(const ImgTransformation& to, dai::RotatedRect rect) const {
-    bool normalized = rect.isNormalized();
-    if(normalized) {
-        rect = rect.denormalize(width, height);
-    }
-    auto sourceRectFrom = invTransformRect(rect);
-    auto sourceRectTo = interSourceFrameTransform(sourceRectFrom, *this, to);
-    auto transformed = to.transformRect(sourceRectTo);
-    if(normalized) {
-        transformed = transformed.normalize(to.width, to.height);
-    }
-    return transformed;
+    return RectRemap(*this, to)(rect);
 }
 dai::RotatedRect ImgTransformation::remapRectFrom(const ImgTransformation& from, dai::RotatedRect rect) const {
-    bool normalized = rect.isNormalized();
-    if(normalized) {
-        rect = rect.denormalize(from.width, from.height);
+    return RectRemap(from, *this)(rect);
+}
+
+std::array<std::array<float, 3>, 3> ImgTransformation::getRemapMatrixTo(const ImgTransformation& to) const {
+    auto remapMatrix = transformationMatrixInv;
+    if(!mateq(sourceIntrinsicMatrix, to.sourceIntrinsicMatrix)) {
+        remapMatrix = matmul(matmul(to.sourceIntrinsicMatrix, sourceIntrinsicMatrixInv), remapMatrix);
     }
-    auto sourceRectFrom = from.invTransformRect(rect);
-    auto sourceRectTo = interSourceFrameTransform(sourceRectFrom, from, *this);
-    auto transformed = transformRect(sourceRectTo);
-    if(normalized) {
-        transformed = transformed.normalize(width, height);
+    return matmul(to.transformationMatrix, remapMatrix);
+}
+void ImgTransformation::transformPoints(span<dai::Point2f> points) const {
+    applyHomography(transformationMatrix, points);
+}
+void ImgTransformation::invTransformPoints(span<dai::Point2f> points) const {
+    applyHomography(transformationMatrixInv, points);
+}
+void ImgTransformation::remapPointsTo(const ImgTransformation& to, span<dai::Point2f> points) const {
+    const auto remapMatrix = getRemapMatrixTo(to);
+    const auto remapMatrixNormalized = normalizedRemapMatrix(remapMatrix, width, height, to.width, to.height);
+    // Points are processed in runs sharing the same normalization, to keep the inner loop uniform
+    size_t start = 0;
+    while(start < points.size()) {
+        const bool normalized = points[start].isNormalized();
+        size_t end = start + 1;
+        while(end < points.size() && points[end].isNormalized() == normalized) ++end;
+        applyHomography(normalized ? remapMatrixNormalized : remapMatrix, points.subspan(start, end - start));
+        for(size_t i = start; i < end; ++i) points[i].normalized = normalized;
+        start = end;
+    }
+}
+void ImgTransformation::remapRectsTo(const ImgTransformation& to, span<dai::RotatedRect> rects) const {
+    const RectRemap remap(*this, to);
+    for(auto& rect : rects) rect = remap(rect);
+}
+void ImgTransformation::remapDetectionsTo(const ImgTransformation& to, span<dai::ImgDetection> detections) const {
+    const auto remapMatrix = normalizedRemapMatrix(getRemapMatrixTo(to), width, height, to.width, to.height);
+    for(auto& detection : detections) {
+        float x[4] = {detection.xmin, detection.xmax, detection.xmax, detection.xmin};
+        float y[4] = {detection.ymin, detection.ymin, detection.ymax, detection.ymax};
+        applyHomography(remapMatrix, x, y, 4);
+        detection.xmin = std::clamp(std::min({x[0], x[1], x[2], x[3]}), 0.0f, 1.0f);
+        detection.xmax = std::clamp(std::max({x[0], x[1], x[2], x[3]}), 0.0f, 1.0f);
+        detection.ymin = std::clamp(std::min({y[0], y[1], y[2], y[3]}), 0.0f, 1.0f);
+        detection.ymax = std::clamp(std::max({y[0], y[1], y[2], y[3]}), 0.0f, 1.0f);
     }
-    return transformed;
 }
 
 };  // namespace dai
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+
+#include "depthai/common/ImgTransformations.hpp"
+#include "depthai/common/optional.hpp"
+#include "depthai/pipeline/datatype/ImgFrame.hpp"
+#include "depthai/utility/Serialization.hpp"
+
+namespace dai {
+
+/**
+ * ImgFrame metadata with the transformation replaced by a reference to an interned one, see StreamMessageParser::TransformationCache.
+ * Fields other than the transformation follow the serialization of ImgFrame, which the stream message parser tests check.
+ */
+struct InternedImgFrame {
+    Timestamp ts = {};
+    Timestamp tsDevice = {};
+    std::int64_t sequenceNum = 0;
+    ImgFrame::Specs fb = {};
+    ImgFrame::Specs sourceFb = {};
+    ImgFrame::CameraSettings cam = {};
+    std::uint32_t category = 0;
+    std::uint32_t instanceNum = 0;
+    std::uint32_t transformationId = 0;
+    // Only sent along with the first use of the id
+    std::optional<ImgTransformation> transformation;
+
+    DEPTHAI_SERIALIZE(InternedImgFrame, ts, tsDevice, sequenceNum, fb, sourceFb, cam, category, instanceNum, transformationId, transformation);
+};
+
+}  // namespace dai
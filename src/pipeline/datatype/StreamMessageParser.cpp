@@ -1,6 +1,7 @@
 #include "depthai/pipeline/datatype/StreamMessageParser.hpp"
 
 // standard
+#include <algorithm>
 #include <memory>
 #include <sstream>
 
@@ -22,6 +23,7 @@
 #include "depthai/pipeline/datatype/EdgeDetectorConfig.hpp"
 #include "depthai/pipeline/datatype/EncodedFrame.hpp"
 #include "depthai/pipeline/datatype/FeatureTrackerConfig.hpp"
+#include "depthai/pipeline/datatype/IMUBatch.hpp"
 #include "depthai/pipeline/datatype/IMUData.hpp"
 #include "depthai/pipeline/datatype/ImageAlignConfig.hpp"
 #include "depthai/pipeline/datatype/ImageFiltersConfig.hpp"
@@ -49,6 +51,7 @@
 // shared
 #include "depthai/pipeline/datatype/DatatypeEnum.hpp"
 #include "depthai/utility/Serialization.hpp"
+#include "pipeline/datatype/InternedImgFrame.hpp"
 #include "utility/SharedMemory.hpp"
 #include "utility/VectorMemory.hpp"
 #include "xlink/XLinkStream.hpp"
@@ -60,6 +63,55 @@ namespace dai {
 
 static constexpr std::array<uint8_t, 16> endOfPacketMarker = {0xAB, 0xCD, 0xEF, 0x01, 0x23, 0x45, 0x67, 0x89, 0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0};
 
+// Wire flag set in the object type of the packet trailer when an ImgFrame carries an InternedImgFrame as metadata.
+// It lies outside of the DatatypeEnum values, so parsers which don't know it reject the packet as an unknown type instead of misreading it.
+// Receiving depends on the sender: XLinkInHost resolves interned packets, which device firmware may send once it interns transformations.
+// Sending depends on the receiver: XLinkOutHost only sends plain ImgFrame metadata, until device firmware parses the flag.
+static constexpr std::int32_t internedTransformationFlag = 0x40000000;
+
+static bool equalTransformations(const ImgTransformation& a, const ImgTransformation& b) {
+    if(a.getSize() != b.getSize() || a.getSourceSize() != b.getSourceSize() || a.getMatrix() != b.getMatrix() || a.getMatrixInv() != b.getMatrixInv()
+       || a.getSourceIntrinsicMatrix() != b.getSourceIntrinsicMatrix() || a.getSourceIntrinsicMatrixInv() != b.getSourceIntrinsicMatrixInv()
+       || a.getDistortionModel() != b.getDistortionModel() || a.getDistortionCoefficients() != b.getDistortionCoefficients()) {
+        return false;
+    }
+    const auto cropsA = a.getSrcCrops();
+    const auto cropsB = b.getSrcCrops();
+    return std::equal(cropsA.begin(), cropsA.end(), cropsB.begin(), cropsB.end(), [](const RotatedRect& cropA, const RotatedRect& cropB) {
+        return cropA.center.x == cropB.center.x && cropA.center.y == cropB.center.y && cropA.size.width == cropB.size.width
+               && cropA.size.height == cropB.size.height && cropA.angle == cropB.angle;
+    });
+}
+
+void StreamMessageParser::TransformationCache::reset() {
+    lastId = 0;
+    entries.clear();
+}
+
+std::pair<std::uint32_t, bool> StreamMessageParser::TransformationCache::intern(const ImgTransformation& transformation) {
+    for(const auto& entry : entries) {
+        if(equalTransformations(entry.second, transformation)) return {entry.first, false};
+    }
+    // Ids start at 1 and skip 0 on wrap around
+    const std::uint32_t id = lastId == UINT32_MAX ? 1 : lastId + 1;
+    insert(id, transformation);
+    return {id, true};
+}
+
+const ImgTransformation* StreamMessageParser::TransformationCache::find(std::uint32_t id) const {
+    for(const auto& entry : entries) {
+        if(entry.first == id) return &entry.second;
+    }
+    return nullptr;
+}
+
+void StreamMessageParser::TransformationCache::insert(std::uint32_t id, const ImgTransformation& transformation) {
+    // The sender and the receiver evict the same entries, as both insert the same ids in the same order
+    lastId = id;
+    entries.emplace_back(id, transformation);
+    if(entries.size() > CAPACITY) entries.pop_front();
+}
+
 // Reads int from little endian format
 inline int readIntLE(uint8_t* data) {
     return data[0] + data[1] * 256 + data[2] * 256 * 256 + data[3] * 256 * 256 * 256;
@@ -80,13 +132,15 @@ inline std::shared_ptr<T> parseDatatype(std::uint8_t* metadata, size_t size, std
     return tmp;
 }
 
-static std::tuple<DatatypeEnum, size_t, size_t> parseHeader(streamPacketDesc_t* const packet) {
+static std::tuple<DatatypeEnum, size_t, size_t, bool> parseHeader(streamPacketDesc_t* const packet) {
     if(packet->length < 24) {
         throw std::runtime_error(fmt::format("Bad packet, couldn't parse (not enough data), total size {}", packet->length));
     }
     const std::uint32_t packetLength = packet->length - endOfPacketMarker.size();
     const int serializedObjectSize = readIntLE(packet->data + packetLength - 4);
-    const auto objectType = static_cast<DatatypeEnum>(readIntLE(packet->data + packetLength - 8));
+    const int rawObjectType = readIntLE(packet->data + packetLength - 8);
+    const bool interned = (rawObjectType & internedTransformationFlag) != 0;
+    const auto objectType = static_cast<DatatypeEnum>(rawObjectType & ~internedTransformationFlag);
 
     uint8_t* marker = packet->data + packetLength;
     if(memcmp(marker, endOfPacketMarker.data(), endOfPacketMarker.size()) != 0) {
@@ -117,15 +171,23 @@ static std::tuple<DatatypeEnum, size_t, size_t> parseHeader(streamPacketDesc_t*
         throw std::runtime_error("Bad packet, couldn't parse (metadata out of bounds)" + info);
     }
 
-    return {objectType, serializedObjectSize, bufferLength};
+    if(interned && objectType != DatatypeEnum::ImgFrame) {
+        throw std::runtime_error("Bad packet, couldn't parse (interned transformation on a message other than ImgFrame)" + info);
+    }
+
+    return {objectType, serializedObjectSize, bufferLength, interned};
 }
 
 std::shared_ptr<ADatatype> StreamMessageParser::parseMessage(streamPacketDesc_t* const packet) {
     DatatypeEnum objectType;
     size_t serializedObjectSize;
     size_t bufferLength;
+    bool interned;
     long fd;
-    std::tie(objectType, serializedObjectSize, bufferLength) = parseHeader(packet);
+    std::tie(objectType, serializedObjectSize, bufferLength, interned) = parseHeader(packet);
+    if(interned) {
+        throw std::runtime_error("Bad packet, couldn't parse (ImgFrame with an interned transformation requires the TransformationCache of its stream)");
+    }
     auto* const metadataStart = packet->data + bufferLength;
 
     // copy data part
@@ -208,6 +270,10 @@ std::shared_ptr<ADatatype> StreamMessageParser::parseMessage(streamPacketDesc_t*
             return parseDatatype<IMUData>(metadataStart, serializedObjectSize, data, fd);
             break;
 
+        case DatatypeEnum::IMUBatch:
+            return parseDatatype<IMUBatch>(metadataStart, serializedObjectSize, data, fd);
+            break;
+
         case DatatypeEnum::StereoDepthConfig:
             return parseDatatype<StereoDepthConfig>(metadataStart, serializedObjectSize, data, fd);
             break;
@@ -293,23 +359,54 @@ std::shared_ptr<ADatatype> StreamMessageParser::parseMessage(StreamPacketDesc pa
     return parseMessage(&packet);
 }
 
-std::vector<std::uint8_t> StreamMessageParser::serializeMetadata(const ADatatype& message) {
-    // Serialization:
-    // 1. fill vector with bytes from message.data
-    // 2. serialize and append metadata
-    // 3. append datatype enum (4B LE)
-    // 4. append size (4B LE) of serialized metadata
-    // 5. append 16-byte marker/canary
+std::shared_ptr<ADatatype> StreamMessageParser::parseMessage(streamPacketDesc_t* const packet, TransformationCache& cache) {
+    DatatypeEnum objectType;
+    size_t serializedObjectSize;
+    size_t bufferLength;
+    bool interned;
+    std::tie(objectType, serializedObjectSize, bufferLength, interned) = parseHeader(packet);
+    if(!interned) return parseMessage(packet);
+
+    InternedImgFrame metadata;
+    utility::deserialize(packet->data + bufferLength, serializedObjectSize, metadata);
+    if(metadata.transformation.has_value()) {
+        cache.insert(metadata.transformationId, *metadata.transformation);
+    }
+    const auto* transformation = cache.find(metadata.transformationId);
+    if(transformation == nullptr) {
+        throw std::runtime_error(fmt::format("Bad packet, couldn't parse (unknown interned transformation id {})", metadata.transformationId));
+    }
 
-    DatatypeEnum datatype;
-    std::vector<std::uint8_t> metadata;
-    message.serialize(metadata, datatype);
+    auto frame = std::make_shared<ImgFrame>();
+    frame->ts = metadata.ts;
+    frame->tsDevice = metadata.tsDevice;
+    frame->sequenceNum = metadata.sequenceNum;
+    frame->fb = metadata.fb;
+    frame->sourceFb = metadata.sourceFb;
+    frame->cam = metadata.cam;
+    frame->category = metadata.category;
+    frame->instanceNum = metadata.instanceNum;
+    frame->transformation = *transformation;
+    if(packet->fd < 0) {
+        frame->data = std::make_shared<dai::VectorMemory>(std::vector<std::uint8_t>(packet->data, packet->data + bufferLength));
+    } else {
+        frame->data = std::make_shared<dai::SharedMemory>(packet->fd);
+    }
+    return frame;
+}
+
+std::shared_ptr<ADatatype> StreamMessageParser::parseMessage(StreamPacketDesc packet, TransformationCache& cache) {
+    return parseMessage(&packet, cache);
+}
+
+// Appends datatype, metadata size and marker to the serialized metadata
+static std::vector<std::uint8_t> appendTrailer(const std::vector<std::uint8_t>& metadata, std::int32_t datatype) {
     uint32_t metadataSize = static_cast<uint32_t>(metadata.size());
 
     // 4B datatype & 4B metadata size
     std::array<std::uint8_t, 4> leDatatype;
     std::array<std::uint8_t, 4> leMetadataSize;
-    for(int i = 0; i < 4; i++) leDatatype[i] = (static_cast<std::int32_t>(datatype) >> (i * 8)) & 0xFF;
+    for(int i = 0; i < 4; i++) leDatatype[i] = (datatype >> (i * 8)) & 0xFF;
     for(int i = 0; i < 4; i++) leMetadataSize[i] = (metadataSize >> i * 8) & 0xFF;
 
     std::vector<std::uint8_t> ser;
@@ -322,11 +419,49 @@ std::vector<std::uint8_t> StreamMessageParser::serializeMetadata(const ADatatype
     return ser;
 }
 
+std::vector<std::uint8_t> StreamMessageParser::serializeMetadata(const ADatatype& message) {
+    // Serialization:
+    // 1. fill vector with bytes from message.data
+    // 2. serialize and append metadata
+    // 3. append datatype enum (4B LE)
+    // 4. append size (4B LE) of serialized metadata
+    // 5. append 16-byte marker/canary
+
+    DatatypeEnum datatype;
+    std::vector<std::uint8_t> metadata;
+    message.serialize(metadata, datatype);
+    return appendTrailer(metadata, static_cast<std::int32_t>(datatype));
+}
+
 std::vector<std::uint8_t> StreamMessageParser::serializeMetadata(const std::shared_ptr<const ADatatype>& data) {
     if(!data) return {};
     return serializeMetadata(*data);
 }
 
+std::vector<std::uint8_t> StreamMessageParser::serializeMetadata(const ADatatype& message, TransformationCache& cache) {
+    const auto* frame = dynamic_cast<const ImgFrame*>(&message);
+    if(frame == nullptr) return serializeMetadata(message);
+
+    InternedImgFrame metadata;
+    metadata.ts = frame->ts;
+    metadata.tsDevice = frame->tsDevice;
+    metadata.sequenceNum = frame->sequenceNum;
+    metadata.fb = frame->fb;
+    metadata.sourceFb = frame->sourceFb;
+    metadata.cam = frame->cam;
+    metadata.category = frame->category;
+    metadata.instanceNum = frame->instanceNum;
+    bool added;
+    std::tie(metadata.transformationId, added) = cache.intern(frame->transformation);
+    if(added) metadata.transformation = frame->transformation;
+    return appendTrailer(utility::serialize(metadata), static_cast<std::int32_t>(DatatypeEnum::ImgFrame) | internedTransformationFlag);
+}
+
+std::vector<std::uint8_t> StreamMessageParser::serializeMetadata(const std::shared_ptr<const ADatatype>& data, TransformationCache& cache) {
+    if(!data) return {};
+    return serializeMetadata(*data, cache);
+}
+
 // std::vector<std::uint8_t> StreamMessageParser::serializeMessage(const ADatatype& message) {
 //     // Serialization:
 //     // 1. fill vector with bytes from data.data
@@ -1,3 +1,119 @@
 #include "depthai/pipeline/datatype/Tracklets.hpp"
 
-namespace dai {}  // namespace dai
+#include <stdexcept>
+
+namespace dai {
+
+TrackletArrays::TrackletArrays(span<const Tracklet> tracklets) {
+    reserve(tracklets.size());
+    for(const auto& tracklet : tracklets) add(tracklet);
+}
+
+std::size_t TrackletArrays::size() const {
+    return ids.size();
+}
+
+bool TrackletArrays::empty() const {
+    return ids.empty();
+}
+
+void TrackletArrays::reserve(std::size_t size) {
+    rois.reserve(size * 4);
+    roiFlags.reserve(size);
+    ids.reserve(size);
+    labels.reserve(size);
+    ages.reserve(size);
+    statuses.reserve(size);
+    spatialCoordinates.reserve(size * 3);
+    srcImgDetections.reserve(size);
+}
+
+void TrackletArrays::clear() {
+    rois.clear();
+    roiFlags.clear();
+    ids.clear();
+    labels.clear();
+    ages.clear();
+    statuses.clear();
+    spatialCoordinates.clear();
+    srcImgDetections.clear();
+}
+
+void TrackletArrays::add(const Tracklet& tracklet) {
+    const auto& roi = tracklet.roi;
+    rois.insert(rois.end(), {roi.x, roi.y, roi.width, roi.height});
+    roiFlags.push_back(static_cast<std::uint8_t>((roi.normalized ? ROI_NORMALIZED : 0) | (roi.hasNormalized ? ROI_HAS_NORMALIZED : 0)));
+    ids.push_back(tracklet.id);
+    labels.push_back(tracklet.label);
+    ages.push_back(tracklet.age);
+    statuses.push_back(tracklet.status);
+    const auto& point = tracklet.spatialCoordinates;
+    spatialCoordinates.insert(spatialCoordinates.end(), {point.x, point.y, point.z});
+    srcImgDetections.add(tracklet.srcImgDetection);
+}
+
+Tracklet TrackletArrays::get(std::size_t index) const {
+    if(index >= size()) throw std::out_of_range("TrackletArrays index out of range");
+    if(rois.size() < (index + 1) * 4 || roiFlags.size() <= index || labels.size() <= index || ages.size() <= index || statuses.size() <= index
+       || spatialCoordinates.size() < (index + 1) * 3) {
+        throw std::invalid_argument("TrackletArrays arrays have to hold the same number of tracklets");
+    }
+    Tracklet tracklet;
+    tracklet.roi.x = rois[index * 4];
+    tracklet.roi.y = rois[index * 4 + 1];
+    tracklet.roi.width = rois[index * 4 + 2];
+    tracklet.roi.height = rois[index * 4 + 3];
+    tracklet.roi.normalized = (roiFlags[index] & ROI_NORMALIZED) != 0;
+    tracklet.roi.hasNormalized = (roiFlags[index] & ROI_HAS_NORMALIZED) != 0;
+    tracklet.id = ids[index];
+    tracklet.label = labels[index];
+    tracklet.age = ages[index];
+    tracklet.status = statuses[index];
+    tracklet.srcImgDetection = srcImgDetections.get(index);
+    tracklet.spatialCoordinates = Point3f(spatialCoordinates[index * 3], spatialCoordinates[index * 3 + 1], spatialCoordinates[index * 3 + 2]);
+    return tracklet;
+}
+
+std::vector<Tracklet> TrackletArrays::toTracklets() const {
+    const std::size_t count = size();
+    if(rois.size() != count * 4 || roiFlags.size() != count || labels.size() != count || ages.size() != count || statuses.size() != count
+       || spatialCoordinates.size() != count * 3 || srcImgDetections.size() != count) {
+        throw std::invalid_argument("TrackletArrays arrays have to hold the same number of tracklets");
+    }
+    std::vector<Tracklet> tracklets;
+    tracklets.reserve(count);
+    for(std::size_t i = 0; i < count; i++) tracklets.push_back(get(i));
+    return tracklets;
+}
+
+bool TrackletArrays::matches(span<const Tracklet> tracklets) const {
+    const std::size_t count = size();
+    if(tracklets.size() != count || rois.size() != count * 4 || roiFlags.size() != count || labels.size() != count || ages.size() != count
+       || statuses.size() != count || spatialCoordinates.size() != count * 3 || srcImgDetections.size() != count) {
+        return false;
+    }
+    for(std::size_t i = 0; i < count; i++) {
+        const auto& tracklet = tracklets[i];
+        const auto& roi = tracklet.roi;
+        const auto& point = tracklet.spatialCoordinates;
+        const auto flags = static_cast<std::uint8_t>((roi.normalized ? ROI_NORMALIZED : 0) | (roi.hasNormalized ? ROI_HAS_NORMALIZED : 0));
+        if(rois[i * 4] != roi.x || rois[i * 4 + 1] != roi.y || rois[i * 4 + 2] != roi.width || rois[i * 4 + 3] != roi.height || roiFlags[i] != flags
+           || ids[i] != tracklet.id || labels[i] != tracklet.label || ages[i] != tracklet.age || statuses[i] != tracklet.status
+           || spatialCoordinates[i * 3] != point.x || spatialCoordinates[i * 3 + 1] != point.y || spatialCoordinates[i * 3 + 2] != point.z
+           || !srcImgDetections.matches(i, tracklet.srcImgDetection)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+const TrackletArrays& Tracklets::getArrays() const {
+    return arraysCache.get([this](const TrackletArrays& kept) { return kept.matches(tracklets); }, [this]() { return TrackletArrays(tracklets); });
+}
+
+void Tracklets::setArrays(const TrackletArrays& arrays) {
+    tracklets = arrays.toTracklets();
+    arraysCache.set(arrays);
+}
+
+}  // namespace dai
@@ -2,7 +2,9 @@
 
 #include <math.h>
 
+#include <algorithm>
 #include <stdexcept>
+#include <vector>
 
 #include "pipeline/ThreadedNodeImpl.hpp"
 #include "pipeline/datatype/AprilTagConfig.hpp"
@@ -58,6 +60,14 @@ int AprilTag::getNumThreads() const {
     return properties.numThreads;
 }
 
+void AprilTag::setRoi(const Rect& roi) {
+    this->roi = roi;
+}
+
+Rect AprilTag::getRoi() const {
+    return roi;
+}
+
 void AprilTag::setRunOnHost(bool runOnHost) {
     runOnHostVar = runOnHost;
 }
@@ -179,6 +189,18 @@ void setDetectorProperties(apriltag_detector_t* td, const dai::AprilTagPropertie
     td->nthreads = properties.numThreads;
 }
 
+// Converts a region of RGB pixels to grayscale, with the fixed point weights of OpenCV
+void convertToGray(const uint8_t* red, const uint8_t* green, const uint8_t* blue, int pixelStep, int stride, int width, int height, uint8_t* out) {
+    for(int y = 0; y < height; y++) {
+        const size_t row = static_cast<size_t>(y) * stride;
+        uint8_t* dst = out + static_cast<size_t>(y) * width;
+        for(int x = 0; x < width; x++) {
+            const size_t i = row + static_cast<size_t>(x) * pixelStep;
+            dst[x] = static_cast<uint8_t>((red[i] * 4899 + green[i] * 9617 + blue[i] * 1868 + 8192) >> 14);
+        }
+    }
+}
+
 void AprilTag::run() {
     auto& logger = pimpl->logger;
     // Retrieve properties and initial config
@@ -188,8 +210,10 @@ void AprilTag::run() {
     // Prepare other variables
     std::shared_ptr<ImgFrame> inFrame = nullptr;
     std::shared_ptr<AprilTagConfig> inConfig = nullptr;
+    // Grayscale frames converted from other types, reused across frames
+    std::vector<uint8_t> grayBuffer;
     #ifdef DEPTHAI_HAVE_OPENCV_SUPPORT
-    std::unique_ptr<cv::Mat> cvimgPtr = nullptr;
+    cv::Mat grayFrame;
     #endif
 
     // Setup april tag detector
@@ -223,39 +247,98 @@ void AprilTag::run() {
         // Get latest frame
         inFrame = inputImage.get<ImgFrame>();
 
-        // Preallocate data on stack for AprilTag detection
-        int32_t width = 0;
-        int32_t height = 0;
-        int32_t stride = 0;
-        uint8_t* imgbuf = nullptr;
+        // Region to detect in, clamped to the frame
+        const auto frameWidth = static_cast<int32_t>(inFrame->getWidth());
+        const auto frameHeight = static_cast<int32_t>(inFrame->getHeight());
+        int32_t roiX = 0;
+        int32_t roiY = 0;
+        int32_t width = frameWidth;
+        int32_t height = frameHeight;
+        if(!roi.empty()) {
+            const Rect region = roi.denormalize(frameWidth, frameHeight);
+            roiX = std::clamp(static_cast<int32_t>(region.x), 0, frameWidth);
+            roiY = std::clamp(static_cast<int32_t>(region.y), 0, frameHeight);
+            width = std::clamp(static_cast<int32_t>(region.x + region.width), 0, frameWidth) - roiX;
+            height = std::clamp(static_cast<int32_t>(region.y + region.height), 0, frameHeight) - roiY;
+        }
 
         // Prepare data for AprilTag detection based on input frame type
+        int32_t stride = 0;
+        uint8_t* imgbuf = nullptr;
+        uint8_t* frameData = inFrame->data->getData().data();
+        const auto frameStride = static_cast<int32_t>(inFrame->getStride());
         ImgFrame::Type frameType = inFrame->getType();
 
-        if(frameType == ImgFrame::Type::GRAY8 || frameType == ImgFrame::Type::NV12) {
-            width = static_cast<int32_t>(inFrame->getWidth());
-            height = static_cast<int32_t>(inFrame->getHeight());
-            stride = static_cast<int32_t>(inFrame->getStride());
-            imgbuf = inFrame->data->getData().data() + inFrame->fb.p1Offset;
-        } else {
+        switch(frameType) {
+            case ImgFrame::Type::GRAY8:
+            case ImgFrame::Type::RAW8:
+            case ImgFrame::Type::YUV400p:
+            case ImgFrame::Type::NV12:
+            case ImgFrame::Type::NV21:
+            case ImgFrame::Type::YUV420p:
+            case ImgFrame::Type::YV12:
+            case ImgFrame::Type::YUV422p:
+            case ImgFrame::Type::YUV444p:
+                // Luma plane is used in place
+                stride = frameStride;
+                imgbuf = frameData + inFrame->fb.p1Offset + static_cast<size_t>(roiY) * stride + roiX;
+                break;
+            case ImgFrame::Type::RGB888i:
+            case ImgFrame::Type::BGR888i: {
+                uint8_t* pixels = frameData + inFrame->fb.p1Offset + static_cast<size_t>(roiY) * frameStride + static_cast<size_t>(roiX) * 3;
+                const bool rgb = frameType == ImgFrame::Type::RGB888i;
     #ifdef DEPTHAI_HAVE_OPENCV_SUPPORT
-            cvimgPtr = std::make_unique<cv::Mat>();
-            cv::cvtColor(inFrame->getCvFrame(), *cvimgPtr, cv::COLOR_BGR2GRAY);
-            width = cvimgPtr->cols;
-            height = cvimgPtr->rows;
-            stride = cvimgPtr->cols;
-            imgbuf = cvimgPtr->data;
+                // Converted in place, without a BGR copy of the frame
+                if(width > 0 && height > 0) {
+                    const cv::Mat region(height, width, CV_8UC3, pixels, frameStride);
+                    cv::cvtColor(region, grayFrame, rgb ? cv::COLOR_RGB2GRAY : cv::COLOR_BGR2GRAY);
+                }
+                stride = static_cast<int32_t>(grayFrame.step);
+                imgbuf = grayFrame.data;
     #else
-            throw std::runtime_error("AprilTag node: Unsupported frame type without opencv support, only GRAY8 and NV12 supported");
+                grayBuffer.resize(static_cast<size_t>(width) * height);
+                convertToGray(pixels + (rgb ? 0 : 2), pixels + 1, pixels + (rgb ? 2 : 0), 3, frameStride, width, height, grayBuffer.data());
+                stride = width;
+                imgbuf = grayBuffer.data();
+    #endif
+                break;
+            }
+            case ImgFrame::Type::RGB888p:
+            case ImgFrame::Type::BGR888p: {
+                // Planes follow each other unless their offsets are set
+                const auto& fb = inFrame->fb;
+                const auto planeStride = fb.stride != 0 ? static_cast<int32_t>(fb.stride) : frameWidth;
+                const bool offsetsSet = fb.p1Offset != 0 || fb.p2Offset != 0 || fb.p3Offset != 0;
+                const size_t planeSize = static_cast<size_t>(planeStride) * frameHeight;
+                const size_t region = static_cast<size_t>(roiY) * planeStride + roiX;
+                const uint8_t* first = frameData + (offsetsSet ? fb.p1Offset : 0) + region;
+                const uint8_t* second = frameData + (offsetsSet ? fb.p2Offset : planeSize) + region;
+                const uint8_t* third = frameData + (offsetsSet ? fb.p3Offset : planeSize * 2) + region;
+                const bool rgb = frameType == ImgFrame::Type::RGB888p;
+                grayBuffer.resize(static_cast<size_t>(width) * height);
+                convertToGray(rgb ? first : third, second, rgb ? third : first, 1, planeStride, width, height, grayBuffer.data());
+                stride = width;
+                imgbuf = grayBuffer.data();
+                break;
+            }
+            default:
+    #ifdef DEPTHAI_HAVE_OPENCV_SUPPORT
+                cv::cvtColor(inFrame->getCvFrame(), grayFrame, cv::COLOR_BGR2GRAY);
+                stride = static_cast<int32_t>(grayFrame.step);
+                imgbuf = grayFrame.data + static_cast<size_t>(roiY) * stride + roiX;
+                break;
+    #else
+                throw std::runtime_error("AprilTag node: Unsupported frame type without opencv support, only GRAY8, YUV and RGB types supported");
     #endif
         }
 
-        // Create AprilTag image
-        image_u8_t aprilImg{width, height, stride, imgbuf};
-
-        // Detect AprilTags
+        // Detect AprilTags, skipped for regions outside of the frame
         auto now = std::chrono::system_clock::now();
-        std::unique_ptr<zarray_t, void (*)(zarray_t*)> detections(apriltag_detector_detect(td.get(), &aprilImg), apriltag_detections_destroy);
+        std::unique_ptr<zarray_t, void (*)(zarray_t*)> detections(nullptr, apriltag_detections_destroy);
+        if(width > 0 && height > 0) {
+            image_u8_t aprilImg{width, height, stride, imgbuf};
+            detections.reset(apriltag_detector_detect(td.get(), &aprilImg));
+        }
         auto end = std::chrono::system_clock::now();
         std::chrono::duration<double> elapsedSeconds = end - now;
         logger->trace("April detections took {} ms", elapsedSeconds.count() / 1000.0);
@@ -276,22 +359,22 @@ void AprilTag::run() {
                 daiDet.hamming = det->hamming;
                 daiDet.decisionMargin = det->decision_margin;
                 dai::Point2f center;
-                center.x = static_cast<float>(det->c[0]);
-                center.y = static_cast<float>(det->c[1]);
+                center.x = static_cast<float>(det->c[0] + roiX);
+                center.y = static_cast<float>(det->c[1] + roiY);
 
                 dai::Point2f topLeft;
                 dai::Point2f topRight;
                 dai::Point2f bottomRight;
                 dai::Point2f bottomLeft;
 
-                topLeft.x = static_cast<float>(det->p[3][0]);
-                topLeft.y = static_cast<float>(det->p[3][1]);
-                topRight.x = static_cast<float>(det->p[2][0]);
-                topRight.y = static_cast<float>(det->p[2][1]);
-                bottomRight.x = static_cast<float>(det->p[1][0]);
-                bottomRight.y = static_cast<float>(det->p[1][1]);
-                bottomLeft.x = static_cast<float>(det->p[0][0]);
-                bottomLeft.y = static_cast<float>(det->p[0][1]);
+                topLeft.x = static_cast<float>(det->p[3][0] + roiX);
+                topLeft.y = static_cast<float>(det->p[3][1] + roiY);
+                topRight.x = static_cast<float>(det->p[2][0] + roiX);
+                topRight.y = static_cast<float>(det->p[2][1] + roiY);
+                bottomRight.x = static_cast<float>(det->p[1][0] + roiX);
+                bottomRight.y = static_cast<float>(det->p[1][1] + roiY);
+                bottomLeft.x = static_cast<float>(det->p[0][0] + roiX);
+                bottomLeft.y = static_cast<float>(det->p[0][1] + roiY);
 
                 daiDet.topLeft = topLeft;
                 daiDet.topRight = topRight;
@@ -312,7 +395,7 @@ void AprilTag::run() {
         passthroughInputImage.send(inFrame);
 
         // Logging
-        logger->trace("Detected {} april tags", zarray_size(detections.get()));
+        logger->trace("Detected {} april tags", aprilTags->aprilTags.size());
     }
 
     // Destroy AprilTag family
@@ -1,6 +1,8 @@
 #include "depthai/pipeline/node/BenchmarkIn.hpp"
 
 #include <chrono>
+#include <cmath>
+#include <optional>
 
 #include "depthai/pipeline/datatype/BenchmarkReport.hpp"
 #include "pipeline/ThreadedNodeImpl.hpp"
@@ -48,6 +50,13 @@ void BenchmarkIn::run() {
     uint32_t messageCount = 0;
     float totalLatency = 0.0f;
 
+    // Histograms have fixed precision and memory, so they are always collected, regardless of the batch size
+    LatencyHistogram latencyHistogram;
+    LatencyHistogram interArrivalHistogram;
+    float totalLatencyDifference = 0.0f;
+    float previousLatency = 0.0f;
+    std::optional<steady_clock::time_point> previousArrival;
+
     std::vector<float> latencies;
     if(storeLatencies) {
         latencies.reserve(numMessages);
@@ -62,6 +71,9 @@ void BenchmarkIn::run() {
         if(messageCount == 0) {
             start = steady_clock::now();
             totalLatency = 0.0f;
+            totalLatencyDifference = 0.0f;
+            latencyHistogram.reset();
+            interArrivalHistogram.reset();
 
             // Clear vector if we are storing latencies
             if(storeLatencies) {
@@ -85,6 +97,17 @@ void BenchmarkIn::run() {
             // Accumulate for average
             totalLatency += diff.count();
 
+            // Accumulate distributions
+            latencyHistogram.record(duration_cast<microseconds>(currentTs - messageTs));
+            if(previousArrival) {
+                interArrivalHistogram.record(duration_cast<microseconds>(currentTs - *previousArrival));
+            }
+            if(messageCount > 0) {
+                totalLatencyDifference += std::abs(diff.count() - previousLatency);
+            }
+            previousLatency = diff.count();
+            previousArrival = currentTs;
+
             // Optionally store individual latencies
             if(storeLatencies) {
                 latencies.push_back(diff.count());
@@ -94,6 +117,7 @@ void BenchmarkIn::run() {
         } else {
             // We reached our batch size, so time to compute and send the report
             auto stop = steady_clock::now();
+            previousArrival = stop;
             duration<float> durationS = stop - start;
 
             auto reportMessage = std::make_shared<dai::BenchmarkReport>();
@@ -101,6 +125,9 @@ void BenchmarkIn::run() {
             reportMessage->timeTotal = durationS.count();
             reportMessage->fps = numMessages / durationS.count();
             reportMessage->averageLatency = totalLatency / numMessages;
+            reportMessage->jitter = numMessages > 1 ? totalLatencyDifference / (numMessages - 1) : 0.0f;
+            reportMessage->latencyHistogram = latencyHistogram;
+            reportMessage->interArrivalHistogram = interArrivalHistogram;
 
             // Attach latencies only if we're storing them
             if(storeLatencies) {
@@ -120,6 +147,12 @@ void BenchmarkIn::run() {
             logFunc("FPS: {}", reportMessage->fps);
             logFunc("Messages took {} s", reportMessage->timeTotal);
             logFunc("Average latency: {} s", reportMessage->averageLatency);
+            logFunc("Latency p50: {} us, p99: {} us, p99.9: {} us, max: {} us, jitter: {} s",
+                    latencyHistogram.getPercentile(50).count(),
+                    latencyHistogram.getPercentile(99).count(),
+                    latencyHistogram.getPercentile(99.9).count(),
+                    latencyHistogram.max,
+                    reportMessage->jitter);
 
             // Send out the report
             report.send(reportMessage);
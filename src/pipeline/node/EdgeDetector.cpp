@@ -1,6 +1,10 @@
 #include "depthai/pipeline/node/EdgeDetector.hpp"
 
+#include <stdexcept>
+
+#include "pipeline/ThreadedNodeImpl.hpp"
 #include "spdlog/fmt/fmt.h"
+#include "utility/EdgeDetectorImpl.hpp"
 
 namespace dai {
 namespace node {
@@ -22,5 +26,48 @@ void EdgeDetector::setMaxOutputFrameSize(int maxFrameSize) {
     properties.outputFrameSize = maxFrameSize;
 }
 
+void EdgeDetector::setRunOnHost(bool runOnHost) {
+    runOnHostVar = runOnHost;
+}
+
+bool EdgeDetector::runOnHost() const {
+    return runOnHostVar;
+}
+
+void EdgeDetector::run() {
+    auto& logger = pimpl->logger;
+
+    impl::SobelEdgeDetector edgeDetector(*initialConfig);
+
+    while(isRunning()) {
+        auto inputImg = inputImage.get<ImgFrame>();
+
+        std::shared_ptr<EdgeDetectorConfig> inputCfg;
+        if(inputConfig.getWaitForMessage()) {
+            inputCfg = inputConfig.get<EdgeDetectorConfig>();
+        } else {
+            inputCfg = inputConfig.tryGet<EdgeDetectorConfig>();
+        }
+        if(inputCfg) {
+            try {
+                edgeDetector.configure(*inputCfg);
+            } catch(const std::invalid_argument& e) {
+                logger->error("Ignoring config: {}", e.what());
+            }
+        }
+
+        std::shared_ptr<ImgFrame> edges;
+        try {
+            edges = edgeDetector.process(*inputImg);
+        } catch(const std::invalid_argument& e) {
+            logger->error("Skipping frame: {}", e.what());
+            continue;
+        }
+
+        outputImage.send(edges);
+        passthroughInputImage.send(inputImg);
+    }
+}
+
 }  // namespace node
 }  // namespace dai
@@ -1,6 +1,11 @@
 #include "depthai/pipeline/node/FeatureTracker.hpp"
 
+#include <stdexcept>
+
+#include "depthai/pipeline/datatype/TrackedFeatures.hpp"
+#include "pipeline/ThreadedNodeImpl.hpp"
 #include "spdlog/fmt/fmt.h"
+#include "utility/FeatureTrackerImpl.hpp"
 
 namespace dai {
 namespace node {
@@ -19,5 +24,55 @@ void FeatureTracker::setHardwareResources(int numShaves, int numMemorySlices) {
     properties.numMemorySlices = numMemorySlices;
 }
 
+void FeatureTracker::setRunOnHost(bool runOnHost) {
+    runOnHostVar = runOnHost;
+}
+
+bool FeatureTracker::runOnHost() const {
+    return runOnHostVar;
+}
+
+void FeatureTracker::run() {
+    auto& logger = pimpl->logger;
+
+    auto checkConfig = [&logger](const FeatureTrackerConfig& config) {
+        if(config.motionEstimator.enable && config.motionEstimator.type == FeatureTrackerConfig::MotionEstimator::Type::HW_MOTION_ESTIMATION) {
+            logger->warn("Hardware motion estimation is not available on host, using optical flow instead");
+        }
+    };
+
+    checkConfig(*initialConfig);
+    impl::LKFeatureTracker tracker(*initialConfig);
+
+    while(isRunning()) {
+        auto inputImg = inputImage.get<ImgFrame>();
+
+        std::shared_ptr<FeatureTrackerConfig> inputCfg;
+        if(inputConfig.getWaitForMessage()) {
+            inputCfg = inputConfig.get<FeatureTrackerConfig>();
+        } else {
+            inputCfg = inputConfig.tryGet<FeatureTrackerConfig>();
+        }
+        if(inputCfg) {
+            checkConfig(*inputCfg);
+            tracker.configure(*inputCfg);
+        }
+
+        auto trackedFeatures = std::make_shared<TrackedFeatures>();
+        try {
+            trackedFeatures->trackedFeatures = tracker.track(*inputImg);
+        } catch(const std::invalid_argument& e) {
+            logger->error("Skipping frame: {}", e.what());
+            continue;
+        }
+        trackedFeatures->ts = inputImg->ts;
+        trackedFeatures->tsDevice = inputImg->tsDevice;
+        trackedFeatures->sequenceNum = inputImg->sequenceNum;
+
+        outputFeatures.send(trackedFeatures);
+        passthroughInputImage.send(inputImg);
+    }
+}
+
 }  // namespace node
 }  // namespace dai
@@ -4,7 +4,10 @@
 #include <stdexcept>
 
 // libraries
+#include "depthai/pipeline/datatype/EncodedFrame.hpp"
+#include "pipeline/ThreadedNodeImpl.hpp"
 #include "spdlog/spdlog.h"
+#include "utility/JpegEncoderImpl.hpp"
 #include "utility/Logging.hpp"
 
 namespace dai {
@@ -137,5 +140,62 @@ int VideoEncoder::getMaxOutputFrameSize() const {
     return properties.outputFrameSize;
 }
 
+void VideoEncoder::setRunOnHost(bool runOnHost) {
+    runOnHostVar = runOnHost;
+}
+
+bool VideoEncoder::runOnHost() const {
+    return runOnHostVar;
+}
+
+void VideoEncoder::run() {
+    auto& logger = pimpl->logger;
+
+    if(properties.profile != VideoEncoderProperties::Profile::MJPEG) {
+        throw std::runtime_error("VideoEncoder on host supports only the MJPEG profile");
+    }
+    if(properties.lossless) {
+        logger->warn("Lossless JPEG isn't supported on host, encoding lossy");
+    }
+    impl::JpegEncoder encoder(properties.quality);
+
+    while(isRunning()) {
+        auto frame = input.get<ImgFrame>();
+
+        std::vector<std::uint8_t> jpeg;
+        try {
+            jpeg = encoder.encode(*frame);
+        } catch(const std::invalid_argument& e) {
+            logger->error("Skipping frame: {}", e.what());
+            continue;
+        }
+
+        auto encoded = std::make_shared<EncodedFrame>();
+        encoded->cam = frame->cam;
+        encoded->instanceNum = frame->instanceNum;
+        encoded->transformation = frame->transformation;
+        encoded->setSize(frame->getWidth(), frame->getHeight());
+        encoded->setQuality(properties.quality);
+        encoded->setBitrate(properties.bitrate);
+        encoded->setLossless(false);
+        encoded->setProfile(EncodedFrame::Profile::JPEG);
+        encoded->setFrameType(EncodedFrame::FrameType::I);
+        encoded->setSequenceNum(frame->getSequenceNum());
+        encoded->setTimestamp(frame->getTimestamp());
+        encoded->setTimestampDevice(frame->getTimestampDevice());
+        encoded->frameOffset = 0;
+        encoded->frameSize = static_cast<std::uint32_t>(jpeg.size());
+
+        // Legacy bitstream output, only when used as it needs its own copy of the data
+        if(!bitstream.getConnections().empty() || !bitstream.getQueueConnections().empty()) {
+            auto bitstreamFrame = std::make_shared<ImgFrame>(encoded->getImgFrameMeta());
+            bitstreamFrame->setData(jpeg);
+            bitstream.send(bitstreamFrame);
+        }
+        encoded->setData(std::move(jpeg));
+        out.send(encoded);
+    }
+}
+
 }  // namespace node
 }  // namespace dai
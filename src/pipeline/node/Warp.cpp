@@ -1,7 +1,25 @@
 #include "depthai/pipeline/node/Warp.hpp"
+
+#include <cstring>
+#include <stdexcept>
+
+#include "pipeline/ThreadedNodeImpl.hpp"
+#include "spdlog/fmt/fmt.h"
+#include "utility/WarpImpl.hpp"
+
 namespace dai {
 namespace node {
 
+namespace {
+
+// Mesh row stride in bytes, aligned to 16B
+size_t getMeshStride(int width) {
+    constexpr auto ALIGNMENT = 16;
+    return ((size_t)((sizeof(float) * 2 * width)) + (ALIGNMENT - 1)) & ~(ALIGNMENT - 1);
+}
+
+}  // namespace
+
 void Warp::setOutputSize(std::tuple<int, int> size) {
     properties.outputWidth = std::get<0>(size);
     properties.outputHeight = std::get<1>(size);
@@ -29,8 +47,7 @@ void Warp::setWarpMesh(const float* meshData, int numMeshPoints, int width, int
     asset.alignment = 64;
 
     // Align stride to 16B
-    constexpr auto ALIGNMENT = 16;
-    size_t meshStride = ((size_t)((sizeof(float) * 2 * width)) + (ALIGNMENT - 1)) & ~(ALIGNMENT - 1);
+    size_t meshStride = getMeshStride(width);
     // Specify final mesh size
     size_t meshSize = meshStride * height;
 
@@ -88,5 +105,68 @@ dai::Interpolation Warp::getInterpolation() const {
     return properties.interpolation;
 }
 
+std::vector<Point2f> Warp::getWarpMesh() const {
+    const std::string prefix = "asset:";
+    if(properties.meshUri.empty() || properties.meshUri.rfind(prefix, 0) != 0) return {};
+    auto asset = assetManager.get(properties.meshUri.substr(prefix.size()));
+    if(asset == nullptr) {
+        throw std::runtime_error(fmt::format("Warp mesh asset '{}' not found", properties.meshUri));
+    }
+    const size_t meshStride = getMeshStride(properties.meshWidth);
+    if(properties.meshWidth <= 0 || properties.meshHeight <= 0 || asset->data.size() < meshStride * properties.meshHeight) {
+        throw std::runtime_error("Warp mesh asset doesn't match mesh width and height");
+    }
+
+    // Undo the reversed HW layout of mesh points
+    std::vector<Point2f> mesh;
+    mesh.reserve(static_cast<size_t>(properties.meshWidth) * properties.meshHeight);
+    for(int i = 0; i < properties.meshHeight; i++) {
+        for(int j = 0; j < properties.meshWidth; j++) {
+            float point[2];
+            std::memcpy(point, asset->data.data() + meshStride * i + j * sizeof(point), sizeof(point));
+            mesh.emplace_back(point[1], point[0]);
+        }
+    }
+    return mesh;
+}
+
+void Warp::setRunOnHost(bool runOnHost) {
+    runOnHostVar = runOnHost;
+}
+
+bool Warp::runOnHost() const {
+    return runOnHostVar;
+}
+
+void Warp::run() {
+    auto& logger = pimpl->logger;
+
+    impl::MeshWarp warp;
+    try {
+        warp.setMesh(getWarpMesh(), properties.meshWidth, properties.meshHeight);
+    } catch(const std::invalid_argument& e) {
+        throw std::runtime_error(fmt::format("Invalid warp mesh: {}", e.what()));
+    }
+    warp.setOutputSize(properties.outputWidth, properties.outputHeight);
+    if(properties.interpolation == Interpolation::BICUBIC) {
+        logger->warn("Bicubic interpolation isn't supported on host, using bilinear");
+    }
+    warp.setInterpolation(properties.interpolation);
+
+    while(isRunning()) {
+        auto inputImg = inputImage.get<ImgFrame>();
+
+        std::shared_ptr<ImgFrame> warped;
+        try {
+            warped = warp.process(*inputImg);
+        } catch(const std::invalid_argument& e) {
+            logger->error("Skipping frame: {}", e.what());
+            continue;
+        }
+
+        out.send(warped);
+    }
+}
+
 }  // namespace node
 }  // namespace dai
@@ -3,9 +3,14 @@
 #include <spdlog/spdlog.h>
 
 #include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
 #include <opencv2/opencv.hpp>
 
 #include "depthai/pipeline/Pipeline.hpp"
+#include "depthai/utility/JoiningThread.hpp"
+#include "pipeline/ThreadedNodeImpl.hpp"
 namespace dai {
 namespace node {
 
@@ -33,29 +38,138 @@ class FPSCounter {
     std::deque<std::chrono::steady_clock::time_point> frames;
 };
 
+namespace {
+
+// Holds the latest frame waiting to be rendered
+class FrameMailbox {
+   public:
+    // Returns false if it replaced a frame which wasn't rendered yet
+    bool put(std::shared_ptr<ImgFrame> frame) {
+        bool replaced = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            replaced = latest != nullptr;
+            latest = std::move(frame);
+        }
+        condition.notify_one();
+        return !replaced;
+    }
+
+    // Waits up to the timeout for a frame, returns nullptr if none arrived or the mailbox is closed
+    std::shared_ptr<ImgFrame> take(std::chrono::milliseconds timeout) {
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait_for(lock, timeout, [this]() { return latest != nullptr || closed; });
+        return std::move(latest);
+    }
+
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            closed = true;
+        }
+        condition.notify_all();
+    }
+
+    bool isClosed() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return closed;
+    }
+
+   private:
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::shared_ptr<ImgFrame> latest;
+    bool closed = false;
+};
+
+}  // namespace
+
 Display::Display(std::string name) : name(std::move(name)) {}
 
+Display& Display::setHeadless(bool headless) {
+    this->headless = headless;
+    return *this;
+}
+
+bool Display::isHeadless() const {
+    return headless;
+}
+
+uint64_t Display::getRenderedFrames() const {
+    return renderedFrames;
+}
+
+uint64_t Display::getDroppedFrames() const {
+    return droppedFrames;
+}
+
 void Display::run() {
-    auto fpsCounter = FPSCounter();
-    while(isRunning()) {
-        std::shared_ptr<dai::ImgFrame> imgFrame = input.get<dai::ImgFrame>();
-        if(imgFrame != nullptr) {
-            fpsCounter.update();
-            auto fps = fpsCounter.getFPS();
-            using namespace std::chrono;
-            auto latencyMs = duration_cast<milliseconds>(steady_clock::now() - imgFrame->getTimestamp());
-            auto frame = imgFrame->getCvFrame();
-            cv::putText(frame, fmt::format("FPS: {:.2f}", fps), cv::Point(10, 30), cv::FONT_HERSHEY_SIMPLEX, 1, cv::Scalar(0, 255, 0), 2);
-            cv::putText(frame, fmt::format("Latency: {}ms", latencyMs.count()), cv::Point(10, 60), cv::FONT_HERSHEY_SIMPLEX, 1, cv::Scalar(0, 255, 0), 2);
-            cv::imshow(name, frame);
-            auto key = cv::waitKey(1);
-            if(key == 'q') {
-                // Get the parent pipeline and stop it
-                stopPipeline();
-                break;
+    FrameMailbox mailbox;
+    JoiningThread renderThread([this, &mailbox]() {
+        // An exception escaping the thread would terminate the process, so it stops the pipeline instead
+        try {
+            auto fpsCounter = FPSCounter();
+            bool windowShown = false;
+            while(!mailbox.isClosed()) {
+                // Window events are handled even while no frames arrive
+                std::shared_ptr<dai::ImgFrame> imgFrame = mailbox.take(std::chrono::milliseconds(10));
+                if(imgFrame != nullptr) {
+                    fpsCounter.update();
+                    auto fps = fpsCounter.getFPS();
+                    using namespace std::chrono;
+                    auto latencyMs = duration_cast<milliseconds>(steady_clock::now() - imgFrame->getTimestamp());
+                    auto frame = imgFrame->getCvFrame();
+                    cv::putText(frame, fmt::format("FPS: {:.2f}", fps), cv::Point(10, 30), cv::FONT_HERSHEY_SIMPLEX, 1, cv::Scalar(0, 255, 0), 2);
+                    cv::putText(frame, fmt::format("Latency: {}ms", latencyMs.count()), cv::Point(10, 60), cv::FONT_HERSHEY_SIMPLEX, 1, cv::Scalar(0, 255, 0), 2);
+                    cv::putText(frame, fmt::format("Dropped: {}", droppedFrames.load()), cv::Point(10, 90), cv::FONT_HERSHEY_SIMPLEX, 1, cv::Scalar(0, 255, 0), 2);
+                    renderedFrames++;
+                    if(headless) {
+                        auto composited = std::make_shared<dai::ImgFrame>();
+                        composited->setCvFrame(frame, frame.channels() == 1 ? ImgFrame::Type::GRAY8 : ImgFrame::Type::BGR888i);
+                        composited->setSequenceNum(imgFrame->getSequenceNum());
+                        composited->setTimestamp(imgFrame->getTimestamp());
+                        composited->setTimestampDevice(imgFrame->getTimestampDevice());
+                        composited->setInstanceNum(imgFrame->getInstanceNum());
+                        composited->transformation = imgFrame->transformation;
+                        try {
+                            out.send(composited);
+                        } catch(const MessageQueue::QueueException&) {
+                            // The pipeline is stopping
+                            break;
+                        }
+                    } else {
+                        cv::imshow(name, frame);
+                        windowShown = true;
+                    }
+                }
+                if(windowShown) {
+                    auto key = cv::waitKey(1);
+                    if(key == 'q') {
+                        // Get the parent pipeline and stop it
+                        stopPipeline();
+                        break;
+                    }
+                }
+            }
+        } catch(const std::exception& ex) {
+            pimpl->logger->error("Display '{}' failed to render: {}", name, ex.what());
+            stopPipeline();
+        }
+    });
+
+    // The render thread is stopped however the node stops
+    try {
+        while(isRunning()) {
+            std::shared_ptr<dai::ImgFrame> imgFrame = input.get<dai::ImgFrame>();
+            if(imgFrame != nullptr && !mailbox.put(std::move(imgFrame))) {
+                droppedFrames++;
             }
         }
+    } catch(...) {
+        mailbox.close();
+        throw;
     }
+    mailbox.close();
 }
 }  // namespace node
 }  // namespace dai
@@ -0,0 +1,177 @@
+#include "depthai/pipeline/node/host/HostSpatialDetections.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <stdexcept>
+
+#include "depthai/pipeline/datatype/MessageGroup.hpp"
+#include "pipeline/ThreadedNodeImpl.hpp"
+#include "utility/SpatialLocationCalculatorImpl.hpp"
+
+namespace dai {
+namespace node {
+
+namespace {
+
+// Box of a detection in the normalized coordinates of the depth frame, scaled around its center and clipped to the frame.
+// Without the transformation of the detections, the box is used as it is.
+Rect toDepthRoi(const ImgDetection& detection, const ImgTransformation* from, const ImgTransformation& to, float scaleFactor) {
+    std::array<Point2f, 4> corners = {Point2f(detection.xmin, detection.ymin, true),
+                                      Point2f(detection.xmax, detection.ymin, true),
+                                      Point2f(detection.xmax, detection.ymax, true),
+                                      Point2f(detection.xmin, detection.ymax, true)};
+    if(from != nullptr) from->remapPointsTo(to, corners);
+
+    float xmin = corners[0].x, xmax = corners[0].x, ymin = corners[0].y, ymax = corners[0].y;
+    for(const auto& corner : corners) {
+        xmin = std::min(xmin, corner.x);
+        xmax = std::max(xmax, corner.x);
+        ymin = std::min(ymin, corner.y);
+        ymax = std::max(ymax, corner.y);
+    }
+    const float centerX = (xmin + xmax) / 2.0f;
+    const float centerY = (ymin + ymax) / 2.0f;
+    const float halfWidth = (xmax - xmin) * scaleFactor / 2.0f;
+    const float halfHeight = (ymax - ymin) * scaleFactor / 2.0f;
+    xmin = std::clamp(centerX - halfWidth, 0.0f, 1.0f);
+    xmax = std::clamp(centerX + halfWidth, 0.0f, 1.0f);
+    ymin = std::clamp(centerY - halfHeight, 0.0f, 1.0f);
+    ymax = std::clamp(centerY + halfHeight, 0.0f, 1.0f);
+    return Rect(xmin, ymin, xmax - xmin, ymax - ymin, true);
+}
+
+}  // namespace
+
+HostSpatialDetections& HostSpatialDetections::setBoundingBoxScaleFactor(float scaleFactor) {
+    if(!(scaleFactor > 0.0f && scaleFactor <= 1.0f)) throw std::invalid_argument("Bounding box scale factor must be in the interval (0,1]");
+    this->scaleFactor = scaleFactor;
+    return *this;
+}
+
+HostSpatialDetections& HostSpatialDetections::setDepthLowerThreshold(uint32_t lowerThreshold) {
+    depthThresholds.lowerThreshold = lowerThreshold;
+    return *this;
+}
+
+HostSpatialDetections& HostSpatialDetections::setDepthUpperThreshold(uint32_t upperThreshold) {
+    depthThresholds.upperThreshold = upperThreshold;
+    return *this;
+}
+
+HostSpatialDetections& HostSpatialDetections::setSpatialCalculationAlgorithm(SpatialLocationCalculatorAlgorithm calculationAlgorithm) {
+    this->calculationAlgorithm = calculationAlgorithm;
+    return *this;
+}
+
+HostSpatialDetections& HostSpatialDetections::setSpatialCalculationStepSize(int stepSize) {
+    if(stepSize < 1 && stepSize != SpatialLocationCalculatorConfigData::AUTO) throw std::invalid_argument("Step size must be at least 1 or AUTO");
+    this->stepSize = stepSize;
+    return *this;
+}
+
+float HostSpatialDetections::getBoundingBoxScaleFactor() const {
+    return scaleFactor;
+}
+
+uint32_t HostSpatialDetections::getDepthLowerThreshold() const {
+    return depthThresholds.lowerThreshold;
+}
+
+uint32_t HostSpatialDetections::getDepthUpperThreshold() const {
+    return depthThresholds.upperThreshold;
+}
+
+SpatialLocationCalculatorAlgorithm HostSpatialDetections::getSpatialCalculationAlgorithm() const {
+    return calculationAlgorithm;
+}
+
+int HostSpatialDetections::getSpatialCalculationStepSize() const {
+    return stepSize;
+}
+
+void HostSpatialDetections::buildInternal() {
+    sync->out.link(inSync);
+    sync->setRunOnHost(true);
+}
+
+void HostSpatialDetections::run() {
+    auto& logger = pimpl->logger;
+    impl::SpatialLocationCalculator calculator;
+    bool warnedNotRemapped = false;
+
+    while(isRunning()) {
+        auto group = inSync.get<MessageGroup>();
+        if(group == nullptr) continue;
+        auto detections = group->get<ImgDetections>(detectionsInputName);
+        auto depth = group->get<ImgFrame>(depthInputName);
+        if(detections == nullptr || depth == nullptr) {
+            logger->error("Skipping group: expected ImgDetections on '{}' and ImgFrame on '{}'", detectionsInputName, depthInputName);
+            continue;
+        }
+
+        const int width = static_cast<int>(depth->getWidth());
+        const int height = static_cast<int>(depth->getHeight());
+        const int stride = static_cast<int>(depth->getStride());
+        const auto data = depth->getData();
+        if(depth->getType() != ImgFrame::Type::RAW16 || stride < width * 2
+           || depth->fb.p1Offset + static_cast<size_t>(stride) * height > data.size()) {
+            logger->error("Skipping depth frame: expected RAW16 data matching its size and stride");
+            continue;
+        }
+
+        // Transformations created without calibration have identity intrinsics, which would give X and Y in pixels times depth
+        const auto intrinsics = depth->transformation.getIntrinsicMatrix();
+        const float fx = intrinsics[0][0];
+        const float fy = intrinsics[1][1];
+        const float cx = intrinsics[0][2];
+        const float cy = intrinsics[1][2];
+        if(!depth->transformation.isValid() || !std::isfinite(fx) || !std::isfinite(fy) || fx <= 1.0f || fy <= 1.0f) {
+            logger->error("Skipping depth frame: its transformation has no valid intrinsics (fx {}, fy {})", fx, fy);
+            continue;
+        }
+        calculator.setDepth(data.data() + depth->fb.p1Offset, width, height, stride, depthThresholds);
+
+        const ImgTransformation* from = detections->transformation.has_value() ? &detections->transformation.value() : nullptr;
+        if(from != nullptr && !from->isValid()) from = nullptr;
+        if(from == nullptr && !warnedNotRemapped) {
+            logger->warn("Detections have no valid transformation, their boxes are used in the depth frame without remapping");
+            warnedNotRemapped = true;
+        }
+
+        auto spatialDetections = std::make_shared<SpatialImgDetections>();
+        spatialDetections->setTimestamp(detections->getTimestamp());
+        spatialDetections->setTimestampDevice(detections->getTimestampDevice());
+        spatialDetections->setSequenceNum(detections->getSequenceNum());
+        spatialDetections->transformation = detections->transformation;
+        spatialDetections->detections.reserve(detections->detections.size());
+        for(const auto& detection : detections->detections) {
+            SpatialImgDetection spatialDetection;
+            static_cast<ImgDetection&>(spatialDetection) = detection;
+            auto& mapping = spatialDetection.boundingBoxMapping;
+            mapping.roi = toDepthRoi(detection, from, depth->transformation, scaleFactor);
+            mapping.depthThresholds = depthThresholds;
+            mapping.calculationAlgorithm = calculationAlgorithm;
+            mapping.stepSize = stepSize;
+
+            const auto& roi = mapping.roi;
+            impl::SpatialLocationCalculator::Region region;
+            // Rounded, so that remapping errors don't add a row or column of pixels
+            region.xmin = static_cast<int>(std::lround(roi.x * width));
+            region.ymin = static_cast<int>(std::lround(roi.y * height));
+            region.xmax = static_cast<int>(std::lround((roi.x + roi.width) * width));
+            region.ymax = static_cast<int>(std::lround((roi.y + roi.height) * height));
+            const float z = calculator.calculate(region, calculationAlgorithm, stepSize);
+
+            // Y points up, as on device
+            const float centerX = (roi.x + roi.width / 2.0f) * width;
+            const float centerY = (roi.y + roi.height / 2.0f) * height;
+            spatialDetection.spatialCoordinates = Point3f((centerX - cx) * z / fx, -(centerY - cy) * z / fy, z);
+            spatialDetections->detections.push_back(spatialDetection);
+        }
+        out.send(spatialDetections);
+    }
+}
+
+}  // namespace node
+}  // namespace dai
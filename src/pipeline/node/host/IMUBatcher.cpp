@@ -0,0 +1,125 @@
+#include "depthai/pipeline/node/host/IMUBatcher.hpp"
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "pipeline/ThreadedNodeImpl.hpp"
+
+namespace dai {
+namespace node {
+
+namespace {
+
+using TimePoint = std::chrono::time_point<std::chrono::steady_clock, std::chrono::steady_clock::duration>;
+
+// Earliest and latest timestamps on one clock of the packets in a batch
+struct TimeRange {
+    TimePoint first = TimePoint::max();
+    TimePoint last = TimePoint::min();
+
+    void add(const Timestamp& timestamp) {
+        if(timestamp.sec == 0 && timestamp.nsec == 0) return;
+        first = std::min(first, timestamp.get());
+        last = std::max(last, timestamp.get());
+    }
+    bool fits(const TimeRange& other) const {
+        if(first > last || other.first > other.last) return true;
+        return std::max(last, other.last) - std::min(first, other.first) <= IMUBatch::MAX_TIME_SPAN;
+    }
+    void merge(const TimeRange& other) {
+        first = std::min(first, other.first);
+        last = std::max(last, other.last);
+    }
+};
+
+std::array<TimeRange, 2> getTimeRanges(const IMUPacket& packet) {
+    std::array<TimeRange, 2> ranges;
+    for(const IMUReport* report : std::array<const IMUReport*, 4>{&packet.acceleroMeter, &packet.gyroscope, &packet.magneticField, &packet.rotationVector}) {
+        ranges[0].add(report->timestamp);
+        ranges[1].add(report->tsDevice);
+    }
+    return ranges;
+}
+
+}  // namespace
+
+IMUBatcher& IMUBatcher::setBatchSize(int batchSize) {
+    if(batchSize < 1) throw std::invalid_argument("IMUBatcher batch size has to be at least 1");
+    this->batchSize = batchSize;
+    return *this;
+}
+
+IMUBatcher& IMUBatcher::setMaxLatency(std::chrono::milliseconds maxLatency) {
+    if(maxLatency.count() < 0) throw std::invalid_argument("IMUBatcher maximum latency can't be negative");
+    this->maxLatency = maxLatency;
+    return *this;
+}
+
+int IMUBatcher::getBatchSize() const {
+    return batchSize;
+}
+
+std::chrono::milliseconds IMUBatcher::getMaxLatency() const {
+    return maxLatency;
+}
+
+void IMUBatcher::run() {
+    auto& logger = pimpl->logger;
+
+    std::vector<IMUPacket> pending;
+    pending.reserve(static_cast<size_t>(batchSize));
+    std::array<TimeRange, 2> pendingRanges;
+    std::shared_ptr<IMUData> last;
+    auto firstReceived = std::chrono::steady_clock::now();
+
+    auto flush = [&]() {
+        if(pending.empty()) return;
+        auto batch = std::make_shared<IMUBatch>();
+        batch->ts = last->ts;
+        batch->tsDevice = last->tsDevice;
+        batch->sequenceNum = last->sequenceNum;
+        try {
+            batch->setPackets(pending);
+        } catch(const std::invalid_argument& e) {
+            logger->error("Skipping IMU packets: {}", e.what());
+            batch = nullptr;
+        }
+        pending.clear();
+        pendingRanges = {};
+        if(batch != nullptr) out.send(batch);
+    };
+
+    while(isRunning()) {
+        std::shared_ptr<IMUData> imuData;
+        if(pending.empty() || maxLatency.count() == 0) {
+            imuData = input.get<IMUData>();
+        } else {
+            const auto remaining = firstReceived + maxLatency - std::chrono::steady_clock::now();
+            bool timedOut = remaining <= std::chrono::steady_clock::duration::zero();
+            if(!timedOut) imuData = input.get<IMUData>(remaining, timedOut);
+            if(timedOut) {
+                flush();
+                continue;
+            }
+        }
+        if(imuData == nullptr) continue;
+
+        for(const auto& packet : imuData->packets) {
+            const auto ranges = getTimeRanges(packet);
+            // Packets that would spread the timestamps of the batch too far apart start the next one
+            if(!pendingRanges[0].fits(ranges[0]) || !pendingRanges[1].fits(ranges[1])) flush();
+            if(pending.empty()) firstReceived = std::chrono::steady_clock::now();
+            pending.push_back(packet);
+            pendingRanges[0].merge(ranges[0]);
+            pendingRanges[1].merge(ranges[1]);
+            last = imuData;
+            if(pending.size() >= static_cast<size_t>(batchSize)) flush();
+        }
+    }
+}
+
+}  // namespace node
+}  // namespace dai
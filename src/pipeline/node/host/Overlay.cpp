@@ -0,0 +1,223 @@
+#include "depthai/pipeline/node/host/Overlay.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "depthai/pipeline/datatype/ImgAnnotations.hpp"
+#include "depthai/pipeline/datatype/ImgDetections.hpp"
+#include "depthai/pipeline/datatype/Tracklets.hpp"
+#include "pipeline/ThreadedNodeImpl.hpp"
+#include "utility/BufferPool.hpp"
+#include "utility/OverlayRendererImpl.hpp"
+
+namespace dai {
+namespace node {
+
+namespace {
+
+using Quad = std::array<Point2f, 4>;
+
+const std::array<Color, 8> PALETTE = {Color(0.90f, 0.10f, 0.10f, 1.0f),
+                                      Color(0.10f, 0.60f, 0.10f, 1.0f),
+                                      Color(0.10f, 0.30f, 0.90f, 1.0f),
+                                      Color(0.80f, 0.45f, 0.00f, 1.0f),
+                                      Color(0.60f, 0.10f, 0.70f, 1.0f),
+                                      Color(0.00f, 0.55f, 0.60f, 1.0f),
+                                      Color(0.75f, 0.10f, 0.45f, 1.0f),
+                                      Color(0.40f, 0.40f, 0.40f, 1.0f)};
+const Color LABEL_COLOR(1.0f, 1.0f, 1.0f, 1.0f);
+
+const Color& labelColor(int64_t label) {
+    return PALETTE[static_cast<size_t>(std::abs(label)) % PALETTE.size()];
+}
+
+// Copies the frame into a pooled buffer of the same layout and returns its planes
+impl::OverlayRenderer::Canvas copyFrame(const ImgFrame& frame, ImgFrame& output, utility::BufferPool& pool) {
+    impl::OverlayRenderer::Canvas canvas;
+    const auto type = frame.getType();
+    if(type == ImgFrame::Type::NV12) {
+        canvas.format = impl::OverlayRenderer::Format::NV12;
+    } else if(type == ImgFrame::Type::GRAY8) {
+        canvas.format = impl::OverlayRenderer::Format::GRAY8;
+    } else if(type == ImgFrame::Type::BGR888i) {
+        canvas.format = impl::OverlayRenderer::Format::BGR888i;
+    } else {
+        throw std::invalid_argument("Overlay draws only into NV12, GRAY8 and BGR888i frames");
+    }
+    canvas.width = static_cast<int>(frame.getWidth());
+    canvas.height = static_cast<int>(frame.getHeight());
+    canvas.stride = static_cast<int>(frame.getStride());
+    canvas.chromaStride = canvas.stride;
+
+    const auto data = frame.getData();
+    const size_t bytesPerPixel = canvas.format == impl::OverlayRenderer::Format::BGR888i ? 3 : 1;
+    bool fits = canvas.stride >= 0 && static_cast<size_t>(canvas.stride) >= canvas.width * bytesPerPixel
+                && frame.fb.p1Offset + static_cast<size_t>(canvas.stride) * canvas.height <= data.size();
+    if(canvas.format == impl::OverlayRenderer::Format::NV12) {
+        fits = fits && frame.fb.p2Offset + static_cast<size_t>(canvas.chromaStride) * ((canvas.height + 1) / 2) <= data.size();
+    }
+    if(!fits) throw std::invalid_argument("Frame data doesn't match its size, stride and type");
+
+    output.data = pool.acquire(data.size());
+    std::uint8_t* pixels = output.data->getData().data();
+    std::memcpy(pixels, data.data(), data.size());
+    output.setMetadata(frame);
+    canvas.data = pixels + frame.fb.p1Offset;
+    if(canvas.format == impl::OverlayRenderer::Format::NV12) canvas.chroma = pixels + frame.fb.p2Offset;
+    return canvas;
+}
+
+// Annotation points are normalized to the frame unless marked otherwise
+Point2f toPixels(const Point2f& point, int width, int height) {
+    if(point.hasNormalized && !point.normalized) return Point2f(point.x, point.y);
+    return Point2f(point.x * width, point.y * height);
+}
+
+void drawAnnotations(impl::OverlayRenderer& renderer, const ImgAnnotations& message, int width, int height) {
+    for(const auto& annotation : message.annotations) {
+        for(const auto& circle : annotation.circles) {
+            const bool normalized = !circle.position.hasNormalized || circle.position.normalized;
+            const float diameter = normalized ? circle.diameter * width : circle.diameter;
+            renderer.drawCircle(toPixels(circle.position, width, height), diameter / 2.0f, circle.thickness, circle.outlineColor, circle.fillColor);
+        }
+        for(const auto& points : annotation.points) {
+            std::vector<Point2f> pixels;
+            pixels.reserve(points.points.size());
+            for(const auto& point : points.points) pixels.push_back(toPixels(point, width, height));
+            const auto type = points.type;
+            if(type == PointsAnnotationType::POINTS) {
+                for(size_t i = 0; i < pixels.size(); i++) {
+                    const auto& color = i < points.outlineColors.size() ? points.outlineColors[i] : points.outlineColor;
+                    renderer.drawCircle(pixels[i], points.thickness / 2.0f, 1.0f, Color(), color);
+                }
+            } else if(type == PointsAnnotationType::LINE_LOOP) {
+                if(points.fillColor.a > 0.0f) renderer.fillPolygon(pixels, points.fillColor);
+                renderer.drawPolyline(pixels, true, points.thickness, points.outlineColor, points.outlineColors);
+            } else if(type == PointsAnnotationType::LINE_STRIP) {
+                renderer.drawPolyline(pixels, false, points.thickness, points.outlineColor, points.outlineColors);
+            } else if(type == PointsAnnotationType::LINE_LIST) {
+                for(size_t i = 0; i + 1 < pixels.size(); i += 2) {
+                    const auto& color = i < points.outlineColors.size() ? points.outlineColors[i] : points.outlineColor;
+                    renderer.drawLine(pixels[i], pixels[i + 1], points.thickness, color);
+                }
+            }
+        }
+        for(const auto& text : annotation.texts) {
+            renderer.drawText(toPixels(text.position, width, height), text.text, text.fontSize, text.textColor, text.backgroundColor);
+        }
+    }
+}
+
+// Corners of a box in the space of a transformation, remapped to frame pixels
+Quad remapBox(Quad corners, const ImgTransformation* from, const ImgTransformation& to, int width, int height) {
+    if(from != nullptr && from->isValid() && to.isValid()) from->remapPointsTo(to, corners);
+    for(auto& corner : corners) corner = toPixels(corner, width, height);
+    return corners;
+}
+
+void drawBox(impl::OverlayRenderer& renderer, const Quad& corners, const Color& color, const std::string& label, float thickness, float fontSize) {
+    renderer.drawPolyline(std::vector<Point2f>(corners.begin(), corners.end()), true, thickness, color);
+    // The label sits on top of the box, or inside of it at the top edge of the frame
+    const auto box = renderer.measureText(label, fontSize);
+    const float left = corners[0].x - thickness / 2.0f;
+    const float top = std::max(0.0f, corners[0].y - thickness / 2.0f - box.height);
+    renderer.drawText(Point2f(left + box.originX, top + box.originY), label, fontSize, LABEL_COLOR, color);
+}
+
+}  // namespace
+
+Overlay& Overlay::setThickness(float thickness) {
+    this->thickness = thickness;
+    return *this;
+}
+
+Overlay& Overlay::setFontSize(float fontSize) {
+    this->fontSize = fontSize;
+    return *this;
+}
+
+Overlay& Overlay::setNumFramesPool(int numFramesPool) {
+    this->numFramesPool = numFramesPool;
+    return *this;
+}
+
+float Overlay::getThickness() const {
+    return thickness;
+}
+
+float Overlay::getFontSize() const {
+    return fontSize;
+}
+
+int Overlay::getNumFramesPool() const {
+    return numFramesPool;
+}
+
+void Overlay::run() {
+    auto& logger = pimpl->logger;
+
+    utility::BufferPool pool(static_cast<size_t>(std::max(0, numFramesPool)));
+    impl::OverlayRenderer renderer;
+    // Latest message of each annotations input, drawn in the order of the input names
+    std::map<std::pair<std::string, std::string>, std::shared_ptr<ADatatype>> latest;
+
+    while(isRunning()) {
+        auto frame = input.get<ImgFrame>();
+        if(frame == nullptr) continue;
+        for(auto& entry : annotations) {
+            while(auto message = entry.second.tryGet()) latest[entry.first] = message;
+        }
+
+        auto output = std::make_shared<ImgFrame>();
+        try {
+            renderer.setCanvas(copyFrame(*frame, *output, pool));
+        } catch(const std::invalid_argument& e) {
+            logger->error("Skipping frame: {}", e.what());
+            continue;
+        }
+
+        const int width = static_cast<int>(frame->getWidth());
+        const int height = static_cast<int>(frame->getHeight());
+        for(const auto& entry : latest) {
+            const auto& message = entry.second;
+            if(auto imgAnnotations = std::dynamic_pointer_cast<ImgAnnotations>(message)) {
+                drawAnnotations(renderer, *imgAnnotations, width, height);
+            } else if(auto detections = std::dynamic_pointer_cast<ImgDetections>(message)) {
+                const ImgTransformation* from = detections->transformation.has_value() ? &detections->transformation.value() : nullptr;
+                for(const auto& detection : detections->detections) {
+                    const Quad corners = {Point2f(detection.xmin, detection.ymin, true),
+                                          Point2f(detection.xmax, detection.ymin, true),
+                                          Point2f(detection.xmax, detection.ymax, true),
+                                          Point2f(detection.xmin, detection.ymax, true)};
+                    const auto name = detection.labelName.empty() ? std::to_string(detection.label) : detection.labelName;
+                    const auto label = name + " " + std::to_string(std::lround(detection.confidence * 100.0f)) + "%";
+                    drawBox(renderer, remapBox(corners, from, frame->transformation, width, height), labelColor(detection.label), label, thickness, fontSize);
+                }
+            } else if(auto tracklets = std::dynamic_pointer_cast<Tracklets>(message)) {
+                for(const auto& tracklet : tracklets->tracklets) {
+                    if(tracklet.status == Tracklet::TrackingStatus::REMOVED) continue;
+                    const auto& roi = tracklet.roi;
+                    const bool normalized = roi.isNormalized();
+                    const Quad corners = {Point2f(roi.x, roi.y, normalized),
+                                          Point2f(roi.x + roi.width, roi.y, normalized),
+                                          Point2f(roi.x + roi.width, roi.y + roi.height, normalized),
+                                          Point2f(roi.x, roi.y + roi.height, normalized)};
+                    const auto& name = tracklet.srcImgDetection.labelName;
+                    const auto label = "ID " + std::to_string(tracklet.id) + " " + (name.empty() ? std::to_string(tracklet.label) : name);
+                    drawBox(renderer, remapBox(corners, &tracklets->transformation, frame->transformation, width, height), labelColor(tracklet.label), label, thickness, fontSize);
+                }
+            }
+        }
+        out.send(output);
+    }
+}
+
+}  // namespace node
+}  // namespace dai
@@ -0,0 +1,111 @@
+#include "depthai/pipeline/node/host/VideoDecoder.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#include "pipeline/ThreadedNodeImpl.hpp"
+#include "utility/BufferPool.hpp"
+#include "utility/JpegDecoderImpl.hpp"
+
+namespace dai {
+namespace node {
+
+namespace {
+
+struct Stream {
+    EncodedFrame::Profile profile = EncodedFrame::Profile::JPEG;
+    std::unique_ptr<impl::JpegDecoder> decoder;
+};
+
+}  // namespace
+
+VideoDecoder& VideoDecoder::setOutputType(ImgFrame::Type type) {
+    if(type != ImgFrame::Type::NV12 && type != ImgFrame::Type::GRAY8) {
+        throw std::invalid_argument("VideoDecoder output type has to be NV12 or GRAY8");
+    }
+    outputType = type;
+    return *this;
+}
+
+VideoDecoder& VideoDecoder::setNumFramesPool(int numFramesPool) {
+    this->numFramesPool = numFramesPool;
+    return *this;
+}
+
+ImgFrame::Type VideoDecoder::getOutputType() const {
+    return outputType;
+}
+
+int VideoDecoder::getNumFramesPool() const {
+    return numFramesPool;
+}
+
+void VideoDecoder::run() {
+    auto& logger = pimpl->logger;
+
+    utility::BufferPool pool(static_cast<size_t>(std::max(0, numFramesPool)));
+    std::unordered_map<uint32_t, Stream> streams;
+
+    while(isRunning()) {
+        auto encoded = input.get<EncodedFrame>();
+        if(encoded == nullptr) continue;
+
+        const uint32_t instanceNum = encoded->getInstanceNum();
+        auto found = streams.find(instanceNum);
+        if(found == streams.end() || found->second.profile != encoded->getProfile()) {
+            Stream stream;
+            stream.profile = encoded->getProfile();
+            if(stream.profile == EncodedFrame::Profile::JPEG) {
+                stream.decoder = std::make_unique<impl::JpegDecoder>();
+            } else {
+                // H.264/H.265 would need libavcodec, which only OpenCV links through the opencv-support feature, not the core library
+                logger->warn("VideoDecoder on host decodes only MJPEG, dropping H.264/H.265 frames of stream {}", instanceNum);
+            }
+            found = streams.insert_or_assign(instanceNum, std::move(stream)).first;
+        }
+        auto& stream = found->second;
+        if(stream.decoder == nullptr) continue;
+
+        auto frame = std::make_shared<ImgFrame>();
+        try {
+            const auto data = encoded->getData();
+            const size_t size = encoded->frameSize != 0 ? encoded->frameSize : data.size() - std::min<size_t>(data.size(), encoded->frameOffset);
+            if(encoded->frameOffset + size > data.size()) throw std::invalid_argument("Encoded frame size doesn't match its data");
+            stream.decoder->parse(data.data() + encoded->frameOffset, size);
+
+            const int width = stream.decoder->getWidth();
+            const int height = stream.decoder->getHeight();
+            const bool nv12 = outputType == ImgFrame::Type::NV12;
+            const int stride = nv12 ? (width + 1) & ~1 : width;
+            const size_t lumaSize = static_cast<size_t>(stride) * height;
+            frame->data = pool.acquire(nv12 ? lumaSize + static_cast<size_t>(stride) * ((height + 1) / 2) : lumaSize);
+            std::uint8_t* pixels = frame->data->getData().data();
+            stream.decoder->decode(pixels, stride, nv12 ? pixels + lumaSize : nullptr, stride);
+
+            frame->setType(outputType);
+            frame->setSize(width, height);
+            frame->setStride(stride);
+            frame->fb.p1Offset = 0;
+            frame->fb.p2Offset = static_cast<std::uint32_t>(lumaSize);
+            frame->fb.p3Offset = static_cast<std::uint32_t>(lumaSize);
+        } catch(const std::invalid_argument& e) {
+            // Every MJPEG frame is a keyframe, decoding resumes with the next one
+            logger->error("Skipping frame: {}", e.what());
+            continue;
+        }
+
+        frame->cam = encoded->cam;
+        frame->setInstanceNum(instanceNum);
+        frame->transformation = encoded->transformation;
+        frame->setSequenceNum(encoded->getSequenceNum());
+        frame->setTimestamp(encoded->getTimestamp());
+        frame->setTimestampDevice(encoded->getTimestampDevice());
+        out.send(frame);
+    }
+}
+
+}  // namespace node
+}  // namespace dai
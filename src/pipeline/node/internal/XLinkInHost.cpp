@@ -38,17 +38,19 @@ void XLinkInHost::run() {
     while(reconnect) {
         reconnect = false;
         XLinkStream stream(std::move(conn), streamName, 1);
+        // Transformations interned by the sender, valid for this stream only
+        StreamMessageParser::TransformationCache transformations;
         while(isRunning()) {
             try {
                 // Blocking -- parse packet and gather timing information
                 auto packet = stream.readMove();
                 const auto t1Parse = std::chrono::steady_clock::now();
-                const auto msg = StreamMessageParser::parseMessage(std::move(packet));
+                const auto msg = StreamMessageParser::parseMessage(std::move(packet), transformations);
                 if(std::dynamic_pointer_cast<MessageGroup>(msg) != nullptr) {
                     auto msgGrp = std::static_pointer_cast<MessageGroup>(msg);
                     for(auto& msg : msgGrp->group) {
                         auto dpacket = stream.readMove();
-                        msg.second = StreamMessageParser::parseMessage(&dpacket);
+                        msg.second = StreamMessageParser::parseMessage(&dpacket, transformations);
                     }
                 }
                 const auto t2Parse = std::chrono::steady_clock::now();
@@ -4,14 +4,219 @@
 #include <pcl/point_cloud.h>
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
 #include "depthai/pipeline/Pipeline.hpp"
 #include "pipeline/ThreadedNodeImpl.hpp"
 #include "rtabmap/core/util3d.h"
 #include "rtabmap/core/util3d_mapping.h"
+#include "utility/BufferPool.hpp"
+#include "utility/MapDiff.hpp"
 
 namespace dai {
 namespace node {
 
+namespace {
+
+constexpr size_t NUM_POOLED_BUFFERS = 8;
+
+// Ground or obstacle cells of a node, in the map frame
+std::vector<Point3fRGBA> nodePoints(const rtabmap::LocalGrid& grid, bool obstacles, const rtabmap::Transform& pose) {
+    const auto cloud = rtabmap::util3d::laserScanToPointCloudRGB(rtabmap::LaserScan::backwardCompatibility(obstacles ? grid.obstacleCells : grid.groundCells), pose);
+    std::vector<Point3fRGBA> points;
+    points.reserve(cloud->size());
+    for(const auto& point : cloud->points) points.emplace_back(point.x, point.y, point.z, point.r, point.g, point.b);
+    return points;
+}
+
+}  // namespace
+
+class RTABMapSLAM::MapPublisher {
+   public:
+    MapPublisher(bool incremental, int keyframeInterval, int tileSize, size_t maxRate, float cellSize)
+        : incremental(incremental),
+          keyframeInterval(keyframeInterval),
+          maxRate(maxRate),
+          cellSize(cellSize),
+          obstacles(cellSize, true),
+          ground(cellSize, false),
+          grid(tileSize) {}
+
+    // Full maps have to be published next, as the published ones don't match the map anymore
+    void invalidate() {
+        obstacles.keyframePending = true;
+        ground.keyframePending = true;
+        grid.keyframePending = true;
+    }
+
+    void publishObstacles(const rtabmap::CloudMap& map, const rtabmap::LocalGridCache& cache, Output& full, Output& update) {
+        publishCloud(*map.getMapObstacles(), map.addedNodes(), cache, obstacles, full, update);
+    }
+
+    void publishGround(const rtabmap::CloudMap& map, const rtabmap::LocalGridCache& cache, Output& full, Output& update) {
+        publishCloud(*map.getMapGround(), map.addedNodes(), cache, ground, full, update);
+    }
+
+    void publishGrid(const cv::Mat& map, float xMin, float yMin, Output& full, Output& update) {
+        const auto now = std::chrono::steady_clock::now();
+        // World cells of the first column and row, the map is flipped so rows go down in y
+        const int originX = static_cast<int>(std::lround(xMin / cellSize));
+        const int originY = -static_cast<int>(std::lround(yMin / cellSize)) - (map.rows - 1);
+        if(publishFull(grid, map.total(), now)) {
+            full.send(makeGridFrame(map, cv::Rect(0, 0, map.cols, map.rows), cv::Point(0, 0), map.size(), grid.sequenceNum++, now));
+            published(grid, now);
+            if(incremental) {
+                grid.tiles.clear();
+                grid.tiles.update(map.data, map.step[0], map.cols, map.rows, originX, originY, nullptr);
+                grid.origin = cv::Point(originX, originY);
+                grid.size = map.size();
+            }
+        } else if(incremental && !grid.keyframePending) {
+            // Tiles are positioned within the latest full map, which the current map may have outgrown in any direction
+            const cv::Point offset(originX - grid.origin.x, originY - grid.origin.y);
+            grid.tiles.update(map.data, map.step[0], map.cols, map.rows, originX, originY, [&](const utility::TileMapDiff::Rect& tile) {
+                update.send(makeGridFrame(map, cv::Rect(tile.x, tile.y, tile.width, tile.height), offset, grid.size, grid.sequenceNum++, now));
+            });
+            grid.updatesSinceKeyframe++;
+        }
+    }
+
+   private:
+    struct State {
+        uint32_t sequenceNum = 0;
+        int updatesSinceKeyframe = 0;
+        bool keyframePending = true;
+        std::chrono::steady_clock::time_point lastKeyframe;
+    };
+    struct CloudState : State {
+        CloudState(float cellSize, bool obstacles) : voxels(cellSize), obstacles(obstacles) {}
+        utility::VoxelMapDiff voxels;
+        bool obstacles;
+    };
+    struct GridState : State {
+        explicit GridState(int tileSize) : tiles(tileSize) {}
+        utility::TileMapDiff tiles;
+        // World cell of the top left corner and the size of the latest full map
+        cv::Point origin;
+        cv::Size size;
+    };
+
+    bool incremental;
+    int keyframeInterval;
+    size_t maxRate;
+    float cellSize;
+    CloudState obstacles;
+    CloudState ground;
+    GridState grid;
+    utility::BufferPool cloudPool{NUM_POOLED_BUFFERS};
+    utility::BufferPool gridPool{NUM_POOLED_BUFFERS};
+    std::vector<Point3fRGBA> changes;
+
+    // Whether the full map is published, rather than its changes since the previous publish
+    bool publishFull(const State& state, size_t mapSize, std::chrono::steady_clock::time_point now) const {
+        if(incremental && !state.keyframePending && state.updatesSinceKeyframe < keyframeInterval) return false;
+        if(maxRate > 0 && state.lastKeyframe != std::chrono::steady_clock::time_point()) {
+            const std::chrono::duration<double> interval(static_cast<double>(mapSize) / static_cast<double>(maxRate));
+            if(now - state.lastKeyframe < interval) return false;
+        }
+        return true;
+    }
+
+    static void published(State& state, std::chrono::steady_clock::time_point now) {
+        state.updatesSinceKeyframe = 0;
+        state.keyframePending = false;
+        state.lastKeyframe = now;
+    }
+
+    static void addNode(CloudState& state, const rtabmap::LocalGridCache& cache, int id, const rtabmap::Transform& pose) {
+        const auto& grids = cache.localGrids();
+        const auto grid = grids.find(id);
+        if(grid != grids.end()) state.voxels.addNode(id, nodePoints(grid->second, state.obstacles, pose));
+    }
+
+    void publishCloud(const pcl::PointCloud<pcl::PointXYZRGB>& cloud,
+                      const std::map<int, rtabmap::Transform>& nodes,
+                      const rtabmap::LocalGridCache& cache,
+                      CloudState& state,
+                      Output& full,
+                      Output& update) {
+        const auto now = std::chrono::steady_clock::now();
+        if(publishFull(state, cloud.size(), now)) {
+            full.send(makeCloud(cloud, state.sequenceNum++, now));
+            published(state, now);
+            if(incremental) {
+                // Nodes are placed anew, as their poses may have changed since they were added
+                state.voxels.clear();
+                for(const auto& node : nodes) addNode(state, cache, node.first, node.second);
+                state.voxels.markPublished();
+            }
+        } else if(incremental && !state.keyframePending) {
+            // While a full map is pending, as after invalidate() or when maxRate defers it, the published voxels don't match
+            // the map anymore, so updates are held back until the full map goes out.
+            // Only the nodes added to or removed from the map since the previous publish are voxelized.
+            for(const auto id : state.voxels.getNodes()) {
+                if(nodes.count(id) == 0) state.voxels.removeNode(id);
+            }
+            for(const auto& node : nodes) {
+                if(!state.voxels.hasNode(node.first)) addNode(state, cache, node.first, node.second);
+            }
+            changes.clear();
+            state.voxels.takeChanges(changes);
+            if(!changes.empty()) update.send(makeCloud(changes, state.sequenceNum++, now));
+            state.updatesSinceKeyframe++;
+        }
+    }
+
+    std::shared_ptr<PointCloudData> makeCloud(const pcl::PointCloud<pcl::PointXYZRGB>& cloud, uint32_t sequenceNum, std::chrono::steady_clock::time_point now) {
+        auto message = std::make_shared<PointCloudData>();
+        message->data = cloudPool.acquire(cloud.size() * sizeof(Point3fRGBA));
+        auto* points = reinterpret_cast<Point3fRGBA*>(message->data->getData().data());
+        for(size_t i = 0; i < cloud.size(); i++) {
+            const auto& point = cloud.points[i];
+            points[i] = Point3fRGBA{point.x, point.y, point.z, point.r, point.g, point.b};
+        }
+        message->setSize(cloud.width, cloud.height);
+        message->setSparse(!cloud.is_dense);
+        message->setColor(true);
+        message->setSequenceNum(sequenceNum);
+        message->setTimestamp(now);
+        return message;
+    }
+
+    std::shared_ptr<PointCloudData> makeCloud(const std::vector<Point3fRGBA>& points, uint32_t sequenceNum, std::chrono::steady_clock::time_point now) {
+        auto message = std::make_shared<PointCloudData>();
+        message->data = cloudPool.acquire(points.size() * sizeof(Point3fRGBA));
+        std::memcpy(message->data->getData().data(), points.data(), points.size() * sizeof(Point3fRGBA));
+        message->setSize(static_cast<unsigned int>(points.size()), 1);
+        message->setSparse(true);
+        message->setColor(true);
+        message->setSequenceNum(sequenceNum);
+        message->setTimestamp(now);
+        return message;
+    }
+
+    // Copies a tile of the map, positioned at offset + tile within a map of the given size
+    std::shared_ptr<ImgFrame> makeGridFrame(
+        const cv::Mat& map, const cv::Rect& tile, cv::Point offset, cv::Size size, uint32_t sequenceNum, std::chrono::steady_clock::time_point now) {
+        auto frame = std::make_shared<ImgFrame>();
+        frame->data = gridPool.acquire(tile.area());
+        uint8_t* pixels = frame->data->getData().data();
+        for(int y = 0; y < tile.height; y++) std::memcpy(pixels + y * tile.width, map.ptr(tile.y + y) + tile.x, tile.width);
+        frame->setType(ImgFrame::Type::GRAY8);
+        frame->setSize(tile.width, tile.height);
+        frame->setStride(tile.width);
+        frame->fb.p1Offset = 0;
+        frame->transformation = ImgTransformation(size.width, size.height);
+        if(tile.size() != size || offset != cv::Point(0, 0)) frame->transformation.addCrop(offset.x + tile.x, offset.y + tile.y, tile.width, tile.height);
+        frame->setSequenceNum(sequenceNum);
+        frame->setTimestamp(now);
+        return frame;
+    }
+};
+
 void RTABMapSLAM::buildInternal() {
     sync->out.link(inSync);
     sync->setRunOnHost(false);
@@ -49,6 +254,7 @@ void RTABMapSLAM::setParams(const rtabmap::ParametersMap& params) {
 
 void RTABMapSLAM::triggerNewMap() {
     rtabmap.triggerNewMap();
+    newMapTriggered = true;
 }
 
 void RTABMapSLAM::saveDatabase() {
@@ -129,7 +335,12 @@ void RTABMapSLAM::run() {
                     if(rtabmap.getLoopClosureId() > 0) {
                         logger->debug("Loop closure detected! last loop closure id = {}", rtabmap.getLoopClosureId());
                     }
+                    const rtabmap::Transform previousCorrection = odomCorr;
                     odomCorr = stats.mapCorrection();
+                    // Published maps are outdated once the map is optimized or started anew
+                    if(rtabmap.getLoopClosureId() > 0 || odomCorr != previousCorrection || newMapTriggered.exchange(false)) {
+                        mapPublisher->invalidate();
+                    }
 
                     const std::map<int, rtabmap::Transform>& optimizedPoses = rtabmap.getLocalOptimizedPoses();
 
@@ -172,11 +383,7 @@ void RTABMapSLAM::publishGridMap(const std::map<int, rtabmap::Transform>& optimi
     if(!map.empty()) {
         cv::Mat map8U = rtabmap::util3d::convertMap2Image8U(map);
         cv::flip(map8U, map8U, 0);
-
-        auto mapMsg = std::make_shared<dai::ImgFrame>();
-        mapMsg->setTimestamp(std::chrono::steady_clock::now());
-        mapMsg->setCvFrame(map8U, ImgFrame::Type::GRAY8);
-        occupancyGridMap.send(mapMsg);
+        mapPublisher->publishGrid(map8U, xMin, yMin, occupancyGridMap, occupancyGridMapUpdate);
     }
 }
 
@@ -186,16 +393,10 @@ void RTABMapSLAM::publishPointClouds(const std::map<int, rtabmap::Transform>& op
     }
 
     if(publishObstacleCloud) {
-        auto obstaclesMap = cloudMap->getMapObstacles();
-        auto pclData = std::make_shared<dai::PointCloudData>();
-        pclData->setPclDataRGB(obstaclesMap);
-        obstaclePCL.send(pclData);
+        mapPublisher->publishObstacles(*cloudMap, *localMaps, obstaclePCL, obstaclePCLUpdate);
     }
     if(publishGroundCloud) {
-        auto groundMap = cloudMap->getMapGround();
-        auto pclData = std::make_shared<dai::PointCloudData>();
-        pclData->setPclDataRGB(groundMap);
-        groundPCL.send(pclData);
+        mapPublisher->publishGround(*cloudMap, *localMaps, groundPCL, groundPCLUpdate);
     }
 }
 
@@ -212,6 +413,9 @@ void RTABMapSLAM::initialize(dai::Pipeline& pipeline, int instanceNum, int width
     startTime = std::chrono::steady_clock::now();
     occupancyGrid = std::make_unique<rtabmap::OccupancyGrid>(localMaps.get(), rtabParams);
     cloudMap = std::make_unique<rtabmap::CloudMap>(localMaps.get(), rtabParams);
+    float cellSize = rtabmap::Parameters::defaultGridCellSize();
+    rtabmap::Parameters::parse(rtabParams, rtabmap::Parameters::kGridCellSize(), cellSize);
+    mapPublisher = std::make_shared<MapPublisher>(publishIncremental, keyframeInterval, gridTileSize, maxMapPublishRate, cellSize);
     initialized = true;
 }
 }  // namespace node
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "depthai/utility/VectorMemory.hpp"
+
+namespace dai {
+namespace utility {
+
+/**
+ * Message data buffers, returned for reuse once the messages holding them are released
+ */
+class BufferPool {
+   public:
+    /**
+     * @param capacity Maximum number of released buffers kept for reuse
+     */
+    explicit BufferPool(size_t capacity) : state(std::make_shared<State>()) {
+        state->capacity = capacity;
+    }
+
+    /**
+     * Get a buffer of the given size, with unspecified contents
+     */
+    std::shared_ptr<Memory> acquire(size_t size) {
+        std::unique_ptr<VectorMemory> memory;
+        {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            if(!state->buffers.empty()) {
+                memory = std::move(state->buffers.back());
+                state->buffers.pop_back();
+            }
+        }
+        if(!memory) memory = std::make_unique<VectorMemory>();
+        memory->resize(size);
+
+        // Buffers released after the pool is destroyed are freed
+        std::weak_ptr<State> weakState = state;
+        return std::shared_ptr<VectorMemory>(memory.release(), [weakState](VectorMemory* released) {
+            std::unique_ptr<VectorMemory> buffer(released);
+            if(auto pool = weakState.lock()) {
+                std::lock_guard<std::mutex> lock(pool->mutex);
+                if(pool->buffers.size() < pool->capacity) pool->buffers.push_back(std::move(buffer));
+            }
+        });
+    }
+
+   private:
+    struct State {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<VectorMemory>> buffers;
+        size_t capacity = 0;
+    };
+    std::shared_ptr<State> state;
+};
+
+}  // namespace utility
+}  // namespace dai
@@ -3,71 +3,501 @@
 #include <fmt/format.h>
 #include <fmt/std.h>
 
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <climits>
+#include <deque>
 #include <filesystem>
 #include <fstream>
+#include <future>
 #include <stdexcept>
+#include <thread>
 
 #include "archive.h"
 #include "archive_entry.h"
 #include "utility/span.hpp"
 #include "zlib.h"
+#include "zstd.h"
 
 namespace dai {
 namespace utility {
 
-std::vector<uint8_t> deflate(span<uint8_t>& data, int compressionLevel) {
+namespace {
+
+constexpr size_t DEFLATE_WINDOW_SIZE = 32 * 1024;
+
+struct DeflatedBlock {
+    std::vector<uint8_t> data;
+    uLong adler;
+};
+
+// Deflates a single block as raw deflate data. Non-last blocks are terminated with a sync flush, so they end on a byte boundary
+// and can be concatenated with the following block.
+DeflatedBlock deflateBlock(const uint8_t* dictionary, size_t dictionarySize, const uint8_t* data, size_t size, int compressionLevel, bool last) {
     z_stream stream;
     stream.zalloc = Z_NULL;
     stream.zfree = Z_NULL;
     stream.opaque = Z_NULL;
-    int ret = deflateInit(&stream, compressionLevel);
-    if(ret != Z_OK) {
-        throw std::runtime_error("deflateInit failed with error code " + std::to_string(ret) + ".");
-    }
-    std::vector<uint8_t> result(deflateBound(&stream, data.size()));
-    stream.next_out = result.data();
-    stream.avail_out = result.size();
-    stream.next_in = data.data();
-    stream.avail_in = data.size();
-    ret = deflate(&stream, Z_NO_FLUSH);
+    int ret = deflateInit2(&stream, compressionLevel, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
     if(ret != Z_OK) {
-        throw std::runtime_error("deflate failed with error code " + std::to_string(ret) + ".");
+        throw std::runtime_error("deflateInit2 failed with error code " + std::to_string(ret) + ".");
     }
-    ret = deflate(&stream, Z_FINISH);
-    if(ret != Z_STREAM_END) {
-        throw std::runtime_error("Could not finish deflation.");
+    if(dictionarySize > 0) {
+        deflateSetDictionary(&stream, dictionary, static_cast<uInt>(dictionarySize));
     }
+
+    DeflatedBlock block;
+    // deflateBound doesn't account for the sync flush marker
+    block.data.resize(deflateBound(&stream, static_cast<uLong>(size)) + 16);
+    stream.next_in = const_cast<Bytef*>(data);
+    stream.avail_in = static_cast<uInt>(size);
+    stream.next_out = block.data.data();
+    stream.avail_out = static_cast<uInt>(block.data.size());
+    ret = deflate(&stream, last ? Z_FINISH : Z_SYNC_FLUSH);
     deflateEnd(&stream);
-    result.resize(stream.total_out);
-    return result;
+    if(ret != (last ? Z_STREAM_END : Z_OK) || stream.avail_in != 0) {
+        throw std::runtime_error("deflate failed with error code " + std::to_string(ret) + ".");
+    }
+    block.data.resize(stream.total_out);
+    block.adler = adler32(adler32(0L, Z_NULL, 0), data, static_cast<uInt>(size));
+    return block;
 }
 
-std::vector<uint8_t> inflate(span<uint8_t>& data) {
-    z_stream stream;
-    stream.zalloc = Z_NULL;
-    stream.zfree = Z_NULL;
-    stream.opaque = Z_NULL;
-    int ret = inflateInit(&stream);
-    if(ret != Z_OK) {
-        throw std::runtime_error("inflateInit failed with error code " + std::to_string(ret) + ".");
-    }
-    std::vector<uint8_t> result;
-    stream.next_out = result.data();
-    stream.avail_out = result.size();
-    stream.next_in = data.data();
-    stream.avail_in = data.size();
-    ret = inflate(&stream, Z_NO_FLUSH);
-    if(ret != Z_OK) {
-        throw std::runtime_error("inflate failed with error code " + std::to_string(ret) + ".");
+void checkDeflateParameters(int compressionLevel, size_t blockSize) {
+    if(compressionLevel < 0 || compressionLevel > 9) {
+        throw std::invalid_argument("Compression level must be between 0 and 9.");
     }
-    ret = inflate(&stream, Z_FINISH);
-    if(ret != Z_STREAM_END) {
-        throw std::runtime_error("Could not finish inflation.");
+    if(blockSize < DEFLATE_WINDOW_SIZE) {
+        throw std::invalid_argument("Block size must be at least 32KiB.");
     }
-    inflateEnd(&stream);
-    result.resize(stream.total_out);
-    return result;
+}
+
+// zlib header, matching the one produced by deflateInit
+std::array<uint8_t, 2> zlibHeader(int compressionLevel) {
+    const unsigned levelFlags = compressionLevel < 2 ? 0 : compressionLevel < 6 ? 1 : compressionLevel == 6 ? 2 : 3;
+    unsigned header = (0x78 << 8) | (levelFlags << 6);
+    header += 31 - (header % 31);
+    return {static_cast<uint8_t>(header >> 8), static_cast<uint8_t>(header & 0xFF)};
+}
+
+// zlib trailer, big endian adler32 of uncompressed data
+std::array<uint8_t, 4> zlibTrailer(uLong adler) {
+    return {static_cast<uint8_t>(adler >> 24), static_cast<uint8_t>(adler >> 16), static_cast<uint8_t>(adler >> 8), static_cast<uint8_t>(adler)};
+}
+
+}  // namespace
+
+void deflateParallel(
+    const uint8_t* data, size_t size, const std::function<void(const uint8_t*, size_t)>& callback, int compressionLevel, size_t blockSize, unsigned numThreads) {
+    checkDeflateParameters(compressionLevel, blockSize);
+    if(numThreads == 0) {
+        numThreads = std::max(1U, std::thread::hardware_concurrency());
+    }
+
+    const auto header = zlibHeader(compressionLevel);
+    callback(header.data(), header.size());
+
+    const size_t numBlocks = std::max<size_t>(1, (size + blockSize - 1) / blockSize);
+    uLong adler = adler32(0L, Z_NULL, 0);
+
+    // Compress in batches of numThreads blocks, to bound the amount of compressed data held in memory
+    for(size_t batchStart = 0; batchStart < numBlocks; batchStart += numThreads) {
+        const size_t batchEnd = std::min<size_t>(numBlocks, batchStart + numThreads);
+        std::vector<std::future<DeflatedBlock>> futures;
+        for(size_t i = batchStart; i < batchEnd; i++) {
+            const size_t offset = i * blockSize;
+            const size_t length = std::min(blockSize, size - std::min(size, offset));
+            const size_t dictionarySize = std::min(offset, DEFLATE_WINDOW_SIZE);
+            const bool last = i == numBlocks - 1;
+            futures.emplace_back(
+                std::async(std::launch::async, deflateBlock, data + offset - dictionarySize, dictionarySize, data + offset, length, compressionLevel, last));
+        }
+        for(size_t i = batchStart; i < batchEnd; i++) {
+            auto block = futures[i - batchStart].get();
+            const size_t length = std::min(blockSize, size - std::min(size, i * blockSize));
+            adler = adler32_combine(adler, block.adler, static_cast<z_off_t>(length));
+            callback(block.data.data(), block.data.size());
+        }
+    }
+
+    const auto trailer = zlibTrailer(adler);
+    callback(trailer.data(), trailer.size());
+}
+
+namespace {
+
+// Largest chunk passed to zlib at once, its sizes are 32 bit
+constexpr size_t MAX_ZLIB_CHUNK = 1U << 30;
+constexpr size_t OUTPUT_CHUNK = 64 * 1024;
+
+// Runs a zlib or zstd step writing into OUTPUT_CHUNK bytes appended to output, and returns the number of bytes it wrote
+template <typename Step>
+size_t appendOutput(std::vector<uint8_t>& output, Step step) {
+    const size_t offset = output.size();
+    output.resize(offset + OUTPUT_CHUNK);
+    size_t written = 0;
+    try {
+        written = step(output.data() + offset, OUTPUT_CHUNK);
+    } catch(...) {
+        output.resize(offset);
+        throw;
+    }
+    output.resize(offset + written);
+    return written;
+}
+
+}  // namespace
+
+class StreamCompressor::Impl {
+   public:
+    Impl(CompressionFormat format, int compressionLevel, unsigned numThreads, size_t blockSize)
+        : compressionLevel(compressionLevel), numThreads(numThreads == 0 ? std::max(1U, std::thread::hardware_concurrency()) : numThreads), blockSize(blockSize) {
+        if(format == CompressionFormat::ZSTD) {
+            if(compressionLevel < ZSTD_minCLevel() || compressionLevel > ZSTD_maxCLevel()) {
+                throw std::invalid_argument(fmt::format("Compression level must be between {} and {}.", ZSTD_minCLevel(), ZSTD_maxCLevel()));
+            }
+            zstd = ZSTD_createCCtx();
+            if(zstd == nullptr) throw std::runtime_error("Could not create zstd compression context.");
+            ZSTD_CCtx_setParameter(zstd, ZSTD_c_compressionLevel, compressionLevel);
+            ZSTD_CCtx_setParameter(zstd, ZSTD_c_checksumFlag, 1);
+            // Fails without multithreading support in the library, which then compresses on the calling thread
+            if(numThreads != 1) ZSTD_CCtx_setParameter(zstd, ZSTD_c_nbWorkers, static_cast<int>(this->numThreads));
+            return;
+        }
+        if(numThreads != 1) {
+            checkDeflateParameters(compressionLevel, blockSize);
+            const auto header = zlibHeader(compressionLevel);
+            output.insert(output.end(), header.begin(), header.end());
+            adler = adler32(0L, Z_NULL, 0);
+            return;
+        }
+        if(compressionLevel < 0 || compressionLevel > 9) {
+            throw std::invalid_argument("Compression level must be between 0 and 9.");
+        }
+        stream.zalloc = Z_NULL;
+        stream.zfree = Z_NULL;
+        stream.opaque = Z_NULL;
+        const int ret = deflateInit(&stream, compressionLevel);
+        if(ret != Z_OK) {
+            throw std::runtime_error("deflateInit failed with error code " + std::to_string(ret) + ".");
+        }
+        streamInitialized = true;
+    }
+
+    ~Impl() {
+        if(streamInitialized) deflateEnd(&stream);
+        if(zstd != nullptr) ZSTD_freeCCtx(zstd);
+    }
+
+    void push(const uint8_t* data, size_t size) {
+        if(finished) throw std::logic_error("Data pushed after the compressed stream was finished.");
+        if(zstd != nullptr) {
+            compressZstd(data, size, ZSTD_e_continue);
+        } else if(streamInitialized) {
+            deflateStream(data, size, Z_NO_FLUSH);
+        } else {
+            while(size > 0) {
+                // A full block is deflated once more input follows it, as only the final block ends the stream
+                if(pending.size() - dictionarySize == blockSize) launchBlock(false);
+                const size_t length = std::min(size, blockSize - (pending.size() - dictionarySize));
+                pending.insert(pending.end(), data, data + length);
+                data += length;
+                size -= length;
+            }
+        }
+    }
+
+    void finish() {
+        if(finished) return;
+        if(zstd != nullptr) {
+            compressZstd(nullptr, 0, ZSTD_e_end);
+        } else if(streamInitialized) {
+            deflateStream(nullptr, 0, Z_FINISH);
+        } else {
+            launchBlock(true);
+            while(!blocks.empty()) collectBlock();
+            const auto trailer = zlibTrailer(adler);
+            output.insert(output.end(), trailer.begin(), trailer.end());
+        }
+        finished = true;
+    }
+
+    std::vector<uint8_t> pull() {
+        while(!blocks.empty() && blocks.front().first.wait_for(std::chrono::seconds(0)) == std::future_status::ready) collectBlock();
+        std::vector<uint8_t> result;
+        result.swap(output);
+        return result;
+    }
+
+    bool isFinished() const {
+        return finished;
+    }
+
+   private:
+    void deflateStream(const uint8_t* data, size_t size, int flush) {
+        do {
+            const size_t chunk = std::min(size, MAX_ZLIB_CHUNK);
+            stream.next_in = const_cast<Bytef*>(data);
+            stream.avail_in = static_cast<uInt>(chunk);
+            int ret = Z_OK;
+            const bool lastChunk = chunk == size;
+            bool full = true;
+            while(full || stream.avail_in > 0) {
+                full = appendOutput(output, [&](uint8_t* out, size_t space) {
+                           stream.next_out = out;
+                           stream.avail_out = static_cast<uInt>(space);
+                           ret = ::deflate(&stream, lastChunk ? flush : Z_NO_FLUSH);
+                           return space - stream.avail_out;
+                       })
+                       == OUTPUT_CHUNK;
+                if(ret == Z_STREAM_END) break;
+                if(ret != Z_OK && ret != Z_BUF_ERROR) {
+                    throw std::runtime_error("deflate failed with error code " + std::to_string(ret) + ".");
+                }
+                // Finishing continues until the end of the stream is written
+                if(lastChunk && flush == Z_FINISH) full = true;
+            }
+            data += chunk;
+            size -= chunk;
+        } while(size > 0);
+    }
+
+    void compressZstd(const uint8_t* data, size_t size, ZSTD_EndDirective directive) {
+        ZSTD_inBuffer input{data, size, 0};
+        bool done = false;
+        while(!done) {
+            size_t remaining = 0;
+            const bool full = appendOutput(output,
+                                           [&](uint8_t* out, size_t space) {
+                                               ZSTD_outBuffer buffer{out, space, 0};
+                                               remaining = ZSTD_compressStream2(zstd, &buffer, &input, directive);
+                                               if(ZSTD_isError(remaining)) {
+                                                   throw std::runtime_error(std::string("zstd compression failed: ") + ZSTD_getErrorName(remaining));
+                                               }
+                                               return buffer.pos;
+                                           })
+                              == OUTPUT_CHUNK;
+            // Continuing is done once the input is consumed, ending once the frame is flushed completely
+            done = directive == ZSTD_e_end ? remaining == 0 : input.pos == input.size && !full;
+        }
+    }
+
+    void launchBlock(bool last) {
+        // Bound the memory held by blocks being compressed
+        while(blocks.size() >= numThreads) collectBlock();
+        // The block is handed over with the window preceding it, which starts the next block
+        auto input = std::make_shared<std::vector<uint8_t>>(std::move(pending));
+        const size_t dictionarySize = this->dictionarySize;
+        const size_t length = input->size() - dictionarySize;
+        this->dictionarySize = std::min(input->size(), DEFLATE_WINDOW_SIZE);
+        pending.reserve(this->dictionarySize + blockSize);
+        pending.assign(input->end() - static_cast<std::ptrdiff_t>(this->dictionarySize), input->end());
+        const int level = compressionLevel;
+        blocks.emplace_back(std::async(std::launch::async,
+                                       [input, dictionarySize, length, level, last]() {
+                                           return deflateBlock(input->data(), dictionarySize, input->data() + dictionarySize, length, level, last);
+                                       }),
+                            length);
+    }
+
+    void collectBlock() {
+        auto block = blocks.front().first.get();
+        adler = adler32_combine(adler, block.adler, static_cast<z_off_t>(blocks.front().second));
+        blocks.pop_front();
+        output.insert(output.end(), block.data.begin(), block.data.end());
+    }
+
+    int compressionLevel;
+    unsigned numThreads;
+    size_t blockSize;
+    bool finished = false;
+    std::vector<uint8_t> output;
+
+    // Single zlib stream
+    z_stream stream{};
+    bool streamInitialized = false;
+
+    // Parallel deflate, the window preceding the input not yet handed to a worker followed by that input, at most one block
+    std::vector<uint8_t> pending;
+    size_t dictionarySize = 0;
+    std::deque<std::pair<std::future<DeflatedBlock>, size_t>> blocks;
+    uLong adler = 0;
+
+    ZSTD_CCtx* zstd = nullptr;
+};
+
+StreamCompressor::StreamCompressor(CompressionFormat format, int compressionLevel, unsigned numThreads, size_t blockSize)
+    : pimpl(std::make_unique<Impl>(format, compressionLevel, numThreads, blockSize)) {}
+StreamCompressor::~StreamCompressor() = default;
+StreamCompressor::StreamCompressor(StreamCompressor&&) noexcept = default;
+StreamCompressor& StreamCompressor::operator=(StreamCompressor&&) noexcept = default;
+
+void StreamCompressor::push(const uint8_t* data, size_t size) {
+    pimpl->push(data, size);
+}
+
+void StreamCompressor::finish() {
+    pimpl->finish();
+}
+
+std::vector<uint8_t> StreamCompressor::pull() {
+    return pimpl->pull();
+}
+
+bool StreamCompressor::isFinished() const {
+    return pimpl->isFinished();
+}
+
+class StreamDecompressor::Impl {
+   public:
+    explicit Impl(CompressionFormat format) {
+        if(format == CompressionFormat::ZSTD) {
+            zstd = ZSTD_createDCtx();
+            if(zstd == nullptr) throw std::runtime_error("Could not create zstd decompression context.");
+            return;
+        }
+        stream.zalloc = Z_NULL;
+        stream.zfree = Z_NULL;
+        stream.opaque = Z_NULL;
+        stream.next_in = Z_NULL;
+        stream.avail_in = 0;
+        const int ret = inflateInit(&stream);
+        if(ret != Z_OK) {
+            throw std::runtime_error("inflateInit failed with error code " + std::to_string(ret) + ".");
+        }
+    }
+
+    ~Impl() {
+        if(zstd != nullptr) {
+            ZSTD_freeDCtx(zstd);
+        } else {
+            inflateEnd(&stream);
+        }
+    }
+
+    void push(const uint8_t* data, size_t size) {
+        if(zstd != nullptr) {
+            decompressZstd(data, size);
+            return;
+        }
+        do {
+            const size_t chunk = std::min(size, MAX_ZLIB_CHUNK);
+            if(finished && chunk > 0) throw std::runtime_error("Data follows the end of the compressed stream.");
+            stream.next_in = const_cast<Bytef*>(data);
+            stream.avail_in = static_cast<uInt>(chunk);
+            bool full = true;
+            while(!finished && (full || stream.avail_in > 0)) {
+                int ret = Z_OK;
+                full = appendOutput(output, [&](uint8_t* out, size_t space) {
+                           stream.next_out = out;
+                           stream.avail_out = static_cast<uInt>(space);
+                           ret = ::inflate(&stream, Z_NO_FLUSH);
+                           return space - stream.avail_out;
+                       })
+                       == OUTPUT_CHUNK;
+                if(ret == Z_STREAM_END) {
+                    finished = true;
+                } else if(ret == Z_BUF_ERROR && !full) {
+                    // No progress is possible until more input is pushed
+                    break;
+                } else if(ret != Z_OK && ret != Z_BUF_ERROR) {
+                    throw std::runtime_error(fmt::format("inflate failed with error code {}: {}.", ret, stream.msg != nullptr ? stream.msg : "unknown error"));
+                }
+            }
+            if(finished && stream.avail_in > 0) throw std::runtime_error("Data follows the end of the compressed stream.");
+            data += chunk;
+            size -= chunk;
+        } while(size > 0);
+    }
+
+    void finish() {
+        if(!finished) throw std::runtime_error("Compressed stream is truncated.");
+    }
+
+    std::vector<uint8_t> pull() {
+        std::vector<uint8_t> result;
+        result.swap(output);
+        return result;
+    }
+
+    bool isFinished() const {
+        return finished;
+    }
+
+   private:
+    void decompressZstd(const uint8_t* data, size_t size) {
+        ZSTD_inBuffer input{data, size, 0};
+        while(true) {
+            const size_t consumed = input.pos;
+            size_t ret = 0;
+            const size_t written = appendOutput(output, [&](uint8_t* out, size_t space) {
+                ZSTD_outBuffer buffer{out, space, 0};
+                ret = ZSTD_decompressStream(zstd, &buffer, &input);
+                if(ZSTD_isError(ret)) throw std::runtime_error(std::string("zstd decompression failed: ") + ZSTD_getErrorName(ret));
+                return buffer.pos;
+            });
+            if(input.pos == consumed && written == 0) break;
+            // A return of 0 marks the end of a frame, another one may follow
+            finished = ret == 0;
+            if(input.pos == input.size && written < OUTPUT_CHUNK) break;
+        }
+    }
+
+    bool finished = false;
+    std::vector<uint8_t> output;
+    z_stream stream{};
+    ZSTD_DCtx* zstd = nullptr;
+};
+
+StreamDecompressor::StreamDecompressor(CompressionFormat format) : pimpl(std::make_unique<Impl>(format)) {}
+StreamDecompressor::~StreamDecompressor() = default;
+StreamDecompressor::StreamDecompressor(StreamDecompressor&&) noexcept = default;
+StreamDecompressor& StreamDecompressor::operator=(StreamDecompressor&&) noexcept = default;
+
+void StreamDecompressor::push(const uint8_t* data, size_t size) {
+    pimpl->push(data, size);
+}
+
+void StreamDecompressor::finish() {
+    pimpl->finish();
+}
+
+std::vector<uint8_t> StreamDecompressor::pull() {
+    return pimpl->pull();
+}
+
+bool StreamDecompressor::isFinished() const {
+    return pimpl->isFinished();
+}
+
+std::vector<uint8_t> compress(const uint8_t* data, size_t size, CompressionFormat format, int compressionLevel, unsigned numThreads) {
+    if(format == CompressionFormat::ZLIB && numThreads != 1) {
+        // The whole input is available, so blocks are deflated straight from it
+        std::vector<uint8_t> output;
+        deflateParallel(
+            data, size, [&output](const uint8_t* chunk, size_t length) { output.insert(output.end(), chunk, chunk + length); }, compressionLevel, 1024 * 1024, numThreads);
+        return output;
+    }
+    StreamCompressor compressor(format, compressionLevel, numThreads);
+    compressor.push(data, size);
+    compressor.finish();
+    return compressor.pull();
+}
+
+std::vector<uint8_t> decompress(const uint8_t* data, size_t size, CompressionFormat format) {
+    StreamDecompressor decompressor(format);
+    decompressor.push(data, size);
+    decompressor.finish();
+    return decompressor.pull();
+}
+
+std::vector<uint8_t> deflate(uint8_t* data, size_t size, int compressionLevel) {
+    return compress(data, size, CompressionFormat::ZLIB, compressionLevel);
+}
+
+std::vector<uint8_t> inflate(uint8_t* data, size_t size) {
+    return decompress(data, size, CompressionFormat::ZLIB);
 }
 
 void tarFiles(const std::filesystem::path& tarPath, const std::vector<std::filesystem::path>& filesOnDisk, const std::vector<std::string>& filesInTar) {
@@ -0,0 +1,270 @@
+#include "EdgeDetectorImpl.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "utility/ParallelFor.hpp"
+#include "utility/Simd.hpp"
+
+namespace dai {
+namespace impl {
+
+namespace {
+
+constexpr SobelEdgeDetector::Kernel DEFAULT_HORIZONTAL_KERNEL = {1, 0, -1, 2, 0, -2, 1, 0, -1};
+constexpr SobelEdgeDetector::Kernel DEFAULT_VERTICAL_KERNEL = {1, 2, 1, 0, 0, 0, -1, -2, -1};
+
+// Gradients are clamped to this, larger ones saturate the output anyway
+constexpr std::int32_t MAX_GRADIENT = 256;
+
+SobelEdgeDetector::Kernel toKernel(const std::vector<std::vector<int>>& kernel, const SobelEdgeDetector::Kernel& defaultKernel, const char* name) {
+    if(kernel.empty()) return defaultKernel;
+    if(kernel.size() != 3 || std::any_of(kernel.begin(), kernel.end(), [](const std::vector<int>& row) { return row.size() != 3; })) {
+        throw std::invalid_argument(std::string("EdgeDetector ") + name + " kernel must be a 3x3 matrix");
+    }
+    SobelEdgeDetector::Kernel result{};
+    for(size_t i = 0; i < 9; i++) {
+        const int coefficient = kernel[i / 3][i % 3];
+        if(std::abs(coefficient) > SobelEdgeDetector::MAX_KERNEL_COEFFICIENT) {
+            throw std::invalid_argument(std::string("EdgeDetector ") + name + " kernel coefficients must be within +-"
+                                        + std::to_string(SobelEdgeDetector::MAX_KERNEL_COEFFICIENT));
+        }
+        result[i] = coefficient;
+    }
+    return result;
+}
+
+// Magnitude rounded to nearest and saturated to 255, the largest k with (k - 0.5)^2 <= gx^2 + gy^2, that is k^2 - k < gx^2 + gy^2.
+// Found by a branch-free binary search in integers, so it is exact and can be vectorized
+inline std::uint8_t magnitude(std::int32_t gx, std::int32_t gy) {
+    gx = gx < -MAX_GRADIENT ? -MAX_GRADIENT : (gx > MAX_GRADIENT ? MAX_GRADIENT : gx);
+    gy = gy < -MAX_GRADIENT ? -MAX_GRADIENT : (gy > MAX_GRADIENT ? MAX_GRADIENT : gy);
+    const std::int32_t squared = gx * gx + gy * gy;
+    // Written out rather than looped, so the pixel loop stays innermost
+    auto step = [squared](std::int32_t k, std::int32_t bit) {
+        const std::int32_t candidate = k | bit;
+        return candidate * candidate - candidate < squared ? candidate : k;
+    };
+    std::int32_t k = step(0, 128);
+    k = step(k, 64);
+    k = step(k, 32);
+    k = step(k, 16);
+    k = step(k, 8);
+    k = step(k, 4);
+    k = step(k, 2);
+    k = step(k, 1);
+    return static_cast<std::uint8_t>(k);
+}
+
+#if defined(DEPTHAI_SIMD_SSE2)
+
+// Sums of coefficient pairs times 16 bit pixels of 4 pixels, in 32 bits. Pixels of taps a and b are interleaved by the caller
+inline __m128i coefficientPair(std::int32_t a, std::int32_t b) {
+    return _mm_set_epi16(static_cast<short>(b), static_cast<short>(a), static_cast<short>(b), static_cast<short>(a),
+                         static_cast<short>(b), static_cast<short>(a), static_cast<short>(b), static_cast<short>(a));
+}
+
+// Gradient of 8 pixels, clamped to MAX_GRADIENT. Taps are 16 bit, coefficients are 5 pairs with the last one padded by zero.
+inline __m128i gradient8(const __m128i taps[10], const __m128i coefficients[5]) {
+    __m128i low = _mm_setzero_si128();
+    __m128i high = _mm_setzero_si128();
+    for(int i = 0; i < 5; i++) {
+        low = _mm_add_epi32(low, _mm_madd_epi16(_mm_unpacklo_epi16(taps[2 * i], taps[2 * i + 1]), coefficients[i]));
+        high = _mm_add_epi32(high, _mm_madd_epi16(_mm_unpackhi_epi16(taps[2 * i], taps[2 * i + 1]), coefficients[i]));
+    }
+    // Saturating to 16 bits before clamping gives the same result as clamping 32 bit values
+    const __m128i gradient = _mm_packs_epi32(low, high);
+    return _mm_min_epi16(_mm_max_epi16(gradient, _mm_set1_epi16(-MAX_GRADIENT)), _mm_set1_epi16(MAX_GRADIENT));
+}
+
+// Rounded magnitude of 4 pixels. Half way values can't occur for integer squares, so sqrt in single precision
+// (exact to about 1e-5 here, while the distance to a rounding boundary is at least 3e-4) matches the integer search
+inline __m128i magnitude4(__m128i gxgy) {
+    const __m128 squared = _mm_cvtepi32_ps(_mm_madd_epi16(gxgy, gxgy));
+    return _mm_cvttps_epi32(_mm_add_ps(_mm_sqrt_ps(squared), _mm_set1_ps(0.5f)));
+}
+
+#elif defined(DEPTHAI_SIMD_NEON)
+
+// Gradient of 4 pixels from 16 bit taps, clamped to MAX_GRADIENT
+inline int16x4_t gradient4(const int16x4_t taps[9], const std::int16_t coefficients[9]) {
+    int32x4_t sum = vmull_n_s16(taps[0], coefficients[0]);
+    for(int i = 1; i < 9; i++) sum = vmlal_n_s16(sum, taps[i], coefficients[i]);
+    const int16x4_t gradient = vqmovn_s32(sum);
+    return vmin_s16(vmax_s16(gradient, vdup_n_s16(-MAX_GRADIENT)), vdup_n_s16(MAX_GRADIENT));
+}
+
+// Rounded magnitude of 4 pixels, the same binary search as the scalar magnitude()
+inline int32x4_t magnitude4(int16x4_t gx, int16x4_t gy) {
+    const int32x4_t squared = vmlal_s16(vmull_s16(gx, gx), gy, gy);
+    int32x4_t k = vdupq_n_s32(0);
+    for(std::int32_t bit = 128; bit > 0; bit >>= 1) {
+        const int32x4_t candidate = vorrq_s32(k, vdupq_n_s32(bit));
+        const uint32x4_t below = vcltq_s32(vsubq_s32(vmulq_s32(candidate, candidate), candidate), squared);
+        k = vbslq_s32(below, candidate, k);
+    }
+    return k;
+}
+
+#endif
+
+}  // namespace
+
+SobelEdgeDetector::SobelEdgeDetector(const EdgeDetectorConfig& config, unsigned numThreads)
+    : numThreads(numThreads == 0 ? std::max(1U, std::thread::hardware_concurrency()) : numThreads) {
+    configure(config);
+}
+
+void SobelEdgeDetector::configure(const EdgeDetectorConfig& config) {
+    const auto& data = config.config;
+    // Validate both before applying, so an invalid config leaves the current one intact
+    const auto newHorizontal = toKernel(data.sobelFilterHorizontalKernel, DEFAULT_HORIZONTAL_KERNEL, "horizontal");
+    const auto newVertical = toKernel(data.sobelFilterVerticalKernel, DEFAULT_VERTICAL_KERNEL, "vertical");
+    horizontal = newHorizontal;
+    vertical = newVertical;
+}
+
+std::shared_ptr<ImgFrame> SobelEdgeDetector::process(const ImgFrame& frame) const {
+    switch(frame.getType()) {
+        case ImgFrame::Type::GRAY8:
+        case ImgFrame::Type::RAW8:
+        case ImgFrame::Type::YUV400p:
+        case ImgFrame::Type::NV12:
+        case ImgFrame::Type::YUV420p:
+            break;
+        default:
+            throw std::invalid_argument("EdgeDetector on host supports only frames with an 8 bit luma plane (GRAY8, RAW8, YUV400p, NV12, YUV420p)");
+    }
+    const int width = static_cast<int>(frame.getWidth());
+    const int height = static_cast<int>(frame.getHeight());
+    const int stride = frame.fb.stride != 0 ? static_cast<int>(frame.fb.stride) : width;
+    const auto data = frame.getData();
+    if(width <= 0 || height <= 0 || stride < width || data.size() < frame.fb.p1Offset + static_cast<size_t>(stride) * (height - 1) + width) {
+        throw std::invalid_argument("EdgeDetector input frame size doesn't match its data");
+    }
+
+    auto edges = std::make_shared<ImgFrame>();
+    edges->setMetadata(frame);
+    std::vector<std::uint8_t> output(static_cast<size_t>(width) * height);
+    process(data.data() + frame.fb.p1Offset, width, height, stride, output.data(), width);
+    edges->setData(std::move(output));
+    edges->setType(ImgFrame::Type::GRAY8);
+    edges->setStride(width);
+    edges->fb.p1Offset = 0;
+    edges->fb.p2Offset = width * height;
+    edges->fb.p3Offset = width * height;
+    return edges;
+}
+
+void SobelEdgeDetector::process(const std::uint8_t* src, int width, int height, int srcStride, std::uint8_t* dst, int dstStride) const {
+    if(width <= 0 || height <= 0) return;
+    const auto hk = horizontal;
+    const auto vk = vertical;
+
+    // Convolution at a single pixel, replicating borders
+    auto pixel = [&](const std::uint8_t* r0, const std::uint8_t* r1, const std::uint8_t* r2, int x) {
+        const int xl = std::max(0, x - 1), xr = std::min(width - 1, x + 1);
+        const std::int32_t p[9] = {r0[xl], r0[x], r0[xr], r1[xl], r1[x], r1[xr], r2[xl], r2[x], r2[xr]};
+        std::int32_t gx = 0, gy = 0;
+        for(int i = 0; i < 9; i++) {
+            gx += hk[i] * p[i];
+            gy += vk[i] * p[i];
+        }
+        return magnitude(gx, gy);
+    };
+
+    utility::parallelFor(0, height, numThreads, 32, [&](int begin, int end) {
+        // Local copies, as stores through the output pointer could otherwise alias them
+        const int last = width - 1;
+        const std::int32_t h0 = hk[0], h1 = hk[1], h2 = hk[2], h3 = hk[3], h4 = hk[4], h5 = hk[5], h6 = hk[6], h7 = hk[7], h8 = hk[8];
+        const std::int32_t v0 = vk[0], v1 = vk[1], v2 = vk[2], v3 = vk[3], v4 = vk[4], v5 = vk[5], v6 = vk[6], v7 = vk[7], v8 = vk[8];
+        for(int y = begin; y < end; y++) {
+            const std::uint8_t* r0 = src + static_cast<size_t>(std::max(0, y - 1)) * srcStride;
+            const std::uint8_t* r1 = src + static_cast<size_t>(y) * srcStride;
+            const std::uint8_t* r2 = src + static_cast<size_t>(std::min(height - 1, y + 1)) * srcStride;
+            std::uint8_t* out = dst + static_cast<size_t>(y) * dstStride;
+
+            out[0] = pixel(r0, r1, r2, 0);
+            if(last == 0) continue;
+            int x = 1;
+#if defined(DEPTHAI_SIMD_SSE2)
+            // 8 pixels at a time, with 16 bit pixels and coefficients multiplied and summed pairwise in 32 bits
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i hc[5] = {coefficientPair(h0, h1), coefficientPair(h2, h3), coefficientPair(h4, h5), coefficientPair(h6, h7), coefficientPair(h8, 0)};
+            const __m128i vc[5] = {coefficientPair(v0, v1), coefficientPair(v2, v3), coefficientPair(v4, v5), coefficientPair(v6, v7), coefficientPair(v8, 0)};
+            auto load = [zero](const std::uint8_t* p) { return _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p)), zero); };
+            for(; x + 8 <= last; x += 8) {
+                const __m128i taps[10] = {load(r0 + x - 1),
+                                          load(r0 + x),
+                                          load(r0 + x + 1),
+                                          load(r1 + x - 1),
+                                          load(r1 + x),
+                                          load(r1 + x + 1),
+                                          load(r2 + x - 1),
+                                          load(r2 + x),
+                                          load(r2 + x + 1),
+                                          zero};
+                const __m128i gx = gradient8(taps, hc);
+                const __m128i gy = gradient8(taps, vc);
+                const __m128i magnitudes = _mm_packs_epi32(magnitude4(_mm_unpacklo_epi16(gx, gy)), magnitude4(_mm_unpackhi_epi16(gx, gy)));
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(out + x), _mm_packus_epi16(magnitudes, magnitudes));
+            }
+#elif defined(DEPTHAI_SIMD_NEON)
+            // 8 pixels at a time, as two halves of 4 with 32 bit sums
+            const std::int16_t hc[9] = {static_cast<std::int16_t>(h0),
+                                        static_cast<std::int16_t>(h1),
+                                        static_cast<std::int16_t>(h2),
+                                        static_cast<std::int16_t>(h3),
+                                        static_cast<std::int16_t>(h4),
+                                        static_cast<std::int16_t>(h5),
+                                        static_cast<std::int16_t>(h6),
+                                        static_cast<std::int16_t>(h7),
+                                        static_cast<std::int16_t>(h8)};
+            const std::int16_t vc[9] = {static_cast<std::int16_t>(v0),
+                                        static_cast<std::int16_t>(v1),
+                                        static_cast<std::int16_t>(v2),
+                                        static_cast<std::int16_t>(v3),
+                                        static_cast<std::int16_t>(v4),
+                                        static_cast<std::int16_t>(v5),
+                                        static_cast<std::int16_t>(v6),
+                                        static_cast<std::int16_t>(v7),
+                                        static_cast<std::int16_t>(v8)};
+            auto load = [](const std::uint8_t* p) { return vreinterpretq_s16_u16(vmovl_u8(vld1_u8(p))); };
+            for(; x + 8 <= last; x += 8) {
+                const int16x8_t taps[9] = {load(r0 + x - 1),
+                                           load(r0 + x),
+                                           load(r0 + x + 1),
+                                           load(r1 + x - 1),
+                                           load(r1 + x),
+                                           load(r1 + x + 1),
+                                           load(r2 + x - 1),
+                                           load(r2 + x),
+                                           load(r2 + x + 1)};
+                int16x4_t low[9], high[9];
+                for(int i = 0; i < 9; i++) {
+                    low[i] = vget_low_s16(taps[i]);
+                    high[i] = vget_high_s16(taps[i]);
+                }
+                const int32x4_t magnitudesLow = magnitude4(gradient4(low, hc), gradient4(low, vc));
+                const int32x4_t magnitudesHigh = magnitude4(gradient4(high, hc), gradient4(high, vc));
+                vst1_u8(out + x, vqmovun_s16(vcombine_s16(vqmovn_s32(magnitudesLow), vqmovn_s32(magnitudesHigh))));
+            }
+#endif
+            // Interior, kept free of branches so the compiler can vectorize the rest where there are no intrinsics
+            for(; x < last; x++) {
+                const std::int32_t p0 = r0[x - 1], p1 = r0[x], p2 = r0[x + 1];
+                const std::int32_t p3 = r1[x - 1], p4 = r1[x], p5 = r1[x + 1];
+                const std::int32_t p6 = r2[x - 1], p7 = r2[x], p8 = r2[x + 1];
+                const std::int32_t gx = h0 * p0 + h1 * p1 + h2 * p2 + h3 * p3 + h4 * p4 + h5 * p5 + h6 * p6 + h7 * p7 + h8 * p8;
+                const std::int32_t gy = v0 * p0 + v1 * p1 + v2 * p2 + v3 * p3 + v4 * p4 + v5 * p5 + v6 * p6 + v7 * p7 + v8 * p8;
+                out[x] = magnitude(gx, gy);
+            }
+            out[last] = pixel(r0, r1, r2, last);
+        }
+    });
+}
+
+}  // namespace impl
+}  // namespace dai
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+
+#include "depthai/pipeline/datatype/EdgeDetectorConfig.hpp"
+#include "depthai/pipeline/datatype/ImgFrame.hpp"
+
+namespace dai {
+namespace impl {
+
+/**
+ * Host implementation of the EdgeDetector node.
+ * Convolves the luma plane with the horizontal and vertical 3x3 kernels and outputs the gradient magnitude,
+ * sqrt(gx^2 + gy^2) rounded to nearest and saturated to 8 bits. Borders are replicated.
+ */
+class SobelEdgeDetector {
+   public:
+    /// Kernel coefficients in row major order
+    using Kernel = std::array<std::int32_t, 9>;
+
+    /// Largest absolute kernel coefficient, so gradients fit 32 bit integers
+    static constexpr std::int32_t MAX_KERNEL_COEFFICIENT = 1024;
+
+    /**
+     * @param config Initial configuration
+     * @param numThreads Number of worker threads, 0 for the number of hardware threads
+     */
+    explicit SobelEdgeDetector(const EdgeDetectorConfig& config, unsigned numThreads = 0);
+
+    /**
+     * Update configuration. Empty kernels select the default Sobel kernels.
+     * @throws std::invalid_argument if a kernel isn't 3x3 or has too large coefficients
+     */
+    void configure(const EdgeDetectorConfig& config);
+
+    /**
+     * Detect edges on the luma plane of a frame
+     * @returns GRAY8 frame with the gradient magnitude, with metadata of the input frame
+     * @throws std::invalid_argument if the frame type has no 8 bit luma plane
+     */
+    std::shared_ptr<ImgFrame> process(const ImgFrame& frame) const;
+
+    /**
+     * Detect edges on a 8 bit grayscale image
+     */
+    void process(const std::uint8_t* src, int width, int height, int srcStride, std::uint8_t* dst, int dstStride) const;
+
+   private:
+    Kernel horizontal;
+    Kernel vertical;
+    unsigned numThreads;
+};
+
+}  // namespace impl
+}  // namespace dai
@@ -0,0 +1,754 @@
+#include "FeatureTrackerImpl.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+
+#include "utility/ParallelFor.hpp"
+#include "utility/Simd.hpp"
+
+namespace dai {
+namespace impl {
+
+namespace {
+
+constexpr float HARRIS_K = 0.04f;
+// Default minimum thresholds, for gradients in intensity units
+constexpr float HARRIS_MIN_THRESHOLD = 6000000.f;
+constexpr float SHI_TOMASI_MIN_THRESHOLD = 1200.f;
+constexpr int MAX_SEARCH_WINDOW = 9;
+constexpr int MIN_PYRAMID_SIZE = 16;
+
+using Config = FeatureTrackerConfig;
+using utility::parallelFor;
+
+int clampWindow(std::int32_t size) {
+    size = std::clamp<std::int32_t>(size, 3, MAX_SEARCH_WINDOW);
+    return size % 2 == 0 ? size - 1 : size;
+}
+
+float harrisScore(float xx, float yy, float xy) {
+    const float trace = xx + yy;
+    return xx * yy - xy * xy - HARRIS_K * trace * trace;
+}
+
+float shiTomasiScore(float xx, float yy, float xy) {
+    const float halfDiff = (xx - yy) * 0.5f;
+    return (xx + yy) * 0.5f - std::sqrt(halfDiff * halfDiff + xy * xy);
+}
+
+// Four float lanes, so that the vectorized loops are written once for both instruction sets.
+// Lanes use the same operations in the same order as the scalar loops, only sums over windows are reordered.
+#if defined(DEPTHAI_SIMD_SSE2)
+using Float4 = __m128;
+inline Float4 load4(const float* p) {
+    return _mm_loadu_ps(p);
+}
+inline void store4(float* p, Float4 v) {
+    _mm_storeu_ps(p, v);
+}
+inline Float4 set4(float v) {
+    return _mm_set1_ps(v);
+}
+inline Float4 add4(Float4 a, Float4 b) {
+    return _mm_add_ps(a, b);
+}
+inline Float4 sub4(Float4 a, Float4 b) {
+    return _mm_sub_ps(a, b);
+}
+inline Float4 mul4(Float4 a, Float4 b) {
+    return _mm_mul_ps(a, b);
+}
+inline Float4 sqrt4(Float4 v) {
+    return _mm_sqrt_ps(v);
+}
+inline float sum4(Float4 v) {
+    const Float4 pairs = _mm_add_ps(v, _mm_movehl_ps(v, v));
+    return _mm_cvtss_f32(_mm_add_ss(pairs, _mm_shuffle_ps(pairs, pairs, 1)));
+}
+#elif defined(DEPTHAI_SIMD_NEON)
+using Float4 = float32x4_t;
+inline Float4 load4(const float* p) {
+    return vld1q_f32(p);
+}
+inline void store4(float* p, Float4 v) {
+    vst1q_f32(p, v);
+}
+inline Float4 set4(float v) {
+    return vdupq_n_f32(v);
+}
+inline Float4 add4(Float4 a, Float4 b) {
+    return vaddq_f32(a, b);
+}
+inline Float4 sub4(Float4 a, Float4 b) {
+    return vsubq_f32(a, b);
+}
+inline Float4 mul4(Float4 a, Float4 b) {
+    return vmulq_f32(a, b);
+}
+inline Float4 sqrt4(Float4 v) {
+    #if defined(__aarch64__)
+    return vsqrtq_f32(v);
+    #else
+    // 32 bit NEON has no exact square root
+    float lanes[4];
+    vst1q_f32(lanes, v);
+    for(auto& lane : lanes) lane = std::sqrt(lane);
+    return vld1q_f32(lanes);
+    #endif
+}
+inline float sum4(Float4 v) {
+    const float32x2_t pairs = vadd_f32(vget_low_f32(v), vget_high_f32(v));
+    return vget_lane_f32(vpadd_f32(pairs, pairs), 0);
+}
+#endif
+
+#if defined(DEPTHAI_SIMD_SSE2) || defined(DEPTHAI_SIMD_NEON)
+constexpr int LANES = 4;
+
+inline Float4 harrisScore4(Float4 xx, Float4 yy, Float4 xy) {
+    const Float4 trace = add4(xx, yy);
+    return sub4(sub4(mul4(xx, yy), mul4(xy, xy)), mul4(mul4(set4(HARRIS_K), trace), trace));
+}
+
+inline Float4 shiTomasiScore4(Float4 xx, Float4 yy, Float4 xy) {
+    const Float4 half = set4(0.5f);
+    const Float4 halfDiff = mul4(sub4(xx, yy), half);
+    return sub4(mul4(add4(xx, yy), half), sqrt4(add4(mul4(halfDiff, halfDiff), mul4(xy, xy))));
+}
+#endif
+
+// Central differences over the inner winW x winH pixels of a patch with a 1 pixel margin, summed into the structure tensor.
+// The inner pixels are copied to a contiguous window for the sums of the iterations.
+void windowGradients(const float* patch, int winW, int winH, float* window, float* gradX, float* gradY, float& gxx, float& gyy, float& gxy) {
+    const int stride = winW + 2;
+    gxx = 0.f;
+    gyy = 0.f;
+    gxy = 0.f;
+#if defined(DEPTHAI_SIMD_SSE2) || defined(DEPTHAI_SIMD_NEON)
+    const Float4 half = set4(0.5f);
+    Float4 sumXX = set4(0.f), sumYY = set4(0.f), sumXY = set4(0.f);
+#endif
+    for(int y = 0; y < winH; y++) {
+        const float* row = patch + (y + 1) * stride + 1;
+        const int offset = y * winW;
+        int x = 0;
+#if defined(DEPTHAI_SIMD_SSE2) || defined(DEPTHAI_SIMD_NEON)
+        for(; x + LANES <= winW; x += LANES) {
+            const Float4 dx = mul4(half, sub4(load4(row + x + 1), load4(row + x - 1)));
+            const Float4 dy = mul4(half, sub4(load4(row + x + stride), load4(row + x - stride)));
+            store4(window + offset + x, load4(row + x));
+            store4(gradX + offset + x, dx);
+            store4(gradY + offset + x, dy);
+            sumXX = add4(sumXX, mul4(dx, dx));
+            sumYY = add4(sumYY, mul4(dy, dy));
+            sumXY = add4(sumXY, mul4(dx, dy));
+        }
+#endif
+        for(; x < winW; x++) {
+            const float dx = 0.5f * (row[x + 1] - row[x - 1]);
+            const float dy = 0.5f * (row[x + stride] - row[x - stride]);
+            window[offset + x] = row[x];
+            gradX[offset + x] = dx;
+            gradY[offset + x] = dy;
+            gxx += dx * dx;
+            gyy += dy * dy;
+            gxy += dx * dy;
+        }
+    }
+#if defined(DEPTHAI_SIMD_SSE2) || defined(DEPTHAI_SIMD_NEON)
+    gxx += sum4(sumXX);
+    gyy += sum4(sumYY);
+    gxy += sum4(sumXY);
+#endif
+}
+
+// Differences between two windows, weighted by the gradients of the first one
+void mismatchSums(const float* prev, const float* cur, const float* gradX, const float* gradY, int size, float& bx, float& by) {
+    bx = 0.f;
+    by = 0.f;
+    int i = 0;
+#if defined(DEPTHAI_SIMD_SSE2) || defined(DEPTHAI_SIMD_NEON)
+    Float4 sumX = set4(0.f), sumY = set4(0.f);
+    for(; i + LANES <= size; i += LANES) {
+        const Float4 diff = sub4(load4(prev + i), load4(cur + i));
+        sumX = add4(sumX, mul4(diff, load4(gradX + i)));
+        sumY = add4(sumY, mul4(diff, load4(gradY + i)));
+    }
+    bx = sum4(sumX);
+    by = sum4(sumY);
+#endif
+    for(; i < size; i++) {
+        const float diff = prev[i] - cur[i];
+        bx += diff * gradX[i];
+        by += diff * gradY[i];
+    }
+}
+
+float squaredDifference(const float* a, const float* b, int size) {
+    float sum = 0.f;
+    int i = 0;
+#if defined(DEPTHAI_SIMD_SSE2) || defined(DEPTHAI_SIMD_NEON)
+    Float4 sums = set4(0.f);
+    for(; i + LANES <= size; i += LANES) {
+        const Float4 diff = sub4(load4(a + i), load4(b + i));
+        sums = add4(sums, mul4(diff, diff));
+    }
+    sum = sum4(sums);
+#endif
+    for(; i < size; i++) {
+        const float diff = a[i] - b[i];
+        sum += diff * diff;
+    }
+    return sum;
+}
+
+// Samples a (2 * halfW + 1) x (2 * halfH + 1) patch centered at (cx, cy) with bilinear interpolation, clamping at image borders
+void samplePatch(const LKFeatureTracker::Image& img, float cx, float cy, int halfW, int halfH, float* out) {
+    const float x0 = cx - halfW;
+    const float y0 = cy - halfH;
+    const int ix = static_cast<int>(std::floor(x0));
+    const int iy = static_cast<int>(std::floor(y0));
+    const float ax = x0 - ix;
+    const float ay = y0 - iy;
+    const float w00 = (1.f - ax) * (1.f - ay), w01 = ax * (1.f - ay), w10 = (1.f - ax) * ay, w11 = ax * ay;
+    const int patchW = 2 * halfW + 1;
+    const int patchH = 2 * halfH + 1;
+    if(ix >= 0 && iy >= 0 && ix + patchW < img.width && iy + patchH < img.height) {
+        // Fast path, whole patch is inside the image
+        for(int y = 0; y < patchH; y++) {
+            const float* row0 = &img.data[static_cast<size_t>(iy + y) * img.width + ix];
+            const float* row1 = row0 + img.width;
+            float* dst = out + y * patchW;
+            for(int x = 0; x < patchW; x++) {
+                dst[x] = w00 * row0[x] + w01 * row0[x + 1] + w10 * row1[x] + w11 * row1[x + 1];
+            }
+        }
+        return;
+    }
+    auto clampX = [&img](int x) { return std::clamp(x, 0, img.width - 1); };
+    auto clampY = [&img](int y) { return std::clamp(y, 0, img.height - 1); };
+    for(int y = 0; y < patchH; y++) {
+        const int y0c = clampY(iy + y), y1c = clampY(iy + y + 1);
+        for(int x = 0; x < patchW; x++) {
+            const int x0c = clampX(ix + x), x1c = clampX(ix + x + 1);
+            out[y * patchW + x] = w00 * img.at(x0c, y0c) + w01 * img.at(x1c, y0c) + w10 * img.at(x0c, y1c) + w11 * img.at(x1c, y1c);
+        }
+    }
+}
+
+// Buckets points, to find ones closer than a given distance
+class PointGrid {
+   public:
+    PointGrid(int width, int height, float minDistanceSquared)
+        : minDistanceSquared(minDistanceSquared), cellSize(std::max(1.f, std::sqrt(minDistanceSquared))) {
+        cols = static_cast<int>(width / cellSize) + 1;
+        rows = static_cast<int>(height / cellSize) + 1;
+        cells.resize(static_cast<size_t>(cols) * rows);
+    }
+
+    bool hasNeighbor(const Point2f& p) const {
+        const int cx = cellOf(p.x, cols), cy = cellOf(p.y, rows);
+        for(int y = std::max(0, cy - 1); y <= std::min(rows - 1, cy + 1); y++) {
+            for(int x = std::max(0, cx - 1); x <= std::min(cols - 1, cx + 1); x++) {
+                for(const auto& q : cells[static_cast<size_t>(y) * cols + x]) {
+                    const float dx = p.x - q.x, dy = p.y - q.y;
+                    if(dx * dx + dy * dy < minDistanceSquared) return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    void add(const Point2f& p) {
+        cells[static_cast<size_t>(cellOf(p.y, rows)) * cols + cellOf(p.x, cols)].push_back(p);
+    }
+
+   private:
+    float minDistanceSquared;
+    float cellSize;
+    int cols = 0;
+    int rows = 0;
+    std::vector<std::vector<Point2f>> cells;
+
+    int cellOf(float v, int count) const {
+        return std::clamp(static_cast<int>(v / cellSize), 0, count - 1);
+    }
+};
+
+}  // namespace
+
+LKFeatureTracker::LKFeatureTracker(const FeatureTrackerConfig& config, unsigned numThreads)
+    : numThreads(numThreads == 0 ? std::max(1U, std::thread::hardware_concurrency()) : numThreads) {
+    configure(config);
+}
+
+void LKFeatureTracker::configure(const FeatureTrackerConfig& config) {
+    this->config = config;
+    const auto& opticalFlow = config.motionEstimator.opticalFlow;
+    border = std::max(3, std::max(clampWindow(opticalFlow.searchWindowWidth), clampWindow(opticalFlow.searchWindowHeight)) / 2 + 1);
+    // Thresholds are reinitialized on next detection
+    thresholdsGridDimension = 0;
+}
+
+void LKFeatureTracker::reset() {
+    features.clear();
+    prevPyramid.clear();
+    thresholdsGridDimension = 0;
+}
+
+std::vector<TrackedFeature> LKFeatureTracker::track(const ImgFrame& frame) {
+    switch(frame.getType()) {
+        case ImgFrame::Type::GRAY8:
+        case ImgFrame::Type::RAW8:
+        case ImgFrame::Type::YUV400p:
+        case ImgFrame::Type::NV12:
+        case ImgFrame::Type::YUV420p:
+            break;
+        default:
+            throw std::invalid_argument("FeatureTracker on host supports only frames with an 8 bit luma plane (GRAY8, RAW8, YUV400p, NV12, YUV420p)");
+    }
+    const int width = static_cast<int>(frame.getWidth());
+    const int height = static_cast<int>(frame.getHeight());
+    const int stride = frame.fb.stride != 0 ? static_cast<int>(frame.fb.stride) : width;
+    const auto data = frame.getData();
+    if(width <= 0 || height <= 0 || stride < width || data.size() < frame.fb.p1Offset + static_cast<size_t>(stride) * (height - 1) + width) {
+        throw std::invalid_argument("FeatureTracker input frame size doesn't match its data");
+    }
+    return track(data.data() + frame.fb.p1Offset, width, height, stride);
+}
+
+std::vector<TrackedFeature> LKFeatureTracker::track(const std::uint8_t* data, int width, int height, int stride) {
+    const bool motionEstimation = config.motionEstimator.enable;
+    buildPyramid(data, width, height, stride, motionEstimation ? getPyramidLevels(width, height) : 1);
+    computeCornerScores();
+
+    std::vector<TrackedFeature> tracked;
+    const bool canTrack = prevPyramid.size() == pyramid.size() && prevPyramid[0].width == width && prevPyramid[0].height == height;
+    if(motionEstimation && canTrack && !features.empty()) {
+        // HW_MOTION_ESTIMATION has no host counterpart, both types use optical flow
+        tracked = features;
+        std::vector<bool> status;
+        trackFeatures(tracked, status);
+        maintainFeatures(tracked, status);
+    }
+    detectFeatures(tracked);
+
+    features = std::move(tracked);
+    std::swap(prevPyramid, pyramid);
+    return features;
+}
+
+int LKFeatureTracker::getPyramidLevels(int width, int height) const {
+    const auto requested = config.motionEstimator.opticalFlow.pyramidLevels;
+    int levels = requested == Config::AUTO ? (width <= 640 ? 3 : 4) : std::clamp<std::int32_t>(requested, 1, 8);
+    while(levels > 1 && (std::min(width, height) >> (levels - 1)) < MIN_PYRAMID_SIZE) levels--;
+    return levels;
+}
+
+float LKFeatureTracker::getMinThreshold() const {
+    const auto& thresholds = config.cornerDetector.thresholds;
+    if(thresholds.min > 0) return thresholds.min;
+    return config.cornerDetector.type == Config::CornerDetector::Type::HARRIS ? HARRIS_MIN_THRESHOLD : SHI_TOMASI_MIN_THRESHOLD;
+}
+
+float LKFeatureTracker::getMaxThreshold() const {
+    const auto& thresholds = config.cornerDetector.thresholds;
+    return thresholds.max > 0 ? thresholds.max : std::numeric_limits<float>::max();
+}
+
+void LKFeatureTracker::buildPyramid(const std::uint8_t* data, int width, int height, int stride, int levels) {
+    pyramid.resize(levels);
+    auto& base = pyramid[0];
+    base.width = width;
+    base.height = height;
+    base.data.resize(static_cast<size_t>(width) * height);
+    parallelFor(0, height, numThreads, 64, [&](int begin, int end) {
+        for(int y = begin; y < end; y++) {
+            const std::uint8_t* src = data + static_cast<size_t>(y) * stride;
+            float* dst = &base.data[static_cast<size_t>(y) * width];
+            for(int x = 0; x < width; x++) dst[x] = src[x];
+        }
+    });
+
+    for(int level = 1; level < levels; level++) {
+        const auto& src = pyramid[level - 1];
+        auto& dst = pyramid[level];
+        dst.width = std::max(1, src.width / 2);
+        dst.height = std::max(1, src.height / 2);
+        dst.data.resize(static_cast<size_t>(dst.width) * dst.height);
+        // 5 tap Gaussian filter, then decimate
+        parallelFor(0, dst.height, numThreads, 32, [&](int begin, int end) {
+            std::vector<float> column(src.width + 4);
+            for(int y = begin; y < end; y++) {
+                const float* rows[5];
+                for(int i = 0; i < 5; i++) {
+                    rows[i] = &src.data[static_cast<size_t>(std::clamp(2 * y + i - 2, 0, src.height - 1)) * src.width];
+                }
+                float* filtered = column.data() + 2;
+                for(int x = 0; x < src.width; x++) {
+                    filtered[x] = rows[0][x] + rows[4][x] + 4.f * (rows[1][x] + rows[3][x]) + 6.f * rows[2][x];
+                }
+                filtered[-2] = filtered[0];
+                filtered[-1] = filtered[0];
+                filtered[src.width] = filtered[src.width - 1];
+                filtered[src.width + 1] = filtered[src.width - 1];
+                float* out = &dst.data[static_cast<size_t>(y) * dst.width];
+                for(int x = 0; x < dst.width; x++) {
+                    const float* c = filtered + 2 * x;
+                    out[x] = (1.f / 256.f) * (c[-2] + c[2] + 4.f * (c[-1] + c[1]) + 6.f * c[0]);
+                }
+            }
+        });
+    }
+}
+
+void LKFeatureTracker::computeCornerScores() {
+    const auto& img = pyramid[0];
+    const int width = img.width;
+    const int height = img.height;
+    const size_t size = static_cast<size_t>(width) * height;
+    for(auto* map : {&tensorXX, &tensorYY, &tensorXY, &score, &rowXX, &rowYY, &rowXY}) {
+        if(map->width != width || map->height != height) {
+            map->width = width;
+            map->height = height;
+            map->data.assign(size, 0.f);
+        }
+    }
+    if(width < 5 || height < 5) return;
+
+    const bool sobel = config.cornerDetector.enableSobel;
+    // Gradient products, summed horizontally over 3 pixels
+    parallelFor(1, height - 1, numThreads, 32, [&](int begin, int end) {
+        std::vector<float> products(3 * static_cast<size_t>(width), 0.f);
+        float* pxx = products.data();
+        float* pyy = pxx + width;
+        float* pxy = pyy + width;
+        for(int y = begin; y < end; y++) {
+            const float* r0 = &img.data[static_cast<size_t>(y - 1) * width];
+            const float* r1 = r0 + width;
+            const float* r2 = r1 + width;
+            int x = 1;
+#if defined(DEPTHAI_SIMD_SSE2) || defined(DEPTHAI_SIMD_NEON)
+            if(sobel) {
+                const Float4 eighth = set4(0.125f);
+                const Float4 two = set4(2.f);
+                for(; x + LANES <= width - 1; x += LANES) {
+                    const Float4 gx = mul4(eighth,
+                                           add4(add4(sub4(load4(r0 + x + 1), load4(r0 + x - 1)), mul4(two, sub4(load4(r1 + x + 1), load4(r1 + x - 1)))),
+                                                sub4(load4(r2 + x + 1), load4(r2 + x - 1))));
+                    const Float4 gy = mul4(eighth,
+                                           add4(add4(sub4(load4(r2 + x - 1), load4(r0 + x - 1)), mul4(two, sub4(load4(r2 + x), load4(r0 + x)))),
+                                                sub4(load4(r2 + x + 1), load4(r0 + x + 1))));
+                    store4(pxx + x, mul4(gx, gx));
+                    store4(pyy + x, mul4(gy, gy));
+                    store4(pxy + x, mul4(gx, gy));
+                }
+            } else {
+                const Float4 half = set4(0.5f);
+                for(; x + LANES <= width - 1; x += LANES) {
+                    const Float4 gx = mul4(half, sub4(load4(r1 + x + 1), load4(r1 + x - 1)));
+                    const Float4 gy = mul4(half, sub4(load4(r2 + x), load4(r0 + x)));
+                    store4(pxx + x, mul4(gx, gx));
+                    store4(pyy + x, mul4(gy, gy));
+                    store4(pxy + x, mul4(gx, gy));
+                }
+            }
+#endif
+            if(sobel) {
+                for(; x < width - 1; x++) {
+                    const float gx = 0.125f * ((r0[x + 1] - r0[x - 1]) + 2.f * (r1[x + 1] - r1[x - 1]) + (r2[x + 1] - r2[x - 1]));
+                    const float gy = 0.125f * ((r2[x - 1] - r0[x - 1]) + 2.f * (r2[x] - r0[x]) + (r2[x + 1] - r0[x + 1]));
+                    pxx[x] = gx * gx;
+                    pyy[x] = gy * gy;
+                    pxy[x] = gx * gy;
+                }
+            } else {
+                for(; x < width - 1; x++) {
+                    const float gx = 0.5f * (r1[x + 1] - r1[x - 1]);
+                    const float gy = 0.5f * (r2[x] - r0[x]);
+                    pxx[x] = gx * gx;
+                    pyy[x] = gy * gy;
+                    pxy[x] = gx * gy;
+                }
+            }
+            float* sxx = &rowXX.data[static_cast<size_t>(y) * width];
+            float* syy = &rowYY.data[static_cast<size_t>(y) * width];
+            float* sxy = &rowXY.data[static_cast<size_t>(y) * width];
+            x = 2;
+#if defined(DEPTHAI_SIMD_SSE2) || defined(DEPTHAI_SIMD_NEON)
+            for(; x + LANES <= width - 2; x += LANES) {
+                store4(sxx + x, add4(add4(load4(pxx + x - 1), load4(pxx + x)), load4(pxx + x + 1)));
+                store4(syy + x, add4(add4(load4(pyy + x - 1), load4(pyy + x)), load4(pyy + x + 1)));
+                store4(sxy + x, add4(add4(load4(pxy + x - 1), load4(pxy + x)), load4(pxy + x + 1)));
+            }
+#endif
+            for(; x < width - 2; x++) {
+                sxx[x] = pxx[x - 1] + pxx[x] + pxx[x + 1];
+                syy[x] = pyy[x - 1] + pyy[x] + pyy[x + 1];
+                sxy[x] = pxy[x - 1] + pxy[x] + pxy[x + 1];
+            }
+        }
+    });
+
+    // Vertical sums give the structure tensor over a 3x3 window, from which the corner score is computed
+    const bool harris = config.cornerDetector.type == Config::CornerDetector::Type::HARRIS;
+    parallelFor(2, height - 2, numThreads, 32, [&](int begin, int end) {
+        for(int y = begin; y < end; y++) {
+            const size_t row = static_cast<size_t>(y) * width;
+            const float* a0 = &rowXX.data[row - width];
+            const float* b0 = &rowYY.data[row - width];
+            const float* c0 = &rowXY.data[row - width];
+            float* xx = &tensorXX.data[row];
+            float* yy = &tensorYY.data[row];
+            float* xy = &tensorXY.data[row];
+            float* s = &score.data[row];
+            int x = 0;
+#if defined(DEPTHAI_SIMD_SSE2) || defined(DEPTHAI_SIMD_NEON)
+            for(; x + LANES <= width; x += LANES) {
+                const Float4 sumXX = add4(add4(load4(a0 + x), load4(a0 + x + width)), load4(a0 + x + 2 * width));
+                const Float4 sumYY = add4(add4(load4(b0 + x), load4(b0 + x + width)), load4(b0 + x + 2 * width));
+                const Float4 sumXY = add4(add4(load4(c0 + x), load4(c0 + x + width)), load4(c0 + x + 2 * width));
+                store4(xx + x, sumXX);
+                store4(yy + x, sumYY);
+                store4(xy + x, sumXY);
+                store4(s + x, harris ? harrisScore4(sumXX, sumYY, sumXY) : shiTomasiScore4(sumXX, sumYY, sumXY));
+            }
+#endif
+            for(; x < width; x++) {
+                xx[x] = a0[x] + a0[x + width] + a0[x + 2 * width];
+                yy[x] = b0[x] + b0[x + width] + b0[x + 2 * width];
+                xy[x] = c0[x] + c0[x + width] + c0[x + 2 * width];
+                s[x] = harris ? harrisScore(xx[x], yy[x], xy[x]) : shiTomasiScore(xx[x], yy[x], xy[x]);
+            }
+        }
+    });
+}
+
+float LKFeatureTracker::harrisScoreAt(float x, float y) const {
+    const int ix = std::clamp(static_cast<int>(std::lround(x)), 0, tensorXX.width - 1);
+    const int iy = std::clamp(static_cast<int>(std::lround(y)), 0, tensorXX.height - 1);
+    return harrisScore(tensorXX.at(ix, iy), tensorYY.at(ix, iy), tensorXY.at(ix, iy));
+}
+
+void LKFeatureTracker::trackFeatures(std::vector<TrackedFeature>& tracked, std::vector<bool>& status) const {
+    // std::vector<bool> isn't safe to write from multiple threads
+    std::vector<std::uint8_t> ok(tracked.size(), 0);
+    parallelFor(0, static_cast<int>(tracked.size()), numThreads, 32, [&](int begin, int end) {
+        for(int i = begin; i < end; i++) ok[i] = trackFeature(tracked[i]) ? 1 : 0;
+    });
+    status.assign(ok.begin(), ok.end());
+}
+
+bool LKFeatureTracker::trackFeature(TrackedFeature& feature) const {
+    const auto& opticalFlow = config.motionEstimator.opticalFlow;
+    const int halfW = clampWindow(opticalFlow.searchWindowWidth) / 2;
+    const int halfH = clampWindow(opticalFlow.searchWindowHeight) / 2;
+    const int winW = 2 * halfW + 1;
+    const int winH = 2 * halfH + 1;
+    const int maxIterations = std::max<std::int32_t>(1, opticalFlow.maxIterations);
+    const float epsilonSquared = opticalFlow.epsilon * opticalFlow.epsilon;
+
+    constexpr int MAX_PATCH = (MAX_SEARCH_WINDOW + 2) * (MAX_SEARCH_WINDOW + 2);
+    std::array<float, MAX_PATCH> prevPatch{};
+    std::array<float, MAX_PATCH> prevWindow{};
+    std::array<float, MAX_PATCH> gradX{};
+    std::array<float, MAX_PATCH> gradY{};
+    std::array<float, MAX_PATCH> curPatch{};
+
+    // Displacement guess, propagated from coarse to fine levels
+    float gx = 0.f, gy = 0.f;
+    for(int level = static_cast<int>(pyramid.size()) - 1; level >= 0; level--) {
+        const auto& prev = prevPyramid[level];
+        const auto& cur = pyramid[level];
+        const float scale = 1.f / static_cast<float>(1 << level);
+        const float px = feature.position.x * scale;
+        const float py = feature.position.y * scale;
+
+        // Previous patch with a 1 pixel margin for gradients
+        samplePatch(prev, px, py, halfW + 1, halfH + 1, prevPatch.data());
+        float gxx = 0.f, gyy = 0.f, gxy = 0.f;
+        windowGradients(prevPatch.data(), winW, winH, prevWindow.data(), gradX.data(), gradY.data(), gxx, gyy, gxy);
+        const float det = gxx * gyy - gxy * gxy;
+        const float minEig = shiTomasiScore(gxx, gyy, gxy);
+        if(minEig < 1e-2f * winW * winH || det <= 0.f) return false;
+
+        float vx = 0.f, vy = 0.f;
+        for(int iteration = 0; iteration < maxIterations; iteration++) {
+            samplePatch(cur, px + gx + vx, py + gy + vy, halfW, halfH, curPatch.data());
+            float bx = 0.f, by = 0.f;
+            mismatchSums(prevWindow.data(), curPatch.data(), gradX.data(), gradY.data(), winW * winH, bx, by);
+            const float etaX = (gyy * bx - gxy * by) / det;
+            const float etaY = (gxx * by - gxy * bx) / det;
+            vx += etaX;
+            vy += etaY;
+            if(etaX * etaX + etaY * etaY < epsilonSquared) break;
+        }
+
+        if(level > 0) {
+            gx = 2.f * (gx + vx);
+            gy = 2.f * (gy + vy);
+        } else {
+            gx += vx;
+            gy += vy;
+        }
+    }
+
+    const float x = feature.position.x + gx;
+    const float y = feature.position.y + gy;
+    const auto& cur = pyramid[0];
+    if(!std::isfinite(x) || !std::isfinite(y) || x < 0.f || y < 0.f || x > cur.width - 1 || y > cur.height - 1) return false;
+
+    // Sum of squared differences between the patches at the final position
+    samplePatch(prevPyramid[0], feature.position.x, feature.position.y, halfW, halfH, prevPatch.data());
+    samplePatch(cur, x, y, halfW, halfH, curPatch.data());
+    feature.position = Point2f(x, y);
+    feature.trackingError = squaredDifference(prevPatch.data(), curPatch.data(), winW * winH);
+    return true;
+}
+
+void LKFeatureTracker::maintainFeatures(std::vector<TrackedFeature>& tracked, const std::vector<bool>& status) const {
+    const auto& maintainer = config.featureMaintainer;
+    std::vector<TrackedFeature> kept;
+    kept.reserve(tracked.size());
+    for(size_t i = 0; i < tracked.size(); i++) {
+        if(!status[i]) continue;
+        auto& feature = tracked[i];
+        feature.harrisScore = harrisScoreAt(feature.position.x, feature.position.y);
+        if(maintainer.enable && (feature.trackingError > maintainer.lostFeatureErrorThreshold || feature.harrisScore < maintainer.trackedFeatureThreshold)) {
+            continue;
+        }
+        feature.age++;
+        kept.push_back(feature);
+    }
+
+    // Features which converged onto the same spot are merged, keeping the oldest
+    if(maintainer.enable && config.cornerDetector.enableSorting && maintainer.minimumDistanceBetweenFeatures > 0.f) {
+        std::stable_sort(kept.begin(), kept.end(), [](const TrackedFeature& a, const TrackedFeature& b) { return a.age > b.age; });
+        PointGrid grid(pyramid[0].width, pyramid[0].height, maintainer.minimumDistanceBetweenFeatures);
+        auto last = std::remove_if(kept.begin(), kept.end(), [&grid](const TrackedFeature& feature) {
+            if(grid.hasNeighbor(feature.position)) return true;
+            grid.add(feature.position);
+            return false;
+        });
+        kept.erase(last, kept.end());
+    }
+    tracked = std::move(kept);
+}
+
+void LKFeatureTracker::detectFeatures(std::vector<TrackedFeature>& tracked) {
+    const auto& detector = config.cornerDetector;
+    const auto& maintainer = config.featureMaintainer;
+    const int width = score.width;
+    const int height = score.height;
+    const int grid = std::clamp<std::int32_t>(detector.cellGridDimension, 1, 4);
+    const int numCells = grid * grid;
+    const float minThreshold = getMinThreshold();
+    const float maxThreshold = getMaxThreshold();
+    // Thresholds adapt to the scene only when no initial value is given
+    const bool autoThreshold = detector.thresholds.initialValue <= 0;
+    if(thresholdsGridDimension != grid) {
+        cellThresholds.assign(numCells, autoThreshold ? minThreshold : detector.thresholds.initialValue);
+        thresholdsGridDimension = grid;
+    }
+
+    if(detector.numMaxFeatures > 0 && static_cast<std::int32_t>(tracked.size()) > detector.numMaxFeatures) {
+        tracked.resize(detector.numMaxFeatures);
+    }
+
+    auto cellOf = [&](float x, float y) {
+        const int cx = std::min(grid - 1, static_cast<int>(x * grid / width));
+        const int cy = std::min(grid - 1, static_cast<int>(y * grid / height));
+        return cy * grid + cx;
+    };
+    const int perCell = std::max<std::int32_t>(0, detector.numTargetFeatures) / numCells;
+    std::vector<int> trackedInCell(numCells, 0);
+    for(const auto& feature : tracked) trackedInCell[cellOf(feature.position.x, feature.position.y)]++;
+
+    // Local maxima above the cell threshold
+    std::vector<std::vector<Candidate>> candidates(numCells);
+    parallelFor(0, numCells, numThreads, 1, [&](int begin, int end) {
+        for(int cell = begin; cell < end; cell++) {
+            if(trackedInCell[cell] >= perCell) continue;
+            const int cx = cell % grid, cy = cell / grid;
+            const int x0 = std::max(border, cx * width / grid), x1 = std::min(width - border, (cx + 1) * width / grid);
+            const int y0 = std::max(border, cy * height / grid), y1 = std::min(height - border, (cy + 1) * height / grid);
+            const float threshold = cellThresholds[cell];
+            for(int y = y0; y < y1; y++) {
+                const float* up = &score.data[static_cast<size_t>(y - 1) * width];
+                const float* row = up + width;
+                const float* down = row + width;
+                for(int x = x0; x < x1; x++) {
+                    const float s = row[x];
+                    if(s < threshold) continue;
+                    // Strict on preceding neighbors, so plateaus yield a single maximum
+                    if(s <= up[x - 1] || s <= up[x] || s <= up[x + 1] || s <= row[x - 1]) continue;
+                    if(s < row[x + 1] || s < down[x - 1] || s < down[x] || s < down[x + 1]) continue;
+                    candidates[cell].push_back({s, x, y});
+                }
+            }
+        }
+    });
+
+    const bool filterDistance = maintainer.enable && detector.enableSorting && maintainer.minimumDistanceBetweenFeatures > 0.f;
+    PointGrid occupied(width, height, std::max(1.f, maintainer.minimumDistanceBetweenFeatures));
+    if(filterDistance) {
+        for(const auto& feature : tracked) occupied.add(feature.position);
+    }
+
+    std::vector<Candidate> accepted;
+    for(int cell = 0; cell < numCells; cell++) {
+        auto& cellCandidates = candidates[cell];
+        const int slots = perCell - trackedInCell[cell];
+        if(slots <= 0) continue;
+        if(detector.enableSorting) {
+            std::stable_sort(cellCandidates.begin(), cellCandidates.end(), [](const Candidate& a, const Candidate& b) { return a.score > b.score; });
+        }
+        int added = 0;
+        for(const auto& candidate : cellCandidates) {
+            if(added >= slots) break;
+            const Point2f position(static_cast<float>(candidate.x), static_cast<float>(candidate.y));
+            if(filterDistance) {
+                if(occupied.hasNeighbor(position)) continue;
+                occupied.add(position);
+            }
+            accepted.push_back(candidate);
+            added++;
+        }
+
+        // Aim for somewhat more candidates than needed: raise the threshold when there are plenty, lower it when there are too few
+        if(autoThreshold) {
+            float& threshold = cellThresholds[cell];
+            if(static_cast<int>(cellCandidates.size()) > 2 * slots) {
+                threshold *= detector.thresholds.increaseFactor;
+            } else if(static_cast<int>(cellCandidates.size()) < slots) {
+                threshold *= detector.thresholds.decreaseFactor;
+            }
+            threshold = std::clamp(threshold, minThreshold, maxThreshold);
+        }
+    }
+
+    if(detector.numMaxFeatures > 0) {
+        const size_t room = static_cast<size_t>(detector.numMaxFeatures) - tracked.size();
+        if(accepted.size() > room) {
+            std::stable_sort(accepted.begin(), accepted.end(), [](const Candidate& a, const Candidate& b) { return a.score > b.score; });
+            accepted.resize(room);
+        }
+    }
+
+    for(const auto& candidate : accepted) {
+        TrackedFeature feature;
+        feature.position = Point2f(static_cast<float>(candidate.x), static_cast<float>(candidate.y));
+        feature.id = nextId++;
+        feature.age = 0;
+        feature.harrisScore = harrisScoreAt(feature.position.x, feature.position.y);
+        feature.trackingError = 0.f;
+        tracked.push_back(feature);
+    }
+}
+
+}  // namespace impl
+}  // namespace dai
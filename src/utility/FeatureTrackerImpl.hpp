@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "depthai/pipeline/datatype/FeatureTrackerConfig.hpp"
+#include "depthai/pipeline/datatype/ImgFrame.hpp"
+#include "depthai/pipeline/datatype/TrackedFeatures.hpp"
+
+namespace dai {
+namespace impl {
+
+/**
+ * Host implementation of the FeatureTracker node.
+ * Detects Harris or Shi-Tomasi corners with a per cell feature budget and adaptive thresholds,
+ * and tracks them between consecutive frames with pyramidal Lucas-Kanade optical flow.
+ */
+class LKFeatureTracker {
+   public:
+    /// Single channel float image
+    struct Image {
+        int width = 0;
+        int height = 0;
+        std::vector<float> data;
+
+        float at(int x, int y) const {
+            return data[static_cast<size_t>(y) * width + x];
+        }
+    };
+
+    /**
+     * @param config Initial configuration
+     * @param numThreads Number of worker threads, 0 for the number of hardware threads
+     */
+    explicit LKFeatureTracker(const FeatureTrackerConfig& config, unsigned numThreads = 0);
+
+    /**
+     * Update configuration. Tracked features are kept.
+     */
+    void configure(const FeatureTrackerConfig& config);
+
+    /**
+     * Detect and track features on the luma plane of a frame
+     * @throws std::invalid_argument if the frame type has no 8 bit luma plane
+     */
+    std::vector<TrackedFeature> track(const ImgFrame& frame);
+
+    /**
+     * Detect and track features on a 8 bit grayscale image
+     */
+    std::vector<TrackedFeature> track(const std::uint8_t* data, int width, int height, int stride);
+
+    /**
+     * Forget tracked features, the next frame starts tracking anew
+     */
+    void reset();
+
+   private:
+    struct Candidate {
+        float score;
+        int x;
+        int y;
+    };
+
+    FeatureTrackerConfig config;
+    unsigned numThreads;
+    int border = 0;
+
+    // Pyramids of the previous and the current frame, level 0 is the input image
+    std::vector<Image> prevPyramid;
+    std::vector<Image> pyramid;
+
+    // Structure tensor, summed over a 3x3 window, and corner score of the current frame
+    Image tensorXX, tensorYY, tensorXY, score;
+    // Temporary per row sums of gradient products
+    Image rowXX, rowYY, rowXY;
+
+    // Per cell corner thresholds
+    std::vector<float> cellThresholds;
+    int thresholdsGridDimension = 0;
+
+    std::vector<TrackedFeature> features;
+    std::uint32_t nextId = 0;
+
+    void buildPyramid(const std::uint8_t* data, int width, int height, int stride, int levels);
+    void computeCornerScores();
+    float harrisScoreAt(float x, float y) const;
+    void trackFeatures(std::vector<TrackedFeature>& tracked, std::vector<bool>& status) const;
+    bool trackFeature(TrackedFeature& feature) const;
+    void maintainFeatures(std::vector<TrackedFeature>& tracked, const std::vector<bool>& status) const;
+    void detectFeatures(std::vector<TrackedFeature>& tracked);
+
+    int getPyramidLevels(int width, int height) const;
+    float getMinThreshold() const;
+    float getMaxThreshold() const;
+};
+
+}  // namespace impl
+}  // namespace dai
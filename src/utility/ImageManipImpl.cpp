@@ -465,32 +465,96 @@ std::tuple<float, float, float, float> dai::impl::getOuterRect(const std::vector
     return {minx, maxx, miny, maxy};
 }
 
-std::vector<std::array<float, 2>> dai::impl::getHull(const std::vector<std::array<float, 2>> points) {
-    std::vector<std::array<float, 2>> remaining(points.rbegin(), points.rend() - 1);
-    std::vector<std::array<float, 2>> hull{points.front()};
-    hull.reserve(points.size());
-    while(remaining.size() > 0) {
-        auto pt = remaining.back();
-        remaining.pop_back();
-        while(hull.size() >= 2) {
-            auto last1 = hull.size() - 1;
-            auto last2 = hull.size() - 2;
+namespace {
+
+// Convex hull of count points, written to hull with remaining as scratch space, both with room for count points. Returns the size of the hull
+size_t convexHull(const std::array<float, 2>* points, size_t count, std::array<float, 2>* hull, std::array<float, 2>* remaining) {
+    size_t numRemaining = 0;
+    for(size_t i = count - 1; i > 0; --i) remaining[numRemaining++] = points[i];
+    size_t numHull = 0;
+    hull[numHull++] = points[0];
+    while(numRemaining > 0) {
+        auto pt = remaining[--numRemaining];
+        while(numHull >= 2) {
+            auto last1 = numHull - 1;
+            auto last2 = numHull - 2;
             std::array<float, 2> v1 = {hull[last1][0] - hull[last2][0], hull[last1][1] - hull[last2][1]};
             std::array<float, 2> v2 = {pt[0] - hull[last1][0], pt[1] - hull[last1][1]};
             std::array<float, 2> v3 = {hull[0][0] - pt[0], hull[0][1] - pt[1]};
             auto cross1 = v1[0] * v2[1] - v1[1] * v2[0];
             auto cross2 = v2[0] * v3[1] - v2[1] * v3[0];
             if(cross1 < 0 || cross2 < 0) {
-                remaining.push_back(hull.back());
-                hull.pop_back();
+                remaining[numRemaining++] = hull[--numHull];
             } else if(cross1 == 0 || cross2 == 0) {
                 throw std::runtime_error("Colinear points");
             } else {
                 break;
             }
         }
-        hull.push_back(pt);
+        hull[numHull++] = pt;
+    }
+    return numHull;
+}
+
+// Smallest rotated rect around a convex hull, with a side along one of the edges of the hull
+std::array<std::array<float, 2>, 4> outerRotatedRect(const std::array<float, 2>* hull, size_t numHull) {
+    float minArea = std::numeric_limits<float>::max();
+    std::array<std::array<float, 2>, 4> minAreaPoints;
+
+    for(size_t i = 1; i < numHull; ++i) {
+        std::array<float, 2> vec = {hull[i][0] - hull[i - 1][0], hull[i][1] - hull[i - 1][1]};
+        std::array<float, 2> vecOrth = {-vec[1], vec[0]};
+        float len = sqrtf(vec[0] * vec[0] + vec[1] * vec[1]);
+        vec[0] /= len;
+        vec[1] /= len;
+        vecOrth[0] /= len;
+        vecOrth[1] /= len;
+        std::array<std::array<float, 2>, 2> mat = {{{vec[0], vecOrth[0]}, {vec[1], vecOrth[1]}}};
+        std::array<std::array<float, 2>, 2> matInv = dai::impl::getInverse(mat);
+
+        // Bounds of the hull rotated to the edge
+        float minx = 0, maxx = 0, miny = 0, maxy = 0;
+        for(size_t j = 0; j < numHull; ++j) {
+            float newX = matInv[0][0] * hull[j][0] + matInv[0][1] * hull[j][1];
+            float newY = matInv[1][0] * hull[j][0] + matInv[1][1] * hull[j][1];
+            minx = j == 0 ? newX : std::min(newX, minx);
+            maxx = j == 0 ? newX : std::max(newX, maxx);
+            miny = j == 0 ? newY : std::min(newY, miny);
+            maxy = j == 0 ? newY : std::max(newY, maxy);
+        }
+        float area = (maxx - minx) * (maxy - miny);
+
+        if(area < minArea) {
+            minArea = area;
+            std::array<std::array<float, 2>, 4> rectPoints = {{{minx, miny}, {maxx, miny}, {maxx, maxy}, {minx, maxy}}};
+            for(auto k = 0U; k < rectPoints.size(); ++k) {
+                auto& pt = rectPoints[k];
+                float origX = mat[0][0] * pt[0] + mat[0][1] * pt[1];
+                float origY = mat[1][0] * pt[0] + mat[1][1] * pt[1];
+                minAreaPoints[k] = {origX, origY};
+            }
+        }
     }
+
+    return minAreaPoints;
+}
+
+dai::RotatedRect rotatedRectFromCorners(const std::array<std::array<float, 2>, 4>& rrCorners) {
+    dai::RotatedRect rect;
+    rect.size.width = std::sqrt(std::pow(rrCorners[1][0] - rrCorners[0][0], 2) + std::pow(rrCorners[1][1] - rrCorners[0][1], 2));
+    rect.size.height = std::sqrt(std::pow(rrCorners[2][0] - rrCorners[1][0], 2) + std::pow(rrCorners[2][1] - rrCorners[1][1], 2));
+    rect.center.x = (rrCorners[0][0] + rrCorners[1][0] + rrCorners[2][0] + rrCorners[3][0]) / 4.0f;
+    rect.center.y = (rrCorners[0][1] + rrCorners[1][1] + rrCorners[2][1] + rrCorners[3][1]) / 4.0f;
+    rect.angle = std::atan2(rrCorners[1][1] - rrCorners[0][1], rrCorners[1][0] - rrCorners[0][0]) * 180.0f / (float)M_PI;
+    return rect;
+}
+
+}  // namespace
+
+std::vector<std::array<float, 2>> dai::impl::getHull(const std::vector<std::array<float, 2>> points) {
+    std::vector<std::array<float, 2>> hull(points.size());
+    std::vector<std::array<float, 2>> remaining(points.size());
+    hull.resize(convexHull(points.data(), points.size(), hull.data(), remaining.data()));
     return hull;
 }
 
@@ -539,43 +603,7 @@ std::array<std::array<float, 3>, 3> dai::impl::getInverse(const std::array<std::
 
 std::array<std::array<float, 2>, 4> dai::impl::getOuterRotatedRect(const std::vector<std::array<float, 2>>& points) {
     auto hull = getHull(points);
-    float minArea = std::numeric_limits<float>::max();
-    std::array<std::array<float, 2>, 4> minAreaPoints;
-
-    for(size_t i = 1; i < hull.size(); ++i) {
-        std::array<float, 2> vec = {hull[i][0] - hull[i - 1][0], hull[i][1] - hull[i - 1][1]};
-        std::array<float, 2> vecOrth = {-vec[1], vec[0]};
-        float len = sqrtf(vec[0] * vec[0] + vec[1] * vec[1]);
-        vec[0] /= len;
-        vec[1] /= len;
-        vecOrth[0] /= len;
-        vecOrth[1] /= len;
-        std::array<std::array<float, 2>, 2> mat = {{{vec[0], vecOrth[0]}, {vec[1], vecOrth[1]}}};
-        std::array<std::array<float, 2>, 2> matInv = getInverse(mat);
-
-        std::vector<std::array<float, 2>> rotatedHull;
-        for(const auto& pt : hull) {
-            float newX = matInv[0][0] * pt[0] + matInv[0][1] * pt[1];
-            float newY = matInv[1][0] * pt[0] + matInv[1][1] * pt[1];
-            rotatedHull.push_back({newX, newY});
-        }
-
-        const auto [minx, maxx, miny, maxy] = getOuterRect(rotatedHull);
-        float area = (maxx - minx) * (maxy - miny);
-
-        if(area < minArea) {
-            minArea = area;
-            std::array<std::array<float, 2>, 4> rectPoints = {{{minx, miny}, {maxx, miny}, {maxx, maxy}, {minx, maxy}}};
-            for(auto i = 0U; i < rectPoints.size(); ++i) {
-                auto& pt = rectPoints[i];
-                float origX = mat[0][0] * pt[0] + mat[0][1] * pt[1];
-                float origY = mat[1][0] * pt[0] + mat[1][1] * pt[1];
-                minAreaPoints[i] = {origX, origY};
-            }
-        }
-    }
-
-    return minAreaPoints;
+    return outerRotatedRect(hull.data(), hull.size());
 }
 
 std::array<std::array<float, 3>, 3> dai::impl::getResizeMat(Resize o, float width, float height, uint32_t outputWidth, uint32_t outputHeight) {
@@ -915,14 +943,12 @@ size_t dai::impl::getAlignedOutputFrameSize(ImgFrame::Type type, size_t width, s
     return 0;
 }
 dai::RotatedRect dai::impl::getRotatedRectFromPoints(const std::vector<std::array<float, 2>>& points) {
-    auto rrCorners = impl::getOuterRotatedRect(points);
-    dai::RotatedRect rect;
-    rect.size.width = std::sqrt(std::pow(rrCorners[1][0] - rrCorners[0][0], 2) + std::pow(rrCorners[1][1] - rrCorners[0][1], 2));
-    rect.size.height = std::sqrt(std::pow(rrCorners[2][0] - rrCorners[1][0], 2) + std::pow(rrCorners[2][1] - rrCorners[1][1], 2));
-    rect.center.x = (rrCorners[0][0] + rrCorners[1][0] + rrCorners[2][0] + rrCorners[3][0]) / 4.0f;
-    rect.center.y = (rrCorners[0][1] + rrCorners[1][1] + rrCorners[2][1] + rrCorners[3][1]) / 4.0f;
-    rect.angle = std::atan2(rrCorners[1][1] - rrCorners[0][1], rrCorners[1][0] - rrCorners[0][0]) * 180.0f / (float)M_PI;
-    return rect;
+    return rotatedRectFromCorners(impl::getOuterRotatedRect(points));
+}
+dai::RotatedRect dai::impl::getRotatedRectFromCorners(const std::array<std::array<float, 2>, 4>& corners) {
+    std::array<std::array<float, 2>, 4> hull, remaining;
+    const size_t numHull = convexHull(corners.data(), corners.size(), hull.data(), remaining.data());
+    return rotatedRectFromCorners(outerRotatedRect(hull.data(), numHull));
 }
 
 #ifdef DEPTHAI_HAVE_OPENCV_SUPPORT
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace dai {
+namespace utility {
+
+/**
+ * Images handed to a consumer, returned for reuse once the consumer releases them.
+ * Holds at most as many images as were in flight at once.
+ * @tparam Image Image type constructible from its width and height, such as basalt::ManagedImage
+ */
+template <typename Image>
+class ImagePool {
+   public:
+    ImagePool() : state(std::make_shared<State>()) {}
+
+    /**
+     * Get an image of the given size, with unspecified contents
+     */
+    std::shared_ptr<Image> acquire(size_t width, size_t height) {
+        std::unique_ptr<Image> image;
+        {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            // Images of a previous resolution are freed
+            if(state->width != width || state->height != height) {
+                state->images.clear();
+                state->width = width;
+                state->height = height;
+            }
+            if(!state->images.empty()) {
+                image = std::move(state->images.back());
+                state->images.pop_back();
+            }
+        }
+        if(!image) image = std::make_unique<Image>(width, height);
+
+        // Images released after the pool is destroyed are freed
+        std::weak_ptr<State> weakState = state;
+        return std::shared_ptr<Image>(image.release(), [weakState, width, height](Image* released) {
+            std::unique_ptr<Image> image(released);
+            if(auto pool = weakState.lock()) {
+                std::lock_guard<std::mutex> lock(pool->mutex);
+                if(pool->width == width && pool->height == height) pool->images.push_back(std::move(image));
+            }
+        });
+    }
+
+   private:
+    struct State {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<Image>> images;
+        size_t width = 0;
+        size_t height = 0;
+    };
+    std::shared_ptr<State> state;
+};
+
+}  // namespace utility
+}  // namespace dai
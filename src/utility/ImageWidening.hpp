@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// Relative, the header is also used by targets without src/ in their include path
+#include "Simd.hpp"
+
+namespace dai {
+namespace utility {
+
+namespace detail {
+
+inline void widenRow(const std::uint8_t* in, std::uint16_t* out, size_t width) {
+    size_t x = 0;
+#if defined(DEPTHAI_SIMD_SSE2)
+    // Interleaving with zero bytes puts each pixel in the upper byte of a little endian 16 bit value
+    const __m128i zero = _mm_setzero_si128();
+    for(; x + 16 <= width; x += 16) {
+        const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + x));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + x), _mm_unpacklo_epi8(zero, pixels));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + x + 8), _mm_unpackhi_epi8(zero, pixels));
+    }
+#elif defined(DEPTHAI_SIMD_NEON)
+    for(; x + 16 <= width; x += 16) {
+        const uint8x16_t pixels = vld1q_u8(in + x);
+        vst1q_u16(out + x, vshll_n_u8(vget_low_u8(pixels), 8));
+        vst1q_u16(out + x + 8, vshll_n_u8(vget_high_u8(pixels), 8));
+    }
+#endif
+    for(; x < width; x++) out[x] = static_cast<std::uint16_t>(in[x] << 8);
+}
+
+}  // namespace detail
+
+/**
+ * Converts an 8 bit image to a 16 bit one, moving each pixel value to the upper byte so the full range is used.
+ * Strides are in bytes.
+ */
+inline void widen8To16(const std::uint8_t* src, size_t srcStride, std::uint16_t* dst, size_t dstStride, size_t width, size_t height) {
+    for(size_t y = 0; y < height; y++) {
+        detail::widenRow(src + y * srcStride, reinterpret_cast<std::uint16_t*>(reinterpret_cast<std::uint8_t*>(dst) + y * dstStride), width);
+    }
+}
+
+/**
+ * Copies a 16 bit image between buffers with different strides, in bytes.
+ */
+inline void copy16(const std::uint16_t* src, size_t srcStride, std::uint16_t* dst, size_t dstStride, size_t width, size_t height) {
+    if(srcStride == dstStride && srcStride == width * sizeof(std::uint16_t)) {
+        std::memcpy(dst, src, height * srcStride);
+        return;
+    }
+    for(size_t y = 0; y < height; y++) {
+        const auto* in = reinterpret_cast<const std::uint8_t*>(src) + y * srcStride;
+        std::memcpy(reinterpret_cast<std::uint8_t*>(dst) + y * dstStride, in, width * sizeof(std::uint16_t));
+    }
+}
+
+}  // namespace utility
+}  // namespace dai
@@ -8,6 +8,7 @@
 // project
 #include "build/version.hpp"
 #include "depthai/config/config.hpp"
+#include "depthai/utility/MetricsRegistry.hpp"
 #include "utility/Environment.hpp"
 #include "utility/Logging.hpp"
 #include "utility/Resources.hpp"
@@ -135,6 +136,16 @@ bool initialize(const char* additionalInfo, bool installSignalHandler, void* jav
             XLinkGlobalProfilingLogger::getInstance().enable(true);
         }
 
+        // Serve metrics over HTTP if requested
+        auto metricsPort = utility::getEnvAs<int>("DEPTHAI_METRICS_PORT", -1);
+        if(metricsPort >= 0) {
+            try {
+                MetricsRegistry::getInstance().startServer("127.0.0.1", metricsPort);
+            } catch(const std::exception& ex) {
+                logger::warn("Couldn't start metrics server - {}", ex.what());
+            }
+        }
+
         // TODO(themarpe), move into XLink library
         auto xlinkEnvLevel = utility::getEnvAs<std::string>("XLINK_LEVEL", "");
         if(xlinkEnvLevel == "debug") {
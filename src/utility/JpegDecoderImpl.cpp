@@ -0,0 +1,493 @@
+#include "JpegDecoderImpl.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include "utility/ParallelFor.hpp"
+
+namespace dai {
+namespace impl {
+
+namespace {
+
+// Natural order index of each zigzag position
+constexpr std::array<std::uint8_t, 64> ZIGZAG = {0,  1,  8,  16, 9,  2,  3,  10, 17, 24, 32, 25, 18, 11, 4,  5,  12, 19, 26, 33, 40, 48,
+                                                 41, 34, 27, 20, 13, 6,  7,  14, 21, 28, 35, 42, 49, 56, 57, 50, 43, 36, 29, 22, 15, 23,
+                                                 30, 37, 44, 51, 58, 59, 52, 45, 38, 31, 39, 46, 53, 60, 61, 54, 47, 55, 62, 63};
+
+constexpr float AAN_SCALES[8] = {1.0f, 1.387039845f, 1.306562965f, 1.175875602f, 1.0f, 0.785694958f, 0.541196100f, 0.275899379f};
+
+int readWord(const std::uint8_t* data) {
+    return (data[0] << 8) | data[1];
+}
+
+[[noreturn]] void corrupted() {
+    throw std::invalid_argument("Corrupted JPEG data");
+}
+
+// Entropy coded segment reader, removes stuffed bytes and reads zeros past the end
+class BitReader {
+   public:
+    BitReader(const std::uint8_t* begin, const std::uint8_t* end) : next(begin), end(end) {}
+
+    // Buffers at least 57 bits, enough for a Huffman code and the following value
+    void fill() {
+        while(count <= 56) {
+            std::uint64_t byte = 0;
+            if(next < end) {
+                byte = *next++;
+                if(byte == 0xFF) {
+                    if(next < end && *next == 0x00) {
+                        next++;
+                    } else {
+                        next = end;
+                        byte = 0;
+                    }
+                }
+            }
+            buffer |= byte << (56 - count);
+            count += 8;
+        }
+    }
+
+    std::uint32_t peek(int length) const {
+        return static_cast<std::uint32_t>(buffer >> (64 - length));
+    }
+
+    void skip(int length) {
+        buffer <<= length;
+        count -= length;
+    }
+
+    // Value of the given magnitude category
+    int receive(int size) {
+        if(size == 0) return 0;
+        const int bits = static_cast<int>(peek(size));
+        skip(size);
+        return bits < (1 << (size - 1)) ? bits - (1 << size) + 1 : bits;
+    }
+
+   private:
+    const std::uint8_t* next;
+    const std::uint8_t* end;
+    std::uint64_t buffer = 0;
+    int count = 0;
+};
+
+// Inverse DCT of a block (Arai, Agui, Nakajima), inputs are prescaled by dequantization
+void inverseDct(float* block, std::uint8_t* out, int stride) {
+    for(int pass = 0; pass < 2; pass++) {
+        // Columns in the first pass, rows in the second
+        const int step = pass == 0 ? 8 : 1;
+        const int next = pass == 0 ? 1 : 8;
+        for(int line = 0; line < 8; line++) {
+            float* d = block + line * next;
+
+            // Even part
+            const float even0 = d[0];
+            const float even1 = d[2 * step];
+            const float even2 = d[4 * step];
+            const float even3 = d[6 * step];
+            const float tmp10 = even0 + even2;
+            const float tmp11 = even0 - even2;
+            const float tmp13 = even1 + even3;
+            const float tmp12 = (even1 - even3) * 1.414213562f - tmp13;
+            const float tmp0 = tmp10 + tmp13;
+            const float tmp3 = tmp10 - tmp13;
+            const float tmp1 = tmp11 + tmp12;
+            const float tmp2 = tmp11 - tmp12;
+
+            // Odd part
+            const float z13 = d[5 * step] + d[3 * step];
+            const float z10 = d[5 * step] - d[3 * step];
+            const float z11 = d[1 * step] + d[7 * step];
+            const float z12 = d[1 * step] - d[7 * step];
+            const float tmp7 = z11 + z13;
+            const float odd11 = (z11 - z13) * 1.414213562f;
+            const float z5 = (z10 + z12) * 1.847759065f;
+            const float odd10 = z5 - z12 * 1.082392200f;
+            const float odd12 = z5 - z10 * 2.613125930f;
+            const float tmp6 = odd12 - tmp7;
+            const float tmp5 = odd11 - tmp6;
+            const float tmp4 = odd10 - tmp5;
+
+            d[0] = tmp0 + tmp7;
+            d[7 * step] = tmp0 - tmp7;
+            d[1 * step] = tmp1 + tmp6;
+            d[6 * step] = tmp1 - tmp6;
+            d[2 * step] = tmp2 + tmp5;
+            d[5 * step] = tmp2 - tmp5;
+            d[3 * step] = tmp3 + tmp4;
+            d[4 * step] = tmp3 - tmp4;
+        }
+    }
+    for(int row = 0; row < 8; row++) {
+        for(int column = 0; column < 8; column++) {
+            const int value = static_cast<int>(block[row * 8 + column] + 128.5f);
+            out[row * stride + column] = static_cast<std::uint8_t>(std::max(0, std::min(255, value)));
+        }
+    }
+}
+
+}  // namespace
+
+// Decodes the MCUs of one restart interval into the component planes
+class JpegDecoder::ScanDecoder {
+   public:
+    ScanDecoder(JpegDecoder& decoder, const std::uint8_t* begin, const std::uint8_t* end, bool decodeChroma)
+        : decoder(decoder), reader(begin, end), decodeChroma(decodeChroma) {}
+
+    void decodeMcu(int mcu) {
+        const int mcuX = mcu % decoder.mcuColumns;
+        const int mcuY = mcu / decoder.mcuColumns;
+        for(size_t index = 0; index < decoder.components.size(); index++) {
+            Component& component = decoder.components[index];
+            for(int blockY = 0; blockY < component.samplingY; blockY++) {
+                for(int blockX = 0; blockX < component.samplingX; blockX++) {
+                    const int x = (mcuX * component.samplingX + blockX) * 8;
+                    const int y = (mcuY * component.samplingY + blockY) * 8;
+                    const bool output = index == 0 || decodeChroma;
+                    decodeBlock(component, index, output ? component.plane.data() + static_cast<size_t>(y) * component.stride + x : nullptr);
+                }
+            }
+        }
+    }
+
+   private:
+    JpegDecoder& decoder;
+    BitReader reader;
+    bool decodeChroma;
+    std::array<int, 4> predictors{};
+
+    int decodeSymbol(const HuffmanTable& table) {
+        const std::uint32_t bits = reader.peek(HuffmanTable::LOOKUP_BITS);
+        const std::uint16_t entry = table.lookup[bits];
+        if(entry != 0) {
+            reader.skip(entry >> 8);
+            return entry & 0xFF;
+        }
+        const std::uint32_t code = reader.peek(16);
+        for(int length = HuffmanTable::LOOKUP_BITS + 1; length <= 16; length++) {
+            const std::uint32_t prefix = code >> (16 - length);
+            if(prefix < table.maxCode[length]) {
+                reader.skip(length);
+                return table.values[prefix + table.valueOffset[length]];
+            }
+        }
+        corrupted();
+    }
+
+    // Decodes coefficients of a block and its inverse DCT into out, if not null
+    void decodeBlock(const Component& component, size_t index, std::uint8_t* out) {
+        const auto& dequantization = decoder.dequantization[component.quantizationTable];
+        const HuffmanTable& dcTable = decoder.dcTables[component.dcTable];
+        const HuffmanTable& acTable = decoder.acTables[component.acTable];
+
+        float block[64] = {};
+        reader.fill();
+        const int dcSize = decodeSymbol(dcTable);
+        if(dcSize > 15) corrupted();
+        predictors[index] += reader.receive(dcSize);
+        block[0] = static_cast<float>(predictors[index]) * dequantization[0];
+
+        bool hasAc = false;
+        for(int k = 1; k < 64;) {
+            reader.fill();
+            const int symbol = decodeSymbol(acTable);
+            const int run = symbol >> 4;
+            const int size = symbol & 0x0F;
+            if(size == 0) {
+                if(run != 15) break;
+                k += 16;
+                continue;
+            }
+            k += run;
+            if(k > 63) corrupted();
+            const int natural = ZIGZAG[k];
+            block[natural] = static_cast<float>(reader.receive(size)) * dequantization[natural];
+            hasAc = true;
+            k++;
+        }
+        if(out == nullptr) return;
+
+        if(!hasAc) {
+            const int value = static_cast<int>(block[0] + 128.5f);
+            const auto pixel = static_cast<std::uint8_t>(std::max(0, std::min(255, value)));
+            for(int row = 0; row < 8; row++) std::memset(out + static_cast<size_t>(row) * component.stride, pixel, 8);
+            return;
+        }
+        inverseDct(block, out, component.stride);
+    }
+};
+
+JpegDecoder::JpegDecoder(unsigned numThreads) : numThreads(numThreads == 0 ? std::max(1U, std::thread::hardware_concurrency()) : numThreads) {}
+
+int JpegDecoder::getWidth() const {
+    return width;
+}
+
+int JpegDecoder::getHeight() const {
+    return height;
+}
+
+bool JpegDecoder::isColor() const {
+    return components.size() > 1;
+}
+
+void JpegDecoder::parse(const std::uint8_t* data, size_t size) {
+    scan = nullptr;
+    end = nullptr;
+    width = 0;
+    height = 0;
+    restartInterval = 0;
+    if(size < 4 || data[0] != 0xFF || data[1] != 0xD8) {
+        throw std::invalid_argument("Data isn't a JPEG image");
+    }
+    size_t position = 2;
+    while(position + 4 <= size) {
+        if(data[position] != 0xFF) corrupted();
+        const std::uint8_t marker = data[position + 1];
+        if(marker == 0xFF) {
+            // Fill byte
+            position++;
+            continue;
+        }
+        if(marker == 0x01 || (marker >= 0xD0 && marker <= 0xD8)) {
+            position += 2;
+            continue;
+        }
+        if(marker == 0xD9) break;
+        const size_t length = readWord(data + position + 2);
+        if(length < 2 || position + 2 + length > size) corrupted();
+        const std::uint8_t* segment = data + position + 4;
+        const size_t segmentLength = length - 2;
+        switch(marker) {
+            case 0xDB:
+                parseQuantizationTables(segment, segmentLength);
+                break;
+            case 0xC4:
+                parseHuffmanTables(segment, segmentLength);
+                break;
+            case 0xC0:
+            case 0xC1:
+                parseFrame(segment, segmentLength);
+                break;
+            case 0xC2:
+            case 0xC3:
+            case 0xC5:
+            case 0xC6:
+            case 0xC7:
+            case 0xC9:
+            case 0xCA:
+            case 0xCB:
+            case 0xCD:
+            case 0xCE:
+            case 0xCF:
+                throw std::invalid_argument("Only baseline Huffman coded JPEG images are supported");
+            case 0xDD:
+                if(segmentLength < 2) corrupted();
+                restartInterval = readWord(segment);
+                break;
+            case 0xDA:
+                parseScan(segment, segmentLength);
+                scan = segment + segmentLength;
+                end = data + size;
+                return;
+            default:
+                // Application data and comments
+                break;
+        }
+        position += 2 + length;
+    }
+    throw std::invalid_argument("JPEG image has no scan");
+}
+
+void JpegDecoder::parseQuantizationTables(const std::uint8_t* segment, size_t length) {
+    size_t position = 0;
+    while(position < length) {
+        const int precision = segment[position] >> 4;
+        const int id = segment[position] & 0x0F;
+        const size_t tableLength = precision == 0 ? 64 : 128;
+        if(id > 3 || precision > 1 || position + 1 + tableLength > length) corrupted();
+        const std::uint8_t* values = segment + position + 1;
+        for(int i = 0; i < 64; i++) {
+            const int step = precision == 0 ? values[i] : readWord(values + 2 * i);
+            const int natural = ZIGZAG[i];
+            dequantization[id][natural] = static_cast<float>(step) * AAN_SCALES[natural / 8] * AAN_SCALES[natural % 8] / 8.f;
+        }
+        quantizationDefined[id] = true;
+        position += 1 + tableLength;
+    }
+}
+
+void JpegDecoder::parseHuffmanTables(const std::uint8_t* segment, size_t length) {
+    size_t position = 0;
+    while(position + 17 <= length) {
+        const int tableClass = segment[position] >> 4;
+        const int id = segment[position] & 0x0F;
+        if(tableClass > 1 || id > 3) corrupted();
+        const std::uint8_t* counts = segment + position + 1;
+        size_t numValues = 0;
+        for(int i = 0; i < 16; i++) numValues += counts[i];
+        if(numValues > 256 || position + 17 + numValues > length) corrupted();
+
+        HuffmanTable& table = tableClass == 0 ? dcTables[id] : acTables[id];
+        table = HuffmanTable{};
+        std::copy(segment + position + 17, segment + position + 17 + numValues, table.values.begin());
+        std::uint32_t code = 0;
+        int k = 0;
+        for(int codeLength = 1; codeLength <= 16; codeLength++) {
+            table.valueOffset[codeLength] = k - static_cast<int>(code);
+            for(int i = 0; i < counts[codeLength - 1]; i++, k++, code++) {
+                if(code >= (1U << codeLength)) corrupted();
+                if(codeLength <= HuffmanTable::LOOKUP_BITS) {
+                    const int shift = HuffmanTable::LOOKUP_BITS - codeLength;
+                    const auto entry = static_cast<std::uint16_t>((codeLength << 8) | table.values[k]);
+                    std::fill_n(table.lookup.begin() + (code << shift), 1 << shift, entry);
+                }
+            }
+            table.maxCode[codeLength] = code;
+            code <<= 1;
+        }
+        table.defined = true;
+        position += 17 + numValues;
+    }
+}
+
+void JpegDecoder::parseFrame(const std::uint8_t* segment, size_t length) {
+    if(length < 6) corrupted();
+    if(segment[0] != 8) throw std::invalid_argument("Only 8 bit JPEG images are supported");
+    height = readWord(segment + 1);
+    width = readWord(segment + 3);
+    const int numComponents = segment[5];
+    if(width == 0 || height == 0) throw std::invalid_argument("JPEG image size has to be set in its frame header");
+    if(numComponents != 1 && numComponents != 3) throw std::invalid_argument("Only grayscale and YCbCr JPEG images are supported");
+    if(length < 6 + 3 * static_cast<size_t>(numComponents)) corrupted();
+
+    components.resize(numComponents);
+    maxSamplingX = 1;
+    maxSamplingY = 1;
+    for(int index = 0; index < numComponents; index++) {
+        const std::uint8_t* fields = segment + 6 + 3 * index;
+        Component& component = components[index];
+        component.id = fields[0];
+        // Sampling factors of a single component image don't matter
+        component.samplingX = numComponents == 1 ? 1 : fields[1] >> 4;
+        component.samplingY = numComponents == 1 ? 1 : fields[1] & 0x0F;
+        component.quantizationTable = fields[2];
+        if(component.samplingX < 1 || component.samplingX > 2 || component.samplingY < 1 || component.samplingY > 2) {
+            throw std::invalid_argument("Only JPEG sampling factors of 1 and 2 are supported");
+        }
+        if(component.quantizationTable > 3) corrupted();
+        maxSamplingX = std::max(maxSamplingX, component.samplingX);
+        maxSamplingY = std::max(maxSamplingY, component.samplingY);
+    }
+    if(components[0].samplingX != maxSamplingX || components[0].samplingY != maxSamplingY) {
+        throw std::invalid_argument("JPEG chroma resolution higher than the luma one isn't supported");
+    }
+
+    mcuColumns = (width + 8 * maxSamplingX - 1) / (8 * maxSamplingX);
+    mcuRows = (height + 8 * maxSamplingY - 1) / (8 * maxSamplingY);
+    for(auto& component : components) {
+        component.stride = mcuColumns * component.samplingX * 8;
+        component.plane.resize(static_cast<size_t>(component.stride) * mcuRows * component.samplingY * 8);
+    }
+}
+
+void JpegDecoder::parseScan(const std::uint8_t* segment, size_t length) {
+    if(width == 0) throw std::invalid_argument("JPEG scan precedes the frame header");
+    if(length < 1 || segment[0] != components.size() || length < 4 + 2 * components.size()) {
+        throw std::invalid_argument("Only JPEG images with a single interleaved scan are supported");
+    }
+    for(size_t index = 0; index < components.size(); index++) {
+        Component& component = components[index];
+        const std::uint8_t* fields = segment + 1 + 2 * index;
+        if(fields[0] != component.id) throw std::invalid_argument("JPEG scan components have to be in the frame order");
+        component.dcTable = fields[1] >> 4;
+        component.acTable = fields[1] & 0x0F;
+        if(component.dcTable > 3 || component.acTable > 3 || !dcTables[component.dcTable].defined || !acTables[component.acTable].defined
+           || !quantizationDefined[component.quantizationTable]) {
+            throw std::invalid_argument("JPEG image references undefined tables");
+        }
+    }
+}
+
+void JpegDecoder::decode(std::uint8_t* luma, int lumaStride, std::uint8_t* chroma, int chromaStride) {
+    if(scan == nullptr) throw std::invalid_argument("No JPEG image parsed");
+
+    // Split the scan into restart intervals
+    std::vector<std::pair<const std::uint8_t*, const std::uint8_t*>> intervals;
+    const std::uint8_t* begin = scan;
+    const std::uint8_t* position = scan;
+    while(true) {
+        position = static_cast<const std::uint8_t*>(std::memchr(position, 0xFF, end - position));
+        if(position == nullptr || position + 1 >= end) {
+            intervals.emplace_back(begin, end);
+            break;
+        }
+        const std::uint8_t marker = position[1];
+        if(marker == 0x00 || marker == 0xFF) {
+            position++;
+            continue;
+        }
+        intervals.emplace_back(begin, position);
+        if(marker < 0xD0 || marker > 0xD7) break;
+        position += 2;
+        begin = position;
+    }
+
+    const int numMcus = mcuColumns * mcuRows;
+    const int interval = restartInterval > 0 ? restartInterval : numMcus;
+    const int numIntervals = (numMcus + interval - 1) / interval;
+    if(static_cast<int>(intervals.size()) < numIntervals) throw std::invalid_argument("Truncated JPEG data");
+
+    const bool decodeChroma = chroma != nullptr && isColor();
+    utility::parallelFor(0, numIntervals, numThreads, 1, [&](int first, int last) {
+        for(int index = first; index < last; index++) {
+            ScanDecoder decoder(*this, intervals[index].first, intervals[index].second, decodeChroma);
+            const int mcuEnd = std::min(numMcus, (index + 1) * interval);
+            for(int mcu = index * interval; mcu < mcuEnd; mcu++) decoder.decodeMcu(mcu);
+        }
+    });
+
+    const Component& lumaComponent = components[0];
+    for(int y = 0; y < height; y++) {
+        std::memcpy(luma + static_cast<size_t>(y) * lumaStride, lumaComponent.plane.data() + static_cast<size_t>(y) * lumaComponent.stride, width);
+    }
+    if(chroma == nullptr) return;
+
+    const int chromaWidth = (width + 1) / 2;
+    const int chromaHeight = (height + 1) / 2;
+    if(!isColor()) {
+        for(int y = 0; y < chromaHeight; y++) std::memset(chroma + static_cast<size_t>(y) * chromaStride, 128, static_cast<size_t>(chromaWidth) * 2);
+        return;
+    }
+    for(int index = 1; index < 3; index++) {
+        const Component& component = components[index];
+        // Chroma samples covered by each output sample, in both directions
+        const int spanX = 2 * component.samplingX / maxSamplingX;
+        const int spanY = 2 * component.samplingY / maxSamplingY;
+        const int count = spanX * spanY;
+        for(int y = 0; y < chromaHeight; y++) {
+            std::uint8_t* out = chroma + static_cast<size_t>(y) * chromaStride + index - 1;
+            const std::uint8_t* in = component.plane.data() + static_cast<size_t>(y) * spanY * component.stride;
+            if(count == 1) {
+                for(int x = 0; x < chromaWidth; x++) out[x * 2] = in[x];
+                continue;
+            }
+            for(int x = 0; x < chromaWidth; x++) {
+                int sum = 0;
+                for(int dy = 0; dy < spanY; dy++) {
+                    for(int dx = 0; dx < spanX; dx++) sum += in[dy * component.stride + x * spanX + dx];
+                }
+                out[x * 2] = static_cast<std::uint8_t>((sum + count / 2) / count);
+            }
+        }
+    }
+}
+
+}  // namespace impl
+}  // namespace dai
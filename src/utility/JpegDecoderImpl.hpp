@@ -0,0 +1,99 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace dai {
+namespace impl {
+
+/**
+ * Host decoder of baseline JPEG images, as produced by the MJPEG profile of the VideoEncoder node.
+ * Decodes grayscale and YCbCr images with luma sampling factors of 1 or 2 into planes in NV12 layout.
+ * Intervals between restart markers are independent and are decoded in parallel.
+ */
+class JpegDecoder {
+   public:
+    /**
+     * @param numThreads Number of worker threads, 0 for the number of hardware threads
+     */
+    explicit JpegDecoder(unsigned numThreads = 0);
+
+    /**
+     * Parse the headers of an image up to its scan. The image data must outlive the following decode() call.
+     * Tables are kept between images, so they may be omitted from the following ones.
+     * @throws std::invalid_argument if the image is malformed or isn't a baseline Huffman coded 8 bit image
+     */
+    void parse(const std::uint8_t* data, size_t size);
+
+    int getWidth() const;
+    int getHeight() const;
+
+    /**
+     * Whether the parsed image has chroma components
+     */
+    bool isColor() const;
+
+    /**
+     * Decode the parsed image
+     * @param luma Luma plane of the image size
+     * @param lumaStride Luma row stride in bytes
+     * @param chroma Interleaved chroma plane with half the luma resolution, nullptr to decode only luma
+     * @param chromaStride Chroma row stride in bytes
+     * @throws std::invalid_argument if the scan is truncated or corrupted
+     */
+    void decode(std::uint8_t* luma, int lumaStride, std::uint8_t* chroma, int chromaStride);
+
+   private:
+    // Huffman table with a lookup of codes up to LOOKUP_BITS long
+    struct HuffmanTable {
+        static constexpr int LOOKUP_BITS = 9;
+        // Code length in the upper byte and value in the lower one, 0 for longer codes
+        std::array<std::uint16_t, 1 << LOOKUP_BITS> lookup{};
+        // Largest code of each length left aligned to 16 bits, and the index of its value
+        std::array<std::uint32_t, 18> maxCode{};
+        std::array<int, 17> valueOffset{};
+        std::array<std::uint8_t, 256> values{};
+        bool defined = false;
+    };
+
+    struct Component {
+        int id = 0;
+        int samplingX = 1;
+        int samplingY = 1;
+        int quantizationTable = 0;
+        int dcTable = 0;
+        int acTable = 0;
+        // Plane covering all MCUs
+        std::vector<std::uint8_t> plane;
+        int stride = 0;
+    };
+
+    class ScanDecoder;
+
+    // Dequantization steps in natural order, combined with the IDCT input scaling
+    std::array<std::array<float, 64>, 4> dequantization{};
+    std::array<bool, 4> quantizationDefined{};
+    std::array<HuffmanTable, 4> dcTables;
+    std::array<HuffmanTable, 4> acTables;
+    std::vector<Component> components;
+    int width = 0;
+    int height = 0;
+    int maxSamplingX = 1;
+    int maxSamplingY = 1;
+    int mcuColumns = 0;
+    int mcuRows = 0;
+    int restartInterval = 0;
+    const std::uint8_t* scan = nullptr;
+    const std::uint8_t* end = nullptr;
+    unsigned numThreads;
+
+    void parseQuantizationTables(const std::uint8_t* segment, size_t length);
+    void parseHuffmanTables(const std::uint8_t* segment, size_t length);
+    void parseFrame(const std::uint8_t* segment, size_t length);
+    void parseScan(const std::uint8_t* segment, size_t length);
+};
+
+}  // namespace impl
+}  // namespace dai
@@ -0,0 +1,551 @@
+#include "JpegEncoderImpl.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include "utility/ParallelFor.hpp"
+#include "utility/Simd.hpp"
+
+namespace dai {
+namespace impl {
+
+namespace {
+
+// Natural order index of each zigzag position
+constexpr std::array<std::uint8_t, 64> ZIGZAG = {0,  1,  8,  16, 9,  2,  3,  10, 17, 24, 32, 25, 18, 11, 4,  5,  12, 19, 26, 33, 40, 48,
+                                                 41, 34, 27, 20, 13, 6,  7,  14, 21, 28, 35, 42, 49, 56, 57, 50, 43, 36, 29, 22, 15, 23,
+                                                 30, 37, 44, 51, 58, 59, 52, 45, 38, 31, 39, 46, 53, 60, 61, 54, 47, 55, 62, 63};
+
+// Quantization tables of the JPEG standard (Annex K), in natural order
+constexpr std::array<std::uint8_t, 64> LUMA_QUANTIZATION = {16, 11, 10, 16, 24,  40,  51,  61,  12, 12, 14, 19, 26,  58,  60,  55,
+                                                            14, 13, 16, 24, 40,  57,  69,  56,  14, 17, 22, 29, 51,  87,  80,  62,
+                                                            18, 22, 37, 56, 68,  109, 103, 77,  24, 35, 55, 64, 81,  104, 113, 92,
+                                                            49, 64, 78, 87, 103, 121, 120, 101, 72, 92, 95, 98, 112, 100, 103, 99};
+constexpr std::array<std::uint8_t, 64> CHROMA_QUANTIZATION = {17, 18, 24, 47, 99, 99, 99, 99, 18, 21, 26, 66, 99, 99, 99, 99, 24, 26, 56, 99, 99, 99,
+                                                              99, 99, 47, 66, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99,
+                                                              99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99};
+
+// Huffman tables of the JPEG standard (Annex K): number of codes of each length and the coded values
+struct HuffmanSpec {
+    std::array<std::uint8_t, 16> counts;
+    std::vector<std::uint8_t> values;
+};
+
+const HuffmanSpec LUMA_DC = {{0, 1, 5, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0}, {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11}};
+const HuffmanSpec CHROMA_DC = {{0, 3, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0}, {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11}};
+const HuffmanSpec LUMA_AC = {
+    {0, 2, 1, 3, 3, 2, 4, 3, 5, 5, 4, 4, 0, 0, 1, 0x7d},
+    {0x01, 0x02, 0x03, 0x00, 0x04, 0x11, 0x05, 0x12, 0x21, 0x31, 0x41, 0x06, 0x13, 0x51, 0x61, 0x07, 0x22, 0x71, 0x14, 0x32, 0x81, 0x91, 0xa1,
+     0x08, 0x23, 0x42, 0xb1, 0xc1, 0x15, 0x52, 0xd1, 0xf0, 0x24, 0x33, 0x62, 0x72, 0x82, 0x09, 0x0a, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x25, 0x26,
+     0x27, 0x28, 0x29, 0x2a, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4a, 0x53, 0x54, 0x55, 0x56,
+     0x57, 0x58, 0x59, 0x5a, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6a, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7a, 0x83, 0x84, 0x85,
+     0x86, 0x87, 0x88, 0x89, 0x8a, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9a, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7, 0xa8, 0xa9, 0xaa,
+     0xb2, 0xb3, 0xb4, 0xb5, 0xb6, 0xb7, 0xb8, 0xb9, 0xba, 0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7, 0xc8, 0xc9, 0xca, 0xd2, 0xd3, 0xd4, 0xd5, 0xd6,
+     0xd7, 0xd8, 0xd9, 0xda, 0xe1, 0xe2, 0xe3, 0xe4, 0xe5, 0xe6, 0xe7, 0xe8, 0xe9, 0xea, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8, 0xf9,
+     0xfa}};
+const HuffmanSpec CHROMA_AC = {
+    {0, 2, 1, 2, 4, 4, 3, 4, 7, 5, 4, 4, 0, 1, 2, 0x77},
+    {0x00, 0x01, 0x02, 0x03, 0x11, 0x04, 0x05, 0x21, 0x31, 0x06, 0x12, 0x41, 0x51, 0x07, 0x61, 0x71, 0x13, 0x22, 0x32, 0x81, 0x08, 0x14, 0x42,
+     0x91, 0xa1, 0xb1, 0xc1, 0x09, 0x23, 0x33, 0x52, 0xf0, 0x15, 0x62, 0x72, 0xd1, 0x0a, 0x16, 0x24, 0x34, 0xe1, 0x25, 0xf1, 0x17, 0x18, 0x19,
+     0x1a, 0x26, 0x27, 0x28, 0x29, 0x2a, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4a, 0x53, 0x54, 0x55,
+     0x56, 0x57, 0x58, 0x59, 0x5a, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6a, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7a, 0x82, 0x83,
+     0x84, 0x85, 0x86, 0x87, 0x88, 0x89, 0x8a, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9a, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7, 0xa8,
+     0xa9, 0xaa, 0xb2, 0xb3, 0xb4, 0xb5, 0xb6, 0xb7, 0xb8, 0xb9, 0xba, 0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7, 0xc8, 0xc9, 0xca, 0xd2, 0xd3, 0xd4,
+     0xd5, 0xd6, 0xd7, 0xd8, 0xd9, 0xda, 0xe2, 0xe3, 0xe4, 0xe5, 0xe6, 0xe7, 0xe8, 0xe9, 0xea, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8, 0xf9,
+     0xfa}};
+
+// Code and its length in bits for each value of a Huffman table
+struct HuffmanTable {
+    std::array<std::uint16_t, 256> codes{};
+    std::array<std::uint8_t, 256> lengths{};
+
+    explicit HuffmanTable(const HuffmanSpec& spec) {
+        std::uint16_t code = 0;
+        size_t k = 0;
+        for(int length = 1; length <= 16; length++) {
+            for(int i = 0; i < spec.counts[length - 1]; i++) {
+                codes[spec.values[k]] = code++;
+                lengths[spec.values[k]] = static_cast<std::uint8_t>(length);
+                k++;
+            }
+            code <<= 1;
+        }
+    }
+};
+
+const HuffmanTable& getHuffmanTable(int index) {
+    static const std::array<HuffmanTable, 4> tables = {HuffmanTable(LUMA_DC), HuffmanTable(LUMA_AC), HuffmanTable(CHROMA_DC), HuffmanTable(CHROMA_AC)};
+    return tables[index];
+}
+
+// Entropy coded segment writer, with 0xFF byte stuffing
+class BitWriter {
+   public:
+    explicit BitWriter(std::vector<std::uint8_t>& out) : out(out) {}
+
+    void write(std::uint32_t bits, int length) {
+        buffer = (buffer << length) | (bits & ((1U << length) - 1));
+        count += length;
+        while(count >= 8) {
+            count -= 8;
+            const auto byte = static_cast<std::uint8_t>(buffer >> count);
+            out.push_back(byte);
+            if(byte == 0xFF) out.push_back(0);
+        }
+    }
+
+    // Pads the last byte with ones
+    void flush() {
+        if(count > 0) write(0x7F, 8 - count);
+    }
+
+   private:
+    std::vector<std::uint8_t>& out;
+    std::uint64_t buffer = 0;
+    int count = 0;
+};
+
+// Number of bits of the magnitude of each coefficient up to 2047, baseline DC differences don't exceed it
+const std::array<std::uint8_t, 2048>& getCategories() {
+    static const auto categories = [] {
+        std::array<std::uint8_t, 2048> result{};
+        for(int value = 1; value < 2048; value++) result[value] = static_cast<std::uint8_t>(result[value / 2] + 1);
+        return result;
+    }();
+    return categories;
+}
+
+// Larger than any scaled DCT output, so adding it makes them positive
+constexpr float ROUNDING_OFFSET = 4096.f;
+
+// One pass of the forward DCT (Arai, Agui, Nakajima) over a line of 8 values d[0], d[step], ..., d[7 * step], in place.
+// Outputs are scaled, which quantization compensates. T is a float or a vector of lines transformed at once.
+template <typename T>
+inline void dctLine(T* d, int step) {
+    const T tmp0 = d[0] + d[7 * step];
+    const T tmp7 = d[0] - d[7 * step];
+    const T tmp1 = d[1 * step] + d[6 * step];
+    const T tmp6 = d[1 * step] - d[6 * step];
+    const T tmp2 = d[2 * step] + d[5 * step];
+    const T tmp5 = d[2 * step] - d[5 * step];
+    const T tmp3 = d[3 * step] + d[4 * step];
+    const T tmp4 = d[3 * step] - d[4 * step];
+
+    // Even part
+    const T tmp10 = tmp0 + tmp3;
+    const T tmp13 = tmp0 - tmp3;
+    const T tmp11 = tmp1 + tmp2;
+    const T tmp12 = tmp1 - tmp2;
+    d[0] = tmp10 + tmp11;
+    d[4 * step] = tmp10 - tmp11;
+    const T z1 = (tmp12 + tmp13) * 0.707106781f;
+    d[2 * step] = tmp13 + z1;
+    d[6 * step] = tmp13 - z1;
+
+    // Odd part
+    const T odd10 = tmp4 + tmp5;
+    const T odd11 = tmp5 + tmp6;
+    const T odd12 = tmp6 + tmp7;
+    const T z5 = (odd10 - odd12) * 0.382683433f;
+    const T z2 = odd10 * 0.541196100f + z5;
+    const T z4 = odd12 * 1.306562965f + z5;
+    const T z3 = odd11 * 0.707106781f;
+    const T z11 = tmp7 + z3;
+    const T z13 = tmp7 - z3;
+    d[5 * step] = z13 + z2;
+    d[3 * step] = z13 - z2;
+    d[1 * step] = z11 + z4;
+    d[7 * step] = z11 - z4;
+}
+
+// Smallest and largest values quantization rounds from, baseline AC coefficients are limited to 10 bits
+constexpr float QUANTIZED_MIN = ROUNDING_OFFSET - 1023.f;
+constexpr float QUANTIZED_MAX = ROUNDING_OFFSET + 1023.f;
+
+#if defined(DEPTHAI_SIMD_SSE2) || defined(DEPTHAI_SIMD_NEON)
+    #if defined(DEPTHAI_SIMD_SSE2)
+// Four lanes with the arithmetic of the DCT
+struct Float4 {
+    __m128 v;
+    static Float4 load(const float* p) {
+        return {_mm_loadu_ps(p)};
+    }
+    void store(float* p) const {
+        _mm_storeu_ps(p, v);
+    }
+    Float4 operator+(Float4 other) const {
+        return {_mm_add_ps(v, other.v)};
+    }
+    Float4 operator-(Float4 other) const {
+        return {_mm_sub_ps(v, other.v)};
+    }
+    Float4 operator*(float factor) const {
+        return {_mm_mul_ps(v, _mm_set1_ps(factor))};
+    }
+};
+
+inline void transpose4(Float4& a, Float4& b, Float4& c, Float4& d) {
+    _MM_TRANSPOSE4_PS(a.v, b.v, c.v, d.v);
+}
+
+// Converts 8 samples to floats centered around zero
+inline void loadSamples(const std::uint8_t* src, float* dst) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i words = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src)), zero);
+    const __m128 center = _mm_set1_ps(128.f);
+    _mm_storeu_ps(dst, _mm_sub_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(words, zero)), center));
+    _mm_storeu_ps(dst + 4, _mm_sub_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(words, zero)), center));
+}
+
+// Same rounding as the scalar loop, clamped before the conversion as SSE2 has no 32 bit minimum and maximum
+inline void quantize(const float* block, const float* scale, int* quantized) {
+    const __m128 offset = _mm_set1_ps(ROUNDING_OFFSET + 0.5f);
+    const __m128 low = _mm_set1_ps(QUANTIZED_MIN);
+    const __m128 high = _mm_set1_ps(QUANTIZED_MAX);
+    const __m128i integerOffset = _mm_set1_epi32(static_cast<int>(ROUNDING_OFFSET));
+    for(int i = 0; i < 64; i += 4) {
+        __m128 value = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(block + i), _mm_loadu_ps(scale + i)), offset);
+        value = _mm_min_ps(_mm_max_ps(value, low), high);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(quantized + i), _mm_sub_epi32(_mm_cvttps_epi32(value), integerOffset));
+    }
+}
+    #elif defined(DEPTHAI_SIMD_NEON)
+// Four lanes with the arithmetic of the DCT
+struct Float4 {
+    float32x4_t v;
+    static Float4 load(const float* p) {
+        return {vld1q_f32(p)};
+    }
+    void store(float* p) const {
+        vst1q_f32(p, v);
+    }
+    Float4 operator+(Float4 other) const {
+        return {vaddq_f32(v, other.v)};
+    }
+    Float4 operator-(Float4 other) const {
+        return {vsubq_f32(v, other.v)};
+    }
+    Float4 operator*(float factor) const {
+        return {vmulq_n_f32(v, factor)};
+    }
+};
+
+inline void transpose4(Float4& a, Float4& b, Float4& c, Float4& d) {
+    const float32x4x2_t ab = vtrnq_f32(a.v, b.v);
+    const float32x4x2_t cd = vtrnq_f32(c.v, d.v);
+    a.v = vcombine_f32(vget_low_f32(ab.val[0]), vget_low_f32(cd.val[0]));
+    b.v = vcombine_f32(vget_low_f32(ab.val[1]), vget_low_f32(cd.val[1]));
+    c.v = vcombine_f32(vget_high_f32(ab.val[0]), vget_high_f32(cd.val[0]));
+    d.v = vcombine_f32(vget_high_f32(ab.val[1]), vget_high_f32(cd.val[1]));
+}
+
+// Converts 8 samples to floats centered around zero
+inline void loadSamples(const std::uint8_t* src, float* dst) {
+    const uint16x8_t words = vmovl_u8(vld1_u8(src));
+    const float32x4_t center = vdupq_n_f32(128.f);
+    vst1q_f32(dst, vsubq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(words))), center));
+    vst1q_f32(dst + 4, vsubq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(words))), center));
+}
+
+// Same rounding as the scalar loop, the conversion truncates as the scalar cast does
+inline void quantize(const float* block, const float* scale, int* quantized) {
+    const float32x4_t offset = vdupq_n_f32(ROUNDING_OFFSET + 0.5f);
+    const float32x4_t low = vdupq_n_f32(QUANTIZED_MIN);
+    const float32x4_t high = vdupq_n_f32(QUANTIZED_MAX);
+    const int32x4_t integerOffset = vdupq_n_s32(static_cast<int>(ROUNDING_OFFSET));
+    for(int i = 0; i < 64; i += 4) {
+        float32x4_t value = vaddq_f32(vmulq_f32(vld1q_f32(block + i), vld1q_f32(scale + i)), offset);
+        value = vminq_f32(vmaxq_f32(value, low), high);
+        vst1q_s32(quantized + i, vsubq_s32(vcvtq_s32_f32(value), integerOffset));
+    }
+}
+    #endif
+
+// Transposes a block held as two vectors per row
+inline void transpose8(Float4* rows) {
+    for(int quarter = 0; quarter < 4; quarter++) {
+        Float4* q = rows + (quarter / 2) * 8 + quarter % 2;
+        transpose4(q[0], q[2], q[4], q[6]);
+    }
+    for(int row = 0; row < 4; row++) std::swap(rows[row * 2 + 1], rows[(row + 4) * 2]);
+}
+
+// Forward DCT of a block in place, lanes hold 4 lines. Rows are transposed to columns for the first pass, so every value goes through
+// the same operations as in the scalar version.
+void forwardDct(float* block) {
+    Float4 rows[16];
+    for(int i = 0; i < 16; i++) rows[i] = Float4::load(block + i * 4);
+    transpose8(rows);
+    dctLine(rows, 2);
+    dctLine(rows + 1, 2);
+    transpose8(rows);
+    dctLine(rows, 2);
+    dctLine(rows + 1, 2);
+    for(int i = 0; i < 16; i++) rows[i].store(block + i * 4);
+}
+#else
+inline void loadSamples(const std::uint8_t* src, float* dst) {
+    for(int i = 0; i < 8; i++) dst[i] = static_cast<float>(src[i]) - 128.f;
+}
+
+// Branch-free so it can be auto vectorized: rounds by truncating after an offset making values positive
+inline void quantize(const float* block, const float* scale, int* quantized) {
+    for(int i = 0; i < 64; i++) {
+        const float value = std::max(QUANTIZED_MIN, std::min(QUANTIZED_MAX, block[i] * scale[i] + (ROUNDING_OFFSET + 0.5f)));
+        quantized[i] = static_cast<int>(value) - static_cast<int>(ROUNDING_OFFSET);
+    }
+}
+
+// Forward DCT of a block in place, rows in the first pass and columns in the second
+void forwardDct(float* block) {
+    for(int row = 0; row < 8; row++) dctLine(block + row * 8, 1);
+    for(int column = 0; column < 8; column++) dctLine(block + column, 8);
+}
+#endif
+
+// Encodes 8x8 blocks of one MCU row into an entropy coded segment
+class SegmentEncoder {
+   public:
+    SegmentEncoder(std::vector<std::uint8_t>& out, const std::array<std::array<float, 64>, 2>& scaling) : writer(out), scaling(scaling) {}
+
+    // Samples block at (x, y) of a plane, replicating its right and bottom borders
+    void encodeBlock(const std::uint8_t* plane, int stride, int pixelStep, int width, int height, int x, int y, int component) {
+        float block[64];
+        if(x + 8 <= width && y + 8 <= height) {
+            std::uint8_t samples[8];
+            for(int row = 0; row < 8; row++) {
+                const std::uint8_t* src = plane + static_cast<size_t>(y + row) * stride + static_cast<size_t>(x) * pixelStep;
+                if(pixelStep != 1) {
+                    // Chroma is interleaved, its samples are gathered first
+                    for(int column = 0; column < 8; column++) samples[column] = src[column * pixelStep];
+                    src = samples;
+                }
+                loadSamples(src, block + row * 8);
+            }
+        } else {
+            for(int row = 0; row < 8; row++) {
+                const std::uint8_t* src = plane + static_cast<size_t>(std::min(y + row, height - 1)) * stride;
+                for(int column = 0; column < 8; column++) {
+                    block[row * 8 + column] = static_cast<float>(src[static_cast<size_t>(std::min(x + column, width - 1)) * pixelStep]) - 128.f;
+                }
+            }
+        }
+        forwardDct(block);
+
+        const int table = component == 0 ? 0 : 1;
+        int quantized[64];
+        quantize(block, scaling[table].data(), quantized);
+
+        const HuffmanTable& dcTable = getHuffmanTable(table * 2);
+        const HuffmanTable& acTable = getHuffmanTable(table * 2 + 1);
+        const int diff = quantized[0] - predictors[component];
+        predictors[component] = quantized[0];
+        writeValue(dcTable, 0, diff);
+
+        int run = 0;
+        for(int i = 1; i < 64; i++) {
+            const int coefficient = quantized[ZIGZAG[i]];
+            if(coefficient == 0) {
+                run++;
+                continue;
+            }
+            while(run > 15) {
+                writer.write(acTable.codes[0xF0], acTable.lengths[0xF0]);
+                run -= 16;
+            }
+            writeValue(acTable, run, coefficient);
+            run = 0;
+        }
+        if(run > 0) writer.write(acTable.codes[0x00], acTable.lengths[0x00]);
+    }
+
+    void flush() {
+        writer.flush();
+    }
+
+   private:
+    BitWriter writer;
+    const std::array<std::array<float, 64>, 2>& scaling;
+    std::array<int, 3> predictors{};
+    const std::array<std::uint8_t, 2048>& categories = getCategories();
+
+    // Huffman code of run and magnitude category, followed by the magnitude bits
+    void writeValue(const HuffmanTable& table, int run, int value) {
+        const int size = categories[value < 0 ? -value : value];
+        const int symbol = (run << 4) | size;
+        writer.write(table.codes[symbol], table.lengths[symbol]);
+        if(size > 0) writer.write(static_cast<std::uint32_t>(value < 0 ? value - 1 : value), size);
+    }
+};
+
+void writeMarker(std::vector<std::uint8_t>& out, std::uint8_t marker) {
+    out.push_back(0xFF);
+    out.push_back(marker);
+}
+
+void writeWord(std::vector<std::uint8_t>& out, int value) {
+    out.push_back(static_cast<std::uint8_t>(value >> 8));
+    out.push_back(static_cast<std::uint8_t>(value & 0xFF));
+}
+
+void writeHuffmanTable(std::vector<std::uint8_t>& out, int tableClass, int id, const HuffmanSpec& spec) {
+    out.push_back(static_cast<std::uint8_t>((tableClass << 4) | id));
+    out.insert(out.end(), spec.counts.begin(), spec.counts.end());
+    out.insert(out.end(), spec.values.begin(), spec.values.end());
+}
+
+}  // namespace
+
+JpegEncoder::JpegEncoder(int quality, unsigned numThreads) : numThreads(numThreads == 0 ? std::max(1U, std::thread::hardware_concurrency()) : numThreads) {
+    setQuality(quality);
+}
+
+void JpegEncoder::setQuality(int quality) {
+    // Scaling of the standard tables as in the IJG reference implementation
+    quality = std::max(1, std::min(100, quality));
+    const int factor = quality < 50 ? 5000 / quality : 200 - quality * 2;
+    constexpr float AAN_SCALES[8] = {1.0f, 1.387039845f, 1.306562965f, 1.175875602f, 1.0f, 0.785694958f, 0.541196100f, 0.275899379f};
+    for(int table = 0; table < 2; table++) {
+        const auto& base = table == 0 ? LUMA_QUANTIZATION : CHROMA_QUANTIZATION;
+        for(int i = 0; i < 64; i++) {
+            const int step = std::max(1, std::min(255, (base[ZIGZAG[i]] * factor + 50) / 100));
+            quantization[table][i] = static_cast<std::uint8_t>(step);
+            const int natural = ZIGZAG[i];
+            scaling[table][natural] = 1.f / (static_cast<float>(step) * AAN_SCALES[natural / 8] * AAN_SCALES[natural % 8] * 8.f);
+        }
+    }
+}
+
+std::vector<std::uint8_t> JpegEncoder::encode(const ImgFrame& frame) const {
+    const int width = static_cast<int>(frame.getWidth());
+    const int height = static_cast<int>(frame.getHeight());
+    const int stride = frame.fb.stride != 0 ? static_cast<int>(frame.fb.stride) : width;
+    const auto data = frame.getData();
+    if(width <= 0 || height <= 0 || stride < width || data.size() < frame.fb.p1Offset + static_cast<size_t>(stride) * (height - 1) + width) {
+        throw std::invalid_argument("VideoEncoder input frame size doesn't match its data");
+    }
+    switch(frame.getType()) {
+        case ImgFrame::Type::NV12: {
+            const int chromaHeight = (height + 1) / 2;
+            const size_t chromaWidth = static_cast<size_t>((width + 1) / 2) * 2;
+            if(data.size() < frame.fb.p2Offset + static_cast<size_t>(stride) * (chromaHeight - 1) + chromaWidth) {
+                throw std::invalid_argument("VideoEncoder input frame size doesn't match its data");
+            }
+            return encode(data.data() + frame.fb.p1Offset, stride, data.data() + frame.fb.p2Offset, stride, width, height);
+        }
+        case ImgFrame::Type::GRAY8:
+        case ImgFrame::Type::RAW8:
+        case ImgFrame::Type::YUV400p:
+            return encode(data.data() + frame.fb.p1Offset, stride, nullptr, 0, width, height);
+        default:
+            throw std::invalid_argument("VideoEncoder on host supports only NV12, GRAY8, RAW8 and YUV400p frames");
+    }
+}
+
+std::vector<std::uint8_t> JpegEncoder::encode(
+    const std::uint8_t* luma, int lumaStride, const std::uint8_t* chroma, int chromaStride, int width, int height) const {
+    const bool color = chroma != nullptr;
+    const int mcuSize = color ? 16 : 8;
+    const int mcuColumns = (width + mcuSize - 1) / mcuSize;
+    const int mcuRows = (height + mcuSize - 1) / mcuSize;
+    const int chromaWidth = (width + 1) / 2;
+    const int chromaHeight = (height + 1) / 2;
+
+    std::vector<std::uint8_t> out;
+    writeMarker(out, 0xD8);  // SOI
+
+    // JFIF header, 1:1 pixel aspect ratio
+    writeMarker(out, 0xE0);
+    writeWord(out, 16);
+    out.insert(out.end(), {'J', 'F', 'I', 'F', 0, 1, 1, 0, 0, 1, 0, 1, 0, 0});
+
+    const int numTables = color ? 2 : 1;
+    writeMarker(out, 0xDB);  // DQT
+    writeWord(out, 2 + 65 * numTables);
+    for(int table = 0; table < numTables; table++) {
+        out.push_back(static_cast<std::uint8_t>(table));
+        out.insert(out.end(), quantization[table].begin(), quantization[table].end());
+    }
+
+    const int numComponents = color ? 3 : 1;
+    writeMarker(out, 0xC0);  // SOF0, baseline
+    writeWord(out, 8 + 3 * numComponents);
+    out.push_back(8);
+    writeWord(out, height);
+    writeWord(out, width);
+    out.push_back(static_cast<std::uint8_t>(numComponents));
+    for(int component = 0; component < numComponents; component++) {
+        out.push_back(static_cast<std::uint8_t>(component + 1));
+        out.push_back(component == 0 && color ? 0x22 : 0x11);
+        out.push_back(static_cast<std::uint8_t>(component == 0 ? 0 : 1));
+    }
+
+    writeMarker(out, 0xC4);  // DHT
+    size_t lengthOffset = out.size();
+    writeWord(out, 0);
+    writeHuffmanTable(out, 0, 0, LUMA_DC);
+    writeHuffmanTable(out, 1, 0, LUMA_AC);
+    if(color) {
+        writeHuffmanTable(out, 0, 1, CHROMA_DC);
+        writeHuffmanTable(out, 1, 1, CHROMA_AC);
+    }
+    const size_t tablesLength = out.size() - lengthOffset;
+    out[lengthOffset] = static_cast<std::uint8_t>(tablesLength >> 8);
+    out[lengthOffset + 1] = static_cast<std::uint8_t>(tablesLength & 0xFF);
+
+    writeMarker(out, 0xDD);  // DRI, a restart interval per MCU row
+    writeWord(out, 4);
+    writeWord(out, mcuColumns);
+
+    writeMarker(out, 0xDA);  // SOS
+    writeWord(out, 6 + 2 * numComponents);
+    out.push_back(static_cast<std::uint8_t>(numComponents));
+    for(int component = 0; component < numComponents; component++) {
+        out.push_back(static_cast<std::uint8_t>(component + 1));
+        out.push_back(component == 0 ? 0x00 : 0x11);
+    }
+    out.push_back(0);
+    out.push_back(63);
+    out.push_back(0);
+
+    // MCU rows are independent thanks to restart markers
+    std::vector<std::vector<std::uint8_t>> segments(mcuRows);
+    utility::parallelFor(0, mcuRows, numThreads, 1, [&](int begin, int end) {
+        for(int row = begin; row < end; row++) {
+            auto& segment = segments[row];
+            segment.reserve(static_cast<size_t>(width) * mcuSize / 4);
+            SegmentEncoder encoder(segment, scaling);
+            const int y = row * mcuSize;
+            for(int column = 0; column < mcuColumns; column++) {
+                const int x = column * mcuSize;
+                if(!color) {
+                    encoder.encodeBlock(luma, lumaStride, 1, width, height, x, y, 0);
+                    continue;
+                }
+                encoder.encodeBlock(luma, lumaStride, 1, width, height, x, y, 0);
+                encoder.encodeBlock(luma, lumaStride, 1, width, height, x + 8, y, 0);
+                encoder.encodeBlock(luma, lumaStride, 1, width, height, x, y + 8, 0);
+                encoder.encodeBlock(luma, lumaStride, 1, width, height, x + 8, y + 8, 0);
+                encoder.encodeBlock(chroma, chromaStride, 2, chromaWidth, chromaHeight, x / 2, y / 2, 1);
+                encoder.encodeBlock(chroma + 1, chromaStride, 2, chromaWidth, chromaHeight, x / 2, y / 2, 2);
+            }
+            encoder.flush();
+        }
+    });
+
+    size_t size = out.size() + 2;
+    for(const auto& segment : segments) size += segment.size() + 2;
+    out.reserve(size);
+    for(int row = 0; row < mcuRows; row++) {
+        if(row > 0) writeMarker(out, static_cast<std::uint8_t>(0xD0 + ((row - 1) & 7)));  // RSTn
+        out.insert(out.end(), segments[row].begin(), segments[row].end());
+    }
+    writeMarker(out, 0xD9);  // EOI
+    return out;
+}
+
+}  // namespace impl
+}  // namespace dai
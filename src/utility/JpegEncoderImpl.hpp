@@ -0,0 +1,56 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "depthai/pipeline/datatype/ImgFrame.hpp"
+
+namespace dai {
+namespace impl {
+
+/**
+ * Host implementation of the MJPEG profile of the VideoEncoder node.
+ * Encodes baseline JPEG images, 4:2:0 subsampled straight from the planes of NV12 frames or grayscale from 8 bit single plane frames.
+ * A restart marker ends each row of MCUs, so the rows are independent and are encoded in parallel.
+ */
+class JpegEncoder {
+   public:
+    /**
+     * @param quality Quality between 1 and 100, scales the standard quantization tables
+     * @param numThreads Number of worker threads, 0 for the number of hardware threads
+     */
+    explicit JpegEncoder(int quality = 80, unsigned numThreads = 0);
+
+    /**
+     * Set quality between 1 and 100, values outside are clamped
+     */
+    void setQuality(int quality);
+
+    /**
+     * Encode a frame
+     * @throws std::invalid_argument if the frame type isn't supported or its size doesn't match its data
+     */
+    std::vector<std::uint8_t> encode(const ImgFrame& frame) const;
+
+    /**
+     * Encode an image in NV12 layout
+     * @param luma Luma plane
+     * @param lumaStride Luma row stride in bytes
+     * @param chroma Interleaved chroma plane with half the luma resolution, nullptr for a grayscale image
+     * @param chromaStride Chroma row stride in bytes
+     * @param width Image width
+     * @param height Image height
+     */
+    std::vector<std::uint8_t> encode(const std::uint8_t* luma, int lumaStride, const std::uint8_t* chroma, int chromaStride, int width, int height) const;
+
+   private:
+    // Quantization tables in zigzag order, luma and chroma
+    std::array<std::array<std::uint8_t, 64>, 2> quantization;
+    // Reciprocals of quantization steps combined with the DCT output scaling, in natural order
+    std::array<std::array<float, 64>, 2> scaling;
+    unsigned numThreads;
+};
+
+}  // namespace impl
+}  // namespace dai
@@ -0,0 +1,217 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include "depthai/common/Point3fRGBA.hpp"
+
+namespace dai {
+namespace utility {
+
+/**
+ * Voxels of a map assembled from the points of its nodes, tracking the voxels added and removed since the changes were last taken.
+ * Adding or removing a node only touches the voxels of that node, whatever the size of the map.
+ */
+class VoxelMapDiff {
+   public:
+    explicit VoxelMapDiff(float cellSize) : cellSize(cellSize) {}
+
+    bool hasNode(int id) const {
+        return nodes.count(id) != 0;
+    }
+
+    /**
+     * Add the points of a node, replacing the ones it had
+     */
+    void addNode(int id, const std::vector<Point3fRGBA>& points) {
+        removeNode(id);
+        auto& keys = nodes[id];
+        for(const auto& point : points) {
+            const auto key = voxelKey(point);
+            auto& voxel = voxels[key];
+            // Voxels are counted once per node
+            if(voxel.lastNode == id && voxel.count > 0) continue;
+            voxel.lastNode = id;
+            if(voxel.count++ == 0 && !voxel.published) voxel.point = point;
+            touch(key, voxel);
+            keys.push_back(key);
+        }
+    }
+
+    void removeNode(int id) {
+        const auto node = nodes.find(id);
+        if(node == nodes.end()) return;
+        for(const auto key : node->second) {
+            auto& voxel = voxels.find(key)->second;
+            voxel.count--;
+            voxel.lastNode = -1;
+            touch(key, voxel);
+        }
+        nodes.erase(node);
+    }
+
+    /**
+     * Ids of the nodes in the map
+     */
+    std::vector<int> getNodes() const {
+        std::vector<int> ids;
+        ids.reserve(nodes.size());
+        for(const auto& node : nodes) ids.push_back(node.first);
+        return ids;
+    }
+
+    /**
+     * Append the voxels changed since the previous call to changes, added voxels as their first point and removed voxels as the point
+     * they were added with, with an alpha of 0
+     */
+    void takeChanges(std::vector<Point3fRGBA>& changes) {
+        for(const auto key : changed) {
+            const auto voxel = voxels.find(key);
+            voxel->second.changed = false;
+            if(voxel->second.count > 0 && !voxel->second.published) {
+                voxel->second.published = true;
+                changes.push_back(voxel->second.point);
+            } else if(voxel->second.count == 0 && voxel->second.published) {
+                changes.push_back(voxel->second.point);
+                changes.back().a = 0;
+            }
+            if(voxel->second.count == 0) voxels.erase(voxel);
+        }
+        changed.clear();
+    }
+
+    /**
+     * Mark all voxels as published, as when the full map was published
+     */
+    void markPublished() {
+        for(const auto key : changed) {
+            const auto voxel = voxels.find(key);
+            if(voxel->second.count == 0) {
+                voxels.erase(voxel);
+            } else {
+                voxel->second.published = true;
+                voxel->second.changed = false;
+            }
+        }
+        changed.clear();
+    }
+
+    void clear() {
+        voxels.clear();
+        nodes.clear();
+        changed.clear();
+    }
+
+    size_t size() const {
+        return voxels.size();
+    }
+
+   private:
+    struct Voxel {
+        Point3fRGBA point;
+        uint32_t count = 0;
+        int lastNode = -1;
+        bool published = false;
+        bool changed = false;
+    };
+
+    float cellSize;
+    std::unordered_map<uint64_t, Voxel> voxels;
+    std::unordered_map<int, std::vector<uint64_t>> nodes;
+    std::vector<uint64_t> changed;
+
+    void touch(uint64_t key, Voxel& voxel) {
+        if(voxel.changed) return;
+        voxel.changed = true;
+        changed.push_back(key);
+    }
+
+    // Packs the indices of the voxel holding a point into a key, 21 bits per axis
+    uint64_t voxelKey(const Point3fRGBA& point) const {
+        auto index = [this](float value) { return static_cast<uint64_t>(static_cast<int64_t>(std::floor(value / cellSize)) + (1 << 20)) & 0x1FFFFF; };
+        return index(point.x) | (index(point.y) << 21) | (index(point.z) << 42);
+    }
+};
+
+/**
+ * Tiles of a grid map changed since the previous map. Tiles are aligned to a fixed grid in world cells, so they keep their
+ * position when the bounds of the map change.
+ */
+class TileMapDiff {
+   public:
+    struct Rect {
+        int x = 0;
+        int y = 0;
+        int width = 0;
+        int height = 0;
+        bool operator==(const Rect& other) const {
+            return x == other.x && y == other.y && width == other.width && height == other.height;
+        }
+    };
+
+    explicit TileMapDiff(int tileSize) : tileSize(tileSize < 1 ? 1 : tileSize) {}
+
+    /**
+     * Compare a map with the previous one and keep it
+     * @param data Cells of the map, one byte each, rows of stride bytes
+     * @param originX World cell of the first column
+     * @param originY World cell of the first row
+     * @param changed Called with each changed tile, as a rectangle within the map
+     */
+    void update(const uint8_t* data, size_t stride, int width, int height, int originX, int originY, const std::function<void(const Rect&)>& changed) {
+        for(int tileY = floorDiv(originY, tileSize); tileY * tileSize < originY + height; tileY++) {
+            for(int tileX = floorDiv(originX, tileSize); tileX * tileSize < originX + width; tileX++) {
+                // Part of the tile covered by the map, in world cells
+                Rect area;
+                area.x = std::max(tileX * tileSize, originX);
+                area.y = std::max(tileY * tileSize, originY);
+                area.width = std::min((tileX + 1) * tileSize, originX + width) - area.x;
+                area.height = std::min((tileY + 1) * tileSize, originY + height) - area.y;
+                const Rect rect{area.x - originX, area.y - originY, area.width, area.height};
+
+                auto& tile = tiles[tileKey(tileX, tileY)];
+                bool same = tile.area == area;
+                for(int y = 0; same && y < rect.height; y++) {
+                    same = std::memcmp(tile.cells.data() + static_cast<size_t>(y) * rect.width, data + (rect.y + y) * stride + rect.x, rect.width) == 0;
+                }
+                if(same) continue;
+                tile.area = area;
+                tile.cells.resize(static_cast<size_t>(rect.width) * rect.height);
+                for(int y = 0; y < rect.height; y++) {
+                    std::memcpy(tile.cells.data() + static_cast<size_t>(y) * rect.width, data + (rect.y + y) * stride + rect.x, rect.width);
+                }
+                if(changed) changed(rect);
+            }
+        }
+    }
+
+    void clear() {
+        tiles.clear();
+    }
+
+   private:
+    struct Tile {
+        Rect area;
+        std::vector<uint8_t> cells;
+    };
+
+    int tileSize;
+    std::unordered_map<uint64_t, Tile> tiles;
+
+    static int floorDiv(int value, int divisor) {
+        return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+    }
+
+    static uint64_t tileKey(int x, int y) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+    }
+};
+
+}  // namespace utility
+}  // namespace dai
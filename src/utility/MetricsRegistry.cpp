@@ -0,0 +1,239 @@
+#include "depthai/utility/MetricsRegistry.hpp"
+
+// std
+#include <cmath>
+#include <stdexcept>
+
+// project
+#include "depthai/device/DeviceBase.hpp"
+#include "depthai/pipeline/MessageQueue.hpp"
+#include "utility/Logging.hpp"
+
+// libraries
+#include "httplib.h"
+#include "spdlog/fmt/fmt.h"
+
+namespace dai {
+
+namespace {
+
+std::atomic<bool> metricsEnabled{false};
+
+// Last dequeue by a node on this thread, used to measure node processing time
+thread_local std::int64_t lastDequeueNodeId = -1;
+thread_local std::chrono::steady_clock::time_point lastDequeueTime;
+
+std::string escapeLabelValue(const std::string& value) {
+    std::string escaped;
+    escaped.reserve(value.size());
+    for(char c : value) {
+        if(c == '\\') {
+            escaped += "\\\\";
+        } else if(c == '"') {
+            escaped += "\\\"";
+        } else if(c == '\n') {
+            escaped += "\\n";
+        } else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+// OpenMetrics spells non-finite values as NaN, +Inf and -Inf
+std::string formatValue(double value) {
+    if(std::isnan(value)) return "NaN";
+    if(std::isinf(value)) return value > 0 ? "+Inf" : "-Inf";
+    return fmt::format("{}", value);
+}
+
+}  // namespace
+
+struct MetricsRegistry::CollectorEntry {
+    Collector collector;
+    std::mutex runMtx;
+    bool removed = false;
+};
+
+struct MetricsRegistry::Server {
+    httplib::Server http;
+    std::thread thread;
+    int port = 0;
+};
+
+void MetricsRegistry::Writer::add(const std::string& name, const char* type, const std::string& help, const Labels& labels, double value) {
+    auto it = familyIndex.find(name);
+    if(it == familyIndex.end()) {
+        it = familyIndex.emplace(name, families.size()).first;
+        families.emplace_back(name, Family{type, help, {}});
+    }
+    auto& family = families[it->second].second;
+    if(family.type != type) {
+        throw std::invalid_argument(fmt::format("Metric family '{}' was already added as a {}", name, family.type));
+    }
+
+    std::string sample = name;
+    if(family.type == "counter") sample += "_total";
+    if(!labels.empty()) {
+        sample += "{";
+        for(size_t i = 0; i < labels.size(); i++) {
+            if(i > 0) sample += ",";
+            sample += labels[i].first + "=\"" + escapeLabelValue(labels[i].second) + "\"";
+        }
+        sample += "}";
+    }
+    sample += " " + formatValue(value);
+    family.samples.push_back(std::move(sample));
+}
+
+void MetricsRegistry::Writer::gauge(const std::string& name, const std::string& help, const Labels& labels, double value) {
+    add(name, "gauge", help, labels, value);
+}
+
+void MetricsRegistry::Writer::counter(const std::string& name, const std::string& help, const Labels& labels, double value) {
+    add(name, "counter", help, labels, value);
+}
+
+std::string MetricsRegistry::Writer::toString() const {
+    std::string text;
+    for(const auto& [name, family] : families) {
+        text += "# TYPE " + name + " " + family.type + "\n";
+        text += "# HELP " + name + " " + family.help + "\n";
+        for(const auto& sample : family.samples) {
+            text += sample + "\n";
+        }
+    }
+    text += "# EOF\n";
+    return text;
+}
+
+MetricsRegistry::MetricsRegistry() {
+    // XLink traffic of all devices
+    addCollector([](Writer& writer) {
+        auto data = DeviceBase::getGlobalProfilingData();
+        writer.counter("depthai_xlink_global_written_bytes", "Bytes written over XLink to all devices", {}, static_cast<double>(data.numBytesWritten));
+        writer.counter("depthai_xlink_global_read_bytes", "Bytes read over XLink from all devices", {}, static_cast<double>(data.numBytesRead));
+    });
+    // Messages in flight in all queues
+    addCollector([](Writer& writer) {
+        auto bytes = static_cast<double>(MessageQueue::getTotalBytes());
+        writer.gauge("depthai_queue_global_held_bytes", "Bytes held by payloads of messages in all queues", {}, bytes);
+    });
+}
+
+MetricsRegistry::~MetricsRegistry() {
+    stopServer();
+}
+
+MetricsRegistry& MetricsRegistry::getInstance() {
+    static MetricsRegistry instance;  // Guaranteed to be destroyed, instantiated on first use.
+    return instance;
+}
+
+void MetricsRegistry::setEnabled(bool enabled) {
+    metricsEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool MetricsRegistry::isEnabled() {
+    return metricsEnabled.load(std::memory_order_relaxed);
+}
+
+MetricsRegistry::CollectorId MetricsRegistry::addCollector(Collector collector) {
+    std::lock_guard<std::mutex> lock(collectorsMtx);
+    auto id = uniqueCollectorId++;
+    auto entry = std::make_shared<CollectorEntry>();
+    entry->collector = std::move(collector);
+    collectors[id] = std::move(entry);
+    return id;
+}
+
+bool MetricsRegistry::removeCollector(CollectorId id) {
+    std::shared_ptr<CollectorEntry> entry;
+    {
+        std::lock_guard<std::mutex> lock(collectorsMtx);
+        auto it = collectors.find(id);
+        if(it == collectors.end()) return false;
+        entry = std::move(it->second);
+        collectors.erase(it);
+    }
+    // Wait for a scrape running the collector, as it may reference the caller (eg. a closing device)
+    std::lock_guard<std::mutex> runLock(entry->runMtx);
+    entry->removed = true;
+    return true;
+}
+
+std::string MetricsRegistry::scrape() {
+    // Collectors can block (eg. RPCs to a device), so they run outside collectorsMtx to not stall adding and removing others
+    std::vector<std::pair<CollectorId, std::shared_ptr<CollectorEntry>>> toRun;
+    {
+        std::lock_guard<std::mutex> lock(collectorsMtx);
+        toRun.assign(collectors.begin(), collectors.end());
+    }
+
+    Writer writer;
+    for(auto& [id, entry] : toRun) {
+        std::lock_guard<std::mutex> runLock(entry->runMtx);
+        if(entry->removed) continue;
+        try {
+            entry->collector(writer);
+        } catch(const std::exception& ex) {
+            // A failing collector (eg. a disconnected device) shouldn't fail the whole scrape
+            logger::debug("Metrics collector {} failed: {}", id, ex.what());
+        }
+    }
+    return writer.toString();
+}
+
+int MetricsRegistry::startServer(const std::string& host, int port) {
+    std::lock_guard<std::mutex> lock(serverMtx);
+    if(server) {
+        throw std::runtime_error(fmt::format("Metrics server is already running on port {}", server->port));
+    }
+    auto newServer = std::make_unique<Server>();
+    newServer->http.Get("/metrics", [this](const httplib::Request&, httplib::Response& res) { res.set_content(scrape(), CONTENT_TYPE); });
+    if(port == 0) {
+        newServer->port = newServer->http.bind_to_any_port(host);
+    } else if(newServer->http.bind_to_port(host, port)) {
+        newServer->port = port;
+    } else {
+        newServer->port = -1;
+    }
+    if(newServer->port < 0) {
+        throw std::runtime_error(fmt::format("Couldn't bind metrics server to {}:{}", host, port));
+    }
+    setEnabled(true);
+    auto* http = &newServer->http;
+    newServer->thread = std::thread([http]() { http->listen_after_bind(); });
+    server = std::move(newServer);
+    logger::info("Serving metrics on http://{}:{}/metrics", host, server->port);
+    return server->port;
+}
+
+void MetricsRegistry::stopServer() {
+    std::unique_ptr<Server> oldServer;
+    {
+        std::lock_guard<std::mutex> lock(serverMtx);
+        std::swap(oldServer, server);
+    }
+    if(oldServer == nullptr) return;
+    oldServer->http.stop();
+    if(oldServer->thread.joinable()) oldServer->thread.join();
+}
+
+bool MetricsRegistry::isServerRunning() const {
+    std::lock_guard<std::mutex> lock(serverMtx);
+    return server != nullptr;
+}
+
+void MetricsRegistry::recordDequeue(std::int64_t nodeId) {
+    if(nodeId < 0) return;
+    lastDequeueNodeId = nodeId;
+    lastDequeueTime = std::chrono::steady_clock::now();
+}
+
+std::optional<std::chrono::nanoseconds> MetricsRegistry::getTimeSinceDequeue(std::int64_t nodeId) {
+    if(nodeId < 0 || lastDequeueNodeId != nodeId) return std::nullopt;
+    return std::chrono::steady_clock::now() - lastDequeueTime;
+}
+
+}  // namespace dai
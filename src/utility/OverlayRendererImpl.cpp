@@ -0,0 +1,371 @@
+#include "OverlayRendererImpl.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <initializer_list>
+#include <limits>
+#include <opencv2/imgproc.hpp>
+
+#include "utility/Simd.hpp"
+
+namespace dai {
+namespace impl {
+
+namespace {
+
+constexpr int FONT_FACE = cv::FONT_HERSHEY_SIMPLEX;
+constexpr size_t MAX_CACHED_GLYPHS = 4096;
+
+// Blending repeats a pattern of 24 channel values, a multiple of the 1, 2 and 3 channels of the supported planes
+using Pattern = std::array<std::uint8_t, 24>;
+
+Pattern makePattern(std::initializer_list<std::uint8_t> values) {
+    Pattern pattern{};
+    for(size_t i = 0; i < pattern.size(); i++) pattern[i] = values.begin()[i % values.size()];
+    return pattern;
+}
+
+std::uint8_t toByte(float value) {
+    return static_cast<std::uint8_t>(std::min(255.0f, std::max(0.0f, value)) + 0.5f);
+}
+
+// Coverage of a pixel whose center is at a signed distance from the edge of a shape, negative inside
+std::uint8_t toCoverage(float distance) {
+    return toByte((0.5f - distance) * 255.0f);
+}
+
+float distanceToSegment(float px, float py, Point2f a, Point2f b) {
+    const float abx = b.x - a.x, aby = b.y - a.y;
+    const float apx = px - a.x, apy = py - a.y;
+    const float lengthSquared = abx * abx + aby * aby;
+    const float t = lengthSquared > 0.0f ? std::min(1.0f, std::max(0.0f, (apx * abx + apy * aby) / lengthSquared)) : 0.0f;
+    const float dx = apx - abx * t, dy = apy - aby * t;
+    return std::sqrt(dx * dx + dy * dy);
+}
+
+// Pixel index of a coordinate, clamped to a range first so far off-canvas geometry can't overflow
+int toPixel(float value, int low, int high) {
+    return static_cast<int>(std::min(static_cast<float>(high), std::max(static_cast<float>(low), value)));
+}
+
+bool sameColor(const Color& a, const Color& b) {
+    return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+}
+
+/*
+ * Blends count bytes of dst towards the pattern values, weighted by the coverage of each byte and alpha.
+ * Weights are rounded to 0..256 so full coverage of an opaque color writes the exact value, and every path computes
+ * the same integers in 16 bit lanes.
+ */
+void blendBytes(std::uint8_t* dst, const std::uint8_t* coverage, std::uint8_t alpha, const Pattern& pattern, size_t count) {
+    size_t i = 0;
+#if defined(DEPTHAI_SIMD_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i alphas = _mm_set1_epi16(alpha);
+    const __m128i round = _mm_set1_epi16(128);
+    const __m128i full = _mm_set1_epi16(256);
+    __m128i values[3];
+    for(int k = 0; k < 3; k++) values[k] = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(pattern.data() + 8 * k)), zero);
+    for(int k = 0; i + 8 <= count; i += 8, k = (k + 1) % 3) {
+        const __m128i cov = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(coverage + i)), zero);
+        const __m128i pixels = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(dst + i)), zero);
+        __m128i weight = _mm_add_epi16(_mm_mullo_epi16(cov, alphas), round);
+        weight = _mm_srli_epi16(_mm_add_epi16(weight, _mm_srli_epi16(weight, 8)), 8);
+        weight = _mm_add_epi16(weight, _mm_srli_epi16(weight, 7));
+        __m128i blended = _mm_add_epi16(_mm_mullo_epi16(pixels, _mm_sub_epi16(full, weight)), _mm_mullo_epi16(values[k], weight));
+        blended = _mm_srli_epi16(_mm_add_epi16(blended, round), 8);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(blended, zero));
+    }
+#elif defined(DEPTHAI_SIMD_NEON)
+    const uint16x8_t alphas = vdupq_n_u16(alpha);
+    const uint16x8_t round = vdupq_n_u16(128);
+    const uint16x8_t full = vdupq_n_u16(256);
+    uint16x8_t values[3];
+    for(int k = 0; k < 3; k++) values[k] = vmovl_u8(vld1_u8(pattern.data() + 8 * k));
+    for(int k = 0; i + 8 <= count; i += 8, k = (k + 1) % 3) {
+        const uint16x8_t cov = vmovl_u8(vld1_u8(coverage + i));
+        const uint16x8_t pixels = vmovl_u8(vld1_u8(dst + i));
+        uint16x8_t weight = vmlaq_u16(round, cov, alphas);
+        weight = vshrq_n_u16(vaddq_u16(weight, vshrq_n_u16(weight, 8)), 8);
+        weight = vaddq_u16(weight, vshrq_n_u16(weight, 7));
+        uint16x8_t blended = vmlaq_u16(vmulq_u16(pixels, vsubq_u16(full, weight)), values[k], weight);
+        blended = vshrq_n_u16(vaddq_u16(blended, round), 8);
+        vst1_u8(dst + i, vmovn_u16(blended));
+    }
+#endif
+    for(; i < count; i++) {
+        unsigned weight = coverage[i] * alpha + 128u;
+        weight = (weight + (weight >> 8)) >> 8;
+        weight += weight >> 7;
+        dst[i] = static_cast<std::uint8_t>((dst[i] * (256u - weight) + pattern[i % pattern.size()] * weight + 128u) >> 8);
+    }
+}
+
+}  // namespace
+
+void OverlayRenderer::setCanvas(const Canvas& canvas) {
+    this->canvas = canvas;
+}
+
+bool OverlayRenderer::resetMask(float x0, float y0, float x1, float y1) {
+    // One extra pixel on each side holds the anti-aliased edge
+    const int left = toPixel(std::floor(x0 - 1.0f), 0, canvas.width);
+    const int top = toPixel(std::floor(y0 - 1.0f), 0, canvas.height);
+    const int right = toPixel(std::ceil(x1 + 1.0f), 0, canvas.width);
+    const int bottom = toPixel(std::ceil(y1 + 1.0f), 0, canvas.height);
+    if(canvas.data == nullptr || left >= right || top >= bottom) return false;
+    mask.x = left;
+    mask.y = top;
+    mask.width = right - left;
+    mask.height = bottom - top;
+    mask.coverage.assign(static_cast<size_t>(mask.width) * mask.height, 0);
+    return true;
+}
+
+void OverlayRenderer::addSegment(Point2f from, Point2f to, float halfThickness) {
+    const float extent = halfThickness + 1.0f;
+    const int left = toPixel(std::floor(std::min(from.x, to.x) - extent), mask.x, mask.x + mask.width);
+    const int top = toPixel(std::floor(std::min(from.y, to.y) - extent), mask.y, mask.y + mask.height);
+    const int right = toPixel(std::ceil(std::max(from.x, to.x) + extent), mask.x, mask.x + mask.width);
+    const int bottom = toPixel(std::ceil(std::max(from.y, to.y) + extent), mask.y, mask.y + mask.height);
+    for(int y = top; y < bottom; y++) {
+        std::uint8_t* row = mask.coverage.data() + static_cast<size_t>(y - mask.y) * mask.width - mask.x;
+        for(int x = left; x < right; x++) {
+            const auto coverage = toCoverage(distanceToSegment(x + 0.5f, y + 0.5f, from, to) - halfThickness);
+            row[x] = std::max(row[x], coverage);
+        }
+    }
+}
+
+void OverlayRenderer::blendMask(const Color& color) {
+    const std::uint8_t alpha = toByte(color.a * 255.0f);
+    if(alpha == 0 || mask.coverage.empty()) return;
+    const float r = color.r * 255.0f, g = color.g * 255.0f, b = color.b * 255.0f;
+    // Same studio range coefficients as ImageManip, matching the NV12 conversion of ImgFrame::getCvFrame
+    const std::uint8_t luma = toByte(0.257f * r + 0.504f * g + 0.098f * b + 16.0f);
+    const auto width = static_cast<size_t>(mask.width);
+
+    if(canvas.format == Format::BGR888i) {
+        const auto pattern = makePattern({toByte(b), toByte(g), toByte(r)});
+        chromaCoverage.resize(width * 3);
+        for(int y = 0; y < mask.height; y++) {
+            const std::uint8_t* coverage = mask.coverage.data() + y * width;
+            for(size_t x = 0; x < width; x++) {
+                chromaCoverage[3 * x] = chromaCoverage[3 * x + 1] = chromaCoverage[3 * x + 2] = coverage[x];
+            }
+            blendBytes(canvas.data + static_cast<size_t>(mask.y + y) * canvas.stride + mask.x * 3, chromaCoverage.data(), alpha, pattern, width * 3);
+        }
+        return;
+    }
+
+    const auto lumaPattern = makePattern({canvas.format == Format::GRAY8 ? toByte(0.299f * r + 0.587f * g + 0.114f * b) : luma});
+    for(int y = 0; y < mask.height; y++) {
+        blendBytes(canvas.data + static_cast<size_t>(mask.y + y) * canvas.stride + mask.x, mask.coverage.data() + y * width, alpha, lumaPattern, width);
+    }
+    if(canvas.format != Format::NV12 || canvas.chroma == nullptr) return;
+
+    // Each chroma sample is blended with the coverage of its 2x2 luma block, pixels outside of the mask cover nothing
+    const auto chromaPattern = makePattern({toByte(-0.148f * r - 0.291f * g + 0.439f * b + 128.0f), toByte(0.439f * r - 0.368f * g - 0.071f * b + 128.0f)});
+    const int left = mask.x / 2, right = (mask.x + mask.width + 1) / 2;
+    const int top = mask.y / 2, bottom = (mask.y + mask.height + 1) / 2;
+    chromaCoverage.resize(static_cast<size_t>(right - left) * 2);
+    auto lumaCoverage = [this](int x, int y) -> unsigned {
+        if(x < mask.x || y < mask.y || x >= mask.x + mask.width || y >= mask.y + mask.height) return 0;
+        return mask.coverage[static_cast<size_t>(y - mask.y) * mask.width + (x - mask.x)];
+    };
+    for(int cy = top; cy < bottom; cy++) {
+        for(int cx = left; cx < right; cx++) {
+            const unsigned sum = lumaCoverage(2 * cx, 2 * cy) + lumaCoverage(2 * cx + 1, 2 * cy) + lumaCoverage(2 * cx, 2 * cy + 1) + lumaCoverage(2 * cx + 1, 2 * cy + 1);
+            chromaCoverage[2 * (cx - left)] = chromaCoverage[2 * (cx - left) + 1] = static_cast<std::uint8_t>((sum + 2) / 4);
+        }
+        blendBytes(canvas.chroma + static_cast<size_t>(cy) * canvas.chromaStride + left * 2, chromaCoverage.data(), alpha, chromaPattern, chromaCoverage.size());
+    }
+}
+
+void OverlayRenderer::drawLine(Point2f from, Point2f to, float thickness, const Color& color) {
+    const float halfThickness = std::max(1.0f, thickness) / 2.0f;
+    if(!resetMask(std::min(from.x, to.x) - halfThickness, std::min(from.y, to.y) - halfThickness, std::max(from.x, to.x) + halfThickness,
+                  std::max(from.y, to.y) + halfThickness)) {
+        return;
+    }
+    addSegment(from, to, halfThickness);
+    blendMask(color);
+}
+
+void OverlayRenderer::drawPolyline(const std::vector<Point2f>& points, bool closed, float thickness, const Color& color, const std::vector<Color>& colors) {
+    if(points.empty()) return;
+    const float halfThickness = std::max(1.0f, thickness) / 2.0f;
+    const size_t numSegments = points.size() == 1 ? 1 : (closed ? points.size() : points.size() - 1);
+    auto segmentColor = [&](size_t i) -> const Color& { return i < colors.size() ? colors[i] : color; };
+
+    // Runs of segments with the same color share a mask, so their joints aren't blended twice
+    size_t start = 0;
+    while(start < numSegments) {
+        size_t end = start + 1;
+        while(end < numSegments && sameColor(segmentColor(end), segmentColor(start))) end++;
+        float x0 = points[start].x, y0 = points[start].y, x1 = x0, y1 = y0;
+        for(size_t i = start; i <= end; i++) {
+            const auto& point = points[i % points.size()];
+            x0 = std::min(x0, point.x);
+            y0 = std::min(y0, point.y);
+            x1 = std::max(x1, point.x);
+            y1 = std::max(y1, point.y);
+        }
+        if(resetMask(x0 - halfThickness, y0 - halfThickness, x1 + halfThickness, y1 + halfThickness)) {
+            for(size_t i = start; i < end; i++) addSegment(points[i], points[(i + 1) % points.size()], halfThickness);
+            blendMask(segmentColor(start));
+        }
+        start = end;
+    }
+}
+
+void OverlayRenderer::fillPolygon(const std::vector<Point2f>& points, const Color& color) {
+    if(points.size() < 3) return;
+    float x0 = points[0].x, y0 = points[0].y, x1 = x0, y1 = y0;
+    for(const auto& point : points) {
+        x0 = std::min(x0, point.x);
+        y0 = std::min(y0, point.y);
+        x1 = std::max(x1, point.x);
+        y1 = std::max(y1, point.y);
+    }
+    if(!resetMask(x0, y0, x1, y1)) return;
+    for(int y = 0; y < mask.height; y++) {
+        const float py = mask.y + y + 0.5f;
+        for(int x = 0; x < mask.width; x++) {
+            const float px = mask.x + x + 0.5f;
+            bool inside = false;
+            float distance = std::numeric_limits<float>::max();
+            for(size_t i = 0, j = points.size() - 1; i < points.size(); j = i++) {
+                const auto& a = points[i];
+                const auto& b = points[j];
+                if((a.y > py) != (b.y > py) && px < (b.x - a.x) * (py - a.y) / (b.y - a.y) + a.x) inside = !inside;
+                distance = std::min(distance, distanceToSegment(px, py, a, b));
+            }
+            mask.coverage[static_cast<size_t>(y) * mask.width + x] = toCoverage(inside ? -distance : distance);
+        }
+    }
+    blendMask(color);
+}
+
+void OverlayRenderer::drawCircle(Point2f center, float radius, float thickness, const Color& outlineColor, const Color& fillColor) {
+    const float halfThickness = std::max(1.0f, thickness) / 2.0f;
+    const float extent = radius + halfThickness;
+    auto rasterize = [&](bool outline) {
+        if(!resetMask(center.x - extent, center.y - extent, center.x + extent, center.y + extent)) return false;
+        for(int y = 0; y < mask.height; y++) {
+            const float dy = mask.y + y + 0.5f - center.y;
+            for(int x = 0; x < mask.width; x++) {
+                const float dx = mask.x + x + 0.5f - center.x;
+                const float distance = std::sqrt(dx * dx + dy * dy) - radius;
+                mask.coverage[static_cast<size_t>(y) * mask.width + x] = toCoverage(outline ? std::abs(distance) - halfThickness : distance);
+            }
+        }
+        return true;
+    };
+    if(fillColor.a > 0.0f && rasterize(false)) blendMask(fillColor);
+    if(outlineColor.a > 0.0f && rasterize(true)) blendMask(outlineColor);
+}
+
+void OverlayRenderer::fillRect(float x0, float y0, float x1, float y1, const Color& color) {
+    if(x1 <= x0 || y1 <= y0 || !resetMask(x0, y0, x1, y1)) return;
+    // Coverage is the area of each pixel inside the rectangle
+    auto overlap = [](int pixel, float from, float to) { return std::max(0.0f, std::min(pixel + 1.0f, to) - std::max(static_cast<float>(pixel), from)); };
+    for(int y = 0; y < mask.height; y++) {
+        const float rowCoverage = overlap(mask.y + y, y0, y1);
+        for(int x = 0; x < mask.width; x++) {
+            mask.coverage[static_cast<size_t>(y) * mask.width + x] = toByte(rowCoverage * overlap(mask.x + x, x0, x1) * 255.0f);
+        }
+    }
+    blendMask(color);
+}
+
+const OverlayRenderer::FontMetrics& OverlayRenderer::getFontMetrics(int pixelSize) {
+    auto found = fontMetrics.find(pixelSize);
+    if(found != fontMetrics.end()) return found->second;
+    const int thickness = std::max(1, (pixelSize + 8) / 16);
+    const double scale = cv::getFontScaleFromHeight(FONT_FACE, pixelSize, thickness);
+    int baseline = 0;
+    const auto size = cv::getTextSize("Ag", FONT_FACE, scale, thickness, &baseline);
+    FontMetrics metrics;
+    metrics.ascent = size.height;
+    metrics.descent = baseline;
+    metrics.padding = thickness + 1;
+    return fontMetrics.emplace(pixelSize, metrics).first->second;
+}
+
+const OverlayRenderer::Glyph& OverlayRenderer::getGlyph(char character, int pixelSize) {
+    auto found = glyphs.find({character, pixelSize});
+    if(found != glyphs.end()) return found->second;
+    if(glyphs.size() >= MAX_CACHED_GLYPHS) glyphs.clear();
+
+    const auto& metrics = getFontMetrics(pixelSize);
+    const int thickness = std::max(1, (pixelSize + 8) / 16);
+    const double scale = cv::getFontScaleFromHeight(FONT_FACE, pixelSize, thickness);
+    const std::string single(1, character);
+    int baseline = 0;
+    // Text width includes the stroke once, the difference to a doubled glyph is its advance
+    const int width = cv::getTextSize(single, FONT_FACE, scale, thickness, &baseline).width;
+    const int advance = cv::getTextSize(std::string(2, character), FONT_FACE, scale, thickness, &baseline).width - width;
+
+    Glyph glyph;
+    glyph.width = width + 2 * metrics.padding;
+    glyph.height = metrics.ascent + metrics.descent + 2 * metrics.padding;
+    glyph.left = -metrics.padding;
+    glyph.top = -metrics.ascent - metrics.padding;
+    glyph.advance = advance;
+    cv::Mat rendered = cv::Mat::zeros(glyph.height, glyph.width, CV_8UC1);
+    cv::putText(rendered, single, cv::Point(metrics.padding, metrics.padding + metrics.ascent), FONT_FACE, scale, cv::Scalar(255), thickness, cv::LINE_AA);
+    glyph.coverage.assign(rendered.datastart, rendered.dataend);
+    return glyphs.emplace(std::make_pair(character, pixelSize), std::move(glyph)).first->second;
+}
+
+OverlayRenderer::TextBox OverlayRenderer::measureText(const std::string& text, float fontSize) {
+    const int pixelSize = std::max(1, static_cast<int>(std::lround(fontSize)));
+    const auto& metrics = getFontMetrics(pixelSize);
+    TextBox box;
+    for(char character : text) {
+        const auto code = static_cast<unsigned char>(character);
+        box.width += getGlyph(code < 32 || code > 126 ? '?' : character, pixelSize).advance;
+    }
+    box.width += 2 * metrics.padding;
+    box.height = metrics.ascent + metrics.descent + 2 * metrics.padding;
+    box.originX = metrics.padding;
+    box.originY = metrics.ascent + metrics.padding;
+    return box;
+}
+
+void OverlayRenderer::drawText(Point2f origin, const std::string& text, float fontSize, const Color& textColor, const Color& backgroundColor) {
+    if(text.empty()) return;
+    const int pixelSize = std::max(1, static_cast<int>(std::lround(fontSize)));
+    const int x = static_cast<int>(std::lround(origin.x));
+    const int y = static_cast<int>(std::lround(origin.y));
+    const auto box = measureText(text, fontSize);
+    const auto left = static_cast<float>(x - box.originX);
+    const auto top = static_cast<float>(y - box.originY);
+    if(backgroundColor.a > 0.0f) fillRect(left, top, left + box.width, top + box.height, backgroundColor);
+    if(textColor.a <= 0.0f || !resetMask(left, top, left + box.width, top + box.height)) return;
+
+    int pen = x;
+    for(char character : text) {
+        const auto code = static_cast<unsigned char>(character);
+        const auto& glyph = getGlyph(code < 32 || code > 126 ? '?' : character, pixelSize);
+        const int glyphX = pen + glyph.left - mask.x;
+        const int glyphY = y + glyph.top - mask.y;
+        for(int gy = std::max(0, -glyphY); gy < glyph.height && glyphY + gy < mask.height; gy++) {
+            const std::uint8_t* in = glyph.coverage.data() + static_cast<size_t>(gy) * glyph.width;
+            std::uint8_t* out = mask.coverage.data() + static_cast<size_t>(glyphY + gy) * mask.width;
+            for(int gx = std::max(0, -glyphX); gx < glyph.width && glyphX + gx < mask.width; gx++) {
+                out[glyphX + gx] = std::max(out[glyphX + gx], in[gx]);
+            }
+        }
+        pen += glyph.advance;
+    }
+    blendMask(textColor);
+}
+
+size_t OverlayRenderer::getGlyphCacheSize() const {
+    return glyphs.size();
+}
+
+}  // namespace impl
+}  // namespace dai
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "depthai/common/Color.hpp"
+#include "depthai/common/Point2f.hpp"
+
+namespace dai {
+namespace impl {
+
+/**
+ * Anti-aliased CPU renderer of overlay primitives, drawing directly into GRAY8, NV12 or BGR888i planes.
+ * Each primitive is rasterized into a coverage mask of its bounding box, from the distance of pixel centers to its edges,
+ * and the mask is then blended into the planes. NV12 chroma is blended with the average coverage of each 2x2 block.
+ * Rendering uses only integer blending after rasterization, so the output is reproducible for golden image tests.
+ * All coordinates and sizes are in pixels.
+ */
+class OverlayRenderer {
+   public:
+    enum class Format { GRAY8, NV12, BGR888i };
+
+    struct Canvas {
+        Format format = Format::NV12;
+        std::uint8_t* data = nullptr;
+        int stride = 0;
+        // Interleaved UV plane of NV12 canvases
+        std::uint8_t* chroma = nullptr;
+        int chromaStride = 0;
+        int width = 0;
+        int height = 0;
+    };
+
+    /**
+     * Set the planes drawn into by the following calls
+     */
+    void setCanvas(const Canvas& canvas);
+
+    void drawLine(Point2f from, Point2f to, float thickness, const Color& color);
+
+    /**
+     * Draw connected segments, joints of segments of the same color are blended once
+     * @param colors Color of each segment, starting at the corresponding point. Empty to draw all segments with color
+     */
+    void drawPolyline(const std::vector<Point2f>& points, bool closed, float thickness, const Color& color, const std::vector<Color>& colors = {});
+
+    /**
+     * Fill a polygon with the even-odd rule
+     */
+    void fillPolygon(const std::vector<Point2f>& points, const Color& color);
+
+    void drawCircle(Point2f center, float radius, float thickness, const Color& outlineColor, const Color& fillColor);
+
+    void fillRect(float x0, float y0, float x1, float y1, const Color& color);
+
+    /**
+     * Draw a single line of text
+     * @param origin Bottom left corner of the text on its baseline, rounded to whole pixels
+     * @param fontSize Height of the text line in pixels
+     * @param backgroundColor Color of the box behind the text, transparent to leave it out
+     */
+    void drawText(Point2f origin, const std::string& text, float fontSize, const Color& textColor, const Color& backgroundColor);
+
+    struct TextBox {
+        int width = 0;
+        int height = 0;
+        // Offset of the text origin from the top left corner of the box
+        int originX = 0;
+        int originY = 0;
+    };
+
+    /**
+     * Measure the box drawn behind a text
+     */
+    TextBox measureText(const std::string& text, float fontSize);
+
+    /**
+     * Number of rasterized glyphs kept for reuse
+     */
+    size_t getGlyphCacheSize() const;
+
+   private:
+    struct Glyph {
+        std::vector<std::uint8_t> coverage;
+        int width = 0;
+        int height = 0;
+        // Position of the top left corner of the mask relative to the pen position on the baseline
+        int left = 0;
+        int top = 0;
+        int advance = 0;
+    };
+    struct FontMetrics {
+        int ascent = 0;
+        int descent = 0;
+        int padding = 0;
+    };
+
+    // Coverage of the current primitive over its clipped bounding box
+    struct Mask {
+        int x = 0;
+        int y = 0;
+        int width = 0;
+        int height = 0;
+        std::vector<std::uint8_t> coverage;
+    };
+
+    bool resetMask(float x0, float y0, float x1, float y1);
+    void addSegment(Point2f from, Point2f to, float halfThickness);
+    void blendMask(const Color& color);
+
+    const Glyph& getGlyph(char character, int pixelSize);
+    const FontMetrics& getFontMetrics(int pixelSize);
+
+    Canvas canvas;
+    Mask mask;
+    std::vector<std::uint8_t> chromaCoverage;
+    std::map<std::pair<char, int>, Glyph> glyphs;
+    std::map<int, FontMetrics> fontMetrics;
+};
+
+}  // namespace impl
+}  // namespace dai
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <future>
+#include <vector>
+
+namespace dai {
+namespace utility {
+
+/**
+ * Splits range [begin, end) into contiguous chunks and processes them in parallel.
+ * The calling thread processes the first chunk. Returns once all chunks are processed.
+ *
+ * @param begin Start of the range
+ * @param end End of the range (exclusive)
+ * @param numThreads Maximum number of threads to use, including the calling one
+ * @param minChunk Minimum chunk size, so small ranges aren't split
+ * @param fn Function called with bounds [chunkBegin, chunkEnd) of each chunk
+ */
+inline void parallelFor(int begin, int end, unsigned numThreads, int minChunk, const std::function<void(int, int)>& fn) {
+    const int count = end - begin;
+    if(count <= 0) return;
+    const int chunks = std::max(1, std::min(static_cast<int>(numThreads), (count + minChunk - 1) / std::max(1, minChunk)));
+    const int chunkSize = (count + chunks - 1) / chunks;
+    std::vector<std::future<void>> futures;
+    for(int start = begin + chunkSize; start < end; start += chunkSize) {
+        futures.push_back(std::async(std::launch::async, fn, start, std::min(end, start + chunkSize)));
+    }
+    fn(begin, std::min(end, begin + chunkSize));
+    for(auto& future : futures) future.get();
+}
+
+}  // namespace utility
+}  // namespace dai
@@ -170,6 +170,7 @@ bool deserializationSupported(DatatypeEnum datatype) {
         case DatatypeEnum::DynamicCalibrationResult:
         case DatatypeEnum::CalibrationQuality:
         case DatatypeEnum::CoverageData:
+        case DatatypeEnum::IMUBatch:
             return false;
     }
     return false;
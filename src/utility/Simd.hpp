@@ -0,0 +1,11 @@
+#pragma once
+
+// Vector instructions available on the target. Vectorized code paths of host nodes are selected with these macros
+// and always keep a scalar fallback, which also handles the remainder of rows.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define DEPTHAI_SIMD_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define DEPTHAI_SIMD_NEON
+#endif
@@ -0,0 +1,120 @@
+#include "utility/SpatialLocationCalculatorImpl.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace dai {
+namespace impl {
+
+void SpatialLocationCalculator::setDepth(
+    const std::uint8_t* data, int width, int height, int stride, const SpatialLocationCalculatorConfigThresholds& thresholds) {
+    this->data = data;
+    this->width = width;
+    this->height = height;
+    this->stride = stride;
+    this->thresholds = thresholds;
+    integralsValid = false;
+}
+
+std::uint16_t SpatialLocationCalculator::at(int x, int y) const {
+    std::uint16_t value;
+    std::memcpy(&value, data + static_cast<std::size_t>(y) * stride + static_cast<std::size_t>(x) * sizeof(value), sizeof(value));
+    return value;
+}
+
+bool SpatialLocationCalculator::isValid(std::uint16_t value) const {
+    return value > thresholds.lowerThreshold && value < thresholds.upperThreshold;
+}
+
+void SpatialLocationCalculator::buildIntegrals() {
+    const std::size_t columns = static_cast<std::size_t>(width) + 1;
+    sums.assign(columns * (height + 1), 0);
+    counts.assign(columns * (height + 1), 0);
+    for(int y = 0; y < height; y++) {
+        std::uint64_t rowSum = 0;
+        std::uint32_t rowCount = 0;
+        const std::size_t above = y * columns;
+        const std::size_t row = above + columns;
+        for(int x = 0; x < width; x++) {
+            const auto value = at(x, y);
+            if(isValid(value)) {
+                rowSum += value;
+                rowCount++;
+            }
+            sums[row + x + 1] = sums[above + x + 1] + rowSum;
+            counts[row + x + 1] = counts[above + x + 1] + rowCount;
+        }
+    }
+    integralsValid = true;
+}
+
+float SpatialLocationCalculator::calculate(Region region, SpatialLocationCalculatorAlgorithm algorithm, int stepSize) {
+    region.xmin = std::max(region.xmin, 0);
+    region.ymin = std::max(region.ymin, 0);
+    region.xmax = std::min(region.xmax, width);
+    region.ymax = std::min(region.ymax, height);
+    if(data == nullptr || region.xmin >= region.xmax || region.ymin >= region.ymax) return 0.0f;
+
+    const bool sampled = algorithm == SpatialLocationCalculatorAlgorithm::MODE || algorithm == SpatialLocationCalculatorAlgorithm::MEDIAN;
+    if(stepSize == SpatialLocationCalculatorConfigData::AUTO) stepSize = sampled ? 2 : 1;
+    stepSize = std::max(stepSize, 1);
+
+    if(algorithm == SpatialLocationCalculatorAlgorithm::AVERAGE && stepSize == 1) {
+        if(!integralsValid) buildIntegrals();
+        const std::size_t columns = static_cast<std::size_t>(width) + 1;
+        const std::size_t topLeft = region.ymin * columns + region.xmin;
+        const std::size_t topRight = region.ymin * columns + region.xmax;
+        const std::size_t bottomLeft = region.ymax * columns + region.xmin;
+        const std::size_t bottomRight = region.ymax * columns + region.xmax;
+        const auto count = counts[bottomRight] - counts[topRight] - counts[bottomLeft] + counts[topLeft];
+        if(count == 0) return 0.0f;
+        const auto sum = sums[bottomRight] - sums[topRight] - sums[bottomLeft] + sums[topLeft];
+        return static_cast<float>(static_cast<double>(sum) / count);
+    }
+
+    samples.clear();
+    for(int y = region.ymin; y < region.ymax; y += stepSize) {
+        for(int x = region.xmin; x < region.xmax; x += stepSize) {
+            const auto value = at(x, y);
+            if(isValid(value)) samples.push_back(value);
+        }
+    }
+    if(samples.empty()) return 0.0f;
+
+    switch(algorithm) {
+        case SpatialLocationCalculatorAlgorithm::AVERAGE: {
+            std::uint64_t sum = 0;
+            for(auto value : samples) sum += value;
+            return static_cast<float>(static_cast<double>(sum) / samples.size());
+        }
+        case SpatialLocationCalculatorAlgorithm::MIN:
+            return *std::min_element(samples.begin(), samples.end());
+        case SpatialLocationCalculatorAlgorithm::MAX:
+            return *std::max_element(samples.begin(), samples.end());
+        case SpatialLocationCalculatorAlgorithm::MODE: {
+            // Only the counted bins are cleared afterwards, so the histogram stays zeroed between regions
+            histogram.resize(std::numeric_limits<std::uint16_t>::max() + 1, 0);
+            std::uint16_t mode = samples.front();
+            std::uint32_t modeCount = 0;
+            for(auto value : samples) {
+                const auto count = ++histogram[value];
+                if(count > modeCount || (count == modeCount && value < mode)) {
+                    mode = value;
+                    modeCount = count;
+                }
+            }
+            for(auto value : samples) histogram[value] = 0;
+            return mode;
+        }
+        case SpatialLocationCalculatorAlgorithm::MEDIAN: {
+            const auto middle = samples.begin() + samples.size() / 2;
+            std::nth_element(samples.begin(), middle, samples.end());
+            return *middle;
+        }
+    }
+    return 0.0f;
+}
+
+}  // namespace impl
+}  // namespace dai
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "depthai/pipeline/datatype/SpatialLocationCalculatorConfig.hpp"
+
+namespace dai {
+namespace impl {
+
+/**
+ * Reduces regions of a 16 bit depth frame to a single depth, as the device spatial location calculator does.
+ * Averages with step size 1 come from integral images of the valid pixels, built once per frame, so each region costs
+ * four lookups. Other algorithms gather the samples of a region into reused buffers, MODE counts them in a histogram.
+ */
+class SpatialLocationCalculator {
+   public:
+    /**
+     * Region in pixels, maximum coordinates exclusive
+     */
+    struct Region {
+        int xmin = 0;
+        int ymin = 0;
+        int xmax = 0;
+        int ymax = 0;
+    };
+
+    /**
+     * Set the depth frame used by the following calls, it has to outlive them
+     * @param stride Distance in bytes between the rows
+     */
+    void setDepth(const std::uint8_t* data, int width, int height, int stride, const SpatialLocationCalculatorConfigThresholds& thresholds);
+
+    /**
+     * Depth of a region, 0 if it holds no pixels within the thresholds. The region is clipped to the frame.
+     * @param stepSize Step between the sampled pixels, SpatialLocationCalculatorConfigData::AUTO for the device default of the algorithm
+     */
+    float calculate(Region region, SpatialLocationCalculatorAlgorithm algorithm, int stepSize);
+
+   private:
+    std::uint16_t at(int x, int y) const;
+    bool isValid(std::uint16_t value) const;
+    void buildIntegrals();
+
+    const std::uint8_t* data = nullptr;
+    int width = 0;
+    int height = 0;
+    int stride = 0;
+    SpatialLocationCalculatorConfigThresholds thresholds;
+
+    // Sums and counts of valid pixels above and left of each pixel, (width + 1) x (height + 1)
+    bool integralsValid = false;
+    std::vector<std::uint64_t> sums;
+    std::vector<std::uint32_t> counts;
+
+    std::vector<std::uint16_t> samples;
+    std::vector<std::uint32_t> histogram;
+};
+
+}  // namespace impl
+}  // namespace dai
@@ -0,0 +1,411 @@
+#include "WarpImpl.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+
+#include "utility/ParallelFor.hpp"
+#include "utility/Simd.hpp"
+
+namespace dai {
+namespace impl {
+
+namespace {
+
+// Fractional bits of remap coordinates and interpolation weights
+constexpr int FRACTION_BITS = 8;
+constexpr std::int32_t FIXED_ONE = 1 << FRACTION_BITS;
+constexpr std::int32_t ROUNDING = 1 << (2 * FRACTION_BITS - 1);
+
+// Number of horizontal and vertical source pixels per plane pixel
+int getSubsampling(ImgFrame::Type type, size_t plane) {
+    return type == ImgFrame::Type::NV12 && plane > 0 ? 2 : 1;
+}
+
+int ceilDiv(int value, int divisor) {
+    return (value + divisor - 1) / divisor;
+}
+
+#if defined(DEPTHAI_SIMD_SSE2) || defined(DEPTHAI_SIMD_NEON)
+// Interpolated rows of a pixel, at most 255 * FIXED_ONE, are kept in 16 bit lanes
+static_assert(FRACTION_BITS <= 8, "Interpolated rows must fit 16 bits");
+
+// Output pixels interpolated at once
+constexpr int VECTOR_PIXELS = 8;
+
+// Horizontal neighbors of a source pixel in the low and high byte, adjacent ones of single channel planes are loaded at once
+inline std::uint16_t neighborPair(const std::uint8_t* p, std::int32_t stepX) {
+    if(stepX == 1) {
+        std::uint16_t pair;
+        std::memcpy(&pair, p, sizeof(pair));
+        return pair;
+    }
+    return static_cast<std::uint16_t>(p[0] | (p[stepX] << 8));
+}
+#endif
+
+#if defined(DEPTHAI_SIMD_SSE2)
+// Remap offsets are arbitrary, so pixels are gathered one at a time. Lanes are filled in registers,
+// going through a stack buffer stalls on store forwarding and is slower than the scalar loop.
+__m128i gatherPairs(const std::uint8_t* base, const std::int32_t* offsets, std::int32_t stepX) {
+    auto pair = [&](int i) { return static_cast<short>(neighborPair(base + offsets[i], stepX)); };
+    return _mm_setr_epi16(pair(0), pair(1), pair(2), pair(3), pair(4), pair(5), pair(6), pair(7));
+}
+
+// Same fixed point interpolation as the scalar loop, the vertical pass is widened to 32 bits from the low and high halves of the products
+void interpolate(__m128i topPairs, __m128i bottomPairs, const std::uint16_t* weightsX, const std::uint16_t* weightsY, std::uint8_t* result) {
+    const __m128i one = _mm_set1_epi16(FIXED_ONE);
+    const __m128i lowBytes = _mm_set1_epi16(0xff);
+    const __m128i wx = _mm_loadu_si128(reinterpret_cast<const __m128i*>(weightsX));
+    const __m128i wy = _mm_loadu_si128(reinterpret_cast<const __m128i*>(weightsY));
+    const __m128i inverseX = _mm_sub_epi16(one, wx);
+    const __m128i inverseY = _mm_sub_epi16(one, wy);
+    const __m128i top = _mm_add_epi16(_mm_mullo_epi16(_mm_and_si128(topPairs, lowBytes), inverseX), _mm_mullo_epi16(_mm_srli_epi16(topPairs, 8), wx));
+    const __m128i bottom =
+        _mm_add_epi16(_mm_mullo_epi16(_mm_and_si128(bottomPairs, lowBytes), inverseX), _mm_mullo_epi16(_mm_srli_epi16(bottomPairs, 8), wx));
+    const __m128i topLow = _mm_mullo_epi16(top, inverseY);
+    const __m128i topHigh = _mm_mulhi_epu16(top, inverseY);
+    const __m128i bottomLow = _mm_mullo_epi16(bottom, wy);
+    const __m128i bottomHigh = _mm_mulhi_epu16(bottom, wy);
+    const __m128i rounding = _mm_set1_epi32(ROUNDING);
+    __m128i first = _mm_add_epi32(_mm_add_epi32(_mm_unpacklo_epi16(topLow, topHigh), _mm_unpacklo_epi16(bottomLow, bottomHigh)), rounding);
+    __m128i second = _mm_add_epi32(_mm_add_epi32(_mm_unpackhi_epi16(topLow, topHigh), _mm_unpackhi_epi16(bottomLow, bottomHigh)), rounding);
+    first = _mm_srli_epi32(first, 2 * FRACTION_BITS);
+    second = _mm_srli_epi32(second, 2 * FRACTION_BITS);
+    const __m128i pixels = _mm_packs_epi32(first, second);
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(result), _mm_packus_epi16(pixels, pixels));
+}
+#elif defined(DEPTHAI_SIMD_NEON)
+// Remap offsets are arbitrary, so pixels are gathered one at a time straight into the lanes
+uint16x8_t gatherPairs(const std::uint8_t* base, const std::int32_t* offsets, std::int32_t stepX) {
+    uint16x8_t pairs = vdupq_n_u16(neighborPair(base + offsets[0], stepX));
+    pairs = vsetq_lane_u16(neighborPair(base + offsets[1], stepX), pairs, 1);
+    pairs = vsetq_lane_u16(neighborPair(base + offsets[2], stepX), pairs, 2);
+    pairs = vsetq_lane_u16(neighborPair(base + offsets[3], stepX), pairs, 3);
+    pairs = vsetq_lane_u16(neighborPair(base + offsets[4], stepX), pairs, 4);
+    pairs = vsetq_lane_u16(neighborPair(base + offsets[5], stepX), pairs, 5);
+    pairs = vsetq_lane_u16(neighborPair(base + offsets[6], stepX), pairs, 6);
+    pairs = vsetq_lane_u16(neighborPair(base + offsets[7], stepX), pairs, 7);
+    return pairs;
+}
+
+// Same fixed point interpolation as the scalar loop, the rounding shift adds ROUNDING before narrowing
+void interpolate(uint16x8_t topPairs, uint16x8_t bottomPairs, const std::uint16_t* weightsX, const std::uint16_t* weightsY, std::uint8_t* result) {
+    const uint16x8_t one = vdupq_n_u16(FIXED_ONE);
+    const uint16x8_t lowBytes = vdupq_n_u16(0xff);
+    const uint16x8_t wx = vld1q_u16(weightsX);
+    const uint16x8_t wy = vld1q_u16(weightsY);
+    const uint16x8_t inverseX = vsubq_u16(one, wx);
+    const uint16x8_t inverseY = vsubq_u16(one, wy);
+    const uint16x8_t top = vmlaq_u16(vmulq_u16(vandq_u16(topPairs, lowBytes), inverseX), vshrq_n_u16(topPairs, 8), wx);
+    const uint16x8_t bottom = vmlaq_u16(vmulq_u16(vandq_u16(bottomPairs, lowBytes), inverseX), vshrq_n_u16(bottomPairs, 8), wx);
+    const uint32x4_t first = vmlal_u16(vmull_u16(vget_low_u16(top), vget_low_u16(inverseY)), vget_low_u16(bottom), vget_low_u16(wy));
+    const uint32x4_t second = vmlal_u16(vmull_u16(vget_high_u16(top), vget_high_u16(inverseY)), vget_high_u16(bottom), vget_high_u16(wy));
+    const uint16x8_t pixels = vcombine_u16(vrshrn_n_u32(first, 2 * FRACTION_BITS), vrshrn_n_u32(second, 2 * FRACTION_BITS));
+    vst1_u8(result, vmovn_u16(pixels));
+}
+#endif
+
+}  // namespace
+
+bool MeshWarp::Layout::operator==(const Layout& other) const {
+    return type == other.type && srcWidth == other.srcWidth && srcHeight == other.srcHeight && srcStride == other.srcStride && dstWidth == other.dstWidth
+           && dstHeight == other.dstHeight;
+}
+
+MeshWarp::MeshWarp(unsigned numThreads) : numThreads(numThreads == 0 ? std::max(1U, std::thread::hardware_concurrency()) : numThreads) {}
+
+void MeshWarp::setMesh(std::vector<Point2f> mesh, int meshWidth, int meshHeight) {
+    if(!mesh.empty()) {
+        if(meshWidth < 2 || meshHeight < 2) {
+            throw std::invalid_argument("Warp mesh must have at least 2x2 points");
+        }
+        if(mesh.size() < static_cast<size_t>(meshWidth) * meshHeight) {
+            throw std::invalid_argument("Not enough points provided for specified width and height");
+        }
+    }
+    this->mesh = std::move(mesh);
+    this->meshWidth = meshWidth;
+    this->meshHeight = meshHeight;
+    tablesValid = false;
+}
+
+void MeshWarp::setOutputSize(int width, int height) {
+    if(width != outputWidth || height != outputHeight) tablesValid = false;
+    outputWidth = width;
+    outputHeight = height;
+}
+
+void MeshWarp::setInterpolation(Interpolation interpolation) {
+    const bool nearestNeighbor = interpolation == Interpolation::NEAREST_NEIGHBOR;
+    if(nearestNeighbor != nearest) tablesValid = false;
+    nearest = nearestNeighbor;
+}
+
+std::vector<Point2f> MeshWarp::getMesh(int srcWidth, int srcHeight) const {
+    if(!mesh.empty()) return mesh;
+    const auto width = static_cast<float>(srcWidth);
+    const auto height = static_cast<float>(srcHeight);
+    return {Point2f(0, 0), Point2f(width, 0), Point2f(0, height), Point2f(width, height)};
+}
+
+MeshWarp::RemapTable MeshWarp::computeTable(int srcWidth, int srcHeight, int srcStride, int pixelStep, int dstWidth, int dstHeight, int subsampling) const {
+    const auto points = getMesh(srcWidth, srcHeight);
+    const int columns = mesh.empty() ? 2 : meshWidth;
+    const int rows = mesh.empty() ? 2 : meshHeight;
+    const int planeSrcWidth = ceilDiv(srcWidth, subsampling);
+    const int planeSrcHeight = ceilDiv(srcHeight, subsampling);
+    const int width = ceilDiv(dstWidth, subsampling);
+    const int height = ceilDiv(dstHeight, subsampling);
+
+    RemapTable table;
+    table.offsets.resize(static_cast<size_t>(width) * height);
+    table.weightsX.resize(table.offsets.size());
+    table.weightsY.resize(table.offsets.size());
+    table.stepX = planeSrcWidth > 1 ? pixelStep : 0;
+    table.stepY = planeSrcHeight > 1 ? srcStride : 0;
+
+    // Fixed point coordinate of a plane pixel, kept one pixel off the far border so its neighbor is within the plane too
+    auto toFixed = [this](float coordinate, int size, std::int32_t& index, std::uint16_t& weight) {
+        const float clamped = std::min(std::max(coordinate, 0.f), static_cast<float>(size - 1));
+        const auto fixed = static_cast<std::int32_t>(nearest ? std::lround(clamped) * FIXED_ONE : std::lround(clamped * FIXED_ONE));
+        index = fixed >> FRACTION_BITS;
+        weight = static_cast<std::uint16_t>(fixed & (FIXED_ONE - 1));
+        if(index >= size - 1) {
+            index = std::max(0, size - 2);
+            weight = static_cast<std::uint16_t>(size > 1 ? FIXED_ONE : 0);
+        }
+    };
+
+    const float meshScaleX = static_cast<float>(columns - 1) / static_cast<float>(dstWidth);
+    const float meshScaleY = static_cast<float>(rows - 1) / static_cast<float>(dstHeight);
+    utility::parallelFor(0, height, numThreads, 16, [&](int begin, int end) {
+        for(int y = begin; y < end; y++) {
+            const float meshY = std::min((static_cast<float>(y) + 0.5f) * static_cast<float>(subsampling) * meshScaleY, static_cast<float>(rows - 1));
+            const int row = std::min(static_cast<int>(meshY), rows - 2);
+            const float ty = meshY - static_cast<float>(row);
+            for(int x = 0; x < width; x++) {
+                const float meshX = std::min((static_cast<float>(x) + 0.5f) * static_cast<float>(subsampling) * meshScaleX, static_cast<float>(columns - 1));
+                const int column = std::min(static_cast<int>(meshX), columns - 2);
+                const float tx = meshX - static_cast<float>(column);
+                const Point2f& p00 = points[row * columns + column];
+                const Point2f& p01 = points[row * columns + column + 1];
+                const Point2f& p10 = points[(row + 1) * columns + column];
+                const Point2f& p11 = points[(row + 1) * columns + column + 1];
+                const float sourceX = (1 - ty) * ((1 - tx) * p00.x + tx * p01.x) + ty * ((1 - tx) * p10.x + tx * p11.x);
+                const float sourceY = (1 - ty) * ((1 - tx) * p00.y + tx * p01.y) + ty * ((1 - tx) * p10.y + tx * p11.y);
+
+                // Mesh coordinates address pixel edges, table ones pixel centers
+                const size_t i = static_cast<size_t>(y) * width + x;
+                std::int32_t x0 = 0, y0 = 0;
+                toFixed(sourceX / static_cast<float>(subsampling) - 0.5f, planeSrcWidth, x0, table.weightsX[i]);
+                toFixed(sourceY / static_cast<float>(subsampling) - 0.5f, planeSrcHeight, y0, table.weightsY[i]);
+                table.offsets[i] = y0 * srcStride + x0 * pixelStep;
+            }
+        }
+    });
+    return table;
+}
+
+std::shared_ptr<ImgFrame> MeshWarp::process(const ImgFrame& frame) {
+    const auto type = frame.getType();
+    int pixelStep = 1;
+    switch(type) {
+        case ImgFrame::Type::GRAY8:
+        case ImgFrame::Type::RAW8:
+        case ImgFrame::Type::YUV400p:
+        case ImgFrame::Type::NV12:
+        case ImgFrame::Type::RGB888p:
+        case ImgFrame::Type::BGR888p:
+            break;
+        case ImgFrame::Type::RGB888i:
+        case ImgFrame::Type::BGR888i:
+            pixelStep = 3;
+            break;
+        default:
+            throw std::invalid_argument("Warp on host supports only GRAY8, RAW8, YUV400p, NV12, RGB888p, BGR888p, RGB888i and BGR888i frames");
+    }
+    const int srcWidth = static_cast<int>(frame.getWidth());
+    const int srcHeight = static_cast<int>(frame.getHeight());
+    const int srcStride = frame.fb.stride != 0 ? static_cast<int>(frame.fb.stride) : srcWidth * pixelStep;
+    const int dstWidth = outputWidth > 0 ? outputWidth : srcWidth;
+    const int dstHeight = outputHeight > 0 ? outputHeight : srcHeight;
+    if(srcWidth <= 0 || srcHeight <= 0 || srcStride < srcWidth * pixelStep) {
+        throw std::invalid_argument("Warp input frame size doesn't match its data");
+    }
+    if(type == ImgFrame::Type::NV12 && (dstWidth % 2 != 0 || dstHeight % 2 != 0)) {
+        throw std::invalid_argument("Warp NV12 output size must be even");
+    }
+
+    const Layout current{type, srcWidth, srcHeight, srcStride, dstWidth, dstHeight};
+    if(!tablesValid || !(current == layout)) {
+        tables.clear();
+        tables.push_back(computeTable(srcWidth, srcHeight, srcStride, pixelStep, dstWidth, dstHeight, 1));
+        if(type == ImgFrame::Type::NV12) {
+            tables.push_back(computeTable(srcWidth, srcHeight, srcStride, 2, dstWidth, dstHeight, 2));
+        }
+        layout = current;
+        tablesValid = true;
+    }
+
+    // Planes of the input and the tightly packed output
+    const size_t dstPlaneSize = static_cast<size_t>(dstWidth) * dstHeight;
+    std::vector<Plane> planes;
+    size_t dstSize = dstPlaneSize;
+    switch(type) {
+        case ImgFrame::Type::NV12:
+            planes.push_back({frame.fb.p1Offset, 0, dstWidth, dstHeight, dstWidth, 1, 0});
+            planes.push_back({frame.fb.p2Offset, dstPlaneSize, dstWidth / 2, dstHeight / 2, dstWidth, 2, 1});
+            dstSize = dstPlaneSize * 3 / 2;
+            break;
+        case ImgFrame::Type::RGB888p:
+        case ImgFrame::Type::BGR888p:
+            planes.push_back({frame.fb.p1Offset, 0, dstWidth, dstHeight, dstWidth, 1, 0});
+            planes.push_back({frame.fb.p2Offset, dstPlaneSize, dstWidth, dstHeight, dstWidth, 1, 0});
+            planes.push_back({frame.fb.p3Offset, dstPlaneSize * 2, dstWidth, dstHeight, dstWidth, 1, 0});
+            dstSize = dstPlaneSize * 3;
+            break;
+        case ImgFrame::Type::RGB888i:
+        case ImgFrame::Type::BGR888i:
+            planes.push_back({frame.fb.p1Offset, 0, dstWidth, dstHeight, dstWidth * 3, 3, 0});
+            dstSize = dstPlaneSize * 3;
+            break;
+        default:
+            planes.push_back({frame.fb.p1Offset, 0, dstWidth, dstHeight, dstWidth, 1, 0});
+            break;
+    }
+
+    const auto data = frame.getData();
+    for(size_t p = 0; p < planes.size(); p++) {
+        const int subsampling = getSubsampling(type, p);
+        const size_t rowBytes = static_cast<size_t>(ceilDiv(srcWidth, subsampling)) * planes[p].channels;
+        if(data.size() < planes[p].srcOffset + static_cast<size_t>(srcStride) * (ceilDiv(srcHeight, subsampling) - 1) + rowBytes) {
+            throw std::invalid_argument("Warp input frame size doesn't match its data");
+        }
+    }
+
+    std::vector<std::uint8_t> output(dstSize);
+    for(const auto& plane : planes) {
+        const RemapTable& table = tables[plane.table];
+        const std::uint8_t* src = data.data() + plane.srcOffset;
+        std::uint8_t* dst = output.data() + plane.dstOffset;
+        utility::parallelFor(0, plane.height, numThreads, 16, [&](int begin, int end) {
+            const int width = plane.width;
+            const int channels = plane.channels;
+            const std::int32_t stepX = table.stepX;
+            const std::int32_t stepY = table.stepY;
+            for(int y = begin; y < end; y++) {
+                const std::int32_t* offsets = table.offsets.data() + static_cast<size_t>(y) * width;
+                const std::uint16_t* weightsX = table.weightsX.data() + static_cast<size_t>(y) * width;
+                const std::uint16_t* weightsY = table.weightsY.data() + static_cast<size_t>(y) * width;
+                std::uint8_t* out = dst + static_cast<size_t>(y) * plane.dstStride;
+                for(int c = 0; c < channels; c++) {
+                    const std::uint8_t* base = src + c;
+                    // Branch-free fixed point interpolation, nearest neighbor tables have weights of 0 or 1
+                    int x = 0;
+#if defined(DEPTHAI_SIMD_SSE2) || defined(DEPTHAI_SIMD_NEON)
+                    std::uint8_t result[VECTOR_PIXELS];
+                    for(; x + VECTOR_PIXELS <= width; x += VECTOR_PIXELS) {
+                        const auto top = gatherPairs(base, offsets + x, stepX);
+                        const auto bottom = gatherPairs(base + stepY, offsets + x, stepX);
+                        if(channels == 1) {
+                            interpolate(top, bottom, weightsX + x, weightsY + x, out + x);
+                        } else {
+                            interpolate(top, bottom, weightsX + x, weightsY + x, result);
+                            for(int i = 0; i < VECTOR_PIXELS; i++) out[(x + i) * channels + c] = result[i];
+                        }
+                    }
+#endif
+                    for(; x < width; x++) {
+                        const std::uint8_t* p = base + offsets[x];
+                        const std::int32_t wx = weightsX[x];
+                        const std::int32_t wy = weightsY[x];
+                        const std::int32_t top = p[0] * (FIXED_ONE - wx) + p[stepX] * wx;
+                        const std::int32_t bottom = p[stepY] * (FIXED_ONE - wx) + p[stepY + stepX] * wx;
+                        out[x * channels + c] = static_cast<std::uint8_t>((top * (FIXED_ONE - wy) + bottom * wy + ROUNDING) >> (2 * FRACTION_BITS));
+                    }
+                }
+            }
+        });
+    }
+
+    auto warped = std::make_shared<ImgFrame>();
+    warped->setMetadata(frame);
+    warped->setData(std::move(output));
+    warped->setType(type);
+    warped->setSize(dstWidth, dstHeight);
+    warped->setStride(dstWidth * pixelStep);
+    warped->fb.p1Offset = 0;
+    switch(type) {
+        case ImgFrame::Type::RGB888p:
+        case ImgFrame::Type::BGR888p:
+            warped->fb.p2Offset = static_cast<std::uint32_t>(dstPlaneSize);
+            warped->fb.p3Offset = static_cast<std::uint32_t>(dstPlaneSize * 2);
+            break;
+        case ImgFrame::Type::RGB888i:
+        case ImgFrame::Type::BGR888i:
+            warped->fb.p2Offset = 0;
+            warped->fb.p3Offset = 0;
+            break;
+        default:
+            warped->fb.p2Offset = static_cast<std::uint32_t>(dstPlaneSize);
+            warped->fb.p3Offset = static_cast<std::uint32_t>(dstPlaneSize);
+            break;
+    }
+    warped->transformation.addTransformation(getMatrix(srcWidth, srcHeight, dstWidth, dstHeight));
+    warped->transformation.setSize(dstWidth, dstHeight);
+    return warped;
+}
+
+std::array<std::array<float, 3>, 3> MeshWarp::getMatrix(int srcWidth, int srcHeight, int dstWidth, int dstHeight) const {
+    const auto points = getMesh(srcWidth, srcHeight);
+    const int columns = mesh.empty() ? 2 : meshWidth;
+    const int rows = mesh.empty() ? 2 : meshHeight;
+
+    // Normal equations of the fit, mapping mesh points to their output positions
+    double normal[3][3] = {};
+    double rhsX[3] = {};
+    double rhsY[3] = {};
+    for(int row = 0; row < rows; row++) {
+        for(int column = 0; column < columns; column++) {
+            const Point2f& point = points[row * columns + column];
+            const double source[3] = {point.x, point.y, 1.0};
+            const double dstX = static_cast<double>(column) * dstWidth / (columns - 1);
+            const double dstY = static_cast<double>(row) * dstHeight / (rows - 1);
+            for(int i = 0; i < 3; i++) {
+                for(int j = 0; j < 3; j++) normal[i][j] += source[i] * source[j];
+                rhsX[i] += source[i] * dstX;
+                rhsY[i] += source[i] * dstY;
+            }
+        }
+    }
+
+    auto det3 = [](const double m[3][3]) {
+        return m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1]) - m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0])
+               + m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
+    };
+    const double det = det3(normal);
+    if(!std::isfinite(det) || std::abs(det) < 1e-9 * std::abs(normal[0][0] * normal[1][1] * normal[2][2])) {
+        // Degenerate mesh, fall back to scaling
+        return {{{static_cast<float>(dstWidth) / srcWidth, 0, 0}, {0, static_cast<float>(dstHeight) / srcHeight, 0}, {0, 0, 1}}};
+    }
+    // Cramer's rule
+    auto solve = [&](const double rhs[3], std::array<float, 3>& result) {
+        for(int k = 0; k < 3; k++) {
+            double replaced[3][3];
+            for(int i = 0; i < 3; i++) {
+                for(int j = 0; j < 3; j++) replaced[i][j] = j == k ? rhs[i] : normal[i][j];
+            }
+            result[k] = static_cast<float>(det3(replaced) / det);
+        }
+    };
+    std::array<std::array<float, 3>, 3> matrix = {{{0, 0, 0}, {0, 0, 0}, {0, 0, 1}}};
+    solve(rhsX, matrix[0]);
+    solve(rhsY, matrix[1]);
+    return matrix;
+}
+
+}  // namespace impl
+}  // namespace dai
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "depthai/common/Interpolation.hpp"
+#include "depthai/common/Point2f.hpp"
+#include "depthai/pipeline/datatype/ImgFrame.hpp"
+
+namespace dai {
+namespace impl {
+
+/**
+ * Host implementation of the Warp node.
+ * The mesh holds source coordinates, in pixels of the input frame, of points spanning the output frame evenly,
+ * top left mesh point at the top left output corner and bottom right one at the bottom right output corner.
+ * Between mesh points source coordinates are interpolated bilinearly. Sources outside of the input are clamped to its border.
+ *
+ * The dense remap table is computed in fixed point once per mesh and frame layout and reused for following frames.
+ */
+class MeshWarp {
+   public:
+    /**
+     * @param numThreads Number of worker threads, 0 for the number of hardware threads
+     */
+    explicit MeshWarp(unsigned numThreads = 0);
+
+    /**
+     * Set the warp mesh
+     * @param mesh Source coordinates of mesh points in row major order. Empty for the input frame corners, resizing it
+     * @param meshWidth Number of mesh points in a row
+     * @param meshHeight Number of mesh rows
+     * @throws std::invalid_argument if the mesh has fewer than 2x2 points or fewer points than specified
+     */
+    void setMesh(std::vector<Point2f> mesh, int meshWidth, int meshHeight);
+
+    /**
+     * Set output size, zero for the input frame size
+     */
+    void setOutputSize(int width, int height);
+
+    /**
+     * Set interpolation of source pixels. NEAREST_NEIGHBOR is supported, other methods use bilinear interpolation
+     */
+    void setInterpolation(Interpolation interpolation);
+
+    /**
+     * Warp a frame
+     * @returns Warped frame of the same type, with metadata of the input frame and updated transformation
+     * @throws std::invalid_argument if the frame type isn't supported or its size doesn't match its data
+     */
+    std::shared_ptr<ImgFrame> process(const ImgFrame& frame);
+
+    /**
+     * Affine transformation from source to output coordinates closest to the mesh in the least squares sense.
+     * It is exact for meshes describing crops, scaling and rotations.
+     */
+    std::array<std::array<float, 3>, 3> getMatrix(int srcWidth, int srcHeight, int dstWidth, int dstHeight) const;
+
+   private:
+    // Fixed point remap table of a plane. Each output pixel interpolates the source pixel at offset,
+    // its right neighbor at offset + stepX and the ones below at offset + stepY
+    struct RemapTable {
+        std::vector<std::int32_t> offsets;
+        std::vector<std::uint16_t> weightsX;
+        std::vector<std::uint16_t> weightsY;
+        std::int32_t stepX = 0;
+        std::int32_t stepY = 0;
+    };
+
+    struct Plane {
+        size_t srcOffset;
+        size_t dstOffset;
+        int width;
+        int height;
+        int dstStride;
+        int channels;
+        size_t table;
+    };
+
+    // Frame layout the tables were computed for
+    struct Layout {
+        ImgFrame::Type type;
+        int srcWidth;
+        int srcHeight;
+        int srcStride;
+        int dstWidth;
+        int dstHeight;
+
+        bool operator==(const Layout& other) const;
+    };
+
+    std::vector<Point2f> mesh;
+    int meshWidth = 0;
+    int meshHeight = 0;
+    int outputWidth = 0;
+    int outputHeight = 0;
+    bool nearest = false;
+    unsigned numThreads;
+
+    bool tablesValid = false;
+    Layout layout{};
+    std::vector<RemapTable> tables;
+
+    std::vector<Point2f> getMesh(int srcWidth, int srcHeight) const;
+    RemapTable computeTable(int srcWidth, int srcHeight, int srcStride, int pixelStep, int dstWidth, int dstHeight, int subsampling) const;
+};
+
+}  // namespace impl
+}  // namespace dai
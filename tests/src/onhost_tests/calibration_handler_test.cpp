@@ -1,5 +1,6 @@
 #include <catch2/catch_all.hpp>
 #include <depthai/device/CalibrationHandler.hpp>
+#include <map>
 #include <nlohmann/json.hpp>
 #include <stdexcept>
 #include <vector>
@@ -131,3 +132,56 @@ TEST_CASE("Long chain extrinsics composition", "[getCameraExtrinsics]") {
         {0.025600001f, 0.0f, 0.0f, -0.025600001f}, {0.0f, 0.008100001f, 0.0f, 0.003240019f}, {0.0f, 0.0f, 1.464100122f, 0.0f}, {0.0f, 0.0f, 0.0f, 1.0f}};
     REQUIRE(M == expected);
 }
+
+TEST_CASE("Fixed size extrinsics match nested vector extrinsics", "[getCameraExtrinsicsMatrix]") {
+    auto handler = loadHandler();
+    // CAM_D is linked to CAM_B with a translation, CAM_B to the origin CAM_A without one
+    const std::map<CameraBoardSocket, float> translationToOrigin = {
+        {CameraBoardSocket::CAM_A, 0.0f}, {CameraBoardSocket::CAM_B, 0.0f}, {CameraBoardSocket::CAM_D, -3.2509000301361084f}};
+    for(const auto& src : translationToOrigin) {
+        for(const auto& dst : translationToOrigin) {
+            std::vector<std::vector<float>> expected = {{1, 0, 0, 0}, {0, 1, 0, src.second - dst.second}, {0, 0, 1, 0}, {0, 0, 0, 1}};
+            auto M = handler.getCameraExtrinsicsMatrix(src.first, dst.first, false);
+            auto V = handler.getCameraExtrinsics(src.first, dst.first, false);
+            for(int i = 0; i < 4; i++) {
+                for(int j = 0; j < 4; j++) {
+                    REQUIRE(M[i][j] == Catch::Approx(expected[i][j]).margin(1e-6));
+                    REQUIRE(V[i][j] == M[i][j]);
+                }
+            }
+        }
+    }
+    REQUIRE_THROWS_AS(handler.getCameraExtrinsicsMatrix(CameraBoardSocket::CAM_A, CameraBoardSocket::CAM_C, false), std::runtime_error);
+
+    // Rotations are composed along the links, CAM_C linked to CAM_A with the rotation it has
+    const std::vector<std::vector<float>> rotation = {{0.9999265074729919f, 0.006867990363389254f, -0.009992731735110283f},
+                                                      {-0.006895299535244703f, 0.9999725818634033f, -0.00270105991512537f},
+                                                      {0.00997390691190958f, 0.002769764279946685f, 0.9999464154243469f}};
+    handler.setCameraExtrinsics(CameraBoardSocket::CAM_C, CameraBoardSocket::CAM_A, rotation, {1, 2, 3}, {0, 0, 0});
+    auto M = handler.getCameraExtrinsicsMatrix(CameraBoardSocket::CAM_C, CameraBoardSocket::CAM_D, false);
+    // Translation of CAM_C in CAM_A plus the translation of CAM_A in CAM_D
+    const std::vector<float> translation = {1.0f, 2.0f + 3.2509000301361084f, 3.0f};
+    for(int i = 0; i < 3; i++) {
+        for(int j = 0; j < 3; j++) REQUIRE(M[i][j] == Catch::Approx(rotation[i][j]).margin(1e-6));
+        REQUIRE(M[i][3] == Catch::Approx(translation[i]).margin(1e-5));
+        REQUIRE(M[3][i] == 0.0f);
+    }
+    REQUIRE(M[3][3] == 1.0f);
+}
+
+TEST_CASE("Cached extrinsics are updated when calibration changes", "[getCameraExtrinsicsMatrix]") {
+    auto handler = loadHandler();
+    auto before = handler.getCameraExtrinsicsMatrix(CameraBoardSocket::CAM_D, CameraBoardSocket::CAM_B, false);
+    REQUIRE(before[1][3] == Catch::Approx(-3.2509f));
+
+    auto R3 = std::vector<std::vector<float>>{{1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+    handler.setCameraExtrinsics(CameraBoardSocket::CAM_D, CameraBoardSocket::CAM_B, R3, {0, 7, 0}, {0, 0, 0});
+    auto after = handler.getCameraExtrinsicsMatrix(CameraBoardSocket::CAM_D, CameraBoardSocket::CAM_B, false);
+    REQUIRE(after[1][3] == Catch::Approx(7.0f));
+
+    // Copies keep working independently
+    auto copy = handler;
+    copy.setCameraExtrinsics(CameraBoardSocket::CAM_D, CameraBoardSocket::CAM_B, R3, {0, 1, 0}, {0, 0, 0});
+    REQUIRE(copy.getCameraExtrinsicsMatrix(CameraBoardSocket::CAM_D, CameraBoardSocket::CAM_B, false)[1][3] == Catch::Approx(1.0f));
+    REQUIRE(handler.getCameraExtrinsicsMatrix(CameraBoardSocket::CAM_D, CameraBoardSocket::CAM_B, false)[1][3] == Catch::Approx(7.0f));
+}
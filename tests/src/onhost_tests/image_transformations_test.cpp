@@ -230,3 +230,87 @@ TEST_CASE("interFrameRemap") {
 
     REQUIRE_THAT(pt.x, Catch::Matchers::WithinAbs(pt2.x, 0.01));
 }
+
+TEST_CASE("batchRemap") {
+    std::array<std::array<float, 3>, 3> intr1 = {{{784.8082885742188, 0.0, 652.2084350585938}, {0.0, 786.7345581054688, 406.1820373535156}, {0.0, 0.0, 1.0}}};
+    std::array<std::array<float, 3>, 3> intr2 = {{{3105.2021484375, 0.0, 1877.4822998046875}, {0.0, 3113.031494140625, 1128.080078125}, {0.0, 0.0, 1.0}}};
+    auto tr1 = dai::ImgTransformation(1920, 1080, intr1);
+    tr1.addCrop(100, 50, 1280, 720);
+    tr1.addScale(0.5f, 0.5f);
+    auto tr2 = dai::ImgTransformation(3840, 2160, intr2);
+    tr2.addRotation(30, dai::Point2f(300, 400));
+
+    std::vector<dai::Point2f> points = {{10, 20}, {0.25f, 0.75f, true}, {320, 180}, {0.5f, 0.5f, true}, {600, 10}};
+    auto batch = points;
+    tr1.remapPointsTo(tr2, batch);
+    for(size_t i = 0; i < points.size(); ++i) {
+        auto single = tr1.remapPointTo(tr2, points[i]);
+        REQUIRE_THAT(batch[i].x, Catch::Matchers::WithinAbs(single.x, 0.01));
+        REQUIRE_THAT(batch[i].y, Catch::Matchers::WithinAbs(single.y, 0.01));
+        REQUIRE(batch[i].isNormalized() == points[i].isNormalized());
+    }
+
+    std::vector<dai::RotatedRect> rects = {dai::RotatedRect({100, 100}, {50, 30}, 10), dai::RotatedRect({0.5f, 0.5f}, {0.1f, 0.2f}, 0)};
+    auto batchRects = rects;
+    tr1.remapRectsTo(tr2, batchRects);
+    for(size_t i = 0; i < rects.size(); ++i) {
+        auto single = tr1.remapRectTo(tr2, rects[i]);
+        REQUIRE_THAT(batchRects[i].center.x, Catch::Matchers::WithinAbs(single.center.x, 0.01));
+        REQUIRE_THAT(batchRects[i].center.y, Catch::Matchers::WithinAbs(single.center.y, 0.01));
+        REQUIRE_THAT(batchRects[i].size.width, Catch::Matchers::WithinAbs(single.size.width, 0.01));
+        REQUIRE_THAT(batchRects[i].size.height, Catch::Matchers::WithinAbs(single.size.height, 0.01));
+    }
+
+    std::vector<dai::ImgDetection> detections(1);
+    detections[0].xmin = 0.2f;
+    detections[0].ymin = 0.3f;
+    detections[0].xmax = 0.4f;
+    detections[0].ymax = 0.6f;
+    float xmin = 1.0f, ymin = 1.0f, xmax = 0.0f, ymax = 0.0f;
+    for(auto corner : {dai::Point2f(0.2f, 0.3f, true), dai::Point2f(0.4f, 0.3f, true), dai::Point2f(0.4f, 0.6f, true), dai::Point2f(0.2f, 0.6f, true)}) {
+        auto remapped = tr1.remapPointTo(tr2, corner);
+        xmin = std::min(xmin, remapped.x);
+        ymin = std::min(ymin, remapped.y);
+        xmax = std::max(xmax, remapped.x);
+        ymax = std::max(ymax, remapped.y);
+    }
+    tr1.remapDetectionsTo(tr2, detections);
+    REQUIRE_THAT(detections[0].xmin, Catch::Matchers::WithinAbs(std::clamp(xmin, 0.0f, 1.0f), 0.001));
+    REQUIRE_THAT(detections[0].ymin, Catch::Matchers::WithinAbs(std::clamp(ymin, 0.0f, 1.0f), 0.001));
+    REQUIRE_THAT(detections[0].xmax, Catch::Matchers::WithinAbs(std::clamp(xmax, 0.0f, 1.0f), 0.001));
+    REQUIRE_THAT(detections[0].ymax, Catch::Matchers::WithinAbs(std::clamp(ymax, 0.0f, 1.0f), 0.001));
+}
+
+TEST_CASE("batchRemapRectsUnderRotation") {
+    std::array<std::array<float, 3>, 3> intr1 = {{{784.8082885742188, 0.0, 652.2084350585938}, {0.0, 786.7345581054688, 406.1820373535156}, {0.0, 0.0, 1.0}}};
+    std::array<std::array<float, 3>, 3> intr2 = {{{3105.2021484375, 0.0, 1877.4822998046875}, {0.0, 3113.031494140625, 1128.080078125}, {0.0, 0.0, 1.0}}};
+    // Rotations combined with a non uniform scale and a perspective warp map rects to quadrilaterals, so the fitted rect depends on the steps taken
+    auto tr1 = dai::ImgTransformation(1920, 1080, intr1);
+    tr1.addCrop(100, 50, 1280, 720);
+    tr1.addRotation(20, dai::Point2f(640, 360));
+    tr1.addScale(0.5f, 1.0f);
+    auto tr2 = dai::ImgTransformation(3840, 2160, intr2);
+    tr2.addTransformation({{{1.0f, 0.05f, 10.0f}, {0.02f, 1.0f, -5.0f}, {0.00002f, 0.00001f, 1.0f}}});
+    tr2.addRotation(-35, dai::Point2f(1920, 1080));
+
+    std::vector<dai::RotatedRect> rects = {dai::RotatedRect({100, 100}, {50, 30}, 10),
+                                           dai::RotatedRect({320, 400}, {120, 60}, -45),
+                                           dai::RotatedRect(dai::Point2f(0.5f, 0.5f, true), dai::Size2f(0.1f, 0.2f, true), 0),
+                                           dai::RotatedRect(dai::Point2f(0.3f, 0.6f, true), dai::Size2f(0.2f, 0.05f, true), 70)};
+    for(const auto* to : {&tr1, &tr2}) {
+        auto batch = rects;
+        tr1.remapRectsTo(*to, batch);
+        for(size_t i = 0; i < rects.size(); ++i) {
+            const auto single = tr1.remapRectTo(*to, rects[i]);
+            const auto from = to->remapRectFrom(tr1, rects[i]);
+            for(const auto& other : {single, from}) {
+                REQUIRE(batch[i].center.x == other.center.x);
+                REQUIRE(batch[i].center.y == other.center.y);
+                REQUIRE(batch[i].size.width == other.size.width);
+                REQUIRE(batch[i].size.height == other.size.height);
+                REQUIRE(batch[i].angle == other.angle);
+                REQUIRE(batch[i].isNormalized() == rects[i].isNormalized());
+            }
+        }
+    }
+}
@@ -0,0 +1,101 @@
+#include <catch2/catch_all.hpp>
+#include <chrono>
+#include <depthai/common/LatencyHistogram.hpp>
+#include <depthai/pipeline/datatype/BenchmarkReport.hpp>
+#include <depthai/utility/Serialization.hpp>
+
+using namespace dai;
+using namespace std::chrono;
+
+TEST_CASE("LatencyHistogram - Bucket boundaries", "[LatencyHistogram]") {
+    // Values are covered by consecutive buckets without gaps
+    std::uint16_t previousIndex = 0;
+    for(std::uint64_t value = 1; value < (1ULL << 20); value++) {
+        auto index = LatencyHistogram::getBucketIndex(value);
+        REQUIRE((index == previousIndex || index == previousIndex + 1));
+        REQUIRE(LatencyHistogram::getBucketLowestValue(index) <= value);
+        REQUIRE(LatencyHistogram::getBucketHighestValue(index) >= value);
+        // Relative precision
+        REQUIRE(LatencyHistogram::getBucketHighestValue(index) - LatencyHistogram::getBucketLowestValue(index) <= value / 64);
+        previousIndex = index;
+    }
+    REQUIRE(LatencyHistogram::getBucketIndex(UINT64_MAX) == LatencyHistogram::getBucketIndex(UINT64_MAX - 1));
+}
+
+TEST_CASE("LatencyHistogram - Percentiles", "[LatencyHistogram]") {
+    LatencyHistogram histogram;
+    REQUIRE(histogram.getPercentile(50) == microseconds(0));
+
+    // 1ms..10s uniformly, plus a single 1 minute stall
+    for(int i = 1; i <= 10000; i++) {
+        histogram.record(milliseconds(i));
+    }
+    histogram.record(minutes(1));
+    histogram.record(microseconds(-5));
+
+    REQUIRE(histogram.count == 10002);
+    REQUIRE(histogram.min == 0);
+    REQUIRE(histogram.max == 60000000);
+    REQUIRE_THAT(duration<double>(histogram.getPercentile(50)).count(), Catch::Matchers::WithinRel(5.0, 0.02));
+    REQUIRE_THAT(duration<double>(histogram.getPercentile(99)).count(), Catch::Matchers::WithinRel(9.9, 0.02));
+    REQUIRE(histogram.getPercentile(100) == minutes(1));
+    REQUIRE(histogram.getPercentile(0) == microseconds(0));
+    // Memory is bounded by the dynamic range, not the number of values
+    REQUIRE(histogram.bucketIndices.size() < 1000);
+    REQUIRE(histogram.bucketIndices.size() == histogram.bucketCounts.size());
+}
+
+TEST_CASE("LatencyHistogram - Merge and serialization", "[LatencyHistogram]") {
+    LatencyHistogram a, b, all;
+    for(int i = 0; i < 1000; i++) {
+        auto value = microseconds(i * i);
+        (i % 3 == 0 ? a : b).record(value);
+        all.record(value);
+    }
+    a.merge(b);
+    a.merge(LatencyHistogram());
+    REQUIRE(a.count == all.count);
+    REQUIRE(a.min == all.min);
+    REQUIRE(a.max == all.max);
+    REQUIRE(a.sum == all.sum);
+    REQUIRE(a.bucketIndices == all.bucketIndices);
+    REQUIRE(a.bucketCounts == all.bucketCounts);
+    REQUIRE_THAT(a.getStdDev().count(), Catch::Matchers::WithinRel(all.getStdDev().count(), 1e-6));
+
+    auto serialized = utility::serialize(a);
+    LatencyHistogram deserialized;
+    REQUIRE(utility::deserialize(serialized, deserialized));
+    REQUIRE(deserialized.bucketIndices == a.bucketIndices);
+    REQUIRE(deserialized.bucketCounts == a.bucketCounts);
+    REQUIRE(deserialized.getPercentile(90) == a.getPercentile(90));
+}
+
+TEST_CASE("BenchmarkReport - Histograms round trip", "[LatencyHistogram]") {
+    BenchmarkReport report;
+    report.fps = 30.0f;
+    report.averageLatency = 0.01f;
+    report.latencies = {0.01f, 0.02f};
+    for(int i = 1; i <= 100; i++) report.latencyHistogram.record(microseconds(i * 137));
+    report.interArrivalHistogram.record(milliseconds(33));
+    report.interArrivalHistogram.record(milliseconds(34));
+    report.jitter = 0.005f;
+
+    for(auto type : {SerializationType::LIBNOP, SerializationType::JSON}) {
+        std::vector<std::uint8_t> serialized;
+        REQUIRE(utility::serialize(report, serialized, type));
+        BenchmarkReport deserialized;
+        REQUIRE(utility::deserialize(serialized.data(), serialized.size(), deserialized, type));
+        REQUIRE(deserialized.fps == report.fps);
+        REQUIRE(deserialized.latencies == report.latencies);
+        REQUIRE(deserialized.jitter == report.jitter);
+        for(auto histogram : {std::make_pair(&deserialized.latencyHistogram, &report.latencyHistogram),
+                              std::make_pair(&deserialized.interArrivalHistogram, &report.interArrivalHistogram)}) {
+            REQUIRE(histogram.first->count == histogram.second->count);
+            REQUIRE(histogram.first->min == histogram.second->min);
+            REQUIRE(histogram.first->max == histogram.second->max);
+            REQUIRE(histogram.first->bucketIndices == histogram.second->bucketIndices);
+            REQUIRE(histogram.first->bucketCounts == histogram.second->bucketCounts);
+            REQUIRE(histogram.first->getPercentile(99) == histogram.second->getPercentile(99));
+        }
+    }
+}
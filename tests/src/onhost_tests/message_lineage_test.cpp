@@ -0,0 +1,135 @@
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include "depthai/depthai.hpp"
+
+using namespace dai;
+using namespace std::chrono;
+
+namespace {
+
+bool isSet(const LineageHop::Timepoint& timepoint) {
+    return timepoint != LineageHop::Timepoint{};
+}
+
+// Creates a new message for each input, simulating some processing
+class Relay : public node::CustomThreadedNode<Relay> {
+   public:
+    Input input{*this, {}};
+    Output out{*this, {}};
+
+    void run() override {
+        while(isRunning()) {
+            std::shared_ptr<Buffer> in;
+            try {
+                in = input.get<Buffer>();
+            } catch(const MessageQueue::QueueException&) {
+                break;
+            }
+            std::this_thread::sleep_for(milliseconds(10));
+            auto derived = std::make_shared<Buffer>();
+            derived->setSequenceNum(in->getSequenceNum());
+            out.send(derived);
+        }
+    }
+};
+
+}  // namespace
+
+TEST_CASE("MessageLineage - disabled by default") {
+    REQUIRE_FALSE(MessageLineage::isEnabled());
+    MessageQueue queue(4);
+    queue.send(std::make_shared<Buffer>());
+    REQUIRE(queue.get()->getLineage() == nullptr);
+}
+
+TEST_CASE("MessageLineage - queue stamps") {
+    MessageLineage::setEnabled(true);
+    MessageQueue queue("queue", 4);
+    auto msg = std::make_shared<Buffer>();
+    queue.send(msg);
+    std::this_thread::sleep_for(milliseconds(5));
+    REQUIRE(queue.get() == msg);
+
+    auto lineage = msg->getLineage();
+    REQUIRE(lineage != nullptr);
+    auto hops = lineage->getHops();
+    REQUIRE(hops.size() == 1);
+    REQUIRE(hops[0].nodeId == -1);
+    REQUIRE(hops[0].name == "queue");
+    REQUIRE(isSet(hops[0].enqueued));
+    REQUIRE(isSet(hops[0].dequeued));
+    REQUIRE_FALSE(isSet(hops[0].emitted));
+
+    auto breakdown = lineage->getLatencyBreakdown();
+    REQUIRE(breakdown.size() == 1);
+    REQUIRE(breakdown[0].queueing.has_value());
+    REQUIRE(*breakdown[0].queueing >= milliseconds(5));
+    REQUIRE_FALSE(breakdown[0].processing.has_value());
+    REQUIRE_FALSE(breakdown[0].transport.has_value());
+
+    // Copies continue the lineage independently
+    auto copy = std::make_shared<Buffer>(*msg);
+    queue.send(copy);
+    REQUIRE(copy->getLineage()->getHops().size() == 2);
+    REQUIRE(msg->getLineage()->getHops().size() == 1);
+    queue.tryGetAll();
+
+    // Number of hops is bounded
+    for(size_t i = 0; i < MessageLineage::MAX_HOPS * 2; i++) {
+        queue.send(msg);
+        queue.get();
+    }
+    REQUIRE(msg->getLineage()->getHops().size() == MessageLineage::MAX_HOPS);
+    MessageLineage::setEnabled(false);
+}
+
+TEST_CASE("MessageLineage - host pipeline") {
+    MessageLineage::setEnabled(true);
+    Pipeline pipeline(false);
+    auto relay = pipeline.create<Relay>();
+    relay->setAlias("relay");
+    auto inputQueue = relay->input.createInputQueue();
+    auto outputQueue = relay->out.createOutputQueue();
+    pipeline.start();
+
+    auto msg = std::make_shared<Buffer>();
+    msg->setSequenceNum(7);
+    inputQueue->send(msg);
+    auto result = outputQueue->get<Buffer>();
+    pipeline.stop();
+    MessageLineage::setEnabled(false);
+
+    REQUIRE(result != nullptr);
+    REQUIRE(result != msg);
+    REQUIRE(result->getSequenceNum() == 7);
+    auto lineage = result->getLineage();
+    REQUIRE(lineage != nullptr);
+
+    // Derived message inherits the hops of the input
+    auto hops = lineage->getHops();
+    REQUIRE(hops.size() >= 2);
+    const auto& relayHop = hops[hops.size() - 2];
+    REQUIRE(relayHop.nodeId == relay->id);
+    REQUIRE(relayHop.name == "relay");
+    REQUIRE(isSet(relayHop.enqueued));
+    REQUIRE(isSet(relayHop.dequeued));
+    REQUIRE(isSet(relayHop.emitted));
+    REQUIRE(relayHop.enqueued <= relayHop.dequeued);
+    REQUIRE(relayHop.dequeued <= relayHop.emitted);
+
+    // Last hop is the output queue, read by the application
+    REQUIRE(hops.back().nodeId == -1);
+    REQUIRE(isSet(hops.back().enqueued));
+    REQUIRE(isSet(hops.back().dequeued));
+
+    auto breakdown = lineage->getLatencyBreakdown();
+    REQUIRE(breakdown.size() == hops.size());
+    const auto& relayLatency = breakdown[breakdown.size() - 2];
+    REQUIRE(relayLatency.processing.has_value());
+    REQUIRE(*relayLatency.processing >= milliseconds(10));
+    REQUIRE(breakdown.back().transport.has_value());
+    REQUIRE_FALSE(lineage->toString().empty());
+}
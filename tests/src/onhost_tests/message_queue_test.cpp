@@ -3,6 +3,7 @@
 #include <chrono>
 #include <depthai/pipeline/MessageQueue.hpp>
 #include <depthai/pipeline/datatype/ADatatype.hpp>
+#include <depthai/pipeline/datatype/Buffer.hpp>
 #include <memory>
 #include <thread>
 
@@ -395,3 +396,118 @@ TEST_CASE("Multi callbacks", "[MessageQueue]") {
     REQUIRE(callbackCount1 == 1);
     REQUIRE(callbackCount2 == 1);
 }
+
+TEST_CASE("MessageQueue - Asynchronous get", "[MessageQueue]") {
+    MessageQueue queue(10);
+
+    // Message already in the queue is delivered immediately
+    auto msg1 = std::make_shared<ADatatype>();
+    queue.send(msg1);
+    auto future1 = queue.getAsync();
+    REQUIRE(future1.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+    REQUIRE(future1.get() == msg1);
+
+    // Pending gets are served in order, without the messages being queued
+    auto future2 = queue.getAsync();
+    auto future3 = queue.getAsync();
+    REQUIRE(future2.wait_for(std::chrono::seconds(0)) == std::future_status::timeout);
+    auto msg2 = std::make_shared<ADatatype>();
+    auto msg3 = std::make_shared<ADatatype>();
+    std::thread sendThread([&]() {
+        queue.send(msg2);
+        queue.send(msg3);
+    });
+    REQUIRE(future2.get() == msg2);
+    REQUIRE(future3.get() == msg3);
+    sendThread.join();
+    REQUIRE(queue.getSize() == 0);
+
+    // Cancelled gets don't consume messages
+    std::atomic<int> callbackCount{0};
+    auto id = queue.getAsync([&](std::shared_ptr<ADatatype>) { callbackCount++; });
+    REQUIRE(queue.cancelGetAsync(id));
+    REQUIRE_FALSE(queue.cancelGetAsync(id));
+    queue.send(std::make_shared<ADatatype>());
+    REQUIRE(callbackCount == 0);
+    REQUIRE(queue.getSize() == 1);
+}
+
+TEST_CASE("MessageQueue - Asynchronous get on a closed queue", "[MessageQueue]") {
+    MessageQueue queue(10);
+    auto future = queue.getAsync();
+    queue.close();
+    REQUIRE_THROWS_AS(future.get(), MessageQueue::QueueException);
+    REQUIRE_THROWS_AS(queue.getAsync().get(), MessageQueue::QueueException);
+}
+
+namespace {
+std::shared_ptr<Buffer> makeBuffer(size_t size) {
+    auto buffer = std::make_shared<Buffer>();
+    buffer->setData(std::vector<std::uint8_t>(size));
+    return buffer;
+}
+}  // namespace
+
+TEST_CASE("MessageQueue - Byte accounting", "[MessageQueue]") {
+    const auto totalBefore = MessageQueue::getTotalBytes();
+    {
+        MessageQueue queue(10);
+        REQUIRE(queue.getMaxBytes() == 0);
+        queue.send(makeBuffer(100));
+        queue.send(makeBuffer(50));
+        REQUIRE(queue.getBytes() == 150);
+        REQUIRE(MessageQueue::getTotalBytes() == totalBefore + 150);
+
+        queue.get();
+        REQUIRE(queue.getBytes() == 50);
+        REQUIRE(MessageQueue::getTotalBytes() == totalBefore + 50);
+    }
+    // Messages left in a destroyed queue are no longer accounted for
+    REQUIRE(MessageQueue::getTotalBytes() == totalBefore);
+}
+
+TEST_CASE("MessageQueue - Byte limit, non blocking", "[MessageQueue]") {
+    MessageQueue queue(10, false);
+    queue.setMaxBytes(250);
+    auto first = makeBuffer(100);
+    queue.send(first);
+    queue.send(makeBuffer(100));
+    REQUIRE(queue.getSize() == 2);
+
+    // Oldest messages are dropped to make room
+    queue.send(makeBuffer(100));
+    REQUIRE(queue.getSize() == 2);
+    REQUIRE(queue.getBytes() == 200);
+    REQUIRE(queue.getStats().dropped == 1);
+    REQUIRE(queue.get() != first);
+
+    // A message larger than the limit replaces everything
+    queue.send(makeBuffer(1000));
+    REQUIRE(queue.getSize() == 1);
+    REQUIRE(queue.getBytes() == 1000);
+    REQUIRE(queue.isFull());
+}
+
+TEST_CASE("MessageQueue - Byte limit, blocking", "[MessageQueue]") {
+    MessageQueue queue(10, true);
+    queue.setMaxBytes(150);
+    queue.send(makeBuffer(100));
+    REQUIRE_FALSE(queue.send(makeBuffer(100), std::chrono::milliseconds(10)));
+    REQUIRE(queue.getSize() == 1);
+
+    std::thread consumer([&queue]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        queue.get();
+    });
+    queue.send(makeBuffer(100));
+    consumer.join();
+    REQUIRE(queue.getSize() == 1);
+    REQUIRE(queue.getStats().blockedTime > std::chrono::nanoseconds(0));
+
+    // Raising the limit unblocks waiting senders
+    std::thread sender([&queue]() { queue.send(makeBuffer(100)); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    queue.setMaxBytes(0);
+    sender.join();
+    REQUIRE(queue.getBytes() == 200);
+}
@@ -0,0 +1,150 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "depthai/depthai.hpp"
+
+using namespace dai;
+
+namespace {
+
+ImgDetection makeDetection(int i) {
+    ImgDetection detection;
+    detection.label = static_cast<uint32_t>(i % 3);
+    detection.confidence = 0.5f + 0.01f * i;
+    detection.xmin = 0.01f * i;
+    detection.ymin = 0.02f * i;
+    detection.xmax = 0.01f * i + 0.1f;
+    detection.ymax = 0.02f * i + 0.2f;
+    return detection;
+}
+
+Tracklet makeTracklet(int i) {
+    Tracklet tracklet;
+    tracklet.roi = Rect(0.1f * i, 0.05f, 0.2f, 0.3f, i % 2 == 0);
+    tracklet.id = 100 + i;
+    tracklet.label = i % 3;
+    tracklet.age = 2 * i;
+    tracklet.status = static_cast<Tracklet::TrackingStatus>(i % 4);
+    tracklet.srcImgDetection = makeDetection(i);
+    tracklet.spatialCoordinates = Point3f(10.0f * i, -5.0f, 1000.0f + i);
+    return tracklet;
+}
+
+bool equalDetections(const ImgDetection& a, const ImgDetection& b) {
+    return a.label == b.label && a.labelName == b.labelName && a.confidence == b.confidence && a.xmin == b.xmin && a.ymin == b.ymin && a.xmax == b.xmax
+           && a.ymax == b.ymax;
+}
+
+bool equalTracklets(const Tracklet& a, const Tracklet& b) {
+    return a.roi.x == b.roi.x && a.roi.y == b.roi.y && a.roi.width == b.roi.width && a.roi.height == b.roi.height && a.roi.normalized == b.roi.normalized
+           && a.roi.hasNormalized == b.roi.hasNormalized && a.id == b.id && a.label == b.label && a.age == b.age && a.status == b.status
+           && equalDetections(a.srcImgDetection, b.srcImgDetection) && a.spatialCoordinates.x == b.spatialCoordinates.x
+           && a.spatialCoordinates.y == b.spatialCoordinates.y && a.spatialCoordinates.z == b.spatialCoordinates.z;
+}
+
+}  // namespace
+
+TEST_CASE("ImgDetectionArrays - conversion") {
+    ImgDetections message;
+    for(int i = 0; i < 50; i++) message.detections.push_back(makeDetection(i));
+
+    auto arrays = message.getArrays();
+    REQUIRE(arrays.size() == 50);
+    REQUIRE(arrays.boxes.size() == 200);
+    REQUIRE(arrays.boxes[7 * 4 + 2] == message.detections[7].xmax);
+    REQUIRE(arrays.confidences[7] == message.detections[7].confidence);
+    REQUIRE(arrays.labels[7] == message.detections[7].label);
+    // No detection has a label name
+    REQUIRE(arrays.labelNames.empty());
+
+    // Label names are filled in once a detection has one
+    auto named = makeDetection(50);
+    named.labelName = "person";
+    arrays.add(named);
+    REQUIRE(arrays.labelNames.size() == 51);
+    REQUIRE(arrays.labelNames[0].empty());
+    REQUIRE(arrays.get(50).labelName == "person");
+
+    ImgDetections restored;
+    restored.setArrays(arrays);
+    REQUIRE(restored.detections.size() == 51);
+    for(int i = 0; i < 50; i++) REQUIRE(equalDetections(restored.detections[i], message.detections[i]));
+    REQUIRE(equalDetections(restored.detections[50], named));
+
+    REQUIRE_THROWS_AS(arrays.get(51), std::out_of_range);
+    arrays.labels.pop_back();
+    REQUIRE_THROWS_AS(arrays.toDetections(), std::invalid_argument);
+}
+
+TEST_CASE("TrackletArrays - conversion") {
+    Tracklets message;
+    for(int i = 0; i < 20; i++) message.tracklets.push_back(makeTracklet(i));
+
+    auto arrays = message.getArrays();
+    REQUIRE(arrays.size() == 20);
+    REQUIRE(arrays.rois[3 * 4] == message.tracklets[3].roi.x);
+    REQUIRE(arrays.roiFlags[2] == (TrackletArrays::ROI_NORMALIZED | TrackletArrays::ROI_HAS_NORMALIZED));
+    REQUIRE(arrays.roiFlags[3] == TrackletArrays::ROI_HAS_NORMALIZED);
+    REQUIRE(arrays.statuses[3] == Tracklet::TrackingStatus::REMOVED);
+    REQUIRE(arrays.spatialCoordinates[5 * 3 + 2] == 1005.0f);
+    REQUIRE(arrays.srcImgDetections.size() == 20);
+
+    Tracklets restored;
+    restored.setArrays(arrays);
+    REQUIRE(restored.tracklets.size() == 20);
+    for(int i = 0; i < 20; i++) REQUIRE(equalTracklets(restored.tracklets[i], message.tracklets[i]));
+
+    arrays.srcImgDetections.confidences.pop_back();
+    REQUIRE_THROWS_AS(arrays.toTracklets(), std::invalid_argument);
+}
+
+TEST_CASE("Detection arrays - kept in the message") {
+    ImgDetections message;
+    for(int i = 0; i < 10; i++) message.detections.push_back(makeDetection(i));
+
+    // The arrays are kept across calls and follow changes to the detections
+    const auto* arrays = &message.getArrays();
+    REQUIRE(&message.getArrays() == arrays);
+    REQUIRE(arrays->size() == 10);
+    message.detections[3].confidence = 0.25f;
+    REQUIRE(message.getArrays().confidences[3] == 0.25f);
+    message.detections[4].labelName = "person";
+    REQUIRE(message.getArrays().labelNames[4] == "person");
+    message.detections.pop_back();
+    REQUIRE(message.getArrays().size() == 9);
+
+    // Copies of the message keep them, and set arrays are kept as they are
+    ImgDetections copy = message;
+    REQUIRE(copy.getArrays().matches(copy.detections));
+    ImgDetectionArrays replacement;
+    replacement.add(makeDetection(20));
+    copy.setArrays(replacement);
+    REQUIRE(copy.getArrays().size() == 1);
+    REQUIRE(equalDetections(copy.getArrays().get(0), makeDetection(20)));
+    REQUIRE(message.getArrays().size() == 9);
+
+    Tracklets tracklets;
+    for(int i = 0; i < 10; i++) tracklets.tracklets.push_back(makeTracklet(i));
+    const auto* trackletArrays = &tracklets.getArrays();
+    REQUIRE(&tracklets.getArrays() == trackletArrays);
+    tracklets.tracklets[2].srcImgDetection.ymax = 0.75f;
+    REQUIRE(tracklets.getArrays().srcImgDetections.boxes[2 * 4 + 3] == 0.75f);
+    tracklets.tracklets[5].roi.normalized = !tracklets.tracklets[5].roi.normalized;
+    REQUIRE(tracklets.getArrays().matches(tracklets.tracklets));
+}
+
+TEST_CASE("Detection arrays - serialization round trip") {
+    TrackletArrays arrays;
+    for(int i = 0; i < 10; i++) arrays.add(makeTracklet(i));
+    arrays.srcImgDetections.labelNames.assign(10, "car");
+
+    TrackletArrays deserialized;
+    REQUIRE(utility::deserialize(utility::serialize(arrays), deserialized));
+    REQUIRE(deserialized.size() == 10);
+    const auto original = arrays.toTracklets();
+    const auto restored = deserialized.toTracklets();
+    for(size_t i = 0; i < original.size(); i++) REQUIRE(equalTracklets(restored[i], original[i]));
+    REQUIRE(restored[9].srcImgDetection.labelName == "car");
+}
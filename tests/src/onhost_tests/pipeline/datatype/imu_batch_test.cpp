@@ -0,0 +1,164 @@
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "depthai/depthai.hpp"
+#include "depthai/pipeline/datatype/StreamMessageParser.hpp"
+
+using namespace dai;
+
+namespace {
+
+Timestamp makeTimestamp(int64_t nanoseconds) {
+    Timestamp timestamp;
+    timestamp.sec = nanoseconds / 1000000000;
+    timestamp.nsec = nanoseconds % 1000000000;
+    return timestamp;
+}
+
+template <typename T>
+void setReport(T& report, int32_t sequence, int64_t nanoseconds) {
+    report.sequence = sequence;
+    report.accuracy = IMUReport::Accuracy::HIGH;
+    report.timestamp = makeTimestamp(nanoseconds);
+    report.tsDevice = makeTimestamp(nanoseconds - 500000000);
+}
+
+// Accelerometer and gyroscope packets at 400 Hz, with the rotation vector in every other packet
+std::vector<IMUPacket> makePackets(int count) {
+    std::vector<IMUPacket> packets(count);
+    for(int i = 0; i < count; i++) {
+        auto& packet = packets[i];
+        const int64_t time = 1700000000123456789ll + i * 2500000ll;
+        setReport(packet.acceleroMeter, i, time);
+        packet.acceleroMeter.x = 0.1f * i;
+        packet.acceleroMeter.y = -9.81f;
+        packet.acceleroMeter.z = 0.5f;
+        setReport(packet.gyroscope, 100 + i, time + 1000);
+        packet.gyroscope.x = 0.01f * i;
+        packet.gyroscope.y = 0.02f;
+        packet.gyroscope.z = -0.03f;
+        if(i % 2 == 0) {
+            setReport(packet.rotationVector, i / 2, time + 2000);
+            packet.rotationVector.i = 0.1f;
+            packet.rotationVector.j = 0.2f;
+            packet.rotationVector.k = 0.3f;
+            packet.rotationVector.real = 0.9f;
+            packet.rotationVector.rotationVectorAccuracy = 0.05f * i;
+        }
+    }
+    return packets;
+}
+
+bool equalReports(const IMUReport& a, const IMUReport& b) {
+    return a.sequence == b.sequence && a.accuracy == b.accuracy && a.timestamp.sec == b.timestamp.sec && a.timestamp.nsec == b.timestamp.nsec
+           && a.tsDevice.sec == b.tsDevice.sec && a.tsDevice.nsec == b.tsDevice.nsec;
+}
+
+bool equalPackets(const IMUPacket& a, const IMUPacket& b) {
+    return equalReports(a.acceleroMeter, b.acceleroMeter) && a.acceleroMeter.x == b.acceleroMeter.x && a.acceleroMeter.y == b.acceleroMeter.y
+           && a.acceleroMeter.z == b.acceleroMeter.z && equalReports(a.gyroscope, b.gyroscope) && a.gyroscope.x == b.gyroscope.x
+           && a.gyroscope.y == b.gyroscope.y && a.gyroscope.z == b.gyroscope.z && equalReports(a.magneticField, b.magneticField)
+           && a.magneticField.x == b.magneticField.x && equalReports(a.rotationVector, b.rotationVector) && a.rotationVector.i == b.rotationVector.i
+           && a.rotationVector.j == b.rotationVector.j && a.rotationVector.k == b.rotationVector.k && a.rotationVector.real == b.rotationVector.real
+           && a.rotationVector.rotationVectorAccuracy == b.rotationVector.rotationVectorAccuracy;
+}
+
+}  // namespace
+
+TEST_CASE("IMUBatch - round trip through IMUData") {
+    IMUData imuData;
+    imuData.packets = makePackets(9);
+    imuData.sequenceNum = 42;
+    imuData.ts = makeTimestamp(1700000000200000000ll);
+    imuData.tsDevice = makeTimestamp(1700000000100000000ll);
+
+    IMUBatch batch(imuData);
+    REQUIRE(batch.getNumPackets() == 9);
+    REQUIRE(batch.hasReport(IMUBatch::Report::ACCELEROMETER));
+    REQUIRE(batch.hasReport(IMUBatch::Report::GYROSCOPE));
+    REQUIRE_FALSE(batch.hasReport(IMUBatch::Report::MAGNETIC_FIELD));
+    REQUIRE(batch.hasReport(IMUBatch::Report::ROTATION_VECTOR));
+    REQUIRE(batch.getSequenceNum() == 42);
+
+    // Only the stored reports take space: 3 offset and sequence columns, the values and the padded accuracies
+    REQUIRE(batch.getData().size() == 9 * (12 + 12) + 12 + 9 * (12 + 12) + 12 + 9 * (12 + 20) + 12);
+
+    auto restored = batch.toIMUData();
+    REQUIRE(restored->getSequenceNum() == 42);
+    REQUIRE(restored->getTimestamp() == imuData.getTimestamp());
+    REQUIRE(restored->getTimestampDevice() == imuData.getTimestampDevice());
+    REQUIRE(restored->packets.size() == imuData.packets.size());
+    for(size_t i = 0; i < imuData.packets.size(); i++) REQUIRE(equalPackets(restored->packets[i], imuData.packets[i]));
+}
+
+TEST_CASE("IMUBatch - columns") {
+    const auto packets = makePackets(4);
+    IMUBatch batch;
+    batch.setPackets(packets);
+
+    REQUIRE(batch.getBaseTimestamp() == packets[0].acceleroMeter.getTimestamp());
+    REQUIRE(batch.getBaseTimestampDevice() == packets[0].acceleroMeter.getTimestampDevice());
+
+    const auto offsets = batch.getTimestampOffsets(IMUBatch::Report::GYROSCOPE);
+    REQUIRE(offsets.size() == 4);
+    REQUIRE(offsets[0] == 1000);
+    REQUIRE(offsets[3] == 3 * 2500000 + 1000);
+    REQUIRE(batch.getTimestampDeviceOffsets(IMUBatch::Report::ACCELEROMETER)[2] == 2 * 2500000);
+
+    const auto values = batch.getValues(IMUBatch::Report::ACCELEROMETER);
+    REQUIRE(values.size() == 4 * 3);
+    REQUIRE(values[3 * 3] == packets[3].acceleroMeter.x);
+    REQUIRE(values[3 * 3 + 1] == packets[3].acceleroMeter.y);
+    REQUIRE(batch.getSequenceNums(IMUBatch::Report::GYROSCOPE)[2] == 102);
+    REQUIRE(batch.getAccuracies(IMUBatch::Report::GYROSCOPE)[1] == IMUReport::Accuracy::HIGH);
+
+    // Reports missing from some packets have no timestamps there
+    const auto rotationOffsets = batch.getTimestampOffsets(IMUBatch::Report::ROTATION_VECTOR);
+    REQUIRE(rotationOffsets[0] == 2000);
+    REQUIRE(rotationOffsets[1] == IMUBatch::NO_TIMESTAMP);
+    REQUIRE(batch.getValues(IMUBatch::Report::ROTATION_VECTOR).size() == 4 * 5);
+
+    // Reports that aren't stored have empty columns
+    REQUIRE(batch.getValues(IMUBatch::Report::MAGNETIC_FIELD).empty());
+    REQUIRE(batch.getTimestampOffsets(IMUBatch::Report::MAGNETIC_FIELD).empty());
+}
+
+TEST_CASE("IMUBatch - empty and invalid batches") {
+    IMUBatch empty;
+    empty.setPackets(std::vector<IMUPacket>{});
+    REQUIRE(empty.getNumPackets() == 0);
+    REQUIRE(empty.getData().empty());
+    REQUIRE(empty.getPackets().empty());
+
+    // Offsets have to fit 32 bits
+    auto packets = makePackets(2);
+    packets[1].acceleroMeter.timestamp = makeTimestamp(1700000005000000000ll);
+    IMUBatch batch;
+    REQUIRE_THROWS_AS(batch.setPackets(packets), std::invalid_argument);
+}
+
+TEST_CASE("IMUBatch - stream message round trip") {
+    IMUBatch batch;
+    batch.setPackets(makePackets(5));
+    batch.setSequenceNum(7);
+
+    const auto data = batch.getData();
+    std::vector<std::uint8_t> serialized(data.begin(), data.end());
+    const auto metadata = StreamMessageParser::serializeMetadata(batch);
+    serialized.insert(serialized.end(), metadata.begin(), metadata.end());
+
+    streamPacketDesc_t packet;
+    packet.data = serialized.data();
+    packet.length = static_cast<uint32_t>(serialized.size());
+    packet.fd = -1;
+    auto parsed = std::dynamic_pointer_cast<IMUBatch>(StreamMessageParser::parseMessage(&packet));
+    REQUIRE(parsed != nullptr);
+    REQUIRE(parsed->getSequenceNum() == 7);
+    REQUIRE(parsed->getNumPackets() == 5);
+    REQUIRE(parsed->getBaseTimestamp() == batch.getBaseTimestamp());
+    const auto original = batch.getPackets();
+    const auto restored = parsed->getPackets();
+    for(size_t i = 0; i < original.size(); i++) REQUIRE(equalPackets(restored[i], original[i]));
+}
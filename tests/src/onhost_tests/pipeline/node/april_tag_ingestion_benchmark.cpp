@@ -0,0 +1,171 @@
+// Benchmark of the host AprilTag node on 4K frames, in CPU time per frame.
+// Compares the previous ingestion, which converted every frame but GRAY8 and NV12 with getCvFrame() and cvtColor into a new image,
+// with the current one, which converts interleaved frames in place into a reused image and can restrict detection to a ROI.
+// Both mirror AprilTag::run, and each frame is also passed through the detector, whose time is reported separately.
+//
+// Usage: april_tag_ingestion_benchmark [frames] [detector threads]
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <memory>
+#include <opencv2/imgproc.hpp>
+#include <vector>
+
+#include "depthai/depthai.hpp"
+
+extern "C" {
+#include "apriltag.h"
+#include "tag36h11.h"
+}
+
+using namespace dai;
+
+namespace {
+
+constexpr int WIDTH = 3840;
+constexpr int HEIGHT = 2160;
+constexpr int SCALE = 24;
+
+// Tags of the 36h11 family spread over the frame, one of them inside the ROI
+const std::vector<std::pair<int, int>> TAGS = {{200, 200}, {1500, 800}, {3000, 1500}, {600, 1600}};
+const Rect ROI{1280, 720, 1280, 720};
+
+std::vector<std::uint8_t> renderScene() {
+    std::vector<std::uint8_t> pixels(static_cast<size_t>(WIDTH) * HEIGHT);
+    // Some texture, so the detector has edges to reject
+    for(int y = 0; y < HEIGHT; y++) {
+        for(int x = 0; x < WIDTH; x++) pixels[static_cast<size_t>(y) * WIDTH + x] = static_cast<std::uint8_t>(150 + ((x / 64 + y / 64) % 2) * 60);
+    }
+    apriltag_family_t* family = tag36h11_create();
+    for(size_t id = 0; id < TAGS.size(); id++) {
+        image_u8_t* image = apriltag_to_image(family, static_cast<int>(id));
+        for(int y = 0; y < image->height * SCALE; y++) {
+            for(int x = 0; x < image->width * SCALE; x++) {
+                pixels[static_cast<size_t>(TAGS[id].second + y) * WIDTH + TAGS[id].first + x] = image->buf[(y / SCALE) * image->stride + x / SCALE];
+            }
+        }
+        image_u8_destroy(image);
+    }
+    tag36h11_destroy(family);
+    return pixels;
+}
+
+std::shared_ptr<ImgFrame> makeFrame(const std::vector<std::uint8_t>& gray, ImgFrame::Type type) {
+    const size_t size = gray.size();
+    std::vector<std::uint8_t> data;
+    int stride = WIDTH;
+    if(type == ImgFrame::Type::NV12) {
+        data = gray;
+        data.resize(size + size / 2, 128);
+    } else {
+        data.resize(size * 3);
+        for(size_t i = 0; i < size; i++) std::fill_n(&data[i * 3], 3, gray[i]);
+        stride = WIDTH * 3;
+    }
+    auto frame = std::make_shared<ImgFrame>();
+    frame->setType(type);
+    frame->setSize(WIDTH, HEIGHT);
+    frame->setStride(stride);
+    frame->setData(data);
+    if(type == ImgFrame::Type::NV12) frame->fb.p2Offset = static_cast<unsigned int>(size);
+    return frame;
+}
+
+// As before, a new gray image converted from the BGR copy of the frame
+image_u8_t ingestPrevious(ImgFrame& frame, std::unique_ptr<cv::Mat>& gray) {
+    if(frame.getType() == ImgFrame::Type::GRAY8 || frame.getType() == ImgFrame::Type::NV12) {
+        auto* data = frame.data->getData().data() + frame.fb.p1Offset;
+        return {static_cast<int32_t>(frame.getWidth()), static_cast<int32_t>(frame.getHeight()), static_cast<int32_t>(frame.getStride()), data};
+    }
+    gray = std::make_unique<cv::Mat>();
+    cv::cvtColor(frame.getCvFrame(), *gray, cv::COLOR_BGR2GRAY);
+    return {gray->cols, gray->rows, gray->cols, gray->data};
+}
+
+// As now, the luma plane in place or interleaved pixels converted in place into a reused image, within the region
+image_u8_t ingestCurrent(ImgFrame& frame, const Rect& roi, cv::Mat& gray) {
+    const auto region = roi.empty() ? Rect(0, 0, frame.getWidth(), frame.getHeight()) : roi;
+    const auto x = static_cast<int32_t>(region.x);
+    const auto y = static_cast<int32_t>(region.y);
+    const auto width = static_cast<int32_t>(region.width);
+    const auto height = static_cast<int32_t>(region.height);
+    const auto stride = static_cast<int32_t>(frame.getStride());
+    uint8_t* data = frame.data->getData().data() + frame.fb.p1Offset;
+    if(frame.getType() == ImgFrame::Type::NV12) {
+        return {width, height, stride, data + static_cast<size_t>(y) * stride + x};
+    }
+    const cv::Mat pixels(height, width, CV_8UC3, data + static_cast<size_t>(y) * stride + static_cast<size_t>(x) * 3, stride);
+    cv::cvtColor(pixels, gray, cv::COLOR_BGR2GRAY);
+    return {width, height, static_cast<int32_t>(gray.step), gray.data};
+}
+
+double cpuMs(std::clock_t start, std::clock_t end) {
+    return 1000.0 * static_cast<double>(end - start) / CLOCKS_PER_SEC;
+}
+
+struct Result {
+    double ingestMs = 0;
+    double detectMs = 0;
+    int detections = 0;
+};
+
+template <typename Ingest>
+Result run(apriltag_detector_t* detector, int numFrames, Ingest ingest) {
+    Result result;
+    for(int i = 0; i < numFrames; i++) {
+        const auto start = std::clock();
+        auto image = ingest();
+        const auto converted = std::clock();
+        zarray_t* detections = apriltag_detector_detect(detector, &image);
+        const auto end = std::clock();
+        result.ingestMs += cpuMs(start, converted);
+        result.detectMs += cpuMs(converted, end);
+        result.detections = zarray_size(detections);
+        apriltag_detections_destroy(detections);
+    }
+    result.ingestMs /= numFrames;
+    result.detectMs /= numFrames;
+    return result;
+}
+
+void print(const char* name, const Result& result) {
+    std::printf("%-28s ingest %7.2f ms  detect %8.2f ms  total %8.2f ms  (%d tags)\n",
+                name,
+                result.ingestMs,
+                result.detectMs,
+                result.ingestMs + result.detectMs,
+                result.detections);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const int numFrames = argc > 1 ? std::atoi(argv[1]) : 20;
+    const int numThreads = argc > 2 ? std::atoi(argv[2]) : 1;
+
+    apriltag_family_t* family = tag36h11_create();
+    std::unique_ptr<apriltag_detector_t, void (*)(apriltag_detector_t*)> detector(apriltag_detector_create(), apriltag_detector_destroy);
+    apriltag_detector_add_family(detector.get(), family);
+    // Defaults of AprilTagConfig
+    detector->quad_decimate = 4;
+    detector->nthreads = numThreads;
+
+    const auto scene = renderScene();
+    std::printf("%dx%d, %d frames, %d detector threads, CPU time per frame\n", WIDTH, HEIGHT, numFrames, numThreads);
+    for(auto type : {ImgFrame::Type::NV12, ImgFrame::Type::BGR888i}) {
+        auto frame = makeFrame(scene, type);
+        std::unique_ptr<cv::Mat> previousGray;
+        cv::Mat currentGray;
+        std::printf("%s\n", type == ImgFrame::Type::NV12 ? "NV12" : "BGR888i");
+        print("  previous", run(detector.get(), numFrames, [&]() { return ingestPrevious(*frame, previousGray); }));
+        print("  current", run(detector.get(), numFrames, [&]() { return ingestCurrent(*frame, Rect{}, currentGray); }));
+        print("  current, 1280x720 ROI", run(detector.get(), numFrames, [&]() { return ingestCurrent(*frame, ROI, currentGray); }));
+    }
+
+    apriltag_detector_clear_families(detector.get());
+    tag36h11_destroy(family);
+    return 0;
+}
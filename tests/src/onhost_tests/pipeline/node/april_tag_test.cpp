@@ -0,0 +1,171 @@
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "depthai/depthai.hpp"
+
+extern "C" {
+#include "apriltag.h"
+#include "tag36h11.h"
+}
+
+using namespace dai;
+
+namespace {
+
+constexpr int WIDTH = 640;
+constexpr int HEIGHT = 480;
+constexpr int SCALE = 12;
+
+struct PlacedTag {
+    int id;
+    int x;
+    int y;
+};
+
+// Tags of the 36h11 family, each 10 cells wide including the white border, at 12 pixels per cell
+const std::vector<PlacedTag> TAGS = {{0, 40, 40}, {1, 260, 180}, {2, 480, 320}};
+
+// Gray scene of the tags on a light background
+std::vector<std::uint8_t> renderScene() {
+    std::vector<std::uint8_t> pixels(static_cast<size_t>(WIDTH) * HEIGHT, 200);
+    apriltag_family_t* family = tag36h11_create();
+    for(const auto& tag : TAGS) {
+        image_u8_t* image = apriltag_to_image(family, tag.id);
+        for(int y = 0; y < image->height * SCALE; y++) {
+            for(int x = 0; x < image->width * SCALE; x++) {
+                pixels[static_cast<size_t>(tag.y + y) * WIDTH + tag.x + x] = image->buf[(y / SCALE) * image->stride + x / SCALE];
+            }
+        }
+        image_u8_destroy(image);
+    }
+    tag36h11_destroy(family);
+    return pixels;
+}
+
+// The scene in the given type. Colors are gray, so the luma of every type equals the scene.
+std::shared_ptr<ImgFrame> makeFrame(const std::vector<std::uint8_t>& gray, ImgFrame::Type type) {
+    const size_t size = gray.size();
+    std::vector<std::uint8_t> data;
+    int stride = WIDTH;
+    switch(type) {
+        case ImgFrame::Type::GRAY8:
+            data = gray;
+            break;
+        case ImgFrame::Type::NV12:
+            data = gray;
+            data.resize(size + size / 2, 128);
+            break;
+        case ImgFrame::Type::RGB888i:
+        case ImgFrame::Type::BGR888i:
+            data.resize(size * 3);
+            for(size_t i = 0; i < size; i++) std::fill_n(&data[i * 3], 3, gray[i]);
+            stride = WIDTH * 3;
+            break;
+        case ImgFrame::Type::RGB888p:
+            for(int plane = 0; plane < 3; plane++) data.insert(data.end(), gray.begin(), gray.end());
+            break;
+        default:
+            FAIL("Unexpected frame type");
+    }
+    auto frame = std::make_shared<ImgFrame>();
+    frame->setType(type);
+    frame->setSize(WIDTH, HEIGHT);
+    frame->setStride(stride);
+    frame->setData(data);
+    if(type == ImgFrame::Type::NV12) frame->fb.p2Offset = static_cast<unsigned int>(size);
+    return frame;
+}
+
+std::vector<dai::AprilTag> detect(std::shared_ptr<ImgFrame> frame, const Rect& roi = Rect()) {
+    Pipeline pipeline(false);
+    auto aprilTag = pipeline.create<node::AprilTag>();
+    aprilTag->setRunOnHost(true);
+    aprilTag->initialConfig->setFamily(AprilTagConfig::Family::TAG_36H11);
+    aprilTag->setRoi(roi);
+    auto inputQueue = aprilTag->inputImage.createInputQueue();
+    auto outputQueue = aprilTag->out.createOutputQueue();
+    pipeline.start();
+    inputQueue->send(frame);
+    auto result = outputQueue->get<AprilTags>();
+    pipeline.stop();
+    REQUIRE(result != nullptr);
+    auto tags = result->aprilTags;
+    std::sort(tags.begin(), tags.end(), [](const dai::AprilTag& a, const dai::AprilTag& b) { return a.id < b.id; });
+    return tags;
+}
+
+std::vector<Point2f> corners(const dai::AprilTag& tag) {
+    return {tag.topLeft, tag.topRight, tag.bottomRight, tag.bottomLeft};
+}
+
+bool sameCorners(const dai::AprilTag& a, const dai::AprilTag& b, float tolerance) {
+    const auto cornersA = corners(a);
+    const auto cornersB = corners(b);
+    for(size_t i = 0; i < cornersA.size(); i++) {
+        if(std::abs(cornersA[i].x - cornersB[i].x) > tolerance || std::abs(cornersA[i].y - cornersB[i].y) > tolerance) return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+TEST_CASE("AprilTag - RGB and YUV frames give the same detections as gray ones") {
+    const auto scene = renderScene();
+    const auto expected = detect(makeFrame(scene, ImgFrame::Type::GRAY8));
+    REQUIRE(expected.size() == TAGS.size());
+    for(size_t i = 0; i < TAGS.size(); i++) {
+        REQUIRE(expected[i].id == TAGS[i].id);
+        // The black square spans cells 1..9 of the tag
+        float xmin = WIDTH, xmax = 0.0f, ymin = HEIGHT, ymax = 0.0f;
+        for(const auto& corner : corners(expected[i])) {
+            xmin = std::min(xmin, corner.x);
+            xmax = std::max(xmax, corner.x);
+            ymin = std::min(ymin, corner.y);
+            ymax = std::max(ymax, corner.y);
+        }
+        REQUIRE(std::abs(xmin - (TAGS[i].x + SCALE)) < 2.0f);
+        REQUIRE(std::abs(ymin - (TAGS[i].y + SCALE)) < 2.0f);
+        REQUIRE(std::abs(xmax - (TAGS[i].x + 9 * SCALE)) < 2.0f);
+        REQUIRE(std::abs(ymax - (TAGS[i].y + 9 * SCALE)) < 2.0f);
+    }
+
+    // The luma plane is used in place, interleaved and planar RGB are converted to the same gray image
+    for(auto type : {ImgFrame::Type::NV12, ImgFrame::Type::BGR888i, ImgFrame::Type::RGB888i, ImgFrame::Type::RGB888p}) {
+        const auto tags = detect(makeFrame(scene, type));
+        REQUIRE(tags.size() == expected.size());
+        for(size_t i = 0; i < tags.size(); i++) {
+            REQUIRE(tags[i].id == expected[i].id);
+            REQUIRE(sameCorners(tags[i], expected[i], 1e-3f));
+        }
+    }
+}
+
+TEST_CASE("AprilTag - detection is restricted to the ROI") {
+    const auto scene = renderScene();
+    const auto all = detect(makeFrame(scene, ImgFrame::Type::GRAY8));
+    REQUIRE(all.size() == TAGS.size());
+
+    // Region around the second tag only, corners are in frame coordinates
+    const Rect roi(200, 148, 240, 200);
+    for(auto type : {ImgFrame::Type::GRAY8, ImgFrame::Type::NV12, ImgFrame::Type::BGR888i, ImgFrame::Type::RGB888p}) {
+        const auto tags = detect(makeFrame(scene, type), roi);
+        REQUIRE(tags.size() == 1);
+        REQUIRE(tags[0].id == 1);
+        REQUIRE(sameCorners(tags[0], all[1], 0.5f));
+    }
+
+    // Normalized regions are scaled to the frame
+    const auto normalized = detect(makeFrame(scene, ImgFrame::Type::GRAY8), roi.normalize(WIDTH, HEIGHT));
+    REQUIRE(normalized.size() == 1);
+    REQUIRE(normalized[0].id == 1);
+
+    // A region partly outside the frame is clipped, one completely outside detects nothing
+    const auto clipped = detect(makeFrame(scene, ImgFrame::Type::GRAY8), Rect(440, 280, 400, 400));
+    REQUIRE(clipped.size() == 1);
+    REQUIRE(clipped[0].id == 2);
+    REQUIRE(detect(makeFrame(scene, ImgFrame::Type::BGR888i), Rect(WIDTH + 10, 0, 100, 100)).empty());
+}
@@ -0,0 +1,112 @@
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "depthai/depthai.hpp"
+
+using namespace dai;
+
+namespace {
+
+constexpr int WIDTH = 320;
+constexpr int HEIGHT = 200;
+
+std::shared_ptr<ImgFrame> makeFrame(int sequenceNum) {
+    auto frame = std::make_shared<ImgFrame>();
+    frame->setType(ImgFrame::Type::BGR888i);
+    frame->setSize(WIDTH, HEIGHT);
+    frame->setStride(WIDTH * 3);
+    frame->setData(std::vector<std::uint8_t>(static_cast<size_t>(WIDTH) * HEIGHT * 3, 40));
+    frame->setSourceSize(WIDTH, HEIGHT);
+    frame->setSequenceNum(sequenceNum);
+    frame->setTimestamp(std::chrono::steady_clock::now());
+    return frame;
+}
+
+}  // namespace
+
+TEST_CASE("Display - headless compositing") {
+    Pipeline pipeline(false);
+    auto display = pipeline.create<node::Display>();
+    display->setHeadless(true);
+    REQUIRE(display->isHeadless());
+    auto inputQueue = display->input.createInputQueue();
+    auto outputQueue = display->out.createOutputQueue();
+    pipeline.start();
+
+    auto frame = makeFrame(5);
+    inputQueue->send(frame);
+    auto composited = outputQueue->get<ImgFrame>();
+    REQUIRE(composited != nullptr);
+    REQUIRE(composited->getType() == ImgFrame::Type::BGR888i);
+    REQUIRE(composited->getWidth() == WIDTH);
+    REQUIRE(composited->getHeight() == HEIGHT);
+    REQUIRE(composited->getSequenceNum() == 5);
+    REQUIRE(composited->getTimestamp() == frame->getTimestamp());
+
+    // The overlay is drawn on the frame
+    auto data = composited->getData();
+    size_t changed = 0;
+    for(auto value : data) changed += value != 40;
+    REQUIRE(changed > 0);
+    REQUIRE(display->getRenderedFrames() == 1);
+    REQUIRE(display->getDroppedFrames() == 0);
+    pipeline.stop();
+}
+
+TEST_CASE("Display - a stalled renderer drops frames instead of blocking") {
+    Pipeline pipeline(false);
+    auto display = pipeline.create<node::Display>();
+    display->setHeadless(true);
+    auto inputQueue = display->input.createInputQueue();
+    // The renderer blocks on the second frame until the first one is read
+    auto outputQueue = display->out.createOutputQueue(1, true);
+    pipeline.start();
+
+    constexpr int numFrames = 10;
+    for(int i = 0; i < numFrames; i++) inputQueue->send(makeFrame(i));
+
+    // Besides the frame waiting to be rendered, at most two are held by the renderer, the rest is dropped
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while(display->getDroppedFrames() < numFrames - 3 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    REQUIRE(display->getDroppedFrames() >= numFrames - 3);
+
+    // The latest frame is always rendered
+    int64_t lastSequenceNum = -1;
+    while(lastSequenceNum != numFrames - 1) {
+        auto composited = outputQueue->get<ImgFrame>();
+        REQUIRE(composited->getSequenceNum() > lastSequenceNum);
+        lastSequenceNum = composited->getSequenceNum();
+    }
+    deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while(display->getRenderedFrames() + display->getDroppedFrames() < numFrames && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    REQUIRE(display->getRenderedFrames() + display->getDroppedFrames() == numFrames);
+    pipeline.stop();
+}
+
+TEST_CASE("Display - a failing renderer stops the pipeline") {
+    Pipeline pipeline(false);
+    auto display = pipeline.create<node::Display>();
+    display->setHeadless(true);
+    auto inputQueue = display->input.createInputQueue();
+    auto outputQueue = display->out.createOutputQueue();
+    pipeline.start();
+
+    // A frame without enough data can't be converted for rendering
+    auto frame = makeFrame(0);
+    frame->setData(std::vector<std::uint8_t>(16));
+    inputQueue->send(frame);
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while(pipeline.isRunning() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    REQUIRE_FALSE(pipeline.isRunning());
+    REQUIRE(display->getRenderedFrames() == 0);
+}
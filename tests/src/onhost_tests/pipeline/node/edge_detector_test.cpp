@@ -0,0 +1,151 @@
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "depthai/depthai.hpp"
+
+using namespace dai;
+
+namespace {
+
+using Kernel = std::vector<std::vector<int>>;
+
+const Kernel SOBEL_HORIZONTAL = {{1, 0, -1}, {2, 0, -2}, {1, 0, -1}};
+const Kernel SOBEL_VERTICAL = {{1, 2, 1}, {0, 0, 0}, {-1, -2, -1}};
+
+std::vector<std::uint8_t> randomPixels(size_t size, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> intensity(0, 255);
+    std::vector<std::uint8_t> pixels(size);
+    for(auto& pixel : pixels) pixel = static_cast<std::uint8_t>(intensity(rng));
+    return pixels;
+}
+
+// Straightforward gradient magnitude with replicated borders
+std::vector<std::uint8_t> reference(const std::uint8_t* src, int width, int height, int stride, const Kernel& horizontal, const Kernel& vertical) {
+    std::vector<std::uint8_t> result(static_cast<size_t>(width) * height);
+    for(int y = 0; y < height; y++) {
+        for(int x = 0; x < width; x++) {
+            long gx = 0, gy = 0;
+            for(int dy = -1; dy <= 1; dy++) {
+                for(int dx = -1; dx <= 1; dx++) {
+                    const long pixel = src[std::clamp(y + dy, 0, height - 1) * stride + std::clamp(x + dx, 0, width - 1)];
+                    gx += horizontal[dy + 1][dx + 1] * pixel;
+                    gy += vertical[dy + 1][dx + 1] * pixel;
+                }
+            }
+            const double magnitude = std::sqrt(static_cast<double>(gx) * gx + static_cast<double>(gy) * gy);
+            result[y * width + x] = static_cast<std::uint8_t>(std::min(255L, std::lround(magnitude)));
+        }
+    }
+    return result;
+}
+
+std::shared_ptr<ImgFrame> grayFrame(int width, int height, int sequenceNum) {
+    auto frame = std::make_shared<ImgFrame>();
+    frame->setType(ImgFrame::Type::GRAY8);
+    frame->setSize(width, height);
+    frame->setStride(width);
+    frame->setData(randomPixels(static_cast<size_t>(width) * height, sequenceNum));
+    frame->setSequenceNum(sequenceNum);
+    return frame;
+}
+
+void requireOutput(const std::shared_ptr<ImgFrame>& output, const std::shared_ptr<ImgFrame>& input, const std::vector<std::uint8_t>& expected) {
+    REQUIRE(output != nullptr);
+    REQUIRE(output->getType() == ImgFrame::Type::GRAY8);
+    REQUIRE(output->getWidth() == input->getWidth());
+    REQUIRE(output->getHeight() == input->getHeight());
+    REQUIRE(output->getStride() == input->getWidth());
+    REQUIRE(output->getSequenceNum() == input->getSequenceNum());
+    auto data = output->getData();
+    REQUIRE(std::vector<std::uint8_t>(data.begin(), data.end()) == expected);
+}
+
+}  // namespace
+
+TEST_CASE("EdgeDetector on host - default Sobel kernels") {
+    Pipeline pipeline(false);
+    auto edgeDetector = pipeline.create<node::EdgeDetector>();
+    edgeDetector->setRunOnHost(true);
+    auto inputQueue = edgeDetector->inputImage.createInputQueue();
+    auto outputQueue = edgeDetector->outputImage.createOutputQueue();
+    auto passthroughQueue = edgeDetector->passthroughInputImage.createOutputQueue();
+    pipeline.start();
+
+    // Includes degenerate sizes, where a single pixel is both border and interior
+    const std::vector<std::pair<int, int>> sizes = {{640, 400}, {33, 17}, {1, 1}, {1, 7}, {9, 1}, {2, 2}};
+    int sequenceNum = 0;
+    for(const auto& size : sizes) {
+        auto frame = grayFrame(size.first, size.second, sequenceNum++);
+        inputQueue->send(frame);
+        auto data = frame->getData();
+        requireOutput(outputQueue->get<ImgFrame>(), frame, reference(data.data(), size.first, size.second, size.first, SOBEL_HORIZONTAL, SOBEL_VERTICAL));
+        REQUIRE(passthroughQueue->get<ImgFrame>()->getSequenceNum() == frame->getSequenceNum());
+    }
+    pipeline.stop();
+}
+
+TEST_CASE("EdgeDetector on host - custom kernels and config updates") {
+    const Kernel scharrHorizontal = {{3, 0, -3}, {10, 0, -10}, {3, 0, -3}};
+    const Kernel scharrVertical = {{3, 10, 3}, {0, 0, 0}, {-3, -10, -3}};
+    const Kernel largeHorizontal = {{-1024, 7, 1024}, {-5, 0, 3}, {-1, 900, 1}};
+    const Kernel largeVertical = {{0, 0, 0}, {0, 1, 0}, {0, 0, 0}};
+
+    Pipeline pipeline(false);
+    auto edgeDetector = pipeline.create<node::EdgeDetector>();
+    edgeDetector->setRunOnHost(true);
+    edgeDetector->initialConfig->setSobelFilterKernels(scharrHorizontal, scharrVertical);
+    auto inputQueue = edgeDetector->inputImage.createInputQueue();
+    auto configQueue = edgeDetector->inputConfig.createInputQueue();
+    auto outputQueue = edgeDetector->outputImage.createOutputQueue();
+    pipeline.start();
+
+    auto frame = grayFrame(320, 240, 0);
+    auto data = frame->getData();
+    inputQueue->send(frame);
+    requireOutput(outputQueue->get<ImgFrame>(), frame, reference(data.data(), 320, 240, 320, scharrHorizontal, scharrVertical));
+
+    auto config = std::make_shared<EdgeDetectorConfig>();
+    config->setSobelFilterKernels(largeHorizontal, largeVertical);
+    configQueue->send(config);
+    inputQueue->send(frame);
+    requireOutput(outputQueue->get<ImgFrame>(), frame, reference(data.data(), 320, 240, 320, largeHorizontal, largeVertical));
+
+    // Invalid config is ignored, the previous kernels stay in use
+    auto invalid = std::make_shared<EdgeDetectorConfig>();
+    invalid->setSobelFilterKernels({{1, 2}, {3, 4}}, SOBEL_VERTICAL);
+    configQueue->send(invalid);
+    inputQueue->send(frame);
+    requireOutput(outputQueue->get<ImgFrame>(), frame, reference(data.data(), 320, 240, 320, largeHorizontal, largeVertical));
+    pipeline.stop();
+}
+
+TEST_CASE("EdgeDetector on host - NV12 with padded stride") {
+    constexpr int WIDTH = 100;
+    constexpr int HEIGHT = 60;
+    constexpr int STRIDE = 128;
+
+    Pipeline pipeline(false);
+    auto edgeDetector = pipeline.create<node::EdgeDetector>();
+    edgeDetector->setRunOnHost(true);
+    auto inputQueue = edgeDetector->inputImage.createInputQueue();
+    auto outputQueue = edgeDetector->outputImage.createOutputQueue();
+    pipeline.start();
+
+    auto pixels = randomPixels(static_cast<size_t>(STRIDE) * HEIGHT * 3 / 2, 7);
+    auto frame = std::make_shared<ImgFrame>();
+    frame->setType(ImgFrame::Type::NV12);
+    frame->setSize(WIDTH, HEIGHT);
+    frame->setStride(STRIDE);
+    frame->fb.p1Offset = 0;
+    frame->fb.p2Offset = STRIDE * HEIGHT;
+    frame->fb.p3Offset = STRIDE * HEIGHT;
+    frame->setData(pixels);
+    inputQueue->send(frame);
+    requireOutput(outputQueue->get<ImgFrame>(), frame, reference(pixels.data(), WIDTH, HEIGHT, STRIDE, SOBEL_HORIZONTAL, SOBEL_VERTICAL));
+    pipeline.stop();
+}
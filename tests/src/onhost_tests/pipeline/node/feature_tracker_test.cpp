@@ -0,0 +1,157 @@
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "depthai/depthai.hpp"
+
+using namespace dai;
+
+namespace {
+
+constexpr int WIDTH = 640;
+constexpr int HEIGHT = 400;
+constexpr int MARGIN = 100;
+
+// Smooth random texture larger than the frame, so it can be translated
+class Texture {
+   public:
+    Texture() : width(WIDTH + 2 * MARGIN), height(HEIGHT + 2 * MARGIN), pixels(static_cast<size_t>(width) * height) {
+        constexpr int BLOCK = 8;
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<int> intensity(0, 255);
+        const int blocksPerRow = width / BLOCK + 1;
+        std::vector<float> blocks(static_cast<size_t>(blocksPerRow) * (height / BLOCK + 1));
+        for(auto& block : blocks) block = static_cast<float>(intensity(rng));
+        std::vector<float> raw(pixels.size());
+        for(int y = 0; y < height; y++) {
+            for(int x = 0; x < width; x++) raw[y * width + x] = blocks[(y / BLOCK) * blocksPerRow + x / BLOCK];
+        }
+        // 3x3 blur, so corners have sub-pixel structure
+        for(int y = 0; y < height; y++) {
+            for(int x = 0; x < width; x++) {
+                float sum = 0.f;
+                for(int dy = -1; dy <= 1; dy++) {
+                    for(int dx = -1; dx <= 1; dx++) sum += raw[std::clamp(y + dy, 0, height - 1) * width + std::clamp(x + dx, 0, width - 1)];
+                }
+                pixels[y * width + x] = sum / 9.f;
+            }
+        }
+    }
+
+    // Renders the frame with its top left corner at (offsetX, offsetY) of the texture
+    std::shared_ptr<ImgFrame> render(float offsetX, float offsetY, int sequenceNum) const {
+        std::vector<std::uint8_t> data(static_cast<size_t>(WIDTH) * HEIGHT);
+        for(int y = 0; y < HEIGHT; y++) {
+            for(int x = 0; x < WIDTH; x++) data[y * WIDTH + x] = static_cast<std::uint8_t>(std::lround(sample(x + offsetX, y + offsetY)));
+        }
+        auto frame = std::make_shared<ImgFrame>();
+        frame->setType(ImgFrame::Type::GRAY8);
+        frame->setSize(WIDTH, HEIGHT);
+        frame->setStride(WIDTH);
+        frame->setData(data);
+        frame->setSequenceNum(sequenceNum);
+        return frame;
+    }
+
+   private:
+    int width;
+    int height;
+    std::vector<float> pixels;
+
+    float sample(float x, float y) const {
+        const int ix = static_cast<int>(std::floor(x));
+        const int iy = static_cast<int>(std::floor(y));
+        const float ax = x - ix;
+        const float ay = y - iy;
+        auto at = [this](int px, int py) { return pixels[std::clamp(py, 0, height - 1) * width + std::clamp(px, 0, width - 1)]; };
+        return (1 - ax) * (1 - ay) * at(ix, iy) + ax * (1 - ay) * at(ix + 1, iy) + (1 - ax) * ay * at(ix, iy + 1) + ax * ay * at(ix + 1, iy + 1);
+    }
+};
+
+struct TrackingResult {
+    size_t numFeatures = 0;
+    size_t numTracked = 0;
+    size_t numAccurate = 0;
+    double meanError = 0.0;
+    std::uint32_t maxAge = 0;
+};
+
+// Runs the host FeatureTracker on a texture translating with constant velocity, comparing tracks to the true motion
+TrackingResult trackTranslation(const std::shared_ptr<FeatureTrackerConfig>& config, float velocityX, float velocityY, int numFrames = 10) {
+    Pipeline pipeline(false);
+    auto featureTracker = pipeline.create<node::FeatureTracker>();
+    featureTracker->setRunOnHost(true);
+    featureTracker->initialConfig = config;
+    auto inputQueue = featureTracker->inputImage.createInputQueue();
+    auto outputQueue = featureTracker->outputFeatures.createOutputQueue();
+    pipeline.start();
+
+    Texture texture;
+    TrackingResult result;
+    double errorSum = 0.0;
+    std::map<std::uint32_t, Point2f> previous;
+    for(int i = 0; i < numFrames; i++) {
+        inputQueue->send(texture.render(MARGIN + i * velocityX, MARGIN + i * velocityY, i));
+        auto features = outputQueue->get<TrackedFeatures>();
+        REQUIRE(features != nullptr);
+        REQUIRE(features->getSequenceNum() == i);
+        result.numFeatures = features->trackedFeatures.size();
+        for(const auto& feature : features->trackedFeatures) {
+            auto it = previous.find(feature.id);
+            if(it == previous.end()) continue;
+            // Content moves opposite to the frame offset
+            const double error = std::hypot(feature.position.x - (it->second.x - velocityX), feature.position.y - (it->second.y - velocityY));
+            errorSum += error;
+            result.numTracked++;
+            if(error < 0.5) result.numAccurate++;
+            result.maxAge = std::max(result.maxAge, feature.age);
+        }
+        previous.clear();
+        for(const auto& feature : features->trackedFeatures) previous[feature.id] = feature.position;
+    }
+    pipeline.stop();
+    if(result.numTracked > 0) result.meanError = errorSum / result.numTracked;
+    return result;
+}
+
+}  // namespace
+
+TEST_CASE("FeatureTracker on host - Harris corners with optical flow") {
+    auto config = std::make_shared<FeatureTrackerConfig>();
+    auto result = trackTranslation(config, 2.3f, -1.6f);
+    REQUIRE(result.numFeatures >= 200);
+    REQUIRE(result.numTracked >= 1000);
+    REQUIRE(result.numAccurate >= result.numTracked * 95 / 100);
+    REQUIRE(result.meanError < 0.2);
+    REQUIRE(result.maxAge >= 8);
+}
+
+TEST_CASE("FeatureTracker on host - Shi-Tomasi corners, larger motion") {
+    auto config = std::make_shared<FeatureTrackerConfig>();
+    config->setCornerDetector(FeatureTrackerConfig::CornerDetector::Type::SHI_THOMASI);
+    auto result = trackTranslation(config, 6.f, 4.f);
+    REQUIRE(result.numFeatures >= 200);
+    REQUIRE(result.numAccurate >= result.numTracked * 90 / 100);
+}
+
+TEST_CASE("FeatureTracker on host - feature budget") {
+    auto config = std::make_shared<FeatureTrackerConfig>();
+    config->setNumTargetFeatures(64);
+    config->cornerDetector.numMaxFeatures = 64;
+    auto result = trackTranslation(config, 1.f, 1.f, 4);
+    REQUIRE(result.numFeatures > 0);
+    REQUIRE(result.numFeatures <= 64);
+}
+
+TEST_CASE("FeatureTracker on host - without motion estimation") {
+    auto config = std::make_shared<FeatureTrackerConfig>();
+    config->setMotionEstimator(false);
+    auto result = trackTranslation(config, 1.f, 1.f, 4);
+    REQUIRE(result.numFeatures > 0);
+    // Features are detected anew on each frame
+    REQUIRE(result.numTracked == 0);
+}
@@ -0,0 +1,207 @@
+#include <array>
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "depthai/depthai.hpp"
+
+using namespace dai;
+
+namespace {
+
+constexpr int WIDTH = 64;
+constexpr int HEIGHT = 48;
+constexpr float FOCAL = 50.0f;
+
+std::array<std::array<float, 3>, 3> intrinsics(float cx, float cy) {
+    return {{{FOCAL, 0.0f, cx}, {0.0f, FOCAL, cy}, {0.0f, 0.0f, 1.0f}}};
+}
+
+// RAW16 depth frame of a plane tilted along x, depth = 1000 + 10 * x, or 0 where invalid
+std::shared_ptr<ImgFrame> makeDepthPlane(std::function<bool(int)> valid = [](int) { return true; }) {
+    std::vector<std::uint8_t> pixels(static_cast<size_t>(WIDTH) * HEIGHT * 2);
+    for(int y = 0; y < HEIGHT; y++) {
+        for(int x = 0; x < WIDTH; x++) {
+            const std::uint16_t depth = valid(x) ? static_cast<std::uint16_t>(1000 + 10 * x) : 0;
+            std::memcpy(&pixels[(static_cast<size_t>(y) * WIDTH + x) * 2], &depth, sizeof(depth));
+        }
+    }
+    auto frame = std::make_shared<ImgFrame>();
+    frame->setType(ImgFrame::Type::RAW16);
+    frame->setSize(WIDTH, HEIGHT);
+    frame->setStride(WIDTH * 2);
+    frame->setData(pixels);
+    frame->transformation = ImgTransformation(WIDTH, HEIGHT, intrinsics(32.0f, 24.0f));
+    frame->setTimestamp(std::chrono::steady_clock::time_point(std::chrono::milliseconds(1000)));
+    return frame;
+}
+
+ImgDetection makeDetection(float xmin, float ymin, float xmax, float ymax) {
+    ImgDetection detection;
+    detection.label = 1;
+    detection.confidence = 0.8f;
+    detection.xmin = xmin;
+    detection.ymin = ymin;
+    detection.xmax = xmax;
+    detection.ymax = ymax;
+    return detection;
+}
+
+std::shared_ptr<ImgDetections> makeDetections(std::vector<ImgDetection> detections) {
+    auto message = std::make_shared<ImgDetections>();
+    message->detections = std::move(detections);
+    message->transformation = ImgTransformation(WIDTH, HEIGHT, intrinsics(32.0f, 24.0f));
+    message->setSequenceNum(5);
+    message->setTimestamp(std::chrono::steady_clock::time_point(std::chrono::milliseconds(1000)));
+    return message;
+}
+
+std::shared_ptr<SpatialImgDetections> fuse(std::function<void(node::HostSpatialDetections&)> configure,
+                                           std::shared_ptr<ImgDetections> detections,
+                                           std::shared_ptr<ImgFrame> depth) {
+    Pipeline pipeline(false);
+    auto node = pipeline.create<node::HostSpatialDetections>();
+    configure(*node);
+    auto detectionsQueue = node->inputDetections.createInputQueue();
+    auto depthQueue = node->inputDepth.createInputQueue();
+    auto outputQueue = node->out.createOutputQueue();
+    pipeline.start();
+    detectionsQueue->send(detections);
+    depthQueue->send(depth);
+    auto result = outputQueue->get<SpatialImgDetections>();
+    pipeline.stop();
+    return result;
+}
+
+bool near(float a, float b) {
+    return std::abs(a - b) < 1e-2f;
+}
+
+}  // namespace
+
+TEST_CASE("HostSpatialDetections - calculation algorithms on a tilted plane") {
+    // Box over pixels x 16..31 and y 12..23, centered at 24,18
+    auto detections = makeDetections({makeDetection(0.25f, 0.25f, 0.5f, 0.5f)});
+    auto depthFor = [&](SpatialLocationCalculatorAlgorithm algorithm) {
+        auto result = fuse([&](node::HostSpatialDetections& node) { node.setSpatialCalculationAlgorithm(algorithm); }, detections, makeDepthPlane());
+        REQUIRE(result != nullptr);
+        REQUIRE(result->detections.size() == 1);
+        return result->detections[0].spatialCoordinates.z;
+    };
+    REQUIRE(near(depthFor(SpatialLocationCalculatorAlgorithm::AVERAGE), 1235.0f));
+    REQUIRE(near(depthFor(SpatialLocationCalculatorAlgorithm::MIN), 1160.0f));
+    REQUIRE(near(depthFor(SpatialLocationCalculatorAlgorithm::MAX), 1310.0f));
+    REQUIRE(near(depthFor(SpatialLocationCalculatorAlgorithm::MEDIAN), 1240.0f));
+
+    // X and Y follow from the intrinsics of the depth frame, Y points up
+    auto result = fuse([](node::HostSpatialDetections& node) { node.setSpatialCalculationAlgorithm(SpatialLocationCalculatorAlgorithm::AVERAGE); },
+                       detections,
+                       makeDepthPlane());
+    const auto& detection = result->detections[0];
+    REQUIRE(near(detection.spatialCoordinates.x, (24.0f - 32.0f) * 1235.0f / FOCAL));
+    REQUIRE(near(detection.spatialCoordinates.y, -(18.0f - 24.0f) * 1235.0f / FOCAL));
+    REQUIRE(detection.label == 1);
+    REQUIRE(detection.confidence == 0.8f);
+    REQUIRE(detection.boundingBoxMapping.calculationAlgorithm == SpatialLocationCalculatorAlgorithm::AVERAGE);
+    REQUIRE(result->getSequenceNum() == 5);
+    REQUIRE(result->transformation.has_value());
+}
+
+TEST_CASE("HostSpatialDetections - mode, thresholds and scale factor") {
+    // Every value of the box is equally frequent, the mode is the smallest one
+    auto detections = makeDetections({makeDetection(0.25f, 0.25f, 0.5f, 0.5f)});
+    auto result = fuse([](node::HostSpatialDetections& node) { node.setSpatialCalculationAlgorithm(SpatialLocationCalculatorAlgorithm::MODE); },
+                       detections,
+                       makeDepthPlane());
+    REQUIRE(near(result->detections[0].spatialCoordinates.z, 1160.0f));
+
+    // Values at or above the upper threshold are left out
+    result = fuse(
+        [](node::HostSpatialDetections& node) {
+            node.setSpatialCalculationAlgorithm(SpatialLocationCalculatorAlgorithm::MAX).setDepthUpperThreshold(1200);
+        },
+        detections,
+        makeDepthPlane());
+    REQUIRE(near(result->detections[0].spatialCoordinates.z, 1190.0f));
+
+    // Invalid pixels are left out, boxes without valid pixels have no spatial coordinates
+    auto partial = makeDetections({makeDetection(0.25f, 0.25f, 0.5f, 0.5f), makeDetection(0.0f, 0.0f, 0.125f, 0.5f)});
+    result = fuse([](node::HostSpatialDetections& node) { node.setSpatialCalculationAlgorithm(SpatialLocationCalculatorAlgorithm::AVERAGE); },
+                  partial,
+                  makeDepthPlane([](int x) { return x >= 24; }));
+    REQUIRE(result->detections.size() == 2);
+    REQUIRE(near(result->detections[0].spatialCoordinates.z, 1275.0f));
+    REQUIRE(result->detections[1].spatialCoordinates.x == 0.0f);
+    REQUIRE(result->detections[1].spatialCoordinates.z == 0.0f);
+
+    // Scaling keeps the center of the box, x 20..27
+    result = fuse(
+        [](node::HostSpatialDetections& node) {
+            node.setSpatialCalculationAlgorithm(SpatialLocationCalculatorAlgorithm::MIN).setBoundingBoxScaleFactor(0.5f);
+        },
+        detections,
+        makeDepthPlane());
+    REQUIRE(near(result->detections[0].spatialCoordinates.z, 1200.0f));
+    REQUIRE(near(result->detections[0].boundingBoxMapping.roi.x, 0.3125f));
+
+    Pipeline pipeline(false);
+    auto node = pipeline.create<node::HostSpatialDetections>();
+    REQUIRE_THROWS_AS(node->setBoundingBoxScaleFactor(0.0f), std::invalid_argument);
+    REQUIRE_THROWS_AS(node->setSpatialCalculationStepSize(0), std::invalid_argument);
+}
+
+TEST_CASE("HostSpatialDetections - boxes are remapped into the depth frame") {
+    // Detections are in a 128x96 image, the depth frame is its 64x48 crop at 32,24
+    auto detections = makeDetections({makeDetection(0.375f, 0.375f, 0.5f, 0.5f)});
+    detections->transformation = ImgTransformation(128, 96, intrinsics(64.0f, 48.0f));
+    auto depth = makeDepthPlane();
+    depth->transformation = ImgTransformation(128, 96, intrinsics(64.0f, 48.0f));
+    depth->transformation.addCrop(32, 24, WIDTH, HEIGHT);
+
+    auto result = fuse([](node::HostSpatialDetections& node) { node.setSpatialCalculationAlgorithm(SpatialLocationCalculatorAlgorithm::AVERAGE); },
+                       detections,
+                       depth);
+    const auto& detection = result->detections[0];
+    REQUIRE(near(detection.spatialCoordinates.z, 1235.0f));
+    REQUIRE(near(detection.spatialCoordinates.x, (24.0f - 32.0f) * 1235.0f / FOCAL));
+    // The box stays in the space of the detections
+    REQUIRE(detection.xmin == 0.375f);
+}
+
+TEST_CASE("HostSpatialDetections - depth frames without intrinsics are skipped") {
+    Pipeline pipeline(false);
+    auto node = pipeline.create<node::HostSpatialDetections>();
+    auto detectionsQueue = node->inputDetections.createInputQueue();
+    auto depthQueue = node->inputDepth.createInputQueue();
+    auto outputQueue = node->out.createOutputQueue();
+    pipeline.start();
+
+    // Identity intrinsics, as of a transformation created without calibration
+    auto uncalibrated = makeDepthPlane();
+    uncalibrated->transformation = ImgTransformation(WIDTH, HEIGHT);
+    detectionsQueue->send(makeDetections({makeDetection(0.25f, 0.25f, 0.5f, 0.5f)}));
+    depthQueue->send(uncalibrated);
+
+    // Detections without a transformation are used as they are
+    auto detections = makeDetections({makeDetection(0.25f, 0.25f, 0.5f, 0.5f)});
+    detections->transformation.reset();
+    detections->setSequenceNum(6);
+    detections->setTimestamp(std::chrono::steady_clock::time_point(std::chrono::milliseconds(1100)));
+    auto depth = makeDepthPlane();
+    depth->setTimestamp(std::chrono::steady_clock::time_point(std::chrono::milliseconds(1100)));
+    detectionsQueue->send(detections);
+    depthQueue->send(depth);
+
+    auto result = outputQueue->get<SpatialImgDetections>();
+    pipeline.stop();
+    REQUIRE(result != nullptr);
+    REQUIRE(result->getSequenceNum() == 6);
+    REQUIRE(near(result->detections[0].spatialCoordinates.z, 1235.0f));
+    REQUIRE(near(result->detections[0].spatialCoordinates.x, (24.0f - 32.0f) * 1235.0f / FOCAL));
+}
@@ -0,0 +1,84 @@
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "depthai/depthai.hpp"
+
+using namespace dai;
+
+namespace {
+
+// IMUData message with accelerometer packets at 500 Hz, numbered from first
+std::shared_ptr<IMUData> makeIMUData(int sequenceNum, int first, int count) {
+    auto imuData = std::make_shared<IMUData>();
+    for(int i = first; i < first + count; i++) {
+        IMUPacket packet;
+        packet.acceleroMeter.sequence = i;
+        packet.acceleroMeter.timestamp.sec = 10;
+        packet.acceleroMeter.timestamp.nsec = i * 2000000;
+        packet.acceleroMeter.tsDevice = packet.acceleroMeter.timestamp;
+        packet.acceleroMeter.x = static_cast<float>(i);
+        imuData->packets.push_back(packet);
+    }
+    imuData->setSequenceNum(sequenceNum);
+    return imuData;
+}
+
+}  // namespace
+
+TEST_CASE("IMUBatcher - batches of a fixed size") {
+    Pipeline pipeline(false);
+    auto batcher = pipeline.create<node::IMUBatcher>();
+    batcher->setBatchSize(5).setMaxLatency(std::chrono::milliseconds(0));
+    auto inputQueue = batcher->input.createInputQueue();
+    auto outputQueue = batcher->out.createOutputQueue();
+    pipeline.start();
+
+    for(int i = 0; i < 3; i++) inputQueue->send(makeIMUData(i, i * 4, 4));
+
+    // Batches span messages and carry the metadata of the last one
+    for(int i = 0; i < 2; i++) {
+        auto batch = outputQueue->get<IMUBatch>();
+        REQUIRE(batch != nullptr);
+        REQUIRE(batch->getNumPackets() == 5);
+        REQUIRE(batch->getSequenceNum() == i + 1);
+        REQUIRE(batch->hasReport(IMUBatch::Report::ACCELEROMETER));
+        REQUIRE_FALSE(batch->hasReport(IMUBatch::Report::GYROSCOPE));
+        const auto sequenceNums = batch->getSequenceNums(IMUBatch::Report::ACCELEROMETER);
+        for(int j = 0; j < 5; j++) REQUIRE(sequenceNums[j] == i * 5 + j);
+        REQUIRE(batch->getValues(IMUBatch::Report::ACCELEROMETER)[3] == static_cast<float>(i * 5 + 1));
+    }
+    // The remaining packets wait for the batch to fill up
+    REQUIRE(outputQueue->tryGet<IMUBatch>() == nullptr);
+    pipeline.stop();
+}
+
+TEST_CASE("IMUBatcher - partial batches after the maximum latency") {
+    Pipeline pipeline(false);
+    auto batcher = pipeline.create<node::IMUBatcher>();
+    batcher->setBatchSize(100).setMaxLatency(std::chrono::milliseconds(20));
+    auto inputQueue = batcher->input.createInputQueue();
+    auto outputQueue = batcher->out.createOutputQueue();
+    pipeline.start();
+
+    inputQueue->send(makeIMUData(3, 0, 3));
+    auto batch = outputQueue->get<IMUBatch>();
+    REQUIRE(batch->getNumPackets() == 3);
+    REQUIRE(batch->getSequenceNum() == 3);
+    const auto packets = batch->toIMUData()->packets;
+    REQUIRE(packets.size() == 3);
+    REQUIRE(packets[2].acceleroMeter.sequence == 2);
+    REQUIRE(packets[2].acceleroMeter.timestamp.nsec == 4000000);
+    pipeline.stop();
+}
+
+TEST_CASE("IMUBatcher - invalid settings") {
+    Pipeline pipeline(false);
+    auto batcher = pipeline.create<node::IMUBatcher>();
+    REQUIRE(batcher->getBatchSize() == 20);
+    REQUIRE(batcher->getMaxLatency() == std::chrono::milliseconds(50));
+    REQUIRE_THROWS_AS(batcher->setBatchSize(0), std::invalid_argument);
+    REQUIRE_THROWS_AS(batcher->setMaxLatency(std::chrono::milliseconds(-1)), std::invalid_argument);
+}
@@ -0,0 +1,214 @@
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "depthai/depthai.hpp"
+
+using namespace dai;
+
+namespace {
+
+constexpr int WIDTH = 64;
+constexpr int HEIGHT = 48;
+constexpr std::uint8_t BACKGROUND = 128;
+
+std::uint8_t gradient(int x, int y) {
+    return static_cast<std::uint8_t>(16 + (x + y) * 2);
+}
+
+std::shared_ptr<ImgFrame> makeNV12Frame(int sequenceNum, bool flat) {
+    const size_t planeSize = static_cast<size_t>(WIDTH) * HEIGHT;
+    std::vector<std::uint8_t> pixels(planeSize * 3 / 2, BACKGROUND);
+    for(int y = 0; y < HEIGHT && !flat; y++) {
+        for(int x = 0; x < WIDTH; x++) pixels[y * WIDTH + x] = gradient(x, y);
+    }
+    auto frame = std::make_shared<ImgFrame>();
+    frame->setType(ImgFrame::Type::NV12);
+    frame->setSize(WIDTH, HEIGHT);
+    frame->setStride(WIDTH);
+    frame->fb.p1Offset = 0;
+    frame->fb.p2Offset = static_cast<std::uint32_t>(planeSize);
+    frame->fb.p3Offset = static_cast<std::uint32_t>(planeSize);
+    frame->setData(pixels);
+    frame->setSourceSize(WIDTH, HEIGHT);
+    frame->setSequenceNum(sequenceNum);
+    frame->setTimestamp(std::chrono::steady_clock::time_point(std::chrono::milliseconds(1000 + sequenceNum)));
+    return frame;
+}
+
+std::uint64_t fnv1a(span<const std::uint8_t> data) {
+    std::uint64_t hash = 14695981039346656037ull;
+    for(auto value : data) hash = (hash ^ value) * 1099511628211ull;
+    return hash;
+}
+
+PointsAnnotation makePoints(PointsAnnotationType type, std::vector<Point2f> points, float thickness, Color outlineColor, std::vector<Color> outlineColors = {}) {
+    PointsAnnotation annotation;
+    annotation.type = type;
+    annotation.points = std::move(points);
+    annotation.thickness = thickness;
+    annotation.outlineColor = outlineColor;
+    annotation.outlineColors = std::move(outlineColors);
+    return annotation;
+}
+
+// Annotations and frames come through separate queues, so frames are sent until one comes back with the annotations drawn
+std::shared_ptr<ImgFrame> getAnnotated(InputQueue& frameQueue, MessageQueue& outputQueue, const std::function<std::shared_ptr<ImgFrame>(int)>& makeFrame) {
+    for(int sequenceNum = 0; sequenceNum < 100; sequenceNum++) {
+        auto frame = makeFrame(sequenceNum);
+        frameQueue.send(frame);
+        auto drawn = outputQueue.get<ImgFrame>();
+        if(drawn == nullptr) return nullptr;
+        const auto input = frame->getData();
+        const auto output = drawn->getData();
+        if(!std::equal(input.begin(), input.end(), output.begin(), output.end())) return drawn;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return nullptr;
+}
+
+}  // namespace
+
+TEST_CASE("Overlay - ImgAnnotations golden NV12 image") {
+    Pipeline pipeline(false);
+    auto overlay = pipeline.create<node::Overlay>();
+    auto frameQueue = overlay->input.createInputQueue();
+    auto annotationsQueue = overlay->annotations["shapes"].createInputQueue();
+    auto outputQueue = overlay->out.createOutputQueue();
+    pipeline.start();
+
+    ImgAnnotation annotation;
+    CircleAnnotation circle;
+    circle.position = Point2f(0.5f, 0.5f);
+    circle.diameter = 0.5f;
+    circle.thickness = 2.0f;
+    circle.outlineColor = Color(1.0f, 0.0f, 0.0f, 1.0f);
+    circle.fillColor = Color(0.0f, 0.0f, 1.0f, 0.5f);
+    annotation.circles.push_back(circle);
+    annotation.points.push_back(makePoints(PointsAnnotationType::LINE_LOOP, {{0.1f, 0.1f}, {0.9f, 0.1f}, {0.5f, 0.9f}}, 1.5f, Color(0.0f, 1.0f, 0.0f, 1.0f)));
+    annotation.points.push_back(makePoints(PointsAnnotationType::LINE_STRIP, {{0.05f, 0.95f}, {0.95f, 0.6f}}, 3.0f, Color(), {Color(1.0f, 1.0f, 0.0f, 1.0f)}));
+    annotation.points.push_back(makePoints(PointsAnnotationType::POINTS, {{0.2f, 0.8f}}, 4.0f, Color(1.0f, 1.0f, 1.0f, 1.0f)));
+    annotationsQueue->send(std::make_shared<ImgAnnotations>(std::vector<ImgAnnotation>{annotation}));
+
+    std::shared_ptr<ImgFrame> frame;
+    auto drawn = getAnnotated(*frameQueue, *outputQueue, [&](int sequenceNum) { return frame = makeNV12Frame(sequenceNum, false); });
+    REQUIRE(drawn != nullptr);
+    const auto original = makeNV12Frame(0, false)->getData();
+    const std::vector<std::uint8_t> originalPixels(original.begin(), original.end());
+    REQUIRE(drawn->getType() == ImgFrame::Type::NV12);
+    REQUIRE(drawn->getSequenceNum() == frame->getSequenceNum());
+    REQUIRE(drawn->getTimestamp() == frame->getTimestamp());
+    REQUIRE(drawn->getData().size() == originalPixels.size());
+
+    // Integer blending makes the image reproducible, the input frame is left untouched
+    REQUIRE(fnv1a(drawn->getData()) == 0x7b34ae408d265b04ull);
+    auto input = frame->getData();
+    REQUIRE(std::vector<std::uint8_t>(input.begin(), input.end()) == originalPixels);
+
+    // Annotations stay drawn until they are replaced
+    frameQueue->send(makeNV12Frame(1000, false));
+    auto next = outputQueue->get<ImgFrame>();
+    REQUIRE(next->getSequenceNum() == 1000);
+    REQUIRE(fnv1a(next->getData()) == 0x7b34ae408d265b04ull);
+    pipeline.stop();
+}
+
+TEST_CASE("Overlay - detections are remapped to the frame") {
+    Pipeline pipeline(false);
+    auto overlay = pipeline.create<node::Overlay>();
+    overlay->setFontSize(8.0f);
+    auto frameQueue = overlay->input.createInputQueue();
+    auto detectionsQueue = overlay->annotations["detections"].createInputQueue();
+    auto outputQueue = overlay->out.createOutputQueue();
+    pipeline.start();
+
+    // Detections are in a 128x96 image, the frame is its 64x48 crop at 32,24
+    auto detections = std::make_shared<ImgDetections>();
+    ImgDetection detection;
+    detection.label = 0;
+    detection.confidence = 0.9f;
+    detection.xmin = 0.375f;
+    detection.ymin = 0.375f;
+    detection.xmax = 0.625f;
+    detection.ymax = 0.625f;
+    detections->detections.push_back(detection);
+    detections->transformation = ImgTransformation(128, 96);
+    detectionsQueue->send(detections);
+
+    auto drawn = getAnnotated(*frameQueue, *outputQueue, [](int sequenceNum) {
+        auto frame = makeNV12Frame(sequenceNum, true);
+        frame->transformation = ImgTransformation(128, 96);
+        frame->transformation.addCrop(32, 24, WIDTH, HEIGHT);
+        return frame;
+    });
+    REQUIRE(drawn != nullptr);
+
+    // The box spans 16..48 horizontally in the frame, in the first palette color
+    auto luma = [&](int x, int y) { return drawn->getData()[static_cast<size_t>(y) * WIDTH + x]; };
+    const std::uint8_t boxLuma = 90;
+    REQUIRE(luma(16, 24) == boxLuma);
+    REQUIRE(luma(47, 24) == boxLuma);
+    REQUIRE(luma(24, 24) == BACKGROUND);
+    REQUIRE(luma(4, 40) == BACKGROUND);
+    pipeline.stop();
+}
+
+TEST_CASE("Overlay - tracklets on BGR frames and unsupported frames") {
+    Pipeline pipeline(false);
+    auto overlay = pipeline.create<node::Overlay>();
+    overlay->setThickness(4.0f);
+    REQUIRE(overlay->getThickness() == 4.0f);
+    auto frameQueue = overlay->input.createInputQueue();
+    auto trackletsQueue = overlay->annotations["tracklets"].createInputQueue();
+    auto outputQueue = overlay->out.createOutputQueue();
+    pipeline.start();
+
+    auto tracklets = std::make_shared<Tracklets>();
+    Tracklet tracked;
+    tracked.id = 3;
+    tracked.label = 1;
+    tracked.status = Tracklet::TrackingStatus::TRACKED;
+    tracked.roi = Rect(0.25f, 0.5f, 0.5f, 0.25f, true);
+    Tracklet removed = tracked;
+    removed.status = Tracklet::TrackingStatus::REMOVED;
+    removed.roi = Rect(0.05f, 0.9f, 0.1f, 0.05f, true);
+    tracklets->tracklets = {tracked, removed};
+    trackletsQueue->send(tracklets);
+
+    auto planar = std::make_shared<ImgFrame>();
+    planar->setType(ImgFrame::Type::RGB888p);
+    planar->setSize(WIDTH, HEIGHT);
+    planar->setData(std::vector<std::uint8_t>(static_cast<size_t>(WIDTH) * HEIGHT * 3, 40));
+    planar->setSequenceNum(1);
+    frameQueue->send(planar);
+
+    // The planar frame is skipped, only BGR frames come out
+    auto drawn = getAnnotated(*frameQueue, *outputQueue, [](int sequenceNum) {
+        auto frame = std::make_shared<ImgFrame>();
+        frame->setType(ImgFrame::Type::BGR888i);
+        frame->setSize(WIDTH, HEIGHT);
+        frame->setStride(WIDTH * 3);
+        frame->setData(std::vector<std::uint8_t>(static_cast<size_t>(WIDTH) * HEIGHT * 3, 40));
+        frame->setSequenceNum(sequenceNum + 2);
+        return frame;
+    });
+    REQUIRE(drawn != nullptr);
+    REQUIRE(drawn->getSequenceNum() >= 2);
+    REQUIRE(drawn->getType() == ImgFrame::Type::BGR888i);
+    auto pixel = [&](int x, int y) {
+        const auto data = drawn->getData();
+        const size_t offset = (static_cast<size_t>(y) * WIDTH + x) * 3;
+        return std::vector<int>{data[offset], data[offset + 1], data[offset + 2]};
+    };
+    // Left edge of the tracked box at x = 16, in the second palette color
+    REQUIRE(pixel(16, 30) == std::vector<int>{26, 153, 26});
+    REQUIRE(pixel(24, 30) == std::vector<int>{40, 40, 40});
+    // Removed tracklets aren't drawn
+    REQUIRE(pixel(3, 44) == std::vector<int>{40, 40, 40});
+    pipeline.stop();
+}
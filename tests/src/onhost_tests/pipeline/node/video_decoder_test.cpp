@@ -0,0 +1,135 @@
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+#include "depthai/depthai.hpp"
+
+using namespace dai;
+
+namespace {
+
+constexpr int WIDTH = 96;
+constexpr int HEIGHT = 64;
+
+std::shared_ptr<ImgFrame> makeFrame(int sequenceNum) {
+    const size_t planeSize = static_cast<size_t>(WIDTH) * HEIGHT;
+    std::vector<std::uint8_t> pixels(planeSize * 3 / 2);
+    for(int y = 0; y < HEIGHT; y++) {
+        for(int x = 0; x < WIDTH; x++) pixels[y * WIDTH + x] = static_cast<std::uint8_t>(128 + 80 * std::sin(x * 0.1) * std::cos(y * 0.08));
+    }
+    for(size_t i = planeSize; i < pixels.size(); i += 2) {
+        pixels[i] = 100;
+        pixels[i + 1] = 160;
+    }
+    auto frame = std::make_shared<ImgFrame>();
+    frame->setType(ImgFrame::Type::NV12);
+    frame->setSize(WIDTH, HEIGHT);
+    frame->setStride(WIDTH);
+    frame->fb.p1Offset = 0;
+    frame->fb.p2Offset = static_cast<std::uint32_t>(planeSize);
+    frame->fb.p3Offset = static_cast<std::uint32_t>(planeSize);
+    frame->setData(pixels);
+    frame->setSourceSize(WIDTH, HEIGHT);
+    frame->setSequenceNum(sequenceNum);
+    frame->setTimestamp(std::chrono::steady_clock::time_point(std::chrono::milliseconds(1000 + sequenceNum)));
+    frame->setInstanceNum(1);
+    return frame;
+}
+
+// Encodes frames with the host VideoEncoder node
+std::vector<std::shared_ptr<EncodedFrame>> encode(int count) {
+    Pipeline pipeline(false);
+    auto encoder = pipeline.create<node::VideoEncoder>();
+    encoder->setRunOnHost(true);
+    encoder->setProfile(VideoEncoderProperties::Profile::MJPEG);
+    encoder->setQuality(95);
+    auto inputQueue = encoder->input.createInputQueue();
+    auto outputQueue = encoder->out.createOutputQueue();
+    pipeline.start();
+    std::vector<std::shared_ptr<EncodedFrame>> encoded;
+    for(int i = 0; i < count; i++) {
+        inputQueue->send(makeFrame(i));
+        encoded.push_back(outputQueue->get<EncodedFrame>());
+    }
+    pipeline.stop();
+    return encoded;
+}
+
+}  // namespace
+
+TEST_CASE("VideoDecoder - MJPEG to NV12 with metadata") {
+    auto encoded = encode(3);
+    auto original = makeFrame(0);
+
+    Pipeline pipeline(false);
+    auto decoder = pipeline.create<node::VideoDecoder>();
+    REQUIRE(decoder->getOutputType() == ImgFrame::Type::NV12);
+    auto inputQueue = decoder->input.createInputQueue();
+    auto outputQueue = decoder->out.createOutputQueue();
+    pipeline.start();
+
+    for(const auto& frame : encoded) {
+        inputQueue->send(frame);
+        auto decoded = outputQueue->get<ImgFrame>();
+        REQUIRE(decoded != nullptr);
+        REQUIRE(decoded->getType() == ImgFrame::Type::NV12);
+        REQUIRE(decoded->getWidth() == WIDTH);
+        REQUIRE(decoded->getHeight() == HEIGHT);
+        REQUIRE(decoded->getStride() == WIDTH);
+        REQUIRE(decoded->getSequenceNum() == frame->getSequenceNum());
+        REQUIRE(decoded->getTimestamp() == frame->getTimestamp());
+        REQUIRE(decoded->getInstanceNum() == 1);
+        REQUIRE(decoded->transformation.getSize() == frame->transformation.getSize());
+
+        auto data = decoded->getData();
+        auto pixels = original->getData();
+        REQUIRE(data.size() == pixels.size());
+        int maxDifference = 0;
+        for(size_t i = 0; i < data.size(); i++) maxDifference = std::max(maxDifference, std::abs(data[i] - pixels[i]));
+        REQUIRE(maxDifference <= 8);
+    }
+    pipeline.stop();
+}
+
+TEST_CASE("VideoDecoder - GRAY8 output and dropped frames") {
+    auto encoded = encode(3);
+
+    // Truncated frame
+    auto corrupted = std::make_shared<EncodedFrame>(*encoded[1]);
+    auto data = encoded[1]->getData();
+    corrupted->setData(std::vector<std::uint8_t>(data.begin(), data.begin() + data.size() / 3));
+    corrupted->frameSize = 0;
+
+    // No decoder for inter coded profiles
+    auto h264 = std::make_shared<EncodedFrame>(*encoded[1]);
+    h264->setProfile(EncodedFrame::Profile::AVC);
+    h264->setInstanceNum(2);
+
+    Pipeline pipeline(false);
+    auto decoder = pipeline.create<node::VideoDecoder>();
+    decoder->setOutputType(ImgFrame::Type::GRAY8);
+    REQUIRE_THROWS_AS(decoder->setOutputType(ImgFrame::Type::RGB888i), std::invalid_argument);
+    auto inputQueue = decoder->input.createInputQueue();
+    auto outputQueue = decoder->out.createOutputQueue();
+    pipeline.start();
+
+    inputQueue->send(encoded[0]);
+    auto first = outputQueue->get<ImgFrame>();
+    REQUIRE(first->getType() == ImgFrame::Type::GRAY8);
+    REQUIRE(first->getData().size() == static_cast<size_t>(WIDTH) * HEIGHT);
+    REQUIRE(first->getSequenceNum() == 0);
+    const auto* firstBuffer = first->getData().data();
+    first.reset();
+
+    inputQueue->send(corrupted);
+    inputQueue->send(h264);
+    inputQueue->send(encoded[2]);
+    auto next = outputQueue->get<ImgFrame>();
+    REQUIRE(next->getSequenceNum() == 2);
+    // Released output buffers are reused
+    REQUIRE(next->getData().data() == firstBuffer);
+    pipeline.stop();
+}
@@ -0,0 +1,157 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "depthai/depthai.hpp"
+
+using namespace dai;
+
+namespace {
+
+std::shared_ptr<ImgFrame> makeFrame(ImgFrame::Type type, int width, int height, int sequenceNum) {
+    const size_t planeSize = static_cast<size_t>(width) * height;
+    std::vector<std::uint8_t> pixels(type == ImgFrame::Type::NV12 ? planeSize * 3 / 2 : planeSize);
+    for(size_t i = 0; i < pixels.size(); i++) {
+        pixels[i] = static_cast<std::uint8_t>(128 + 100 * std::sin(static_cast<double>(i % width) * 0.1) * std::cos(static_cast<double>(i / width) * 0.05));
+    }
+    auto frame = std::make_shared<ImgFrame>();
+    frame->setType(type);
+    frame->setSize(width, height);
+    frame->setStride(width);
+    frame->fb.p1Offset = 0;
+    frame->fb.p2Offset = static_cast<std::uint32_t>(planeSize);
+    frame->fb.p3Offset = static_cast<std::uint32_t>(planeSize);
+    frame->setData(pixels);
+    frame->setSequenceNum(sequenceNum);
+    return frame;
+}
+
+struct JpegInfo {
+    int width = 0;
+    int height = 0;
+    int components = 0;
+    int restartInterval = 0;
+    std::vector<int> restartMarkers;
+    bool ended = false;
+};
+
+// Walks the marker segments of a JPEG image and the restart markers of its scan
+JpegInfo parseJpeg(const std::vector<std::uint8_t>& data) {
+    JpegInfo info;
+    REQUIRE(data.size() > 4);
+    REQUIRE(data[0] == 0xFF);
+    REQUIRE(data[1] == 0xD8);
+    size_t i = 2;
+    while(i + 4 <= data.size()) {
+        REQUIRE(data[i] == 0xFF);
+        const std::uint8_t marker = data[i + 1];
+        const size_t length = (data[i + 2] << 8) | data[i + 3];
+        const std::uint8_t* segment = data.data() + i + 4;
+        if(marker == 0xC0) {
+            info.height = (segment[1] << 8) | segment[2];
+            info.width = (segment[3] << 8) | segment[4];
+            info.components = segment[5];
+        } else if(marker == 0xDD) {
+            info.restartInterval = (segment[0] << 8) | segment[1];
+        }
+        i += 2 + length;
+        if(marker == 0xDA) break;
+    }
+    for(; i + 1 < data.size(); i++) {
+        if(data[i] != 0xFF || data[i + 1] == 0x00) continue;
+        if(data[i + 1] >= 0xD0 && data[i + 1] <= 0xD7) {
+            info.restartMarkers.push_back(data[i + 1] - 0xD0);
+        } else {
+            info.ended = data[i + 1] == 0xD9 && i + 2 == data.size();
+            break;
+        }
+    }
+    return info;
+}
+
+std::vector<std::uint8_t> toVector(span<const std::uint8_t> data) {
+    return std::vector<std::uint8_t>(data.begin(), data.end());
+}
+
+}  // namespace
+
+TEST_CASE("VideoEncoder on host - MJPEG from NV12") {
+    constexpr int WIDTH = 100;
+    constexpr int HEIGHT = 70;
+
+    Pipeline pipeline(false);
+    auto encoder = pipeline.create<node::VideoEncoder>();
+    encoder->setRunOnHost(true);
+    encoder->setDefaultProfilePreset(30, VideoEncoderProperties::Profile::MJPEG);
+    encoder->setQuality(90);
+    auto inputQueue = encoder->input.createInputQueue();
+    auto outputQueue = encoder->out.createOutputQueue();
+    auto bitstreamQueue = encoder->bitstream.createOutputQueue();
+    pipeline.start();
+
+    for(int i = 0; i < 3; i++) {
+        inputQueue->send(makeFrame(ImgFrame::Type::NV12, WIDTH, HEIGHT, i));
+        auto encoded = outputQueue->get<EncodedFrame>();
+        REQUIRE(encoded != nullptr);
+        REQUIRE(encoded->getSequenceNum() == i);
+        REQUIRE(encoded->getProfile() == EncodedFrame::Profile::JPEG);
+        REQUIRE(encoded->getFrameType() == EncodedFrame::FrameType::I);
+        REQUIRE(encoded->getWidth() == WIDTH);
+        REQUIRE(encoded->getHeight() == HEIGHT);
+        REQUIRE(encoded->getQuality() == 90);
+        REQUIRE_FALSE(encoded->getLossless());
+
+        auto data = toVector(encoded->getData());
+        REQUIRE(encoded->frameSize == data.size());
+        auto info = parseJpeg(data);
+        REQUIRE(info.width == WIDTH);
+        REQUIRE(info.height == HEIGHT);
+        REQUIRE(info.components == 3);
+        REQUIRE(info.ended);
+        // A restart interval per row of 16x16 MCUs
+        REQUIRE(info.restartInterval == (WIDTH + 15) / 16);
+        REQUIRE(info.restartMarkers.size() == (HEIGHT + 15) / 16 - 1);
+        for(size_t marker = 0; marker < info.restartMarkers.size(); marker++) REQUIRE(info.restartMarkers[marker] == static_cast<int>(marker % 8));
+
+        auto bitstream = bitstreamQueue->get<ImgFrame>();
+        REQUIRE(bitstream->getType() == ImgFrame::Type::BITSTREAM);
+        REQUIRE(bitstream->getSequenceNum() == i);
+        REQUIRE(toVector(bitstream->getData()) == data);
+    }
+    pipeline.stop();
+}
+
+TEST_CASE("VideoEncoder on host - grayscale, quality and unsupported frames") {
+    constexpr int WIDTH = 320;
+    constexpr int HEIGHT = 200;
+
+    auto encode = [](int quality) {
+        Pipeline pipeline(false);
+        auto encoder = pipeline.create<node::VideoEncoder>();
+        encoder->setRunOnHost(true);
+        encoder->setProfile(VideoEncoderProperties::Profile::MJPEG);
+        encoder->setQuality(quality);
+        auto inputQueue = encoder->input.createInputQueue();
+        auto outputQueue = encoder->out.createOutputQueue();
+        pipeline.start();
+        // Unsupported frames are skipped
+        inputQueue->send(makeFrame(ImgFrame::Type::RAW16, WIDTH, HEIGHT, 0));
+        inputQueue->send(makeFrame(ImgFrame::Type::GRAY8, WIDTH, HEIGHT, 1));
+        auto encoded = outputQueue->get<EncodedFrame>();
+        pipeline.stop();
+        REQUIRE(encoded->getSequenceNum() == 1);
+        return toVector(encoded->getData());
+    };
+
+    auto low = encode(30);
+    auto high = encode(95);
+    REQUIRE(high.size() > low.size());
+    auto info = parseJpeg(high);
+    REQUIRE(info.components == 1);
+    REQUIRE(info.width == WIDTH);
+    REQUIRE(info.height == HEIGHT);
+    REQUIRE(info.restartInterval == WIDTH / 8);
+    REQUIRE(info.restartMarkers.size() == HEIGHT / 8 - 1);
+    REQUIRE(info.ended);
+}
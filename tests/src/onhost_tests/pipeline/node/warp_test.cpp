@@ -0,0 +1,148 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "depthai/depthai.hpp"
+
+using namespace dai;
+
+namespace {
+
+constexpr int WIDTH = 64;
+constexpr int HEIGHT = 48;
+
+std::vector<std::uint8_t> randomPixels(size_t size) {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> intensity(0, 255);
+    std::vector<std::uint8_t> pixels(size);
+    for(auto& pixel : pixels) pixel = static_cast<std::uint8_t>(intensity(rng));
+    return pixels;
+}
+
+std::shared_ptr<ImgFrame> makeFrame(ImgFrame::Type type, int stride, const std::vector<std::uint8_t>& pixels) {
+    auto frame = std::make_shared<ImgFrame>();
+    frame->setType(type);
+    frame->setSize(WIDTH, HEIGHT);
+    frame->setStride(stride);
+    frame->fb.p1Offset = 0;
+    frame->fb.p2Offset = stride * HEIGHT;
+    frame->fb.p3Offset = stride * HEIGHT;
+    frame->setData(pixels);
+    frame->setSequenceNum(7);
+    return frame;
+}
+
+// Runs a single frame through the host Warp node
+std::shared_ptr<ImgFrame> warp(const std::shared_ptr<ImgFrame>& frame,
+                               const std::vector<Point2f>& mesh,
+                               int meshWidth,
+                               int meshHeight,
+                               int outputWidth,
+                               int outputHeight,
+                               Interpolation interpolation = Interpolation::BILINEAR) {
+    Pipeline pipeline(false);
+    auto warpNode = pipeline.create<node::Warp>();
+    warpNode->setRunOnHost(true);
+    if(!mesh.empty()) warpNode->setWarpMesh(mesh, meshWidth, meshHeight);
+    warpNode->setOutputSize(outputWidth, outputHeight);
+    warpNode->setInterpolation(interpolation);
+    auto inputQueue = warpNode->inputImage.createInputQueue();
+    auto outputQueue = warpNode->out.createOutputQueue();
+    pipeline.start();
+    inputQueue->send(frame);
+    auto output = outputQueue->get<ImgFrame>();
+    pipeline.stop();
+    REQUIRE(output != nullptr);
+    REQUIRE(output->getSequenceNum() == frame->getSequenceNum());
+    REQUIRE(output->getType() == frame->getType());
+    REQUIRE(output->getWidth() == static_cast<unsigned>(outputWidth));
+    REQUIRE(output->getHeight() == static_cast<unsigned>(outputHeight));
+    return output;
+}
+
+}  // namespace
+
+TEST_CASE("Warp on host - mesh cropping a region") {
+    constexpr int STRIDE = 80;
+    auto pixels = randomPixels(static_cast<size_t>(STRIDE) * HEIGHT);
+    auto frame = makeFrame(ImgFrame::Type::GRAY8, STRIDE, pixels);
+
+    // 3x3 mesh covering 32x24 pixels from (10, 5), mapped 1:1 to the output
+    std::vector<Point2f> mesh;
+    for(int row = 0; row < 3; row++) {
+        for(int column = 0; column < 3; column++) mesh.emplace_back(10.f + column * 16.f, 5.f + row * 12.f);
+    }
+    auto output = warp(frame, mesh, 3, 3, 32, 24);
+    REQUIRE(output->getStride() == 32);
+    auto data = output->getData();
+    for(int y = 0; y < 24; y++) {
+        for(int x = 0; x < 32; x++) REQUIRE(data[y * 32 + x] == pixels[(y + 5) * STRIDE + x + 10]);
+    }
+
+    auto point = output->transformation.transformPoint({20.f, 15.f});
+    REQUIRE_THAT(point.x, Catch::Matchers::WithinAbs(10.f, 1e-3));
+    REQUIRE_THAT(point.y, Catch::Matchers::WithinAbs(10.f, 1e-3));
+    auto size = output->transformation.getSize();
+    REQUIRE(size.first == 32);
+    REQUIRE(size.second == 24);
+}
+
+TEST_CASE("Warp on host - mirroring interleaved frames") {
+    auto pixels = randomPixels(static_cast<size_t>(WIDTH) * HEIGHT * 3);
+    auto frame = makeFrame(ImgFrame::Type::BGR888i, WIDTH * 3, pixels);
+
+    const std::vector<Point2f> mesh = {{WIDTH, 0}, {0, 0}, {WIDTH, HEIGHT}, {0, HEIGHT}};
+    auto output = warp(frame, mesh, 2, 2, WIDTH, HEIGHT);
+    REQUIRE(output->getStride() == WIDTH * 3);
+    auto data = output->getData();
+    for(int y = 0; y < HEIGHT; y++) {
+        for(int x = 0; x < WIDTH; x++) {
+            for(int c = 0; c < 3; c++) REQUIRE(data[(y * WIDTH + x) * 3 + c] == pixels[(y * WIDTH + WIDTH - 1 - x) * 3 + c]);
+        }
+    }
+
+    auto point = output->transformation.transformPoint({10.f, 20.f});
+    REQUIRE_THAT(point.x, Catch::Matchers::WithinAbs(WIDTH - 10.f, 1e-3));
+    REQUIRE_THAT(point.y, Catch::Matchers::WithinAbs(20.f, 1e-3));
+}
+
+TEST_CASE("Warp on host - NV12 upscaling with nearest neighbor") {
+    auto pixels = randomPixels(static_cast<size_t>(WIDTH) * HEIGHT * 3 / 2);
+    auto frame = makeFrame(ImgFrame::Type::NV12, WIDTH, pixels);
+
+    // Without a mesh the whole input is resized
+    auto output = warp(frame, {}, 0, 0, WIDTH * 2, HEIGHT * 2, Interpolation::NEAREST_NEIGHBOR);
+    auto data = output->getData();
+    REQUIRE(data.size() == static_cast<size_t>(WIDTH) * HEIGHT * 6);
+    for(int y = 0; y < HEIGHT * 2; y++) {
+        for(int x = 0; x < WIDTH * 2; x++) REQUIRE(data[y * WIDTH * 2 + x] == pixels[(y / 2) * WIDTH + x / 2]);
+    }
+    const size_t chroma = static_cast<size_t>(WIDTH) * HEIGHT * 4;
+    REQUIRE(output->fb.p2Offset == chroma);
+    for(int y = 0; y < HEIGHT; y++) {
+        for(int x = 0; x < WIDTH; x++) {
+            for(int c = 0; c < 2; c++) {
+                REQUIRE(data[chroma + y * WIDTH * 2 + x * 2 + c] == pixels[static_cast<size_t>(WIDTH) * HEIGHT + (y / 2) * WIDTH + (x / 2) * 2 + c]);
+            }
+        }
+    }
+}
+
+TEST_CASE("Warp on host - bilinear interpolation") {
+    auto pixels = randomPixels(static_cast<size_t>(WIDTH) * HEIGHT);
+    auto frame = makeFrame(ImgFrame::Type::GRAY8, WIDTH, pixels);
+
+    // Shifted by half a pixel, each output pixel averages two neighbors
+    const std::vector<Point2f> mesh = {{0.5f, 0}, {WIDTH - 1.5f, 0}, {0.5f, HEIGHT}, {WIDTH - 1.5f, HEIGHT}};
+    auto output = warp(frame, mesh, 2, 2, WIDTH - 2, HEIGHT);
+    auto data = output->getData();
+    for(int y = 0; y < HEIGHT; y++) {
+        for(int x = 0; x < WIDTH - 2; x++) {
+            const int expected = (pixels[y * WIDTH + x] + pixels[y * WIDTH + x + 1] + 1) / 2;
+            REQUIRE(std::abs(data[y * (WIDTH - 2) + x] - expected) <= 1);
+        }
+    }
+}
@@ -4,6 +4,8 @@
 #include <depthai/depthai.hpp>
 #include <depthai/pipeline/datatype/StreamMessageParser.hpp>
 
+#include "pipeline/datatype/InternedImgFrame.hpp"
+
 // TODO(themarpe) - fuzz me instead
 
 constexpr auto MARKER_SIZE = 16;
@@ -130,4 +132,119 @@ TEST_CASE("Raw - Incorrect message too small size 2") {
     packet.length = ser.size();
 
     REQUIRE_THROWS(dai::StreamMessageParser::parseMessage(&packet));
-}
\ No newline at end of file
+}
+static std::shared_ptr<dai::ADatatype> parseInterned(std::vector<uint8_t>& ser, dai::StreamMessageParser::TransformationCache& cache) {
+    streamPacketDesc_t packet;
+    packet.data = ser.data();
+    packet.length = ser.size();
+    packet.fd = -1;
+    return dai::StreamMessageParser::parseMessage(&packet, cache);
+}
+
+static dai::ImgFrame makeCroppedFrame(int sequenceNum, int cropX) {
+    dai::ImgFrame frm;
+    frm.setSequenceNum(sequenceNum);
+    frm.setSize(320, 200);
+    frm.transformation = dai::ImgTransformation(640, 400);
+    frm.transformation.addCrop(cropX, 100, 320, 200);
+    return frm;
+}
+
+TEST_CASE("Interned transformations - sent once per change") {
+    dai::StreamMessageParser::TransformationCache sender;
+    dai::StreamMessageParser::TransformationCache receiver;
+
+    auto first = makeCroppedFrame(1, 0);
+    auto second = makeCroppedFrame(2, 0);
+    auto moved = makeCroppedFrame(3, 160);
+    auto serFirst = dai::StreamMessageParser::serializeMetadata(first, sender);
+    auto serSecond = dai::StreamMessageParser::serializeMetadata(second, sender);
+    auto serMoved = dai::StreamMessageParser::serializeMetadata(moved, sender);
+
+    // Only the first use of a transformation carries it
+    REQUIRE(serSecond.size() < serFirst.size());
+    REQUIRE(serSecond.size() < dai::StreamMessageParser::serializeMetadata(second).size());
+    REQUIRE(serMoved.size() == serFirst.size());
+
+    for(auto* ser : {&serFirst, &serSecond, &serMoved}) {
+        auto parsed = std::dynamic_pointer_cast<dai::ImgFrame>(parseInterned(*ser, receiver));
+        REQUIRE(parsed != nullptr);
+        const auto& expected = ser == &serMoved ? moved : first;
+        REQUIRE(parsed->transformation.getSize() == expected.transformation.getSize());
+        REQUIRE(parsed->transformation.getSourceSize() == expected.transformation.getSourceSize());
+        REQUIRE(parsed->transformation.getMatrix() == expected.transformation.getMatrix());
+        REQUIRE(parsed->getWidth() == 320);
+    }
+
+    // Frames parse to the same metadata as without interning
+    auto parsed = parseInterned(serSecond, receiver);
+    REQUIRE(dai::StreamMessageParser::serializeMetadata(parsed) == dai::StreamMessageParser::serializeMetadata(second));
+}
+
+TEST_CASE("Interned transformations - alternating sources") {
+    dai::StreamMessageParser::TransformationCache sender;
+    dai::StreamMessageParser::TransformationCache receiver;
+    auto left = makeCroppedFrame(1, 0);
+    auto right = makeCroppedFrame(1, 320);
+    auto serLeft = dai::StreamMessageParser::serializeMetadata(left, sender);
+    auto serRight = dai::StreamMessageParser::serializeMetadata(right, sender);
+    parseInterned(serLeft, receiver);
+    parseInterned(serRight, receiver);
+
+    // Both stay interned, up to the capacity of the cache
+    auto serLeftAgain = dai::StreamMessageParser::serializeMetadata(left, sender);
+    REQUIRE(serLeftAgain.size() < serLeft.size());
+    auto parsed = std::dynamic_pointer_cast<dai::ImgFrame>(parseInterned(serLeftAgain, receiver));
+    REQUIRE(parsed->transformation.getMatrix() == left.transformation.getMatrix());
+
+    for(unsigned i = 0; i < dai::StreamMessageParser::TransformationCache::CAPACITY; i++) {
+        auto ser = dai::StreamMessageParser::serializeMetadata(makeCroppedFrame(2, 10 + i), sender);
+        parseInterned(ser, receiver);
+    }
+    auto serRightEvicted = dai::StreamMessageParser::serializeMetadata(right, sender);
+    REQUIRE(serRightEvicted.size() == serRight.size());
+    parsed = std::dynamic_pointer_cast<dai::ImgFrame>(parseInterned(serRightEvicted, receiver));
+    REQUIRE(parsed->transformation.getMatrix() == right.transformation.getMatrix());
+}
+
+TEST_CASE("Interned transformations - other messages and missing references") {
+    dai::StreamMessageParser::TransformationCache sender;
+    dai::Buffer buffer;
+    REQUIRE(dai::StreamMessageParser::serializeMetadata(buffer, sender) == dai::StreamMessageParser::serializeMetadata(buffer));
+
+    auto frame = makeCroppedFrame(1, 0);
+    dai::StreamMessageParser::serializeMetadata(frame, sender);
+    auto reference = dai::StreamMessageParser::serializeMetadata(frame, sender);
+
+    // A reference can't be resolved by a receiver which hasn't seen the transformation, or without a cache
+    dai::StreamMessageParser::TransformationCache receiver;
+    REQUIRE_THROWS(parseInterned(reference, receiver));
+    streamPacketDesc_t packet;
+    packet.data = reference.data();
+    packet.length = reference.size();
+    packet.fd = -1;
+    REQUIRE_THROWS(dai::StreamMessageParser::parseMessage(&packet));
+
+    // Reset caches start over, as when a stream is reopened
+    sender.reset();
+    auto resent = dai::StreamMessageParser::serializeMetadata(frame, sender);
+    REQUIRE(resent.size() > reference.size());
+    REQUIRE(parseInterned(resent, receiver) != nullptr);
+}
+
+TEST_CASE("Interned transformations - metadata follows the serialization of ImgFrame") {
+    // InternedImgFrame repeats the serialized fields of ImgFrame, so fields added to or changed in ImgFrame have to be added there too
+    auto frame = makeCroppedFrame(7, 16);
+    frame.setCategory(3).setInstanceNum(2);
+    frame.cam.exposureTimeUs = 1000;
+    const nlohmann::json serialized = frame;
+    nlohmann::json fields;
+    for(const auto& item : serialized.items()) {
+        // Inherited fields are named with their class, as Buffer::ts
+        const auto& key = item.key();
+        fields[key.substr(key.find_last_of(':') + 1)] = item.value();
+    }
+    fields["transformationId"] = 1;
+    const auto interned = fields.get<dai::InternedImgFrame>();
+    REQUIRE(nlohmann::json(interned) == fields);
+}
@@ -0,0 +1,112 @@
+// Microbenchmark of the image ingestion done by BasaltVIO for every synchronized group of frames.
+// Compares allocating 16 bit images and widening pixels one by one, as done previously,
+// with images recycled by the ImagePool of BasaltVIO and the row widening used now, on synthetic frames.
+//
+// Usage: basalt_image_ingestion_benchmark [width] [height] [cameras] [frames]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "utility/ImagePool.hpp"
+#include "utility/ImageWidening.hpp"
+#include "utility/ParallelFor.hpp"
+
+namespace {
+
+// Number of frame groups held downstream before their images are released, as by the optical flow queue
+constexpr size_t IN_FLIGHT = 3;
+
+// Stands in for basalt::ManagedImage<uint16_t>, which allocates its pixels when constructed
+struct Image {
+    Image(size_t width, size_t height) : pitch(width * sizeof(uint16_t)), pixels(new uint16_t[width * height]), ptr(pixels.get()) {}
+    size_t pitch;
+    std::unique_ptr<uint16_t[]> pixels;
+    uint16_t* ptr;
+};
+
+using Images = std::vector<std::shared_ptr<Image>>;
+
+Images ingestPrevious(const std::vector<std::vector<uint8_t>>& frames, size_t width, size_t height) {
+    Images images;
+    const size_t fullSize = width * height;
+    for(const auto& frame : frames) {
+        images.push_back(std::make_shared<Image>(width, height));
+        const uint8_t* dataIN = frame.data();
+        uint16_t* data_out = images.back()->ptr;
+        for(size_t j = 0; j < fullSize; j++) {
+            int val = dataIN[j];
+            val = val << 8;
+            data_out[j] = val;
+        }
+    }
+    return images;
+}
+
+Images ingestCurrent(const std::vector<std::vector<uint8_t>>& frames, size_t width, size_t height, std::vector<dai::utility::ImagePool<Image>>& pools) {
+    const int numImages = static_cast<int>(frames.size());
+    Images images(numImages);
+    const unsigned numThreads = std::max(1u, std::min(static_cast<unsigned>(numImages), std::thread::hardware_concurrency()));
+    dai::utility::parallelFor(0, numImages, numThreads, 1, [&](int begin, int end) {
+        for(int i = begin; i < end; i++) {
+            images[i] = pools[i].acquire(width, height);
+            dai::utility::widen8To16(frames[i].data(), width, images[i]->ptr, images[i]->pitch, width, height);
+        }
+    });
+    return images;
+}
+
+// Images go back to their pool when the group holding them is dropped
+template <typename Ingest>
+double run(int numFrames, Ingest ingest) {
+    std::deque<Images> inFlight;
+    auto start = std::chrono::steady_clock::now();
+    for(int frame = 0; frame < numFrames; frame++) {
+        inFlight.push_back(ingest());
+        if(inFlight.size() > IN_FLIGHT) inFlight.pop_front();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::micro>(elapsed).count() / numFrames;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const size_t width = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1280;
+    const size_t height = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 800;
+    const size_t cameras = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 2;
+    const int numFrames = argc > 4 ? std::atoi(argv[4]) : 600;
+
+    std::vector<std::vector<uint8_t>> frames(cameras, std::vector<uint8_t>(width * height));
+    for(size_t camera = 0; camera < cameras; camera++) {
+        for(size_t i = 0; i < width * height; i++) frames[camera][i] = static_cast<uint8_t>((i * 31 + camera * 7) ^ (i >> 11));
+    }
+
+    // Both paths have to produce the same images
+    auto expected = ingestPrevious(frames, width, height);
+    std::vector<dai::utility::ImagePool<Image>> pools(cameras);
+    auto actual = ingestCurrent(frames, width, height, pools);
+    for(size_t camera = 0; camera < cameras; camera++) {
+        for(size_t i = 0; i < width * height; i++) {
+            if(expected[camera]->ptr[i] != actual[camera]->ptr[i]) {
+                std::fprintf(stderr, "Mismatch at camera %zu pixel %zu\n", camera, i);
+                return 1;
+            }
+        }
+    }
+    actual.clear();
+
+    const double previous = run(numFrames, [&]() { return ingestPrevious(frames, width, height); });
+    const double current = run(numFrames, [&]() { return ingestCurrent(frames, width, height, pools); });
+
+    std::printf("%zu x %zux%zu, %d frames\n", cameras, width, height, numFrames);
+    std::printf("previous: %8.1f us per frame group\n", previous);
+    std::printf("current:  %8.1f us per frame group (%.2fx)\n", current, previous / current);
+    return 0;
+}
@@ -0,0 +1,195 @@
+#include <catch2/catch_all.hpp>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "depthai/utility/Compression.hpp"
+#include "zlib.h"
+
+namespace {
+
+std::vector<uint8_t> generateData(size_t size) {
+    std::vector<uint8_t> data(size);
+    for(size_t i = 0; i < size; i++) {
+        data[i] = static_cast<uint8_t>(((i * 7) ^ (i >> 9)) % 13);
+    }
+    return data;
+}
+
+std::vector<uint8_t> deflateParallel(const std::vector<uint8_t>& data, unsigned numThreads) {
+    std::vector<uint8_t> compressed;
+    dai::utility::deflateParallel(
+        data.data(), data.size(), [&](const uint8_t* chunk, size_t size) { compressed.insert(compressed.end(), chunk, chunk + size); }, 9, 64 * 1024, numThreads);
+    return compressed;
+}
+
+// Pushes data in chunks of random sizes, pulling output in between
+std::vector<uint8_t> compressChunked(dai::utility::StreamCompressor& compressor, const std::vector<uint8_t>& data, std::mt19937& random) {
+    std::vector<uint8_t> compressed;
+    std::uniform_int_distribution<size_t> chunkSize(0, 100 * 1024);
+    for(size_t offset = 0; offset < data.size();) {
+        const size_t size = std::min(chunkSize(random), data.size() - offset);
+        compressor.push(data.data() + offset, size);
+        offset += size;
+        auto output = compressor.pull();
+        compressed.insert(compressed.end(), output.begin(), output.end());
+    }
+    compressor.finish();
+    auto output = compressor.pull();
+    compressed.insert(compressed.end(), output.begin(), output.end());
+    return compressed;
+}
+
+std::vector<uint8_t> decompressChunked(dai::utility::CompressionFormat format, const std::vector<uint8_t>& compressed, std::mt19937& random) {
+    dai::utility::StreamDecompressor decompressor(format);
+    std::vector<uint8_t> data;
+    std::uniform_int_distribution<size_t> chunkSize(0, 20 * 1024);
+    for(size_t offset = 0; offset < compressed.size();) {
+        const size_t size = std::min(chunkSize(random), compressed.size() - offset);
+        decompressor.push(compressed.data() + offset, size);
+        offset += size;
+        auto output = decompressor.pull();
+        data.insert(data.end(), output.begin(), output.end());
+    }
+    decompressor.finish();
+    return data;
+}
+
+// Compressible runs mixed with random bytes
+std::vector<uint8_t> generateMixedData(size_t size, std::mt19937& random) {
+    std::vector<uint8_t> data(size);
+    std::uniform_int_distribution<int> byte(0, 255);
+    for(size_t i = 0; i < size; i++) {
+        data[i] = (i / 4096) % 2 == 0 ? static_cast<uint8_t>(byte(random)) : static_cast<uint8_t>(i % 7);
+    }
+    return data;
+}
+
+}  // namespace
+
+using dai::utility::CompressionFormat;
+
+TEST_CASE("Streamed deflate is identical to zlib compress", "[StreamCompressor]") {
+    std::mt19937 random(1);
+    auto data = generateData(2 * 1024 * 1024 + 5);
+    for(int level : {1, 6, 9}) {
+        std::vector<uint8_t> reference(compressBound(static_cast<uLong>(data.size())));
+        uLongf referenceSize = static_cast<uLongf>(reference.size());
+        REQUIRE(compress2(reference.data(), &referenceSize, data.data(), static_cast<uLong>(data.size()), level) == Z_OK);
+        reference.resize(referenceSize);
+
+        dai::utility::StreamCompressor compressor(CompressionFormat::ZLIB, level);
+        REQUIRE(compressChunked(compressor, data, random) == reference);
+        REQUIRE(compressor.isFinished());
+        REQUIRE(dai::utility::deflate(data.data(), data.size(), level) == reference);
+        REQUIRE(dai::utility::inflate(reference.data(), reference.size()) == data);
+    }
+}
+
+TEST_CASE("Streamed parallel deflate is identical to deflateParallel", "[StreamCompressor]") {
+    std::mt19937 random(2);
+    for(size_t size : {size_t(0), size_t(64 * 1024), size_t(3 * 1024 * 1024 + 17)}) {
+        auto data = generateData(size);
+        dai::utility::StreamCompressor compressor(CompressionFormat::ZLIB, 9, 3, 64 * 1024);
+        auto compressed = compressChunked(compressor, data, random);
+        REQUIRE(compressed == deflateParallel(data, 4));
+        REQUIRE(decompressChunked(CompressionFormat::ZLIB, compressed, random) == data);
+    }
+
+    // Input much larger than a block pushed at once, and compress() with threads
+    auto data = generateData(16 * 1024 * 1024 + 3);
+    dai::utility::StreamCompressor compressor(CompressionFormat::ZLIB, 9, 3, 64 * 1024);
+    compressor.push(data.data(), data.size());
+    compressor.finish();
+    REQUIRE(compressor.pull() == deflateParallel(data, 2));
+    auto compressed = dai::utility::compress(data.data(), data.size(), CompressionFormat::ZLIB, 6, 2);
+    REQUIRE(dai::utility::inflate(compressed.data(), compressed.size()) == data);
+}
+
+TEST_CASE("Zstd round trip", "[StreamCompressor]") {
+    std::mt19937 random(3);
+    auto data = generateMixedData(3 * 1024 * 1024, random);
+    for(int level : {-5, 1, 3, 12}) {
+        for(unsigned numThreads : {1U, 4U}) {
+            dai::utility::StreamCompressor compressor(CompressionFormat::ZSTD, level, numThreads);
+            auto compressed = compressChunked(compressor, data, random);
+            REQUIRE(compressed.size() < data.size());
+            REQUIRE(decompressChunked(CompressionFormat::ZSTD, compressed, random) == data);
+        }
+    }
+
+    // Concatenated frames are decompressed one after another
+    auto first = dai::utility::compress(data.data(), 1000, CompressionFormat::ZSTD, 3);
+    auto second = dai::utility::compress(data.data() + 1000, 2000, CompressionFormat::ZSTD, 3);
+    first.insert(first.end(), second.begin(), second.end());
+    REQUIRE(dai::utility::decompress(first.data(), first.size(), CompressionFormat::ZSTD) == std::vector<uint8_t>(data.begin(), data.begin() + 3000));
+
+    REQUIRE_THROWS_AS(dai::utility::StreamCompressor(CompressionFormat::ZSTD, 100), std::invalid_argument);
+    REQUIRE_THROWS_AS(dai::utility::StreamCompressor(CompressionFormat::ZLIB, 10), std::invalid_argument);
+    REQUIRE_THROWS_AS(dai::utility::StreamCompressor(CompressionFormat::ZLIB, 6, 2, 1024), std::invalid_argument);
+}
+
+TEST_CASE("Compression fuzzing", "[StreamCompressor]") {
+    std::mt19937 random(4);
+    std::uniform_int_distribution<size_t> dataSize(0, 256 * 1024);
+    for(int iteration = 0; iteration < 40; iteration++) {
+        const auto format = iteration % 2 == 0 ? CompressionFormat::ZLIB : CompressionFormat::ZSTD;
+        const unsigned numThreads = iteration % 3 == 0 ? 2 : 1;
+        const int level = std::uniform_int_distribution<int>(1, 9)(random);
+        auto data = generateMixedData(dataSize(random), random);
+        dai::utility::StreamCompressor compressor(format, level, numThreads, 32 * 1024);
+        auto compressed = compressChunked(compressor, data, random);
+        REQUIRE(decompressChunked(format, compressed, random) == data);
+
+        // Truncated streams are detected
+        const size_t truncated = std::uniform_int_distribution<size_t>(0, compressed.size() - 1)(random);
+        REQUIRE_THROWS_AS(dai::utility::decompress(compressed.data(), truncated, format), std::runtime_error);
+
+        // Corrupted streams either fail or, if the corruption went unnoticed, still decompress correctly
+        auto corrupted = compressed;
+        corrupted[std::uniform_int_distribution<size_t>(0, corrupted.size() - 1)(random)] ^= static_cast<uint8_t>(1 + random() % 255);
+        std::vector<uint8_t> decompressed;
+        bool detected = false;
+        try {
+            decompressed = decompressChunked(format, corrupted, random);
+        } catch(const std::runtime_error&) {
+            detected = true;
+        }
+        if(!detected) REQUIRE(decompressed == data);
+
+        // Trailing data after a ZLIB stream is an error
+        if(format == CompressionFormat::ZLIB) {
+            compressed.push_back(0);
+            REQUIRE_THROWS_AS(dai::utility::decompress(compressed.data(), compressed.size(), format), std::runtime_error);
+        }
+    }
+
+    // Random bytes aren't a valid stream
+    for(int iteration = 0; iteration < 20; iteration++) {
+        auto garbage = generateMixedData(std::uniform_int_distribution<size_t>(1, 4096)(random), random);
+        for(auto format : {CompressionFormat::ZLIB, CompressionFormat::ZSTD}) {
+            REQUIRE_THROWS_AS(dai::utility::decompress(garbage.data(), garbage.size(), format), std::runtime_error);
+        }
+    }
+}
+
+TEST_CASE("deflateParallel produces a valid zlib stream", "[deflateParallel]") {
+    for(size_t size : {size_t(0), size_t(1), size_t(64 * 1024), size_t(3 * 1024 * 1024 + 17)}) {
+        auto data = generateData(size);
+        auto compressed = deflateParallel(data, 4);
+
+        std::vector<uint8_t> decompressed(size + 1);
+        uLongf decompressedSize = static_cast<uLongf>(decompressed.size());
+        REQUIRE(uncompress(decompressed.data(), &decompressedSize, compressed.data(), static_cast<uLong>(compressed.size())) == Z_OK);
+        decompressed.resize(decompressedSize);
+        REQUIRE(decompressed == data);
+    }
+}
+
+TEST_CASE("deflateParallel output doesn't depend on number of threads", "[deflateParallel]") {
+    auto data = generateData(5 * 1024 * 1024);
+    auto reference = deflateParallel(data, 1);
+    REQUIRE(deflateParallel(data, 3) == reference);
+    REQUIRE(deflateParallel(data, 8) == reference);
+}
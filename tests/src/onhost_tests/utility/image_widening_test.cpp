@@ -0,0 +1,42 @@
+#include <catch2/catch_all.hpp>
+#include <cstdint>
+#include <vector>
+
+#include "utility/ImageWidening.hpp"
+
+TEST_CASE("widen8To16 moves pixels to the upper byte", "[ImageWidening]") {
+    constexpr size_t width = 37;
+    constexpr size_t height = 5;
+    constexpr size_t srcStride = 48;
+    constexpr size_t dstStride = 40 * sizeof(uint16_t);
+    std::vector<uint8_t> src(srcStride * height);
+    for(size_t i = 0; i < src.size(); i++) src[i] = static_cast<uint8_t>(i * 7);
+    std::vector<uint16_t> dst(dstStride / sizeof(uint16_t) * height, 0xFFFF);
+
+    dai::utility::widen8To16(src.data(), srcStride, dst.data(), dstStride, width, height);
+    for(size_t y = 0; y < height; y++) {
+        for(size_t x = 0; x < dstStride / sizeof(uint16_t); x++) {
+            const uint16_t value = dst[y * dstStride / sizeof(uint16_t) + x];
+            // Padding is left untouched
+            REQUIRE(value == (x < width ? src[y * srcStride + x] << 8 : 0xFFFF));
+        }
+    }
+}
+
+TEST_CASE("copy16 copies rows between strides", "[ImageWidening]") {
+    constexpr size_t width = 19;
+    constexpr size_t height = 4;
+    std::vector<uint16_t> src(24 * height);
+    for(size_t i = 0; i < src.size(); i++) src[i] = static_cast<uint16_t>(i * 1031);
+
+    std::vector<uint16_t> packed(width * height);
+    dai::utility::copy16(src.data(), 24 * sizeof(uint16_t), packed.data(), width * sizeof(uint16_t), width, height);
+    std::vector<uint16_t> copy(width * height);
+    dai::utility::copy16(packed.data(), width * sizeof(uint16_t), copy.data(), width * sizeof(uint16_t), width, height);
+    for(size_t y = 0; y < height; y++) {
+        for(size_t x = 0; x < width; x++) {
+            REQUIRE(packed[y * width + x] == src[y * 24 + x]);
+            REQUIRE(copy[y * width + x] == src[y * 24 + x]);
+        }
+    }
+}
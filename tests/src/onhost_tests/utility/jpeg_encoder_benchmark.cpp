@@ -0,0 +1,55 @@
+// Benchmark of the host MJPEG encoder used by VideoEncoder, on synthetic 4K NV12 and grayscale frames.
+// Reports the time per frame for a range of worker thread counts, MCU rows being encoded in parallel.
+//
+// Usage: jpeg_encoder_benchmark [frames] [quality] [width] [height]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "utility/JpegEncoderImpl.hpp"
+
+int main(int argc, char** argv) {
+    const int numFrames = argc > 1 ? std::atoi(argv[1]) : 20;
+    const int quality = argc > 2 ? std::atoi(argv[2]) : 80;
+    const int width = argc > 3 ? std::atoi(argv[3]) : 3840;
+    const int height = argc > 4 ? std::atoi(argv[4]) : 2160;
+
+    // Smooth gradients with some noise, so blocks have a realistic number of coefficients
+    std::vector<std::uint8_t> luma(static_cast<size_t>(width) * height);
+    std::vector<std::uint8_t> chroma(static_cast<size_t>((width + 1) / 2) * 2 * ((height + 1) / 2));
+    std::srand(1);
+    for(int y = 0; y < height; y++) {
+        for(int x = 0; x < width; x++) {
+            const double value = 128 + 60 * std::sin(x * 0.01) + 40 * std::cos(y * 0.013) + std::rand() % 16 - 8;
+            luma[static_cast<size_t>(y) * width + x] = static_cast<std::uint8_t>(std::max(0.0, std::min(255.0, value)));
+        }
+    }
+    for(size_t i = 0; i < chroma.size(); i++) chroma[i] = static_cast<std::uint8_t>(128 + 30 * std::sin(static_cast<double>(i % width) * 0.005));
+
+    std::vector<unsigned> threadCounts = {1, 2, 4, 8};
+    const unsigned hardwareThreads = std::max(1U, std::thread::hardware_concurrency());
+    if(std::find(threadCounts.begin(), threadCounts.end(), hardwareThreads) == threadCounts.end()) threadCounts.push_back(hardwareThreads);
+
+    std::printf("%dx%d, quality %d, %d frames, %u hardware threads\n", width, height, quality, numFrames, hardwareThreads);
+    for(const bool color : {true, false}) {
+        std::printf("%s\n", color ? "NV12" : "GRAY8");
+        double singleThreaded = 0;
+        for(const auto numThreads : threadCounts) {
+            dai::impl::JpegEncoder encoder(quality, numThreads);
+            const std::uint8_t* chromaPlane = color ? chroma.data() : nullptr;
+            size_t size = encoder.encode(luma.data(), width, chromaPlane, width, width, height).size();
+            const auto start = std::chrono::steady_clock::now();
+            for(int frame = 0; frame < numFrames; frame++) size = encoder.encode(luma.data(), width, chromaPlane, width, width, height).size();
+            const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / numFrames;
+            if(numThreads == 1) singleThreaded = ms;
+            std::printf("  %2u threads: %8.2f ms per frame (%.2fx), %zu bytes\n", numThreads, ms, singleThreaded / ms, size);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,113 @@
+#include <catch2/catch_all.hpp>
+#include <cstdint>
+#include <vector>
+
+#include "utility/MapDiff.hpp"
+
+using dai::Point3fRGBA;
+using dai::utility::TileMapDiff;
+using dai::utility::VoxelMapDiff;
+
+namespace {
+
+std::vector<Point3fRGBA> takeChanges(VoxelMapDiff& diff) {
+    std::vector<Point3fRGBA> changes;
+    diff.takeChanges(changes);
+    return changes;
+}
+
+std::vector<TileMapDiff::Rect> update(TileMapDiff& diff, const std::vector<uint8_t>& map, int width, int height, int originX, int originY) {
+    std::vector<TileMapDiff::Rect> changed;
+    diff.update(map.data(), width, width, height, originX, originY, [&](const TileMapDiff::Rect& tile) { changed.push_back(tile); });
+    return changed;
+}
+
+}  // namespace
+
+TEST_CASE("VoxelMapDiff reports added and removed voxels", "[MapDiff]") {
+    VoxelMapDiff diff(0.1f);
+    diff.addNode(1, {{0.01f, 0.01f, 0.01f, 1, 0, 0}, {0.02f, 0.02f, 0.02f, 2, 0, 0}, {0.5f, 0.0f, 0.0f, 3, 0, 0}});
+    auto changes = takeChanges(diff);
+    REQUIRE(changes.size() == 2);
+    REQUIRE(diff.size() == 2);
+    // Voxels are published with their first point
+    REQUIRE(changes[0].r == 1);
+    REQUIRE(changes[1].r == 3);
+    REQUIRE(takeChanges(diff).empty());
+
+    // Voxels shared with another node are only added once, and only removed with the last node holding them
+    diff.addNode(2, {{0.05f, 0.05f, 0.05f, 4, 0, 0}, {-0.05f, 0.0f, 0.0f, 5, 0, 0}});
+    changes = takeChanges(diff);
+    REQUIRE(changes.size() == 1);
+    REQUIRE(changes[0].r == 5);
+    diff.removeNode(1);
+    changes = takeChanges(diff);
+    REQUIRE(changes.size() == 1);
+    REQUIRE(changes[0].r == 3);
+    REQUIRE(changes[0].a == 0);
+    REQUIRE(diff.size() == 2);
+
+    // Voxels removed and added again before the changes are taken are unchanged
+    diff.removeNode(2);
+    diff.addNode(3, {{0.0f, 0.0f, 0.0f, 6, 0, 0}, {-0.05f, 0.0f, 0.0f, 7, 0, 0}});
+    REQUIRE(takeChanges(diff).empty());
+    REQUIRE(!diff.hasNode(2));
+    REQUIRE(diff.getNodes() == std::vector<int>{3});
+
+    // Replacing the points of a node reports the difference
+    diff.addNode(3, {{0.0f, 0.0f, 0.0f, 8, 0, 0}, {0.0f, 0.3f, 0.0f, 9, 0, 0}});
+    changes = takeChanges(diff);
+    REQUIRE(changes.size() == 2);
+    for(const auto& point : changes) REQUIRE((point.r == 9 ? point.a == 255 : point.r == 5 && point.a == 0));
+}
+
+TEST_CASE("VoxelMapDiff starts from a published map", "[MapDiff]") {
+    VoxelMapDiff diff(0.1f);
+    diff.addNode(1, {{0.0f, 0.0f, 0.0f, 1, 0, 0}});
+    diff.addNode(2, {{1.0f, 0.0f, 0.0f, 2, 0, 0}});
+    diff.removeNode(2);
+    diff.markPublished();
+    REQUIRE(diff.size() == 1);
+    REQUIRE(takeChanges(diff).empty());
+    diff.removeNode(1);
+    auto changes = takeChanges(diff);
+    REQUIRE(changes.size() == 1);
+    REQUIRE(changes[0].a == 0);
+    REQUIRE(diff.size() == 0);
+}
+
+TEST_CASE("TileMapDiff reports changed tiles", "[MapDiff]") {
+    TileMapDiff diff(4);
+    std::vector<uint8_t> map(10 * 6, 1);
+    // Tiles are aligned to the world, a map starting at cell -2 covers the tiles starting at -4, 0 and 4
+    auto changed = update(diff, map, 10, 6, -2, 0);
+    REQUIRE(changed.size() == 6);
+    REQUIRE((changed[0] == TileMapDiff::Rect{0, 0, 2, 4}));
+    REQUIRE((changed[1] == TileMapDiff::Rect{2, 0, 4, 4}));
+    REQUIRE((changed[2] == TileMapDiff::Rect{6, 0, 4, 4}));
+    REQUIRE((changed[3] == TileMapDiff::Rect{0, 4, 2, 2}));
+    REQUIRE(update(diff, map, 10, 6, -2, 0).empty());
+
+    map[3 * 10 + 7] = 2;
+    changed = update(diff, map, 10, 6, -2, 0);
+    REQUIRE(changed.size() == 1);
+    REQUIRE((changed[0] == TileMapDiff::Rect{6, 0, 4, 4}));
+}
+
+TEST_CASE("TileMapDiff keeps tiles when the map grows", "[MapDiff]") {
+    TileMapDiff diff(4);
+    std::vector<uint8_t> map(8 * 8);
+    for(size_t i = 0; i < map.size(); i++) map[i] = static_cast<uint8_t>(i);
+    update(diff, map, 8, 8, 0, 0);
+
+    // The same cells in a map grown by 4 cells to the left and 2 at the bottom
+    std::vector<uint8_t> grown(12 * 10, 0);
+    for(int y = 0; y < 8; y++) {
+        for(int x = 0; x < 8; x++) grown[y * 12 + x + 4] = map[y * 8 + x];
+    }
+    auto changed = update(diff, grown, 12, 10, -4, 0);
+    // Only the new tiles on the left and the tiles extended at the bottom changed
+    REQUIRE(changed.size() == 3 + 2);
+    for(const auto& tile : changed) REQUIRE((tile.x == 0 || tile.y == 8));
+    REQUIRE(update(diff, grown, 12, 10, -4, 0).empty());
+}
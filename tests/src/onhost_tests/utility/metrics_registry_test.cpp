@@ -0,0 +1,175 @@
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "depthai/depthai.hpp"
+#include "httplib.h"
+
+using namespace dai;
+using namespace std::chrono;
+
+namespace {
+
+class Relay : public node::CustomThreadedNode<Relay> {
+   public:
+    Input input{*this, {}};
+    Output out{*this, {}};
+
+    void run() override {
+        while(isRunning()) {
+            std::shared_ptr<Buffer> in;
+            try {
+                in = input.get<Buffer>();
+            } catch(const MessageQueue::QueueException&) {
+                break;
+            }
+            std::this_thread::sleep_for(milliseconds(2));
+            out.send(std::make_shared<Buffer>());
+        }
+    }
+};
+
+bool contains(const std::string& text, const std::string& part) {
+    return text.find(part) != std::string::npos;
+}
+
+}  // namespace
+
+TEST_CASE("MetricsRegistry - OpenMetrics format") {
+    MetricsRegistry::Writer writer;
+    writer.gauge("test_depth", "Queue depth", {{"queue", "in\"put"}}, 3);
+    writer.counter("test_messages", "Messages", {{"node", "a"}}, 10);
+    writer.counter("test_messages", "Messages", {{"node", "b"}}, 0.5);
+    REQUIRE(writer.toString()
+            == "# TYPE test_depth gauge\n"
+               "# HELP test_depth Queue depth\n"
+               "test_depth{queue=\"in\\\"put\"} 3\n"
+               "# TYPE test_messages counter\n"
+               "# HELP test_messages Messages\n"
+               "test_messages_total{node=\"a\"} 10\n"
+               "test_messages_total{node=\"b\"} 0.5\n"
+               "# EOF\n");
+    REQUIRE_THROWS(writer.gauge("test_messages", "Messages", {}, 1));
+}
+
+TEST_CASE("MetricsRegistry - non-finite values") {
+    MetricsRegistry::Writer writer;
+    writer.gauge("test_nan", "NaN", {}, std::numeric_limits<double>::quiet_NaN());
+    writer.gauge("test_inf", "Inf", {{"sign", "+"}}, std::numeric_limits<double>::infinity());
+    writer.gauge("test_inf", "Inf", {{"sign", "-"}}, -std::numeric_limits<double>::infinity());
+    auto text = writer.toString();
+    REQUIRE(contains(text, "test_nan NaN\n"));
+    REQUIRE(contains(text, "test_inf{sign=\"+\"} +Inf\n"));
+    REQUIRE(contains(text, "test_inf{sign=\"-\"} -Inf\n"));
+}
+
+TEST_CASE("MetricsRegistry - collectors") {
+    auto& registry = MetricsRegistry::getInstance();
+    auto id = registry.addCollector([](MetricsRegistry::Writer& writer) { writer.gauge("test_collector", "Test collector", {}, 42); });
+    REQUIRE(contains(registry.scrape(), "test_collector 42\n"));
+    REQUIRE(registry.removeCollector(id));
+    REQUIRE_FALSE(registry.removeCollector(id));
+    REQUIRE_FALSE(contains(registry.scrape(), "test_collector"));
+}
+
+TEST_CASE("MetricsRegistry - blocking collectors") {
+    auto& registry = MetricsRegistry::getInstance();
+    std::atomic<bool> running{false};
+    std::atomic<bool> release{false};
+    auto slowId = registry.addCollector([&](MetricsRegistry::Writer& writer) {
+        running = true;
+        while(!release) std::this_thread::sleep_for(milliseconds(1));
+        writer.gauge("test_slow", "Slow collector", {}, 1);
+    });
+    std::string text;
+    std::thread scraper([&] { text = registry.scrape(); });
+    while(!running) std::this_thread::sleep_for(milliseconds(1));
+
+    // Other collectors can be added and removed while one blocks
+    auto id = registry.addCollector([](MetricsRegistry::Writer&) {});
+    REQUIRE(registry.removeCollector(id));
+
+    // Removing the running collector waits for it to return
+    bool removed = false;
+    std::thread remover([&] { removed = registry.removeCollector(slowId); });
+    std::this_thread::sleep_for(milliseconds(20));
+    release = true;
+    remover.join();
+    scraper.join();
+    REQUIRE(removed);
+    REQUIRE(contains(text, "test_slow 1\n"));
+    REQUIRE_FALSE(contains(registry.scrape(), "test_slow"));
+}
+
+TEST_CASE("MetricsRegistry - pipeline metrics over HTTP") {
+    auto& registry = MetricsRegistry::getInstance();
+    auto port = registry.startServer("127.0.0.1", 0);
+    REQUIRE(port > 0);
+    REQUIRE(registry.isServerRunning());
+    REQUIRE(MetricsRegistry::isEnabled());
+
+    Pipeline pipeline(false);
+    auto relay = pipeline.create<Relay>();
+    relay->setAlias("relay");
+    auto inputQueue = relay->input.createInputQueue();
+    auto outputQueue = relay->out.createOutputQueue();
+    pipeline.start();
+    for(int i = 0; i < 5; i++) {
+        inputQueue->send(std::make_shared<Buffer>());
+        outputQueue->get();
+    }
+
+    httplib::Client client("127.0.0.1", port);
+    auto res = client.Get("/metrics");
+    REQUIRE(res);
+    REQUIRE(res->status == 200);
+    REQUIRE(contains(res->get_header_value("Content-Type"), "application/openmetrics-text"));
+    const auto& text = res->body;
+    const std::string relayLabels = "node=\"relay\",node_id=\"" + std::to_string(relay->id) + "\"";
+    REQUIRE(contains(text, "depthai_queue_pushed_messages_total{" + relayLabels + ",queue=\"" + relay->input.getName() + "\"} 5\n"));
+    REQUIRE(contains(text, "depthai_node_sent_messages_total{" + relayLabels + ",output=\"" + relay->out.getName() + "\"} 5\n"));
+    REQUIRE(contains(text, "depthai_node_processed_messages_total{" + relayLabels + ",output=\"" + relay->out.getName() + "\"} 5\n"));
+    REQUIRE(contains(text, "depthai_xlink_global_written_bytes_total"));
+    REQUIRE(text.size() >= 6);
+    REQUIRE(text.substr(text.size() - 6) == "# EOF\n");
+
+    // Processing time includes the simulated work
+    auto stats = relay->out.getStats();
+    REQUIRE(stats.messages == 5);
+    REQUIRE(stats.processingTime >= milliseconds(10));
+
+    pipeline.stop();
+    REQUIRE_FALSE(contains(registry.scrape(), relayLabels));
+    registry.stopServer();
+    REQUIRE_FALSE(registry.isServerRunning());
+    MetricsRegistry::setEnabled(false);
+}
+
+TEST_CASE("MetricsRegistry - queue statistics") {
+    MessageQueue queue(2, false);
+    for(int i = 0; i < 5; i++) {
+        auto buffer = std::make_shared<Buffer>();
+        buffer->setData(std::vector<std::uint8_t>(100));
+        queue.send(buffer);
+    }
+    auto stats = queue.getStats();
+    REQUIRE(stats.pushed == 5);
+    REQUIRE(stats.dropped == 3);
+    REQUIRE(stats.size == 2);
+    REQUIRE(stats.heldBytes == 200);
+    REQUIRE(stats.blockedTime == nanoseconds(0));
+
+    MessageQueue blockingQueue(1, true);
+    blockingQueue.send(std::make_shared<Buffer>());
+    std::thread consumer([&blockingQueue]() {
+        std::this_thread::sleep_for(milliseconds(20));
+        blockingQueue.get();
+    });
+    blockingQueue.send(std::make_shared<Buffer>());
+    consumer.join();
+    REQUIRE(blockingQueue.getStats().blockedTime >= milliseconds(10));
+}